@@ -58,12 +58,12 @@ void ActorController::OnUpdate(uint32 msDiff)
 
     if (fabs(climbY) > FLT_EPSILON)
     {
-        shared_ptr<EventData_Start_Climb> pClimbEvent(new EventData_Start_Climb(m_pControlledObject->VGetProperties()->GetActorId(), Point(0, climbY)));
+        shared_ptr<EventData_Start_Climb> pClimbEvent(MakeEvent<EventData_Start_Climb>(m_pControlledObject->VGetProperties()->GetActorId(), Point(0, climbY)));
         IEventMgr::Get()->VTriggerEvent(pClimbEvent);
     }
     if (fabs(moveX) > FLT_EPSILON || fabs(moveY) > FLT_EPSILON)
     {
-        shared_ptr<EventData_Actor_Start_Move> pMoveEvent(new EventData_Actor_Start_Move(m_pControlledObject->VGetProperties()->GetActorId(), Point(moveX, moveY)));
+        shared_ptr<EventData_Actor_Start_Move> pMoveEvent(MakeEvent<EventData_Actor_Start_Move>(m_pControlledObject->VGetProperties()->GetActorId(), Point(moveX, moveY)));
         IEventMgr::Get()->VTriggerEvent(pMoveEvent);
     }
 
@@ -79,19 +79,19 @@ bool ActorController::VOnKeyDown(SDL_Keycode key)
 {
     if (SDL_GetScancodeFromKey(key) == SDL_SCANCODE_LALT)
     {
-        shared_ptr<EventData_Actor_Fire> pClimbEvent(new EventData_Actor_Fire(m_pControlledObject->VGetProperties()->GetActorId()));
+        shared_ptr<EventData_Actor_Fire> pClimbEvent(MakeEvent<EventData_Actor_Fire>(m_pControlledObject->VGetProperties()->GetActorId()));
         IEventMgr::Get()->VTriggerEvent(pClimbEvent);
         return true;
     }
     else if (SDL_GetScancodeFromKey(key) == SDL_SCANCODE_LCTRL)
     {
-        shared_ptr<EventData_Actor_Attack> pClimbEvent(new EventData_Actor_Attack(m_pControlledObject->VGetProperties()->GetActorId()));
+        shared_ptr<EventData_Actor_Attack> pClimbEvent(MakeEvent<EventData_Actor_Attack>(m_pControlledObject->VGetProperties()->GetActorId()));
         IEventMgr::Get()->VTriggerEvent(pClimbEvent);
         return true;
     }
     else if (SDL_GetScancodeFromKey(key) == SDL_SCANCODE_LSHIFT)
     {
-        shared_ptr<EventData_Request_Change_Ammo_Type> pEvent(new EventData_Request_Change_Ammo_Type(m_pControlledObject->VGetProperties()->GetActorId()));
+        shared_ptr<EventData_Request_Change_Ammo_Type> pEvent(MakeEvent<EventData_Request_Change_Ammo_Type>(m_pControlledObject->VGetProperties()->GetActorId()));
         IEventMgr::Get()->VTriggerEvent(pEvent);
         return true;
     }
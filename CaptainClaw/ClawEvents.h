@@ -43,7 +43,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Actor_Start_Move(m_Id, m_Move));
+        return MakeEvent<EventData_Actor_Start_Move>(m_Id, m_Move);
     }
 
     virtual const char* GetName(void) const
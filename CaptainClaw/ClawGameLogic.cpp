@@ -112,7 +112,7 @@ void ClawGameLogic::ControlledActorStartMoveDelegate(IEventDataPtr pEventData)
     }
 
     shared_ptr<PhysicsComponent> pPhysicsComponent = 
-        MakeStrongPtr(pActor->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+        MakeStrongPtr(pActor->GetComponent<PhysicsComponent>());
     if (!pPhysicsComponent)
     {
         return;
@@ -132,7 +132,7 @@ void ClawGameLogic::ControlledActorStartClimbDelegate(IEventDataPtr pEventData)
     }
 
     shared_ptr<PhysicsComponent> pPhysicsComponent =
-        MakeStrongPtr(pActor->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+        MakeStrongPtr(pActor->GetComponent<PhysicsComponent>());
     if (!pPhysicsComponent)
     {
         return;
@@ -152,7 +152,7 @@ void ClawGameLogic::ActorFireDelegate(IEventDataPtr pEventData)
     }
 
     shared_ptr<ClawControllableComponent> pControllableComponent =
-        MakeStrongPtr(pActor->GetComponent<ClawControllableComponent>(ClawControllableComponent::g_Name));
+        MakeStrongPtr(pActor->GetComponent<ClawControllableComponent>());
     if (!pControllableComponent)
     {
         return;
@@ -172,7 +172,7 @@ void ClawGameLogic::ActorAttackDelegate(IEventDataPtr pEventData)
     }
 
     shared_ptr<ClawControllableComponent> pControllableComponent =
-        MakeStrongPtr(pActor->GetComponent<ClawControllableComponent>(ClawControllableComponent::g_Name));
+        MakeStrongPtr(pActor->GetComponent<ClawControllableComponent>());
     if (!pControllableComponent)
     {
         return;
@@ -190,7 +190,7 @@ void ClawGameLogic::NewLifeDelegate(IEventDataPtr pEventData)
         return;
     }
 
-    shared_ptr<LifeComponent> pLifeComponent = MakeStrongPtr(pActor->GetComponent<LifeComponent>(LifeComponent::g_Name));
+    shared_ptr<LifeComponent> pLifeComponent = MakeStrongPtr(pActor->GetComponent<LifeComponent>());
     if (!pLifeComponent)
     {
         LOG_WARNING("Life component not present in actor: " + pActor->GetName());
@@ -212,8 +212,7 @@ void ClawGameLogic::TeleportActorDelegate(IEventDataPtr pEventData)
     }
 
     m_pPhysics->VSetPosition(pCastEventData->GetActorId(), pCastEventData->GetDestination());
-    IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-        new EventData_Move_Actor(pCastEventData->GetActorId(), pCastEventData->GetDestination())));
+    IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Move_Actor>(pCastEventData->GetActorId(), pCastEventData->GetDestination()));
     pActor->GetPositionComponent()->SetPosition(pCastEventData->GetDestination());
 }
 
@@ -228,7 +227,7 @@ void ClawGameLogic::RequestChangeAmmoTypeDelegate(IEventDataPtr pEventData)
     }
 
     shared_ptr<AmmoComponent> pAmmoComponent =
-        MakeStrongPtr(pActor->GetComponent<AmmoComponent>(AmmoComponent::g_Name));
+        MakeStrongPtr(pActor->GetComponent<AmmoComponent>());
     if (!pAmmoComponent)
     {
         return;
@@ -237,7 +236,7 @@ void ClawGameLogic::RequestChangeAmmoTypeDelegate(IEventDataPtr pEventData)
     AmmoType newAmmoType = AmmoType((pAmmoComponent->GetActiveAmmoType() + 1) % AmmoType_Max);
     pAmmoComponent->SetActiveAmmo(newAmmoType);
 
-    shared_ptr<EventData_Updated_Ammo_Type> pEvent(new EventData_Updated_Ammo_Type(pCastEventData->GetActorId(), newAmmoType));
+    shared_ptr<EventData_Updated_Ammo_Type> pEvent(MakeEvent<EventData_Updated_Ammo_Type>(pCastEventData->GetActorId(), newAmmoType));
     IEventMgr::Get()->VTriggerEvent(pEvent);
 }
 
@@ -253,7 +252,7 @@ void ClawGameLogic::ModifyActorStatDelegate(IEventDataPtr pEventData)
 
     if (pCastEventData->GetStatType() == PlayerStat_Score)
     {
-        shared_ptr<ScoreComponent> pScoreComponent = MakeStrongPtr(pActor->GetComponent<ScoreComponent>(ScoreComponent::g_Name));
+        shared_ptr<ScoreComponent> pScoreComponent = MakeStrongPtr(pActor->GetComponent<ScoreComponent>());
         if (!pScoreComponent)
         {
             assert(false && "Actor does not have ScoreComponent !");
@@ -270,7 +269,7 @@ void ClawGameLogic::ModifyActorStatDelegate(IEventDataPtr pEventData)
     }
     else if (pCastEventData->GetStatType() == PlayerStat_Health)
     {
-        shared_ptr<HealthComponent> pHealthComponent = MakeStrongPtr(pActor->GetComponent<HealthComponent>(HealthComponent::g_Name));
+        shared_ptr<HealthComponent> pHealthComponent = MakeStrongPtr(pActor->GetComponent<HealthComponent>());
         if (!pHealthComponent)
         {
             assert(false && "Actor does not have HealthComponent !");
@@ -287,7 +286,7 @@ void ClawGameLogic::ModifyActorStatDelegate(IEventDataPtr pEventData)
     }
     else if (pCastEventData->GetStatType() == PlayerStat_Lives)
     {
-        shared_ptr<LifeComponent> pLifeComponent = MakeStrongPtr(pActor->GetComponent<LifeComponent>(LifeComponent::g_Name));
+        shared_ptr<LifeComponent> pLifeComponent = MakeStrongPtr(pActor->GetComponent<LifeComponent>());
         if (!pLifeComponent)
         {
             assert(false && "Actor does not have LifeComponent !");
@@ -307,7 +306,7 @@ void ClawGameLogic::ModifyActorStatDelegate(IEventDataPtr pEventData)
         pCastEventData->GetStatType() == PlayerStat_Dynamite)
     {
         shared_ptr<AmmoComponent> pAmmoComponent =
-            MakeStrongPtr(pActor->GetComponent<AmmoComponent>(AmmoComponent::g_Name));
+            MakeStrongPtr(pActor->GetComponent<AmmoComponent>());
         if (!pAmmoComponent)
         {
             assert(false && "Actor does not have AmmoComponent !");
@@ -355,10 +354,10 @@ void ClawGameLogic::CheckpointReachedDelegate(IEventDataPtr pEventData)
     {
         CheckpointSave checkpointSave;
         
-        auto pScoreComponent = MakeStrongPtr(pActor->GetComponent<ScoreComponent>(ScoreComponent::g_Name));
-        auto pHealthComponent = MakeStrongPtr(pActor->GetComponent<HealthComponent>(HealthComponent::g_Name));
-        auto pLifeComponent = MakeStrongPtr(pActor->GetComponent<LifeComponent>(LifeComponent::g_Name));
-        auto pAmmoComponent = MakeStrongPtr(pActor->GetComponent<AmmoComponent>(AmmoComponent::g_Name));
+        auto pScoreComponent = MakeStrongPtr(pActor->GetComponent<ScoreComponent>());
+        auto pHealthComponent = MakeStrongPtr(pActor->GetComponent<HealthComponent>());
+        auto pLifeComponent = MakeStrongPtr(pActor->GetComponent<LifeComponent>());
+        auto pAmmoComponent = MakeStrongPtr(pActor->GetComponent<AmmoComponent>());
         assert(pScoreComponent);
         assert(pHealthComponent);
         assert(pLifeComponent);
@@ -387,10 +386,10 @@ void ClawGameLogic::ClawDiedDelegate(IEventDataPtr pEventData)
     }
 
     IEventMgr* pEventMgr = IEventMgr::Get();
-    pEventMgr->VTriggerEvent(IEventDataPtr(new EventData_Modify_Player_Stat(pCastEventData->GetActorId(), PlayerStat_Lives, -1, true)));
+    pEventMgr->VTriggerEvent(MakeEvent<EventData_Modify_Player_Stat>(pCastEventData->GetActorId(), PlayerStat_Lives, -1, true));
 
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(pCastEventData->GetActorId(), PlayerStat_Health, 1000, true)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Teleport_Actor(pCastEventData->GetActorId(), m_CurrentSpawnPosition)));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(pCastEventData->GetActorId(), PlayerStat_Health, 1000, true));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Teleport_Actor>(pCastEventData->GetActorId(), m_CurrentSpawnPosition));
 }
 
 void ClawGameLogic::UpdatedPowerupStatusDelegate(IEventDataPtr pEventData)
@@ -406,7 +405,7 @@ void ClawGameLogic::UpdatedPowerupStatusDelegate(IEventDataPtr pEventData)
     if (pCastEventData->GetPowerupType() == PowerupType_Catnip)
     {
         shared_ptr<PhysicsComponent> pPhysicsComponent =
-            MakeStrongPtr(pActor->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+            MakeStrongPtr(pActor->GetComponent<PhysicsComponent>());
         assert(pPhysicsComponent);
 
         if (pCastEventData->IsPowerupFinished())
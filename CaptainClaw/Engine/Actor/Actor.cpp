@@ -1,4 +1,5 @@
 #include <tinyxml.h>
+#include <unordered_set>
 
 #include "../SharedDefines.h"
 #include "Actor.h"
@@ -6,25 +7,48 @@
 
 #include "Components/PositionComponent.h"
 
+// There are only as many names as there are actor types. Never destroyed, actors can still be released during
+// static destruction.
+static const std::string* InternActorName(const char* name)
+{
+    static std::unordered_set<std::string>* s_pActorNames = new std::unordered_set<std::string>;
+    // Reused so that looking up already interned name does not allocate
+    static std::string s_LookupName;
+
+    s_LookupName.assign(name);
+    auto findIt = s_pActorNames->find(s_LookupName);
+    if (findIt == s_pActorNames->end())
+    {
+        findIt = s_pActorNames->insert(s_LookupName).first;
+    }
+
+    return &*findIt;
+}
+
 Actor::Actor(uint32 actorGUID)
 {
     _GUID = actorGUID;
-    _name = "Unknown";
+    _pName = InternActorName("Unknown");
     _resource = "Unknown";
+    _alwaysActive = false;
 }
 
 Actor::~Actor()
 {
-    //LOG_TAG("Actor", "Destructor: Destroying actor: " + _name + ", GUID: " + std::to_string(_GUID));
-    assert(_components.empty() && "Actors components are not empty !");
+    //LOG_TAG("Actor", "Destructor: Destroying actor: " + GetName() + ", GUID: " + std::to_string(_GUID));
+    for (const StrongActorComponentPtr& pComponent : _components)
+    {
+        assert(!pComponent && "Actors components are not empty !");
+    }
 }
 
 bool Actor::Init(TiXmlElement* data)
 {
-    _name = data->Attribute("Type");
+    _pName = InternActorName(data->Attribute("Type"));
+    data->QueryBoolAttribute("AlwaysActive", &_alwaysActive);
     //_resource = data->Attribute("resource");
 
-    //LOG_TAG("Actor", "Constructor: Initializing actor: " + _name + ", GUID: " + std::to_string(_GUID) + 
+    //LOG_TAG("Actor", "Constructor: Initializing actor: " + GetName() + ", GUID: " + std::to_string(_GUID) + 
         //" from resource: " + _resource);
 
     return true;
@@ -32,33 +56,45 @@ bool Actor::Init(TiXmlElement* data)
 
 void Actor::PostInit()
 {
-    for (auto component : _components)
+    for (StrongActorComponentPtr pComponent : _components)
     {
-        component.second->VPostInit();
+        if (pComponent)
+        {
+            pComponent->VPostInit();
+        }
     }
 
-    m_pPositionComponent = MakeStrongPtr(GetComponent<PositionComponent>(PositionComponent::g_Name));
+    m_pPositionComponent = MakeStrongPtr(GetComponent<PositionComponent>());
 }
 
 void Actor::PostPostInit()
 {
-    for (auto component : _components)
+    for (StrongActorComponentPtr pComponent : _components)
     {
-        component.second->VPostPostInit();
+        if (pComponent)
+        {
+            pComponent->VPostPostInit();
+        }
     }
 }
 
 void Actor::Destroy()
 {
-    //LOG("Destroying actor: " + _name);
-    _components.clear();
+    //LOG("Destroying actor: " + GetName());
+    for (StrongActorComponentPtr& pComponent : _components)
+    {
+        pComponent.reset();
+    }
 }
 
 void Actor::Update(uint32 msDiff)
 {
-    for (auto component : _components)
+    for (const StrongActorComponentPtr& pComponent : _components)
     {
-        component.second->VUpdate(msDiff);
+        if (pComponent)
+        {
+            pComponent->VUpdate(msDiff);
+        }
     }
 }
 
@@ -71,8 +107,9 @@ std::string Actor::ToXML()
 
 void Actor::AddComponent(StrongActorComponentPtr component)
 {
-    std::pair<ActorComponentsMap::iterator, bool> success =
-        _components.insert(std::make_pair(component->VGetId(), component));
+    uint32 typeIndex = component->GetTypeIndex();
+    assert(typeIndex > 0 && typeIndex < MAX_COMPONENT_TYPES && "Component type is not registered");
+    assert(!_components[typeIndex] && "Actor already has component of this type");
 
-    assert(success.second);
+    _components[typeIndex] = component;
 }
\ No newline at end of file
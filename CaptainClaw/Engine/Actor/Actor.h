@@ -4,13 +4,14 @@
 #include <string>
 #include <stdint.h>
 #include <memory>
-#include <map>
+#include <array>
 
 #include "../SharedDefines.h"
 
 #include "ActorComponent.h"
 
-typedef std::map<uint32, StrongActorComponentPtr> ActorComponentsMap;
+// Indexed by ComponentTypeIndex, slots of component types which actor does not have are NULL
+typedef std::array<StrongActorComponentPtr, MAX_COMPONENT_TYPES> ActorComponentArray;
 
 class PositionComponent;
 class TiXmlElement;
@@ -24,49 +25,32 @@ public:
     void PostInit();
     void PostPostInit();
     void Destroy();
+    // Updates every component of this actor, game logic updates all actors through
+    // ComponentUpdateScheduler instead
     void Update(uint32_t msDiff);
 
     std::string ToXML();
 
     uint32_t GetGUID() const { return _GUID; }
-    std::string GetName() const { return _name; }
+    const std::string& GetName() const { return *_pName; }
+    // Always active actors are never suspended when they are far from camera
+    bool IsAlwaysActive() const { return _alwaysActive; }
 
-    // Retrieves component from given ID or NULL if component not found
+    // Retrieves component of given type or NULL if component not found
     template <class ComponentType>
-    weak_ptr<ComponentType> GetComponent(uint32 id)
+    weak_ptr<ComponentType> GetComponent()
     {
-        ActorComponentsMap::iterator findIter = _components.find(id);
-        if (findIter != _components.end())
-        {
-            StrongActorComponentPtr base(findIter->second);
-            shared_ptr<ComponentType> sub(std::static_pointer_cast<ComponentType>(base));  // cast to subclass version of the pointer
-            weak_ptr<ComponentType> weakSub(sub);  // convert strong pointer to weak pointer
-            return weakSub;  // return the weak pointer
-        }
-
-        return weak_ptr<ComponentType>();
+        return static_pointer_cast<ComponentType>(_components[ComponentTypeIndex<ComponentType>::value]);
     }
 
-    // Retrieves component from given name or NULL if component not found
-    template <class ComponentType>
-    weak_ptr<ComponentType> GetComponent(const char *name)
+    // Retrieves component from given type index or NULL if component not found
+    StrongActorComponentPtr GetComponentByTypeIndex(uint32 typeIndex)
     {
-        uint32 id = ActorComponent::GetIdFromName(name);
-        ActorComponentsMap::iterator findIter = _components.find(id);
-        if (findIter != _components.end())
-        {
-            StrongActorComponentPtr base(findIter->second);
-            shared_ptr<ComponentType> sub(static_pointer_cast<ComponentType>(base));  // cast to subclass version of the pointer
-            weak_ptr<ComponentType> weakSub(sub);  // convert strong pointer to weak pointer
-            return weakSub;  // return the weak pointer
-        }
-        else
-        {
-            return weak_ptr<ComponentType>();
-        }
+        assert(typeIndex < MAX_COMPONENT_TYPES);
+        return _components[typeIndex];
     }
 
-    const ActorComponentsMap* GetComponents() { return &_components; }
+    const ActorComponentArray* GetComponents() { return &_components; }
 
     void AddComponent(StrongActorComponentPtr pComponent);
 
@@ -81,9 +65,11 @@ private:
     friend class ActorFactory;
 
     uint32_t _GUID;
-    std::string _name;
+    // Interned, actors of the same type share one string so that spawning does not allocate it
+    const std::string* _pName;
+    bool _alwaysActive;
 
-    ActorComponentsMap _components;
+    ActorComponentArray _components;
 
     // Resource from which this actor was loaded
     std::string _resource;
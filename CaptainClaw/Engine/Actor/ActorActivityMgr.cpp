@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ActorActivityMgr.h"
+#include "ComponentUpdateScheduler.h"
+#include "Actor.h"
+
+#include "Components/PositionComponent.h"
+
+// Side of one grid cell of suspended actors in pixels
+static const int32 ACTIVITY_CELL_SIZE = 512;
+
+static int32 GetCellCoord(double position)
+{
+    return (int32)floor(position / ACTIVITY_CELL_SIZE);
+}
+
+static uint64 GetCellKey(int32 cellX, int32 cellY)
+{
+    return ((uint64)(uint32)cellX << 32) | (uint32)cellY;
+}
+
+static bool IsInRegion(const Point& position, const SDL_Rect& region)
+{
+    return position.x >= region.x && position.x < (region.x + region.w) &&
+        position.y >= region.y && position.y < (region.y + region.h);
+}
+
+ActorActivityMgr::ActorActivityMgr()
+    :
+    m_Margin(-1),
+    m_NumSuspendedActors(0)
+{
+
+}
+
+void ActorActivityMgr::AddActor(StrongActorPtr pActor)
+{
+    if (!pActor->GetPositionComponent() || pActor->IsAlwaysActive())
+    {
+        return;
+    }
+
+    TrackedActor& trackedActor = m_TrackedActors[pActor->GetGUID()];
+    assert(!trackedActor.pActor && "Actor is already tracked");
+
+    trackedActor.pActor = pActor;
+    m_ActiveActorIds.push_back(pActor->GetGUID());
+}
+
+void ActorActivityMgr::RemoveActor(StrongActorPtr pActor)
+{
+    auto findIter = m_TrackedActors.find(pActor->GetGUID());
+    if (findIter == m_TrackedActors.end())
+    {
+        return;
+    }
+
+    const TrackedActor& trackedActor = findIter->second;
+    if (trackedActor.bIsSuspended)
+    {
+        std::vector<uint32>& cellActorIds = m_SuspendedActorCells[trackedActor.cellKey];
+        cellActorIds.erase(std::find(cellActorIds.begin(), cellActorIds.end(), pActor->GetGUID()));
+        if (cellActorIds.empty())
+        {
+            m_SuspendedActorCells.erase(trackedActor.cellKey);
+        }
+
+        m_NumSuspendedActors--;
+    }
+
+    m_TrackedActors.erase(findIter);
+}
+
+void ActorActivityMgr::Clear()
+{
+    m_TrackedActors.clear();
+    m_ActiveActorIds.clear();
+    m_SuspendedActorCells.clear();
+    m_NumSuspendedActors = 0;
+}
+
+void ActorActivityMgr::Update(const SDL_Rect& cameraRect, ComponentUpdateScheduler* pScheduler, IGamePhysics* pPhysics)
+{
+    if (m_Margin < 0)
+    {
+        return;
+    }
+
+    SDL_Rect activeRegion = { cameraRect.x - m_Margin, cameraRect.y - m_Margin,
+        cameraRect.w + 2 * m_Margin, cameraRect.h + 2 * m_Margin };
+
+    // Active actors which left the region
+    size_t numActiveActors = 0;
+    for (uint32 actorId : m_ActiveActorIds)
+    {
+        auto findIter = m_TrackedActors.find(actorId);
+        if (findIter == m_TrackedActors.end())
+        {
+            continue;
+        }
+
+        Point position = findIter->second.pActor->GetPositionComponent()->GetPosition();
+        if (IsInRegion(position, activeRegion))
+        {
+            m_ActiveActorIds[numActiveActors++] = actorId;
+        }
+        else
+        {
+            SuspendActor(actorId, findIter->second, position, pScheduler, pPhysics);
+        }
+    }
+    m_ActiveActorIds.resize(numActiveActors);
+
+    // Suspended actors which entered the region, only cells overlapping it can have them
+    int32 minCellX = GetCellCoord(activeRegion.x);
+    int32 maxCellX = GetCellCoord(activeRegion.x + activeRegion.w - 1);
+    int32 minCellY = GetCellCoord(activeRegion.y);
+    int32 maxCellY = GetCellCoord(activeRegion.y + activeRegion.h - 1);
+    for (int32 cellY = minCellY; cellY <= maxCellY; cellY++)
+    {
+        for (int32 cellX = minCellX; cellX <= maxCellX; cellX++)
+        {
+            auto cellIter = m_SuspendedActorCells.find(GetCellKey(cellX, cellY));
+            if (cellIter == m_SuspendedActorCells.end())
+            {
+                continue;
+            }
+
+            std::vector<uint32>& cellActorIds = cellIter->second;
+            for (size_t actorIdx = 0; actorIdx < cellActorIds.size();)
+            {
+                uint32 actorId = cellActorIds[actorIdx];
+                TrackedActor& trackedActor = m_TrackedActors[actorId];
+                if (!IsInRegion(trackedActor.pActor->GetPositionComponent()->GetPosition(), activeRegion))
+                {
+                    actorIdx++;
+                    continue;
+                }
+
+                ResumeActor(actorId, trackedActor, pScheduler, pPhysics);
+                m_ActiveActorIds.push_back(actorId);
+
+                cellActorIds[actorIdx] = cellActorIds.back();
+                cellActorIds.pop_back();
+            }
+
+            if (cellActorIds.empty())
+            {
+                m_SuspendedActorCells.erase(cellIter);
+            }
+        }
+    }
+}
+
+void ActorActivityMgr::SuspendActor(uint32 actorId, TrackedActor& trackedActor, const Point& position, ComponentUpdateScheduler* pScheduler, IGamePhysics* pPhysics)
+{
+    pScheduler->RemoveActor(trackedActor.pActor);
+
+    trackedActor.bWasBodyActive = pPhysics && pPhysics->VIsActive(actorId);
+    if (trackedActor.bWasBodyActive)
+    {
+        pPhysics->VDeactivate(actorId);
+    }
+
+    trackedActor.bIsSuspended = true;
+    trackedActor.cellKey = GetCellKey(GetCellCoord(position.x), GetCellCoord(position.y));
+    m_SuspendedActorCells[trackedActor.cellKey].push_back(actorId);
+    m_NumSuspendedActors++;
+}
+
+void ActorActivityMgr::ResumeActor(uint32 actorId, TrackedActor& trackedActor, ComponentUpdateScheduler* pScheduler, IGamePhysics* pPhysics)
+{
+    pScheduler->AddActor(trackedActor.pActor);
+
+    if (trackedActor.bWasBodyActive && pPhysics)
+    {
+        pPhysics->VActivate(actorId);
+    }
+
+    trackedActor.bIsSuspended = false;
+    m_NumSuspendedActors--;
+}
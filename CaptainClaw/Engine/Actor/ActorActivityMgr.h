@@ -0,0 +1,66 @@
+#ifndef ACTORACTIVITYMGR_H_
+#define ACTORACTIVITYMGR_H_
+
+#include <unordered_map>
+#include <vector>
+#include <SDL2/SDL.h>
+
+#include "../SharedDefines.h"
+
+//=================================================================================================
+// class ActorActivityMgr
+//
+//     Suspends actors which are farther than a margin from the camera. Suspended actors are not
+//     updated and their physics bodies are deactivated until the camera comes close again.
+//     Only actors near the camera are checked each frame, suspended actors do not move and are
+//     kept in a grid so that only grid cells around the camera have to be looked at. Per-frame
+//     cost thus depends on screen size rather than on level size.
+//
+
+class ComponentUpdateScheduler;
+class ActorActivityMgr
+{
+public:
+    ActorActivityMgr();
+
+    // Actors without PositionComponent or flagged as always active are ignored
+    void AddActor(StrongActorPtr pActor);
+    // Has to be called before actor is destroyed
+    void RemoveActor(StrongActorPtr pActor);
+    void Clear();
+
+    // Suspends actors which left the active region around camera and resumes actors which entered it
+    void Update(const SDL_Rect& cameraRect, ComponentUpdateScheduler* pScheduler, IGamePhysics* pPhysics);
+
+    // Distance from camera edges within which actors are still active, negative disables suspending
+    void SetMargin(int32 margin) { m_Margin = margin; }
+    int32 GetMargin() const { return m_Margin; }
+
+    uint32 GetNumTrackedActors() const { return m_TrackedActors.size(); }
+    uint32 GetNumSuspendedActors() const { return m_NumSuspendedActors; }
+
+private:
+    struct TrackedActor
+    {
+        TrackedActor() : bIsSuspended(false), bWasBodyActive(false), cellKey(0) { }
+
+        StrongActorPtr pActor;
+        bool bIsSuspended;
+        // Body could have already been deactivated by actor itself, e.g. by toggle peg
+        bool bWasBodyActive;
+        uint64 cellKey;
+    };
+
+    void SuspendActor(uint32 actorId, TrackedActor& trackedActor, const Point& position, ComponentUpdateScheduler* pScheduler, IGamePhysics* pPhysics);
+    void ResumeActor(uint32 actorId, TrackedActor& trackedActor, ComponentUpdateScheduler* pScheduler, IGamePhysics* pPhysics);
+
+    int32 m_Margin;
+    uint32 m_NumSuspendedActors;
+
+    std::unordered_map<uint32, TrackedActor> m_TrackedActors;
+    // Can contain ids of already removed actors, they are dropped during next Update()
+    std::vector<uint32> m_ActiveActorIds;
+    std::unordered_map<uint64, std::vector<uint32>> m_SuspendedActorCells;
+};
+
+#endif
@@ -8,17 +8,39 @@
 #include "../Util/StringUtil.h"
 
 #include "ActorTemplates.h"
+#include "ActorPool.h"
 
 #include "../SharedDefines.h"
 #include "ActorFactory.h"
 
+// Upper bound of registered component types, actors keep one slot for each of them
+const uint32 MAX_COMPONENT_TYPES = 64;
+
+// Dense index of component type assigned by ActorFactory when type is registered. Index 0 is
+// never assigned so types which are not registered always look into an empty slot.
+template <class ComponentType>
+struct ComponentTypeIndex
+{
+    static uint32 value;
+};
+
+template <class ComponentType>
+uint32 ComponentTypeIndex<ComponentType>::value = 0;
+
 class ActorComponent
 {
     friend class ActorFactory;
+    friend class ComponentUpdateScheduler;
 
 public:
+    ActorComponent() : m_TypeIndex(0), m_bNeedsUpdate(false), m_UpdateSlot(-1) { }
     virtual ~ActorComponent() { _owner.reset(); }
 
+    // Components of every actor are pooled, destroyed actor's components are reused by the next actor spawned.
+    // ActorFactory::RegisterComponent() checks that component types fit ActorPool::ALIGNMENT.
+    static void* operator new(size_t size) { return ActorPool::Allocate(size); }
+    static void operator delete(void* pComponent, size_t size) { ActorPool::Free(pComponent, size); }
+
     // These functions are meant to be overriden by the implementation classes of the components
     virtual bool VInit(TiXmlElement* data) = 0;
     virtual void VPostInit() { }
@@ -26,6 +48,10 @@ public:
     virtual void VUpdate(uint32 msDiff) { }
     virtual void VOnChanged() { }
 
+    // Copy of this component as it is right after VInit(), lets ActorPrefab create components without parsing XML.
+    // Components which can not be copied return NULL and are initialized from their XML for every instance.
+    virtual ActorComponent* VClone() const { return NULL; }
+
     // For potential editor
     virtual TiXmlElement* VGenerateXml() = 0;
 
@@ -38,11 +64,22 @@ public:
         return HashName(componentName);
     }
 
+    // Slot of this component within its actor, see ComponentTypeIndex
+    uint32 GetTypeIndex() const { return m_TypeIndex; }
+
+    // True if this component's type overrides VUpdate(), other components are never updated
+    bool NeedsUpdate() const { return m_bNeedsUpdate; }
+
 protected:
     StrongActorPtr _owner;
 
 private:
     void SetOwner(StrongActorPtr owner) { _owner = owner; }
+
+    uint32 m_TypeIndex;
+    bool m_bNeedsUpdate;
+    // Index within ComponentUpdateScheduler's array of this component's type, -1 if not scheduled
+    int32 m_UpdateSlot;
 };
 
 #endif
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include <tinyxml.h>
+#include <type_traits>
 
 #include "ActorFactory.h"
 #include "Actor.h"
+#include "ActorPool.h"
 #include "../Logger/Logger.h"
 #include "../SharedDefines.h"
 #include "../Util/Util.h"
@@ -44,61 +46,109 @@
 #include "Components/AuraComponents/AuraComponent.h"
 #include "Components/SingleAnimationComponent.h"
 
+// Component types which do not override VUpdate() do not have to be scheduled for updates at all
+template <class ComponentType>
+struct HasComponentUpdate
+{
+    static const bool value = !std::is_same<decltype(&ComponentType::VUpdate), void (ActorComponent::*)(uint32)>::value;
+};
+
+template <class ComponentType>
+void ActorFactory::RegisterComponent()
+{
+    static_assert(alignof(ComponentType) <= ActorPool::ALIGNMENT, "Component type is over-aligned for ActorPool");
+
+    uint32 componentId = ActorComponent::GetIdFromName(ComponentType::g_Name);
+    _componentFactory.Register<ComponentType>(componentId);
+    _componentTypeIndices[componentId] = &ComponentTypeIndex<ComponentType>::value;
+
+    if (HasComponentUpdate<ComponentType>::value)
+    {
+        _updatedComponentIds.insert(componentId);
+    }
+}
+
 ActorFactory::ActorFactory()
 {
     _lastActorGUID = 0;
 
-    _componentFactory.Register<PositionComponent>(ActorComponent::GetIdFromName(PositionComponent::g_Name));
-    _componentFactory.Register<CollisionComponent>(ActorComponent::GetIdFromName(CollisionComponent::g_Name));
-    _componentFactory.Register<PhysicsComponent>(ActorComponent::GetIdFromName(PhysicsComponent::g_Name));
-    //_componentFactory.Register<ControllableComponent>(ActorComponent::GetIdFromName(ControllableComponent::g_Name));
-    _componentFactory.Register<AnimationComponent>(ActorComponent::GetIdFromName(AnimationComponent::g_Name));
-    _componentFactory.Register<SoundComponent>(SoundComponent::GetIdFromName(SoundComponent::g_Name));
-    _componentFactory.Register<ActorRenderComponent>(ActorRenderComponent::GetIdFromName(ActorRenderComponent::g_Name));
-    _componentFactory.Register<TilePlaneRenderComponent>(TilePlaneRenderComponent::GetIdFromName(TilePlaneRenderComponent::g_Name));
-    _componentFactory.Register<HUDRenderComponent>(HUDRenderComponent::GetIdFromName(HUDRenderComponent::g_Name));
-    _componentFactory.Register<ClawControllableComponent>(ClawControllableComponent::GetIdFromName(ClawControllableComponent::g_Name));
-    _componentFactory.Register<KinematicComponent>(KinematicComponent::GetIdFromName(KinematicComponent::g_Name));
-    _componentFactory.Register<TogglePegAIComponent>(TogglePegAIComponent::GetIdFromName(TogglePegAIComponent::g_Name));
-    _componentFactory.Register<CrumblingPegAIComponent>(CrumblingPegAIComponent::GetIdFromName(CrumblingPegAIComponent::g_Name));
-    _componentFactory.Register<TriggerComponent>(TriggerComponent::GetIdFromName(TriggerComponent::g_Name));
-    _componentFactory.Register<TreasurePickupComponent>(TreasurePickupComponent::GetIdFromName(TreasurePickupComponent::g_Name));
-    _componentFactory.Register<LifePickupComponent>(LifePickupComponent::GetIdFromName(LifePickupComponent::g_Name));
-    _componentFactory.Register<HealthPickupComponent>(HealthPickupComponent::GetIdFromName(HealthPickupComponent::g_Name));
-    _componentFactory.Register<ScoreComponent>(ScoreComponent::GetIdFromName(ScoreComponent::g_Name));
-    _componentFactory.Register<LifeComponent>(LifeComponent::GetIdFromName(LifeComponent::g_Name));
-    _componentFactory.Register<HealthComponent>(HealthComponent::GetIdFromName(HealthComponent::g_Name));
-    _componentFactory.Register<TeleportPickupComponent>(TeleportPickupComponent::GetIdFromName(TeleportPickupComponent::g_Name));
-    _componentFactory.Register<AmmoComponent>(AmmoComponent::GetIdFromName(AmmoComponent::g_Name));
-    _componentFactory.Register<PowerupComponent>(PowerupComponent::GetIdFromName(PowerupComponent::g_Name));
-    _componentFactory.Register<PowerupPickupComponent>(PowerupPickupComponent::GetIdFromName(PowerupPickupComponent::g_Name));
-    _componentFactory.Register<AmmoPickupComponent>(AmmoPickupComponent::GetIdFromName(AmmoPickupComponent::g_Name));
-    _componentFactory.Register<PowerupSparkleAIComponent>(PowerupSparkleAIComponent::GetIdFromName(PowerupSparkleAIComponent::g_Name));
-    _componentFactory.Register<ProjectileAIComponent>(ProjectileAIComponent::GetIdFromName(ProjectileAIComponent::g_Name));
-    _componentFactory.Register<LootComponent>(LootComponent::GetIdFromName(LootComponent::g_Name));
-    _componentFactory.Register<DestroyableComponent>(DestroyableComponent::GetIdFromName(DestroyableComponent::g_Name));
-    _componentFactory.Register<ExplodeableComponent>(ExplodeableComponent::GetIdFromName(ExplodeableComponent::g_Name));
-    _componentFactory.Register<AreaDamageComponent>(AreaDamageComponent::GetIdFromName(AreaDamageComponent::g_Name));
-    _componentFactory.Register<GlitterComponent>(GlitterComponent::GetIdFromName(GlitterComponent::g_Name));
-    _componentFactory.Register<CheckpointComponent>(CheckpointComponent::GetIdFromName(CheckpointComponent::g_Name));
-    _componentFactory.Register<EnemyAIComponent>(EnemyAIComponent::GetIdFromName(EnemyAIComponent::g_Name));
-    _componentFactory.Register<PatrolEnemyAIStateComponent>(PatrolEnemyAIStateComponent::GetIdFromName(PatrolEnemyAIStateComponent::g_Name));
-    _componentFactory.Register<MeleeAttackAIStateComponent>(MeleeAttackAIStateComponent::GetIdFromName(MeleeAttackAIStateComponent::g_Name));
-    _componentFactory.Register<RangedAttackAIStateComponent>(RangedAttackAIStateComponent::GetIdFromName(RangedAttackAIStateComponent::g_Name));
-    _componentFactory.Register<PredefinedMoveComponent>(PredefinedMoveComponent::GetIdFromName(PredefinedMoveComponent::g_Name));
-    _componentFactory.Register<SoundTriggerComponent>(SoundTriggerComponent::GetIdFromName(SoundTriggerComponent::g_Name));
-    _componentFactory.Register<GlobalAmbientSoundComponent>(GlobalAmbientSoundComponent::GetIdFromName(GlobalAmbientSoundComponent::g_Name));
-    _componentFactory.Register<FollowableComponent>(FollowableComponent::GetIdFromName(FollowableComponent::g_Name));
-    _componentFactory.Register<DamageAuraComponent>(DamageAuraComponent::GetIdFromName(DamageAuraComponent::g_Name));
-    _componentFactory.Register<SingleAnimationComponent>(SingleAnimationComponent::GetIdFromName(SingleAnimationComponent::g_Name));
-    _componentFactory.Register<TakeDamageAIStateComponent>(TakeDamageAIStateComponent::GetIdFromName(TakeDamageAIStateComponent::g_Name));
+    RegisterComponent<PositionComponent>();
+    RegisterComponent<CollisionComponent>();
+    RegisterComponent<PhysicsComponent>();
+    //RegisterComponent<ControllableComponent>();
+    RegisterComponent<AnimationComponent>();
+    RegisterComponent<SoundComponent>();
+    RegisterComponent<ActorRenderComponent>();
+    RegisterComponent<TilePlaneRenderComponent>();
+    RegisterComponent<HUDRenderComponent>();
+    RegisterComponent<ClawControllableComponent>();
+    RegisterComponent<KinematicComponent>();
+    RegisterComponent<TogglePegAIComponent>();
+    RegisterComponent<CrumblingPegAIComponent>();
+    RegisterComponent<TriggerComponent>();
+    RegisterComponent<TreasurePickupComponent>();
+    RegisterComponent<LifePickupComponent>();
+    RegisterComponent<HealthPickupComponent>();
+    RegisterComponent<ScoreComponent>();
+    RegisterComponent<LifeComponent>();
+    RegisterComponent<HealthComponent>();
+    RegisterComponent<TeleportPickupComponent>();
+    RegisterComponent<AmmoComponent>();
+    RegisterComponent<PowerupComponent>();
+    RegisterComponent<PowerupPickupComponent>();
+    RegisterComponent<AmmoPickupComponent>();
+    RegisterComponent<PowerupSparkleAIComponent>();
+    RegisterComponent<ProjectileAIComponent>();
+    RegisterComponent<LootComponent>();
+    RegisterComponent<DestroyableComponent>();
+    RegisterComponent<ExplodeableComponent>();
+    RegisterComponent<AreaDamageComponent>();
+    RegisterComponent<GlitterComponent>();
+    RegisterComponent<CheckpointComponent>();
+    RegisterComponent<EnemyAIComponent>();
+    RegisterComponent<PatrolEnemyAIStateComponent>();
+    RegisterComponent<MeleeAttackAIStateComponent>();
+    RegisterComponent<RangedAttackAIStateComponent>();
+    RegisterComponent<PredefinedMoveComponent>();
+    RegisterComponent<SoundTriggerComponent>();
+    RegisterComponent<GlobalAmbientSoundComponent>();
+    RegisterComponent<FollowableComponent>();
+    RegisterComponent<DamageAuraComponent>();
+    RegisterComponent<SingleAnimationComponent>();
+    RegisterComponent<TakeDamageAIStateComponent>();
+
+    AssignComponentTypeIndices();
+}
+
+void ActorFactory::AssignComponentTypeIndices()
+{
+    // Indices follow component ids so that components of an actor are iterated in the same order
+    // as when they were kept in a map by their ids
+    uint32 typeIndex = 1;
+    for (auto& typeIndexPair : _componentTypeIndices)
+    {
+        *typeIndexPair.second = typeIndex++;
+    }
+
+    assert(typeIndex <= MAX_COMPONENT_TYPES && "Too many component types, raise MAX_COMPONENT_TYPES");
+}
+
+uint32 ActorFactory::GetComponentTypeIndex(uint32 componentId) const
+{
+    auto findIter = _componentTypeIndices.find(componentId);
+    if (findIter != _componentTypeIndices.end())
+    {
+        return *findIter->second;
+    }
+
+    return 0;
 }
 
 StrongActorPtr ActorFactory::CreateActor(TiXmlElement* pActorRoot, TiXmlElement* overrides)
 {
     //PROFILE_CPU("Create actor");
     uint32 nextActorGUID = GetNextActorGUID();
-    StrongActorPtr actor(new Actor(nextActorGUID));
+    StrongActorPtr actor = MakePooled<Actor>(nextActorGUID);
     if (!actor->Init(pActorRoot))
     {
         LOG_ERROR("Failed to initialize actor.");
@@ -149,12 +199,58 @@ StrongActorPtr ActorFactory::CreateActor(const char* actorResource, TiXmlElement
     return CreateActor(root, overrides);
 }
 
+StrongActorPtr ActorFactory::CreateActor(const ActorPrefab* pPrefab, const ActorPrefabOverrides& overrides)
+{
+    assert(pPrefab);
+
+    uint32 nextActorGUID = GetNextActorGUID();
+    StrongActorPtr actor = MakePooled<Actor>(nextActorGUID);
+    if (!actor->Init(pPrefab->m_pActorRoot))
+    {
+        LOG_ERROR("Failed to initialize actor.");
+        return NULL;
+    }
+
+    for (const ActorPrefab::ComponentPrototype& prototype : pPrefab->m_Components)
+    {
+        StrongActorComponentPtr component;
+        if (prototype.pComponent)
+        {
+            component = WrapPooled(prototype.pComponent->VClone());
+        }
+        else
+        {
+            component = VCreateComponent(prototype.pXmlData);
+        }
+
+        if (!component)
+        {
+            LOG_ERROR("Failed to create component of prefab: " + actor->GetName());
+            actor->Destroy();
+            return nullptr;
+        }
+
+        actor->AddComponent(component);
+        component->SetOwner(actor);
+    }
+
+    if (overrides)
+    {
+        overrides(actor.get());
+    }
+
+    actor->PostInit();
+    actor->PostPostInit();
+
+    return actor;
+}
+
 void ActorFactory::ModifyActor(StrongActorPtr actor, TiXmlElement* overrides)
 {
     for (TiXmlElement* node = overrides->FirstChildElement(); node != NULL; node = node->NextSiblingElement())
     {
         uint32 componentId = ActorComponent::GetIdFromName(node->Value());
-        StrongActorComponentPtr component = MakeStrongPtr(actor->GetComponent<ActorComponent>(componentId));
+        StrongActorComponentPtr component = actor->GetComponentByTypeIndex(GetComponentTypeIndex(componentId));
         {
             if (component)
             {
@@ -174,10 +270,62 @@ void ActorFactory::ModifyActor(StrongActorPtr actor, TiXmlElement* overrides)
     }
 }
 
+ActorPrefab::~ActorPrefab()
+{
+    // Prototypes have to go first, they may still reference their XML
+    m_Components.clear();
+    SAFE_DELETE(m_pActorRoot);
+}
+
+const ActorPrefab* ActorFactory::GetPrefab(const std::string& key) const
+{
+    auto findIter = _prefabs.find(key);
+    if (findIter != _prefabs.end())
+    {
+        return findIter->second.get();
+    }
+
+    return NULL;
+}
+
+const ActorPrefab* ActorFactory::AddPrefab(const std::string& key, TiXmlElement* pActorRoot)
+{
+    assert(pActorRoot);
+    assert(_prefabs.count(key) == 0 && "Prefab with this key already exists");
+
+    unique_ptr<ActorPrefab> pPrefab(new ActorPrefab(pActorRoot));
+    for (TiXmlElement* node = pActorRoot->FirstChildElement(); node != NULL; node = node->NextSiblingElement())
+    {
+        StrongActorComponentPtr component = VCreateComponent(node);
+        if (!component)
+        {
+            LOG_ERROR("Failed to create prefab component from node: " + std::string(node->Value()));
+            return NULL;
+        }
+
+        // Components which can not be copied are initialized from their XML for every instance instead
+        ActorPrefab::ComponentPrototype prototype;
+        prototype.pComponent.reset(component->VClone());
+        prototype.pXmlData = prototype.pComponent ? NULL : node;
+        pPrefab->m_Components.push_back(prototype);
+    }
+
+    const ActorPrefab* pAddedPrefab = pPrefab.get();
+    _prefabs[key] = std::move(pPrefab);
+
+    return pAddedPrefab;
+}
+
+void ActorFactory::ClearPrefabs()
+{
+    _prefabs.clear();
+}
+
 StrongActorComponentPtr ActorFactory::VCreateComponent(TiXmlElement* data)
 {
     const char* name = data->Value();
-    StrongActorComponentPtr component(_componentFactory.Create(ActorComponent::GetIdFromName(name)));
+    uint32 componentId = ActorComponent::GetIdFromName(name);
+    StrongActorComponentPtr component = WrapPooled(_componentFactory.Create(componentId));
 
     // Initialize the component if we found one
     if (component)
@@ -187,6 +335,9 @@ StrongActorComponentPtr ActorFactory::VCreateComponent(TiXmlElement* data)
             LOG_ERROR("Component: " + std::string(name) + " failed to initialize");
             return StrongActorComponentPtr();
         }
+
+        component->m_TypeIndex = GetComponentTypeIndex(componentId);
+        component->m_bNeedsUpdate = (_updatedComponentIds.count(componentId) != 0);
     }
     else
     {
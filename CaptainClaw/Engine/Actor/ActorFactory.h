@@ -2,9 +2,44 @@
 #define ACTORFACTORY_H_
 
 #include <map>
+#include <set>
+#include <vector>
 
 #include "ActorComponent.h"
 
+//-------------------------------------------------------------------------------------------------
+// ActorPrefab
+//
+// Actor XML which was parsed only once. Components which support VClone() were initialized when
+// the prefab was created and each instance gets their copy, other components keep their XML and
+// are initialized from it for every instance.
+//-------------------------------------------------------------------------------------------------
+
+class ActorPrefab
+{
+    friend class ActorFactory;
+
+public:
+    ~ActorPrefab();
+
+private:
+    struct ComponentPrototype
+    {
+        // Exactly one of these is set
+        StrongActorComponentPtr pComponent;
+        TiXmlElement* pXmlData;
+    };
+
+    ActorPrefab(TiXmlElement* pActorRoot) : m_pActorRoot(pActorRoot) { }
+
+    // Owned by prefab, component XML elements point into it
+    TiXmlElement* m_pActorRoot;
+    std::vector<ComponentPrototype> m_Components;
+};
+
+// Sets per instance values, e.g. position, before components of the instance are post-initialized
+typedef std::function<void(Actor* pActor)> ActorPrefabOverrides;
+
 //-------------------------------------------------------------------------------------------------
 // Actor factory
 //-------------------------------------------------------------------------------------------------
@@ -16,14 +51,35 @@ public:
 
     StrongActorPtr CreateActor(TiXmlElement* pActorRoot, TiXmlElement* overrides);
     StrongActorPtr CreateActor(const char* actorResource, TiXmlElement* overrides);
+    StrongActorPtr CreateActor(const ActorPrefab* pPrefab, const ActorPrefabOverrides& overrides);
     void ModifyActor(StrongActorPtr actor, TiXmlElement* overrides);
 
+    // Returns NULL if there is no prefab with given key
+    const ActorPrefab* GetPrefab(const std::string& key) const;
+    // Takes ownership of pActorRoot, returns NULL if any of its components failed to initialize
+    const ActorPrefab* AddPrefab(const std::string& key, TiXmlElement* pActorRoot);
+    // Prefab components are initialized against current level, e.g. they hold its physics
+    void ClearPrefabs();
+
     virtual StrongActorComponentPtr VCreateComponent(TiXmlElement* data);
 
 protected:
     GenericObjectFactory<ActorComponent, uint32_t> _componentFactory;
+    // Types which override ActorComponent::VUpdate()
+    std::set<uint32_t> _updatedComponentIds;
+    // Component id to ComponentTypeIndex<>::value of its type
+    std::map<uint32_t, uint32_t*> _componentTypeIndices;
+    std::map<std::string, unique_ptr<ActorPrefab>> _prefabs;
 
 private:
+    // Registers component type and remembers whether it has to be updated each frame
+    template <class ComponentType>
+    void RegisterComponent();
+    // Assigns type indices to all registered component types
+    void AssignComponentTypeIndices();
+    // Returns 0 if no such component type is registered
+    uint32_t GetComponentTypeIndex(uint32_t componentId) const;
+
     uint32_t _lastActorGUID;
     uint32_t GetNextActorGUID() { ++_lastActorGUID; return _lastActorGUID; }
 };
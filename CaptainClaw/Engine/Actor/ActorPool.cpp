@@ -0,0 +1,197 @@
+#include <cstdlib>
+#include <new>
+
+#include "ActorPool.h"
+#include "../SharedDefines.h"
+#include "../Util/Memory/MemoryPool.h"
+
+// Chunk sizes are multiples of this
+static const size_t ACTOR_POOL_GRANULARITY = 16;
+// Has to fit Actor with its control block, actor alone is over 1 kB because of its component slots. Bigger objects
+// are rare components of long lived level actors, they go straight to the heap.
+static const size_t ACTOR_POOL_MAX_CHUNK_SIZE = 2048;
+// Pool grows by roughly this many bytes at once
+static const size_t ACTOR_POOL_GROW_SIZE = 16 * 1024;
+static const size_t ACTOR_POOL_NUM_SIZE_CLASSES = ACTOR_POOL_MAX_CHUNK_SIZE / ACTOR_POOL_GRANULARITY;
+
+static_assert(MEMORY_POOL_ALIGNMENT >= ActorPool::ALIGNMENT, "MemoryPool chunks are not aligned enough for ActorPool");
+
+// Pools are never destroyed, actors can still be released during static destruction
+static MemoryPool* s_Pools[ACTOR_POOL_NUM_SIZE_CLASSES] = { NULL };
+static ActorPool::Stats s_Stats = { 0, 0, 0, 0, 0, 0, 0, 0 };
+static uint32_t s_NumFrameAllocations = 0;
+static uint32_t s_NumFrameHeapAllocations = 0;
+
+#ifdef ACTOR_POOL_STATS
+// Per thread so that resource loading on worker threads does not show up as main thread allocations
+static thread_local uint32_t t_NumNewCalls = 0;
+static uint32_t s_NumNewCallsAtFrameStart = 0;
+
+void* operator new(size_t size)
+{
+    t_NumNewCalls++;
+
+    void* pBlock = malloc(size > 0 ? size : 1);
+    while (!pBlock)
+    {
+        std::new_handler newHandler = std::get_new_handler();
+        if (!newHandler)
+        {
+            throw std::bad_alloc();
+        }
+        newHandler();
+        pBlock = malloc(size > 0 ? size : 1);
+    }
+
+    return pBlock;
+}
+
+void* operator new[](size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return ::operator new(size);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return NULL;
+    }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* pBlock) noexcept
+{
+    free(pBlock);
+}
+
+void operator delete[](void* pBlock) noexcept
+{
+    free(pBlock);
+}
+
+void operator delete(void* pBlock, const std::nothrow_t&) noexcept
+{
+    free(pBlock);
+}
+
+void operator delete[](void* pBlock, const std::nothrow_t&) noexcept
+{
+    free(pBlock);
+}
+#endif
+
+static size_t GetSizeClass(size_t size)
+{
+    return (size + ACTOR_POOL_GRANULARITY - 1) / ACTOR_POOL_GRANULARITY - 1;
+}
+
+static MemoryPool* GetPool(size_t sizeClass)
+{
+    if (!s_Pools[sizeClass])
+    {
+        unsigned int chunkSize = (unsigned int)((sizeClass + 1) * ACTOR_POOL_GRANULARITY);
+
+        // Init() already allocates the first memory array
+        s_Pools[sizeClass] = new MemoryPool;
+        s_Pools[sizeClass]->SetDebugName("ActorPool");
+        s_Pools[sizeClass]->Init(chunkSize, (unsigned int)max(ACTOR_POOL_GROW_SIZE / chunkSize, (size_t)16));
+        s_NumFrameHeapAllocations++;
+        s_Stats.numHeapAllocations++;
+        s_Stats.numReservedBytes += (uint32_t)s_Pools[sizeClass]->GetReservedBytes();
+    }
+
+    return s_Pools[sizeClass];
+}
+
+void* ActorPool::Allocate(size_t size)
+{
+    assert(size > 0);
+
+    s_NumFrameAllocations++;
+    s_Stats.numAllocations++;
+    s_Stats.numBlocksInUse++;
+
+    if (size > ACTOR_POOL_MAX_CHUNK_SIZE)
+    {
+        s_NumFrameHeapAllocations++;
+        s_Stats.numHeapAllocations++;
+        return ::operator new(size);
+    }
+
+    MemoryPool* pPool = GetPool(GetSizeClass(size));
+    size_t reservedBytes = pPool->GetReservedBytes();
+
+    void* pBlock = pPool->Alloc();
+    if (!pBlock)
+    {
+        throw std::bad_alloc();
+    }
+    assert(((uintptr_t)pBlock % ActorPool::ALIGNMENT) == 0);
+
+    if (pPool->GetReservedBytes() != reservedBytes)
+    {
+        s_NumFrameHeapAllocations++;
+        s_Stats.numHeapAllocations++;
+        s_Stats.numReservedBytes += (uint32_t)(pPool->GetReservedBytes() - reservedBytes);
+    }
+
+    return pBlock;
+}
+
+void ActorPool::Free(void* pBlock, size_t size)
+{
+    if (!pBlock)
+    {
+        return;
+    }
+
+    assert(s_Stats.numBlocksInUse > 0);
+    s_Stats.numBlocksInUse--;
+
+    if (size > ACTOR_POOL_MAX_CHUNK_SIZE)
+    {
+        ::operator delete(pBlock);
+        return;
+    }
+
+    size_t sizeClass = GetSizeClass(size);
+    assert(s_Pools[sizeClass] && "Block was not allocated from ActorPool");
+    s_Pools[sizeClass]->Free(pBlock);
+}
+
+ActorPool::Stats ActorPool::GetStats()
+{
+    return s_Stats;
+}
+
+void ActorPool::EndFrame()
+{
+    s_Stats.numLastFrameAllocations = s_NumFrameAllocations;
+    s_Stats.numLastFrameHeapAllocations = s_NumFrameHeapAllocations;
+    s_NumFrameAllocations = 0;
+    s_NumFrameHeapAllocations = 0;
+
+#ifdef ACTOR_POOL_STATS
+    s_Stats.numLastFrameNewCalls = t_NumNewCalls - s_NumNewCallsAtFrameStart;
+    s_Stats.numNewCalls = t_NumNewCalls;
+    s_NumNewCallsAtFrameStart = t_NumNewCalls;
+#endif
+}
+
+bool ActorPool::CountsNewCalls()
+{
+#ifdef ACTOR_POOL_STATS
+    return true;
+#else
+    return false;
+#endif
+}
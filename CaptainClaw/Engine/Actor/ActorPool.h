@@ -0,0 +1,102 @@
+#ifndef __ACTORPOOL_H__
+#define __ACTORPOOL_H__
+
+#include <cstddef>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+//---------------------------------------------------------------------------------------------------------------------
+// ActorPool
+//
+// Actors, components, their scene nodes and the shared_ptr control blocks and map nodes which reference them are
+// allocated from MemoryPools, one pool per 16 byte size class, so objects of the same type always reuse blocks of
+// each other. When EventData_Destroy_Actor releases an actor its blocks go back to the pools and the next projectile,
+// glitter or score popup takes them over, pools only grow until the highest number of live actors is reached.
+// Main thread only, actors are neither created nor destroyed anywhere else.
+//
+// Built with ACTOR_POOL_STATS, global operator new is replaced to also count every heap allocation of the main thread,
+// including those which do not go through the pool at all.
+//---------------------------------------------------------------------------------------------------------------------
+namespace ActorPool
+{
+    // Every block is aligned to this, also on Win32 where doubles are aligned more than pointers
+    const size_t ALIGNMENT = alignof(std::max_align_t);
+
+    struct Stats
+    {
+        // Frame which ended with last EndFrame()
+        uint32_t numLastFrameAllocations;
+        // Heap allocations of ActorPool itself, its growths plus blocks too big for any pool. Says nothing about
+        // allocations which do not go through ActorPool.
+        uint32_t numLastFrameHeapAllocations;
+        // Every operator new on main thread, 0 unless built with ACTOR_POOL_STATS
+        uint32_t numLastFrameNewCalls;
+
+        // Since start
+        uint32_t numAllocations;
+        uint32_t numHeapAllocations;
+        uint32_t numNewCalls;
+
+        uint32_t numBlocksInUse;
+        uint32_t numReservedBytes;
+    };
+
+    void* Allocate(size_t size);
+    void Free(void* pBlock, size_t size);
+
+    Stats GetStats();
+    void EndFrame();
+
+    // Whether numNewCalls are counted
+    bool CountsNewCalls();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// ActorPoolAllocator - places shared_ptr control blocks and std::map nodes into ActorPool
+//---------------------------------------------------------------------------------------------------------------------
+template <class T>
+class ActorPoolAllocator
+{
+public:
+    typedef T value_type;
+
+    ActorPoolAllocator() { }
+    template <class U> ActorPoolAllocator(const ActorPoolAllocator<U>&) { }
+
+    T* allocate(size_t count)
+    {
+        static_assert(alignof(T) <= ActorPool::ALIGNMENT, "Type is over-aligned for ActorPool");
+        return static_cast<T*>(ActorPool::Allocate(count * sizeof(T)));
+    }
+    void deallocate(T* pBlock, size_t count) { ActorPool::Free(pBlock, count * sizeof(T)); }
+};
+
+template <class T, class U>
+bool operator==(const ActorPoolAllocator<T>&, const ActorPoolAllocator<U>&) { return true; }
+
+template <class T, class U>
+bool operator!=(const ActorPoolAllocator<T>&, const ActorPoolAllocator<U>&) { return false; }
+
+// Creates pooled object together with its reference counts, use instead of shared_ptr<T>(new T(...))
+template <class T, class... Args>
+std::shared_ptr<T> MakePooled(Args&&... args)
+{
+    return std::allocate_shared<T>(ActorPoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+// Takes ownership of object created by factory, only its reference counts are placed into the pool. Object itself
+// is pooled if its class allocates from ActorPool, as actor components do.
+template <class T>
+std::shared_ptr<T> WrapPooled(T* pObject)
+{
+    if (!pObject)
+    {
+        return std::shared_ptr<T>();
+    }
+
+    return std::shared_ptr<T>(pObject, std::default_delete<T>(), ActorPoolAllocator<T>());
+}
+
+#endif
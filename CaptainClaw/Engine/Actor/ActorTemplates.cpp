@@ -4,10 +4,21 @@
 #include "../Events/EventMgr.h"
 #include "../Events/Events.h"
 
+#include "Components/PositionComponent.h"
+#include "Components/PhysicsComponent.h"
+#include "Components/AreaDamageComponent.h"
+#include "Components/AIComponents/ProjectileAIComponent.h"
+
 #include <time.h>
 
 namespace ActorTemplates
 {
+    bool g_UseActorPrefabs = true;
+
+    const char* GetBuildStamp()
+    {
+        return __DATE__ " " __TIME__;
+    }
 
     // The empty image set strings signal that these pickups cant be used like this. Maybe change ?
     std::map<PickupType, std::string> g_PickupTypeToImageSetMap =
@@ -148,12 +159,76 @@ namespace ActorTemplates
         assert(pActor && "Failed to create actor");
 
         // Just to be consistent
-        shared_ptr<EventData_New_Actor> pNewActorEvent(new EventData_New_Actor(pActor->GetGUID()));
+        shared_ptr<EventData_New_Actor> pNewActorEvent(MakeEvent<EventData_New_Actor>(pActor->GetGUID()));
         IEventMgr::Get()->VQueueEvent(pNewActorEvent);
 
         return pActor;
     }
 
+    StrongActorPtr CreateAndReturnActor(const ActorPrefab* pPrefab, const ActorPrefabOverrides& overrides)
+    {
+        assert(pPrefab && "Failed to create prefab for actor");
+
+        StrongActorPtr pActor = g_pApp->GetGameLogic()->CreateActor(pPrefab, overrides);
+        assert(pActor && "Failed to create actor");
+
+        shared_ptr<EventData_New_Actor> pNewActorEvent(MakeEvent<EventData_New_Actor>(pActor->GetGUID()));
+        IEventMgr::Get()->VQueueEvent(pNewActorEvent);
+
+        return pActor;
+    }
+
+    // Xml data are created only for the first actor with given key on each level, every other actor is
+    // created as a copy of it
+    const ActorPrefab* GetPrefab(const std::string& key, const std::function<TiXmlElement*()>& createXmlData)
+    {
+        ActorFactory* pActorFactory = g_pApp->GetGameLogic()->GetActorFactory();
+        if (const ActorPrefab* pPrefab = pActorFactory->GetPrefab(key))
+        {
+            return pPrefab;
+        }
+
+        TiXmlElement* pXmlData = createXmlData();
+        if (!pXmlData)
+        {
+            return NULL;
+        }
+
+        return pActorFactory->AddPrefab(key, pXmlData);
+    }
+
+    //
+    // Per instance overrides, prefabs are created at position [0, 0] facing right
+    //
+
+    void SetInstancePosition(Actor* pActor, const Point& position)
+    {
+        shared_ptr<PositionComponent> pPositionComponent = MakeStrongPtr(pActor->GetComponent<PositionComponent>());
+        assert(pPositionComponent);
+
+        pPositionComponent->SetPosition(position);
+    }
+
+    void SetInstanceInitialSpeed(Actor* pActor, const Point& initialSpeed)
+    {
+        shared_ptr<PhysicsComponent> pPhysicsComponent = MakeStrongPtr(pActor->GetComponent<PhysicsComponent>());
+        assert(pPhysicsComponent);
+
+        pPhysicsComponent->SetInitialSpeed(initialSpeed);
+    }
+
+    void SetInstanceDirection(Actor* pActor, Direction direction)
+    {
+        if (direction == Direction_Left)
+        {
+            shared_ptr<PhysicsComponent> pPhysicsComponent = MakeStrongPtr(pActor->GetComponent<PhysicsComponent>());
+            assert(pPhysicsComponent);
+
+            Point initialSpeed = pPhysicsComponent->GetInitialSpeed();
+            pPhysicsComponent->SetInitialSpeed(Point(-initialSpeed.x, initialSpeed.y));
+        }
+    }
+
     void ImageSetToWildcardImagePath(std::string& imageSet)
     {
         std::replace(imageSet.begin(), imageSet.end(), '_', '/');
@@ -799,6 +874,17 @@ namespace ActorTemplates
     // Specific functions for creating specific actors
     //=====================================================================================================================
 
+    // Spawned pickups jump out in random direction
+    Point GetRandomPickupSpeed()
+    {
+        double speedX = 0.5 + (rand() % 100) / 50.0;
+        double speedY = -(1 + (rand() % 100) / 50.0);
+
+        if (rand() % 2 == 1) { speedX *= -1; }
+
+        return Point(speedX, speedY);
+    }
+
     // TODO: What is this function specifically for ? Only dynamically spawned pickups ?
     TiXmlElement* CreateXmlData_GeneralPickupActor(std::string imageSet, Point position, int32 zCoord, bool isStatic)
     {
@@ -815,10 +901,7 @@ namespace ActorTemplates
         pActorElem->LinkEndChild(CreateTriggerComponent(1, false, isStatic));
 
         srand((long)pActorElem + time(NULL));
-        double speedX = 0.5 + (rand() % 100) / 50.0;
-        double speedY = -(1 + (rand() % 100) / 50.0);
-
-        if (rand() % 2 == 1) { speedX *= -1; }
+        Point speed = GetRandomPickupSpeed();
 
         ActorBodyDef bodyDef;
         if (isStatic)
@@ -834,7 +917,7 @@ namespace ActorTemplates
         bodyDef.position = position;
         bodyDef.gravityScale = 0.8f;
         bodyDef.setInitialSpeed = true;
-        bodyDef.initialSpeed = Point(speedX, speedY);
+        bodyDef.initialSpeed = speed;
         bodyDef.collisionFlag = CollisionFlag_Pickup;
         bodyDef.collisionMask = (CollisionFlag_Death | CollisionFlag_Ground | CollisionFlag_Solid);
         bodyDef.density = 10.0f;
@@ -1627,11 +1710,7 @@ namespace ActorTemplates
         return pActor;
     }
 
-    //=====================================================================================================================
-    // Public API
-    //=====================================================================================================================
-
-    StrongActorPtr CreateSingleAnimation(Point position, AnimationType animType)
+    TiXmlElement* CreateXmlData_SingleAnimationActor(Point position, AnimationType animType)
     {
         TiXmlElement* pActorElem = new TiXmlElement("Actor");
 
@@ -1657,8 +1736,8 @@ namespace ActorTemplates
 
             default:
                 LOG_ERROR("Unknown AnimationType: " + ToStr((int)animType));
-                return nullptr;
-                break;
+                SAFE_DELETE(pActorElem);
+                return NULL;
         }
 
         pActorElem->SetAttribute("Type", imageSet.c_str());
@@ -1668,25 +1747,11 @@ namespace ActorTemplates
         TiXmlElement* pSingleAnimComponentElem = new TiXmlElement("SingleAnimationComponent");
         pActorElem->LinkEndChild(pSingleAnimComponentElem);
 
-        return CreateAndReturnActor(pActorElem);
+        return pActorElem;
     }
 
-    StrongActorPtr CreateActorPickup(PickupType pickupType, Point position, bool isStatic)
+    TiXmlElement* CreateXmlData_ActorPickup(const std::string& imageSet, const std::string& pickupSound, Point position, bool isStatic)
     {
-        std::string imageSet = g_PickupTypeToImageSetMap[pickupType];
-        if (imageSet.empty())
-        {
-            LOG_ERROR("Could not get valid image set for pickup type: " + ToStr(pickupType));
-            return StrongActorPtr();
-        }
-
-        std::string pickupSound = g_PickupTypeToPickupSoundMap[pickupType];
-        if (pickupSound.empty())
-        {
-            LOG_ERROR("Could not get valid pickup sound for pickup type: " + ToStr(pickupType));
-            return StrongActorPtr();
-        }
-
         TiXmlElement* pActorXmlData = NULL;
         if (imageSet.find("_TREASURE") != std::string::npos)
         {
@@ -1712,7 +1777,77 @@ namespace ActorTemplates
             assert(false);
         }
 
-        return CreateAndReturnActor(pActorXmlData);
+        return pActorXmlData;
+    }
+
+    //=====================================================================================================================
+    // Public API
+    //=====================================================================================================================
+
+    void SetUseActorPrefabs(bool useActorPrefabs)
+    {
+        g_UseActorPrefabs = useActorPrefabs;
+    }
+
+    bool GetUseActorPrefabs()
+    {
+        return g_UseActorPrefabs;
+    }
+
+    StrongActorPtr CreateSingleAnimation(Point position, AnimationType animType)
+    {
+        if (!g_UseActorPrefabs)
+        {
+            TiXmlElement* pActorElem = CreateXmlData_SingleAnimationActor(position, animType);
+            return pActorElem ? CreateAndReturnActor(pActorElem) : nullptr;
+        }
+
+        const ActorPrefab* pPrefab = GetPrefab("SingleAnimation_" + ToStr((int)animType), [animType]()
+        {
+            return CreateXmlData_SingleAnimationActor(Point(0, 0), animType);
+        });
+        if (!pPrefab)
+        {
+            return nullptr;
+        }
+
+        return CreateAndReturnActor(pPrefab, [&position](Actor* pActor)
+        {
+            SetInstancePosition(pActor, position);
+        });
+    }
+
+    StrongActorPtr CreateActorPickup(PickupType pickupType, Point position, bool isStatic)
+    {
+        const std::string& imageSet = g_PickupTypeToImageSetMap[pickupType];
+        if (imageSet.empty())
+        {
+            LOG_ERROR("Could not get valid image set for pickup type: " + ToStr(pickupType));
+            return StrongActorPtr();
+        }
+
+        const std::string& pickupSound = g_PickupTypeToPickupSoundMap[pickupType];
+        if (pickupSound.empty())
+        {
+            LOG_ERROR("Could not get valid pickup sound for pickup type: " + ToStr(pickupType));
+            return StrongActorPtr();
+        }
+
+        if (!g_UseActorPrefabs)
+        {
+            return CreateAndReturnActor(CreateXmlData_ActorPickup(imageSet, pickupSound, position, isStatic));
+        }
+
+        const ActorPrefab* pPrefab = GetPrefab("Pickup_" + imageSet + (isStatic ? "_Static" : ""), [&]()
+        {
+            return CreateXmlData_ActorPickup(imageSet, pickupSound, Point(0, 0), isStatic);
+        });
+
+        return CreateAndReturnActor(pPrefab, [&position](Actor* pActor)
+        {
+            SetInstancePosition(pActor, position);
+            SetInstanceInitialSpeed(pActor, GetRandomPickupSpeed());
+        });
     }
 
     StrongActorPtr CreateRenderedActor(Point position, std::string imageSet, std::string animPath, int zCoord)
@@ -1732,12 +1867,36 @@ namespace ActorTemplates
 
     StrongActorPtr CreatePowerupSparkleActor()
     {
-        return CreateAndReturnActor(CreateXmlData_PowerupSparkleActor("GAME_SPARKLE"));
+        if (!g_UseActorPrefabs)
+        {
+            return CreateAndReturnActor(CreateXmlData_PowerupSparkleActor("GAME_SPARKLE"));
+        }
+
+        const ActorPrefab* pPrefab = GetPrefab("PowerupSparkle", []()
+        {
+            return CreateXmlData_PowerupSparkleActor("GAME_SPARKLE");
+        });
+
+        return CreateAndReturnActor(pPrefab, ActorPrefabOverrides());
     }
 
     StrongActorPtr CreateClawProjectile(AmmoType ammoType, Direction direction, Point position)
     {
-        return CreateAndReturnActor(CreateXmlData_ClawProjectileActor(ammoType, direction, position));
+        if (!g_UseActorPrefabs)
+        {
+            return CreateAndReturnActor(CreateXmlData_ClawProjectileActor(ammoType, direction, position));
+        }
+
+        const ActorPrefab* pPrefab = GetPrefab("ClawProjectile_" + ToStr((int)ammoType), [ammoType]()
+        {
+            return CreateXmlData_ClawProjectileActor(ammoType, Direction_Right, Point(0, 0));
+        });
+
+        return CreateAndReturnActor(pPrefab, [&](Actor* pActor)
+        {
+            SetInstancePosition(pActor, position);
+            SetInstanceDirection(pActor, direction);
+        });
     }
 
     StrongActorPtr CreateProjectile(
@@ -1749,29 +1908,97 @@ namespace ActorTemplates
         CollisionFlag collisionFlag, 
         uint32 collisionMask)
     {
-        return CreateAndReturnActor(CreateXmlData_ProjectileActor(
-            imageSet, 
-            damage, 
-            damageType, 
-            direction, 
-            position, 
-            collisionFlag, 
-            collisionMask));
+        if (!g_UseActorPrefabs)
+        {
+            return CreateAndReturnActor(CreateXmlData_ProjectileActor(
+                imageSet, 
+                damage, 
+                damageType, 
+                direction, 
+                position, 
+                collisionFlag, 
+                collisionMask));
+        }
+
+        std::string prefabKey = "Projectile_" + imageSet + "_" + ToStr((int)collisionFlag) + "_" + ToStr(collisionMask);
+        const ActorPrefab* pPrefab = GetPrefab(prefabKey, [&]()
+        {
+            return CreateXmlData_ProjectileActor(imageSet, damage, damageType, Direction_Right, Point(0, 0), collisionFlag, collisionMask);
+        });
+
+        return CreateAndReturnActor(pPrefab, [&](Actor* pActor)
+        {
+            SetInstancePosition(pActor, position);
+            SetInstanceDirection(pActor, direction);
+
+            shared_ptr<ProjectileAIComponent> pProjectileAIComponent =
+                MakeStrongPtr(pActor->GetComponent<ProjectileAIComponent>());
+            assert(pProjectileAIComponent);
+            pProjectileAIComponent->SetDamage(damage);
+        });
     }
 
     StrongActorPtr CreateAreaDamage(Point position, Point size, int32 damage, CollisionFlag collisionFlag, std::string shape, DamageType damageType, Direction hitDirection, Point positionOffset, std::string imageSet, int32 zCoord)
     {
-        return CreateAndReturnActor(CreateXmlData_AreaDamageActor(position, size, damage, collisionFlag, shape, damageType, hitDirection, positionOffset, imageSet, zCoord));
+        if (!g_UseActorPrefabs)
+        {
+            return CreateAndReturnActor(CreateXmlData_AreaDamageActor(position, size, damage, collisionFlag, shape, damageType, hitDirection, positionOffset, imageSet, zCoord));
+        }
+
+        std::string prefabKey = "AreaDamage_" + shape + "_" + ToStr((int)size.x) + "x" + ToStr((int)size.y) + "_" +
+            ToStr((int)positionOffset.x) + "x" + ToStr((int)positionOffset.y) + "_" + ToStr((int)collisionFlag) + "_" +
+            ToStr((int)damageType) + "_" + imageSet + "_" + ToStr(zCoord);
+        const ActorPrefab* pPrefab = GetPrefab(prefabKey, [&]()
+        {
+            return CreateXmlData_AreaDamageActor(Point(0, 0), size, damage, collisionFlag, shape, damageType, hitDirection, positionOffset, imageSet, zCoord);
+        });
+
+        return CreateAndReturnActor(pPrefab, [&](Actor* pActor)
+        {
+            SetInstancePosition(pActor, position);
+
+            shared_ptr<AreaDamageComponent> pAreaDamageComponent =
+                MakeStrongPtr(pActor->GetComponent<AreaDamageComponent>());
+            assert(pAreaDamageComponent);
+            pAreaDamageComponent->SetDamage(damage);
+            pAreaDamageComponent->SetHitDirection(hitDirection);
+        });
     }
 
     StrongActorPtr CreateGlitter(std::string glitterType, Point position, int32 zCoord)
     {
-        return CreateAndReturnActor(CreateXmlData_GlitterActor(glitterType, position, zCoord));
+        if (!g_UseActorPrefabs)
+        {
+            return CreateAndReturnActor(CreateXmlData_GlitterActor(glitterType, position, zCoord));
+        }
+
+        const ActorPrefab* pPrefab = GetPrefab("Glitter_" + glitterType + "_" + ToStr(zCoord), [&]()
+        {
+            return CreateXmlData_GlitterActor(glitterType, Point(0, 0), zCoord);
+        });
+
+        return CreateAndReturnActor(pPrefab, [&position](Actor* pActor)
+        {
+            SetInstancePosition(pActor, position);
+        });
     }
 
     StrongActorPtr CreateScorePopupActor(Point position, int score)
     {
-        return CreateAndReturnActor(CreateXmlData_ScorePopupActor(position, score));
+        if (!g_UseActorPrefabs)
+        {
+            return CreateAndReturnActor(CreateXmlData_ScorePopupActor(position, score));
+        }
+
+        const ActorPrefab* pPrefab = GetPrefab("ScorePopup_" + ToStr(score), [score]()
+        {
+            return CreateXmlData_ScorePopupActor(Point(0, 0), score);
+        });
+
+        return CreateAndReturnActor(pPrefab, [&position](Actor* pActor)
+        {
+            SetInstancePosition(pActor, position);
+        });
     }
 
     // From XML to Struct
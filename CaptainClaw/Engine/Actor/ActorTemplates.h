@@ -36,6 +36,9 @@ struct DamageAuraComponentDef
 
 namespace ActorTemplates
 {
+    // Time ActorTemplates.cpp was compiled, part of LevelCache::GetConverterVersion()
+    const char* GetBuildStamp();
+
     // Exposed Component Xml data generating functions
     TiXmlElement* CreateXmlData_GlitterComponent(std::string glitterType, bool spawnImmediate, bool followOwner);
     TiXmlElement* CreatePhysicsComponent(const ActorBodyDef* pBodyDef);
@@ -62,7 +65,10 @@ namespace ActorTemplates
 
     TiXmlElement* CreateXmlData_GlobalAmbientSoundActor(const std::string& sound, int soundVolume, int minTimeOff, int maxTimeOff, int minTimeOn, int maxTimeOn, bool isLooping);
 
-    // This is used by the game itself
+    // This is used by the game itself. Actors are created as copies of prefabs which are parsed from their
+    // Xml data only once per level, unless prefabs are turned off e.g. to compare them in benchmark.
+    void SetUseActorPrefabs(bool useActorPrefabs);
+    bool GetUseActorPrefabs();
     StrongActorPtr CreateActorPickup(PickupType pickupType, Point position, bool isStatic = false);
     StrongActorPtr CreatePowerupSparkleActor();
     StrongActorPtr CreateClawProjectile(AmmoType ammoType, Direction direction, Point position);
@@ -0,0 +1,128 @@
+#include "ComponentUpdateScheduler.h"
+#include "Actor.h"
+#include "ActorComponent.h"
+
+ComponentUpdateScheduler::ComponentUpdateScheduler()
+    :
+    m_NumScheduledComponents(0),
+    m_bIsUpdating(false)
+{
+
+}
+
+void ComponentUpdateScheduler::AddActor(StrongActorPtr pActor)
+{
+    for (const StrongActorComponentPtr& pStrongComponent : *pActor->GetComponents())
+    {
+        ActorComponent* pComponent = pStrongComponent.get();
+        if (!pComponent || !pComponent->NeedsUpdate() || pComponent->m_UpdateSlot >= 0)
+        {
+            continue;
+        }
+
+        ComponentArray& componentArray = m_ComponentArrays[pComponent->GetTypeIndex()];
+        pComponent->m_UpdateSlot = componentArray.components.size();
+        componentArray.components.push_back(pComponent);
+        m_NumScheduledComponents++;
+    }
+}
+
+void ComponentUpdateScheduler::RemoveActor(StrongActorPtr pActor)
+{
+    for (const StrongActorComponentPtr& pStrongComponent : *pActor->GetComponents())
+    {
+        ActorComponent* pComponent = pStrongComponent.get();
+        if (!pComponent || pComponent->m_UpdateSlot < 0)
+        {
+            continue;
+        }
+
+        ComponentArray& componentArray = m_ComponentArrays[pComponent->GetTypeIndex()];
+        assert(componentArray.components[pComponent->m_UpdateSlot] == pComponent);
+
+        componentArray.components[pComponent->m_UpdateSlot] = NULL;
+        componentArray.numRemoved++;
+        pComponent->m_UpdateSlot = -1;
+        m_NumScheduledComponents--;
+
+        // Component which destroyed its own actor may still be running
+        if (m_bIsUpdating)
+        {
+            m_RemovedDuringUpdate.push_back(pStrongComponent);
+        }
+    }
+}
+
+void ComponentUpdateScheduler::Clear()
+{
+    for (auto& arrayPair : m_ComponentArrays)
+    {
+        for (ActorComponent* pComponent : arrayPair.second.components)
+        {
+            if (pComponent)
+            {
+                pComponent->m_UpdateSlot = -1;
+            }
+        }
+    }
+
+    m_ComponentArrays.clear();
+    m_NumScheduledComponents = 0;
+}
+
+void ComponentUpdateScheduler::Update(uint32 msDiff)
+{
+    assert(!m_bIsUpdating && "Update() is not reentrant");
+    m_bIsUpdating = true;
+
+    for (auto& arrayPair : m_ComponentArrays)
+    {
+        std::vector<ActorComponent*>& components = arrayPair.second.components;
+
+        // Array can grow while it is updated, new components wait for the next update
+        const size_t numComponents = components.size();
+        for (size_t componentIdx = 0; componentIdx < numComponents; componentIdx++)
+        {
+            ActorComponent* pComponent = components[componentIdx];
+            if (pComponent)
+            {
+                pComponent->VUpdate(msDiff);
+            }
+        }
+    }
+
+    m_bIsUpdating = false;
+
+    // Destructors of released components can destroy other actors so it cannot be
+    // done while removed components are still being collected
+    std::vector<StrongActorComponentPtr> removedComponents;
+    removedComponents.swap(m_RemovedDuringUpdate);
+    removedComponents.clear();
+
+    for (auto& arrayPair : m_ComponentArrays)
+    {
+        if (arrayPair.second.numRemoved > 0)
+        {
+            Compact(arrayPair.second);
+        }
+    }
+}
+
+void ComponentUpdateScheduler::Compact(ComponentArray& componentArray)
+{
+    std::vector<ActorComponent*>& components = componentArray.components;
+
+    // Stable so that components of one type keep being updated in the order they were created
+    size_t numKept = 0;
+    for (ActorComponent* pComponent : components)
+    {
+        if (pComponent)
+        {
+            pComponent->m_UpdateSlot = numKept;
+            components[numKept++] = pComponent;
+        }
+    }
+
+    components.resize(numKept);
+    componentArray.numRemoved = 0;
+}
@@ -0,0 +1,57 @@
+#ifndef COMPONENTUPDATESCHEDULER_H_
+#define COMPONENTUPDATESCHEDULER_H_
+
+#include <map>
+#include <vector>
+
+#include "../SharedDefines.h"
+
+//=================================================================================================
+// class ComponentUpdateScheduler
+//
+//     Keeps one contiguous array per component type holding only components which override
+//     VUpdate(). Each tick walks these arrays type by type, so same code runs for all components
+//     of one type in a row and components with nothing to update are not visited at all.
+//     Arrays are ordered by component type index which is the same order in which Actor::Update()
+//     updates components of a single actor.
+//
+
+class ActorComponent;
+class ComponentUpdateScheduler
+{
+public:
+    ComponentUpdateScheduler();
+
+    // Schedules actor's components which are not scheduled yet, safe to call again after
+    // components were added to the actor
+    void AddActor(StrongActorPtr pActor);
+    // Has to be called before actor is destroyed
+    void RemoveActor(StrongActorPtr pActor);
+    void Clear();
+
+    // Components scheduled during this call are updated from the next one
+    void Update(uint32 msDiff);
+
+    uint32 GetNumScheduledComponents() const { return m_NumScheduledComponents; }
+
+private:
+    struct ComponentArray
+    {
+        ComponentArray() : numRemoved(0) { }
+
+        // Removed components are left as NULL until the array is compacted
+        std::vector<ActorComponent*> components;
+        uint32 numRemoved;
+    };
+
+    void Compact(ComponentArray& componentArray);
+
+    std::map<uint32, ComponentArray> m_ComponentArrays;
+    uint32 m_NumScheduledComponents;
+
+    bool m_bIsUpdating;
+    // Components of actors destroyed during Update(), kept alive until it returns
+    std::vector<StrongActorComponentPtr> m_RemovedDuringUpdate;
+};
+
+#endif
@@ -50,7 +50,7 @@ bool CrumblingPegAIComponent::VInit(TiXmlElement* data)
 void CrumblingPegAIComponent::VPostInit()
 {
     shared_ptr<AnimationComponent> pAnimationComponent =
-        MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
     assert(pAnimationComponent && pAnimationComponent->GetCurrentAnimation());
     pAnimationComponent->AddObserver(this);
 }
@@ -72,7 +72,7 @@ void CrumblingPegAIComponent::VOnAnimationFrameChanged(Animation* pAnimation, An
     if (pAnimation->IsAtLastAnimFrame())
     {
         pAnimation->Pause();
-        auto pARC = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+        auto pARC = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
         pARC->SetVisible(false);
     }
 }
@@ -85,23 +85,22 @@ void CrumblingPegAIComponent::VOnAnimationLooped(Animation* pAnimation)
 void CrumblingPegAIComponent::OnContact(b2Body* pBody)
 {
     shared_ptr<AnimationComponent> pAnimationComponent =
-        MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
     assert(pAnimationComponent && pAnimationComponent->GetCurrentAnimation());
     pAnimationComponent->ResumeAnimation();
 
-    IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-        new EventData_Request_Play_Sound(SOUND_LEVEL1_PEG_CRUMBLE, 100, false)));
+    IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_LEVEL1_PEG_CRUMBLE, 100, false));
 }
 
 // After claw dies, "recreate" crumbling pegs
 void CrumblingPegAIComponent::ClawDiedDelegate(IEventDataPtr pEventData)
 {
     shared_ptr<AnimationComponent> pAnimationComponent =
-        MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
     pAnimationComponent->GetCurrentAnimation()->Reset();
     pAnimationComponent->GetCurrentAnimation()->Pause();
 
-    auto pARC = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+    auto pARC = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
     pARC->SetVisible(true);
     pARC->SetImage(pAnimationComponent->GetCurrentAnimation()->GetCurrentAnimationFrame()->imageName);
 
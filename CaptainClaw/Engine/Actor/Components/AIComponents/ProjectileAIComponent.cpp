@@ -78,7 +78,7 @@ void ProjectileAIComponent::OnCollidedWithSolidTile()
     {
         m_pPhysics->VRemoveActor(_owner->GetGUID());
 
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
         IEventMgr::Get()->VQueueEvent(pEvent);
 
         m_IsActive = false;
@@ -86,8 +86,7 @@ void ProjectileAIComponent::OnCollidedWithSolidTile()
         if (m_Type == "Dynamite")
         {
             ActorTemplates::CreateSingleAnimation(_owner->GetPositionComponent()->GetPosition(), AnimationType_Explosion);
-            IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-                new EventData_Request_Play_Sound(SOUND_LEVEL1_KEG_EXPLODE, 100, false)));
+            IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_LEVEL1_KEG_EXPLODE, 100, false));
             ActorTemplates::CreateAreaDamage(
                 _owner->GetPositionComponent()->GetPosition(),
                 Point(150, 150),
@@ -103,7 +102,7 @@ void ProjectileAIComponent::OnCollidedWithSolidTile()
 void ProjectileAIComponent::OnCollidedWithActor(Actor* pActorWhoWasShot)
 {
     shared_ptr<HealthComponent> pHealthComponent =
-        MakeStrongPtr(pActorWhoWasShot->GetComponent<HealthComponent>(HealthComponent::g_Name));
+        MakeStrongPtr(pActorWhoWasShot->GetComponent<HealthComponent>());
     if (pHealthComponent)
     {
 
@@ -137,8 +136,8 @@ void ProjectileAIComponent::OnCollidedWithActor(Actor* pActorWhoWasShot)
         OnCollidedWithSolidTile();
     }
     else if (m_Type == "Dynamite" &&
-             (MakeStrongPtr(pActorWhoWasShot->GetComponent<EnemyAIComponent>(EnemyAIComponent::g_Name)) != nullptr ||
-              MakeStrongPtr(pActorWhoWasShot->GetComponent<ExplodeableComponent>(ExplodeableComponent::g_Name)) != nullptr))
+             (MakeStrongPtr(pActorWhoWasShot->GetComponent<EnemyAIComponent>()) != nullptr ||
+              MakeStrongPtr(pActorWhoWasShot->GetComponent<ExplodeableComponent>()) != nullptr))
     {
         OnCollidedWithSolidTile();
     }
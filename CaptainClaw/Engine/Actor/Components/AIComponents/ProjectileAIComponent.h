@@ -13,11 +13,14 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const override { return g_Name; }
+    virtual ActorComponent* VClone() const override { return new ProjectileAIComponent(*this); }
     virtual void VPostInit() override;
 
     virtual bool VInit(TiXmlElement* data) override;
     virtual TiXmlElement* VGenerateXml() override;
 
+    void SetDamage(int32 damage) { m_Damage = damage; }
+
     void OnCollidedWithSolidTile();
     void OnCollidedWithActor(Actor* pActorWhoWasShot);
 
@@ -72,7 +72,7 @@ void TogglePegAIComponent::VPostInit()
     if (fabs(m_Size.x) < DBL_EPSILON || fabs(m_Size.y) < DBL_EPSILON)
     {
         shared_ptr<ActorRenderComponent> pRenderComponent =
-            MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
         assert(pRenderComponent);
 
         shared_ptr<Image> pImage = MakeStrongPtr(pRenderComponent->GetCurrentImage());
@@ -82,7 +82,7 @@ void TogglePegAIComponent::VPostInit()
     }
 
     shared_ptr<AnimationComponent> pAnimationComponent =
-        MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
     assert(pAnimationComponent);
 
     if (m_IsAlwaysActive)
@@ -100,7 +100,7 @@ void TogglePegAIComponent::VPostInit()
     if (fabs(m_Size.x) < DBL_EPSILON || fabs(m_Size.y) < DBL_EPSILON)
     {
         shared_ptr<ActorRenderComponent> pRenderComponent =
-            MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
         assert(pRenderComponent);
 
         shared_ptr<Image> pImage = MakeStrongPtr(pRenderComponent->GetCurrentImage());
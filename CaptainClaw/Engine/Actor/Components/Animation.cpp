@@ -6,17 +6,25 @@
 #include "../../Events/Events.h"
 
 static void PlayFrameSound(const std::string& sound)
+{
+    std::string soundPath = Animation::GetFrameEventSoundPath(sound);
+    if (!soundPath.empty())
+    {
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(soundPath, 100, false));
+    }
+}
+
+std::string Animation::GetFrameEventSoundPath(const std::string& eventName)
 {
     // Only Claw sounds are supported at the moment (there are some misc others)
-    std::string soundName = sound;
+    std::string soundName = eventName;
     if (soundName.find("CLAW_") != std::string::npos)
     {
         soundName.erase(0, std::string("CLAW_").length());
-        std::string soundPath = "/CLAW/SOUNDS/" + soundName + ".WAV";
-
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-            new EventData_Request_Play_Sound(soundPath, 100, false)));
+        return "/CLAW/SOUNDS/" + soundName + ".WAV";
     }
+
+    return "";
 }
 
 Animation::Animation() :
@@ -29,6 +29,9 @@ public:
     static Animation* CreateAnimation(std::vector<AnimationFrame> animFrames, const char* animName, AnimationComponent* owner);
     static Animation* CreateAnimation(int numAnimFrames, int animFrameTime, const char* animName, AnimationComponent* owner);
 
+    // Sound played by animation frame event or empty string if the event plays no supported sound
+    static std::string GetFrameEventSoundPath(const std::string& eventName);
+
     inline std::string GetName() const { return _name; }
 
     AnimationFrame* GetCurrentAnimationFrame() { return &_currentAnimationFrame; }
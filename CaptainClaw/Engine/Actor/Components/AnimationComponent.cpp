@@ -85,6 +85,18 @@ bool AnimationComponent::VInit(TiXmlElement* data)
     return true;
 }
 
+ActorComponent* AnimationComponent::VClone() const
+{
+    // Loaded animations point back to this component, only cycle animations which are created in VPostInit()
+    // can be copied
+    if (!_animationMap.empty())
+    {
+        return NULL;
+    }
+
+    return new AnimationComponent(*this);
+}
+
 void AnimationComponent::VPostInit()
 {
     for (std::string animType : m_SpecialAnimationRequestList)
@@ -95,10 +107,10 @@ void AnimationComponent::VPostInit()
             cycleDurationStr.erase(0, 5);
             int cycleDuration = std::stoi(cycleDurationStr);
 
-            shared_ptr<ActorRenderComponent> pRenderComponent = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+            shared_ptr<ActorRenderComponent> pRenderComponent = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
             if (!pRenderComponent)
             {
-                pRenderComponent = MakeStrongPtr(_owner->GetComponent<HUDRenderComponent>(HUDRenderComponent::g_Name));
+                pRenderComponent = MakeStrongPtr(_owner->GetComponent<HUDRenderComponent>());
             }
             if (!pRenderComponent)
             {
@@ -122,7 +134,7 @@ void AnimationComponent::VPostInit()
 
             // Set delay according to X coord
             shared_ptr<PositionComponent> pPositionComponent =
-                MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+                MakeStrongPtr(_owner->GetComponent<PositionComponent>());
             if (!pPositionComponent)
             {
                 LOG_ERROR("Actor is missing position component. Actor: " + _owner->GetName());
@@ -254,12 +266,12 @@ void AnimationComponent::OnAnimationFrameStarted(AnimationFrame* frame)
 
     // Notify render component to change frame image
     shared_ptr<ActorRenderComponent> renderComponent =
-        MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
     if (renderComponent)
     {
         renderComponent->SetImage(frame->imageName);
     }
-    else if ((renderComponent = MakeStrongPtr(_owner->GetComponent<HUDRenderComponent>(HUDRenderComponent::g_Name))))
+    else if ((renderComponent = MakeStrongPtr(_owner->GetComponent<HUDRenderComponent>())))
     {
         renderComponent->SetImage(frame->imageName);
     }
@@ -51,6 +51,7 @@ public:
     virtual const char* VGetName() const override { return g_Name; }
 
     virtual bool VInit(TiXmlElement* data) override;
+    virtual ActorComponent* VClone() const override;
     virtual TiXmlElement* VGenerateXml() override;
 
     virtual void VPostInit() override;
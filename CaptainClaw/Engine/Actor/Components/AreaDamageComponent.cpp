@@ -87,7 +87,7 @@ void AreaDamageComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseElement
 bool AreaDamageComponent::VOnApply(Actor* pActorWhoPickedThis)
 {
     shared_ptr<HealthComponent> pHealthComponent =
-        MakeStrongPtr(pActorWhoPickedThis->GetComponent<HealthComponent>(HealthComponent::g_Name));
+        MakeStrongPtr(pActorWhoPickedThis->GetComponent<HealthComponent>());
     if (pHealthComponent)
     {
         
@@ -128,7 +128,7 @@ void AreaDamageComponent::VUpdate(uint32 msDiff)
 
     if (m_ActiveTime >= m_Duration)
     {
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
         IEventMgr::Get()->VQueueEvent(pEvent);
     }
 }
\ No newline at end of file
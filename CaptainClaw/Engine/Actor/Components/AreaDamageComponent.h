@@ -13,11 +13,15 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const { return g_Name; }
+    virtual ActorComponent* VClone() const { return new AreaDamageComponent(*this); }
 
     virtual void VUpdate(uint32 msDiff);
 
     virtual bool VOnApply(Actor* pActorWhoPickedThis);
 
+    void SetDamage(int32 damage) { m_Damage = damage; }
+    void SetHitDirection(Direction hitDirection) { m_HitDirection = hitDirection; }
+
 protected:
     virtual bool VDelegateInit(TiXmlElement* data);
     virtual void VCreateInheritedXmlElements(TiXmlElement* pBaseElement);
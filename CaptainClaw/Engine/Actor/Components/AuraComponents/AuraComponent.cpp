@@ -183,7 +183,7 @@ void DamageAuraComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseElement
 void DamageAuraComponent::VOnAuraApply(Actor* pActorInAura)
 {
     shared_ptr<HealthComponent> pHealthComponent =
-        MakeStrongPtr(pActorInAura->GetComponent<HealthComponent>(HealthComponent::g_Name));
+        MakeStrongPtr(pActorInAura->GetComponent<HealthComponent>());
     if (pHealthComponent)
     {
         // TODO: In original game this causes the damage impact anim effect
@@ -49,21 +49,21 @@ void CheckpointComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseElement
 bool CheckpointComponent::VOnApply(Actor* pActorWhoPickedThis)
 {
     shared_ptr<AnimationComponent> pAnimationComponent =
-        MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
     assert(pAnimationComponent);
     pAnimationComponent->ResumeAnimation();
     pAnimationComponent->AddObserver(this);
 
     shared_ptr<PhysicsComponent> pPhysicsComponent =
-        MakeStrongPtr(_owner->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PhysicsComponent>());
     assert(pPhysicsComponent);
     pPhysicsComponent->Destroy();
 
-    shared_ptr<EventData_Checkpoint_Reached> pEvent(new EventData_Checkpoint_Reached(pActorWhoPickedThis->GetGUID(), m_SpawnPosition, m_IsSaveCheckpoint, m_SaveCheckpointNumber));
+    shared_ptr<EventData_Checkpoint_Reached> pEvent(MakeEvent<EventData_Checkpoint_Reached>(pActorWhoPickedThis->GetGUID(), m_SpawnPosition, m_IsSaveCheckpoint, m_SaveCheckpointNumber));
     IEventMgr::Get()->VQueueEvent(pEvent);
 
     // I Need to specify this here since I return false
-    IEventMgr::Get()->VTriggerEvent(IEventDataPtr(new EventData_Request_Play_Sound(SOUND_GAME_FLAG_RISE, 100, false)));
+    IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_GAME_FLAG_RISE, 100, false));
 
     return false;
 }
@@ -73,11 +73,11 @@ void CheckpointComponent::VOnAnimationAtLastFrame(Animation* pAnimation)
     if (!(pAnimation->GetName() == "wave"))
     {
         shared_ptr<AnimationComponent> pAnimationComponent =
-            MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
         assert(pAnimationComponent);
 
         assert(pAnimationComponent->SetAnimation("wave"));
 
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(new EventData_Request_Play_Sound(SOUND_GAME_FLAG_WAVE, 100, false)));
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_GAME_FLAG_WAVE, 100, false));
     }
 }
\ No newline at end of file
@@ -39,7 +39,7 @@ bool ControllableComponent::VInit(TiXmlElement* data)
 void ControllableComponent::VPostInit()
 {
     shared_ptr<PhysicsComponent> pPhysicsComponent =
-        MakeStrongPtr(_owner->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PhysicsComponent>());
     if (pPhysicsComponent)
     {
         pPhysicsComponent->SetControllableComponent(this);
@@ -47,7 +47,7 @@ void ControllableComponent::VPostInit()
 
     if (m_Active)
     {
-        shared_ptr<EventData_Attach_Actor> pEvent(new EventData_Attach_Actor(_owner->GetGUID()));
+        shared_ptr<EventData_Attach_Actor> pEvent(MakeEvent<EventData_Attach_Actor>(_owner->GetGUID()));
         IEventMgr::Get()->VTriggerEvent(pEvent);
     }
 }
@@ -89,12 +89,12 @@ void ClawControllableComponent::VPostInit()
 {
     ControllableComponent::VPostInit();
 
-    m_pRenderComponent = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name)).get();
-    m_pClawAnimationComponent = MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name)).get();
-    m_pPositionComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name)).get();
-    m_pAmmoComponent = MakeStrongPtr(_owner->GetComponent<AmmoComponent>(AmmoComponent::g_Name)).get();
-    m_pPowerupComponent = MakeStrongPtr(_owner->GetComponent<PowerupComponent>(PowerupComponent::g_Name)).get();
-    m_pHealthComponent = MakeStrongPtr(_owner->GetComponent<HealthComponent>(HealthComponent::g_Name)).get();
+    m_pRenderComponent = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>()).get();
+    m_pClawAnimationComponent = MakeStrongPtr(_owner->GetComponent<AnimationComponent>()).get();
+    m_pPositionComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>()).get();
+    m_pAmmoComponent = MakeStrongPtr(_owner->GetComponent<AmmoComponent>()).get();
+    m_pPowerupComponent = MakeStrongPtr(_owner->GetComponent<PowerupComponent>()).get();
+    m_pHealthComponent = MakeStrongPtr(_owner->GetComponent<HealthComponent>()).get();
     assert(m_pClawAnimationComponent);
     assert(m_pRenderComponent);
     assert(m_pPositionComponent);
@@ -103,10 +103,10 @@ void ClawControllableComponent::VPostInit()
     assert(m_pHealthComponent);
     m_pClawAnimationComponent->AddObserver(this);
 
-    auto pHealthComponent = MakeStrongPtr(_owner->GetComponent<HealthComponent>(HealthComponent::g_Name));
+    auto pHealthComponent = MakeStrongPtr(_owner->GetComponent<HealthComponent>());
     pHealthComponent->AddObserver(this);
 
-    m_pPhysicsComponent = MakeStrongPtr(_owner->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name)).get();
+    m_pPhysicsComponent = MakeStrongPtr(_owner->GetComponent<PhysicsComponent>()).get();
 
     // Sounds that play when claw takes some damage
     m_TakeDamageSoundList.push_back(SOUND_CLAW_TAKE_DAMAGE1);
@@ -145,11 +145,10 @@ void ClawControllableComponent::VUpdate(uint32 msDiff)
             {
                 idleQuoteSoundIdx = m_pIdleQuotesSequence->GetNext(true);
             }
-            IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-                new EventData_Request_Play_Sound(m_IdleQuoteSoundList[idleQuoteSoundIdx], 100, false)));
+            IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(m_IdleQuoteSoundList[idleQuoteSoundIdx], 100, false));
 
             shared_ptr<FollowableComponent> pExclamationMark =
-                MakeStrongPtr(_owner->GetComponent<FollowableComponent>(FollowableComponent::g_Name));
+                MakeStrongPtr(_owner->GetComponent<FollowableComponent>());
             if (pExclamationMark)
             {
                 pExclamationMark->Activate(2000);
@@ -543,8 +542,7 @@ void ClawControllableComponent::VOnAnimationLooped(Animation* pAnimation)
     std::string animName = pAnimation->GetName();
     if (pAnimation->GetName().find("death") != std::string::npos)
     {
-        shared_ptr<EventData_Claw_Died> pEvent(
-            new EventData_Claw_Died(_owner->GetGUID(), m_pPositionComponent->GetPosition()));
+        shared_ptr<EventData_Claw_Died> pEvent(MakeEvent<EventData_Claw_Died>(_owner->GetGUID(), m_pPositionComponent->GetPosition()));
         IEventMgr::Get()->VTriggerEvent(pEvent);
 
         SetCurrentPhysicsState();
@@ -586,8 +584,7 @@ void ClawControllableComponent::VOnHealthBelowZero(DamageType damageType)
         m_pPhysicsComponent->SetGravityScale(0.0f);
         m_State = ClawState_Dying;
 
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-            new EventData_Request_Play_Sound(SOUND_CLAW_DEATH_SPIKES, 100, false)));
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_CLAW_DEATH_SPIKES, 100, false));
     }
 }
 
@@ -607,8 +604,7 @@ void ClawControllableComponent::VOnHealthChanged(int32 oldHealth, int32 newHealt
 
         // Play random "take damage" sound
         int takeDamageSoundIdx = Util::GetRandomNumber(0, m_TakeDamageSoundList.size() - 1);
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-            new EventData_Request_Play_Sound(m_TakeDamageSoundList[takeDamageSoundIdx], 100, false)));
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(m_TakeDamageSoundList[takeDamageSoundIdx], 100, false));
 
         Point knockback(-10, 0);
         if (m_pRenderComponent->IsMirrored())
@@ -33,7 +33,7 @@ bool HealthComponent::VInit(TiXmlElement* pData)
 
 void HealthComponent::VPostInit()
 {
-    if (MakeStrongPtr(_owner->GetComponent<ClawControllableComponent>(ClawControllableComponent::g_Name)))
+    if (MakeStrongPtr(_owner->GetComponent<ClawControllableComponent>()))
     {
         m_IsController = true;
     }
@@ -56,7 +56,7 @@ void HealthComponent::AddHealth(int32 health, DamageType damageType, Point impac
 
     if (g_pApp->GetGameCheats()->clawInvincible && health < 0)
     {
-        if (MakeStrongPtr(_owner->GetComponent<ClawControllableComponent>(ClawControllableComponent::g_Name)))
+        if (MakeStrongPtr(_owner->GetComponent<ClawControllableComponent>()))
         {
             return;
         }
@@ -101,7 +101,7 @@ void HealthComponent::BroadcastHealthChanged(int32 oldHealth, int32 newHealth, D
     // Only broadcast controllers health. this is abit hacky
     if (m_IsController)
     {
-        shared_ptr<EventData_Updated_Health> pEvent(new EventData_Updated_Health(oldHealth, newHealth, isInitial));
+        shared_ptr<EventData_Updated_Health> pEvent(MakeEvent<EventData_Updated_Health>(oldHealth, newHealth, isInitial));
         IEventMgr::Get()->VQueueEvent(pEvent);
     }
 }
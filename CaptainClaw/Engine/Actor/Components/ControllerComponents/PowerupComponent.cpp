@@ -46,15 +46,15 @@ void PowerupComponent::VPostInit()
         assert(pPowerupSparkle);
 
         shared_ptr<PositionComponent> pPositionComponent =
-            MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<PositionComponent>());
         assert(pPositionComponent);
 
         shared_ptr<PhysicsComponent> pPhysicsComponent =
-            MakeStrongPtr(_owner->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<PhysicsComponent>());
         assert(pPhysicsComponent);
 
         shared_ptr<PowerupSparkleAIComponent> pPowerupSparkleAIComponent =
-            MakeStrongPtr(pPowerupSparkle->GetComponent<PowerupSparkleAIComponent>(PowerupSparkleAIComponent::g_Name));
+            MakeStrongPtr(pPowerupSparkle->GetComponent<PowerupSparkleAIComponent>());
         assert(pPowerupSparkleAIComponent);
 
         pPowerupSparkleAIComponent->SetTargetPositionComponent(pPositionComponent.get());
@@ -116,7 +116,7 @@ void PowerupComponent::SetPowerupSparklesVisibility(bool visible)
     for (auto pSparkle : m_PowerupSparkles)
     {
         shared_ptr<ActorRenderComponent> pRenderComponent =
-            MakeStrongPtr(pSparkle->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+            MakeStrongPtr(pSparkle->GetComponent<ActorRenderComponent>());
         assert(pRenderComponent);
 
         pRenderComponent->SetVisible(visible);
@@ -125,12 +125,12 @@ void PowerupComponent::SetPowerupSparklesVisibility(bool visible)
 
 void PowerupComponent::BroadcastPowerupTimeUpdated(uint32 actorId, PowerupType powerupType, int32 secondsRemaining)
 {
-    shared_ptr<EventData_Updated_Powerup_Time> pEvent(new EventData_Updated_Powerup_Time(actorId, powerupType, secondsRemaining));
+    shared_ptr<EventData_Updated_Powerup_Time> pEvent(MakeEvent<EventData_Updated_Powerup_Time>(actorId, powerupType, secondsRemaining));
     IEventMgr::Get()->VQueueEvent(pEvent);
 }
 
 void PowerupComponent::BroadcastPowerupStatusUpdated(uint32 actorId, PowerupType powerupType, bool isPowerupFinished)
 {
-    shared_ptr<EventData_Updated_Powerup_Status> pEvent(new EventData_Updated_Powerup_Status(actorId, powerupType, isPowerupFinished));
+    shared_ptr<EventData_Updated_Powerup_Status> pEvent(MakeEvent<EventData_Updated_Powerup_Status>(actorId, powerupType, isPowerupFinished));
     IEventMgr::Get()->VQueueEvent(pEvent);
 }
\ No newline at end of file
@@ -59,14 +59,14 @@ void DestroyableComponent::VPostInit()
     }
 
     shared_ptr<HealthComponent> pHealthComponent =
-        MakeStrongPtr(_owner->GetComponent<HealthComponent>(HealthComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<HealthComponent>());
     if (pHealthComponent)
     {
         pHealthComponent->AddObserver(this);
     }
 
     shared_ptr<AnimationComponent> pAnimationComponent =
-        MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
     if (pAnimationComponent)
     {
         pAnimationComponent->AddObserver(this);
@@ -91,14 +91,13 @@ void DestroyableComponent::VOnHealthBelowZero(DamageType damageType)
         int soundToPlayIdx = rand() % m_PossibleDestructionSounds.size();
 
         // And play it
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-            new EventData_Request_Play_Sound(m_PossibleDestructionSounds[soundToPlayIdx].c_str(), 100, false)));
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(m_PossibleDestructionSounds[soundToPlayIdx].c_str(), 100, false));
     }
 
     if (!m_DeathAnimationName.empty())
     {
         shared_ptr<AnimationComponent> pAnimationComponent =
-            MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
         if (pAnimationComponent)
         {
             if (m_DeathAnimationName == "DEFAULT")
@@ -130,7 +129,7 @@ void DestroyableComponent::VOnAnimationAtLastFrame(Animation* pAnimation)
 
     if (m_bDeleteOnDestruction)
     {
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
         IEventMgr::Get()->VQueueEvent(pEvent);
     }
     else
@@ -77,13 +77,13 @@ bool EnemyAIComponent::VInit(TiXmlElement* pData)
 
 void EnemyAIComponent::VPostInit()
 {
-    m_pRenderComponent = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
-    m_pPositionComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+    m_pRenderComponent = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
+    m_pPositionComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>());
     assert(m_pRenderComponent);
     assert(m_pPositionComponent);
 
     shared_ptr<HealthComponent> pHealthComp = 
-        MakeStrongPtr(_owner->GetComponent<HealthComponent>(HealthComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<HealthComponent>());
     assert(pHealthComp);
 
     pHealthComp->AddObserver(this);
@@ -111,7 +111,7 @@ void EnemyAIComponent::VUpdate(uint32 msDiff)
             shared_ptr<CameraNode> pCamera = pHumanView->GetCamera();
             if (pCamera)
             {
-                shared_ptr<EventData_Move_Actor> pEvent(new EventData_Move_Actor(_owner->GetGUID(), m_pPositionComponent->GetPosition()));
+                shared_ptr<EventData_Move_Actor> pEvent(MakeEvent<EventData_Move_Actor>(_owner->GetGUID(), m_pPositionComponent->GetPosition()));
                 IEventMgr::Get()->VTriggerEvent(pEvent);
 
                 SDL_Rect dummy;
@@ -119,7 +119,7 @@ void EnemyAIComponent::VUpdate(uint32 msDiff)
                 SDL_Rect cameraRect = pCamera->GetCameraRect();
                 if (!SDL_IntersectRect(&renderRect, &cameraRect, &dummy))
                 {
-                    shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+                    shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
                     IEventMgr::Get()->VQueueEvent(pEvent);
                 }
             }
@@ -131,7 +131,7 @@ void EnemyAIComponent::VUpdate(uint32 msDiff)
 
         if (!m_DeathAnimation.empty())
         {
-            auto pAnimComp = MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+            auto pAnimComp = MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
             assert(pAnimComp);
 
             pAnimComp->SetAnimation(m_DeathAnimation);
@@ -151,7 +151,7 @@ void EnemyAIComponent::VOnHealthBelowZero(DamageType damageType)
     Util::PlayRandomSoundFromList(m_DeathSounds);
 
     shared_ptr<PhysicsComponent> pPhysicsComponent =
-        MakeStrongPtr(_owner->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PhysicsComponent>());
     assert(pPhysicsComponent);
 
     pPhysicsComponent->Destroy();
@@ -276,7 +276,7 @@ Point EnemyAIComponent::FindClosestHostileActorOffset()
         for (Actor* pHostileActor : m_EnemiesInMeleeZone)
         {
             shared_ptr<PositionComponent> pHostileActorPositionComponent =
-                MakeStrongPtr(pHostileActor->GetComponent<PositionComponent>(PositionComponent::g_Name));
+                MakeStrongPtr(pHostileActor->GetComponent<PositionComponent>());
             assert(pHostileActorPositionComponent);
 
             Point positionDiff = pHostileActorPositionComponent->GetPosition() - m_pPositionComponent->GetPosition();
@@ -291,7 +291,7 @@ Point EnemyAIComponent::FindClosestHostileActorOffset()
         for (Actor* pHostileActor : m_EnemiesInRangedZone)
         {
             shared_ptr<PositionComponent> pHostileActorPositionComponent =
-                MakeStrongPtr(pHostileActor->GetComponent<PositionComponent>(PositionComponent::g_Name));
+                MakeStrongPtr(pHostileActor->GetComponent<PositionComponent>());
             assert(pHostileActorPositionComponent);
 
             Point positionDiff = pHostileActorPositionComponent->GetPosition() - m_pPositionComponent->GetPosition();
@@ -50,15 +50,15 @@ bool BaseEnemyAIStateComponent::VInit(TiXmlElement* pData)
 void BaseEnemyAIStateComponent::VPostInit()
 {
     m_pAnimationComponent = 
-        MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name)).get();
+        MakeStrongPtr(_owner->GetComponent<AnimationComponent>()).get();
     m_pPhysicsComponent =
-        MakeStrongPtr(_owner->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name)).get();
+        MakeStrongPtr(_owner->GetComponent<PhysicsComponent>()).get();
     m_pPositionComponent =
-        MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name)).get();
+        MakeStrongPtr(_owner->GetComponent<PositionComponent>()).get();
     m_pEnemyAIComponent = 
-        MakeStrongPtr(_owner->GetComponent<EnemyAIComponent>(EnemyAIComponent::g_Name)).get();
+        MakeStrongPtr(_owner->GetComponent<EnemyAIComponent>()).get();
     m_pRenderComponent =
-        MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name)).get();
+        MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>()).get();
 
     assert(m_pAnimationComponent);
     assert(m_pPhysicsComponent);
@@ -432,7 +432,7 @@ void PatrolEnemyAIStateComponent::CalculatePatrolBorders()
     m_pPhysics->VSetPosition(_owner->GetGUID(), spawnPosition);
     m_pPositionComponent->SetPosition(spawnPosition);
 
-    /*shared_ptr<EventData_Move_Actor> pEvent(new EventData_Move_Actor(_owner->GetGUID(), spawnPosition));
+    /*shared_ptr<EventData_Move_Actor> pEvent(MakeEvent<EventData_Move_Actor>(_owner->GetGUID(), spawnPosition));
     IEventMgr::Get()->VQueueEvent(pEvent);*/
 
     assert(m_LeftPatrolBorder > 0);
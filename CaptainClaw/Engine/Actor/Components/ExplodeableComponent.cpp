@@ -49,7 +49,7 @@ bool ExplodeableComponent::VInit(TiXmlElement* pData)
 void ExplodeableComponent::VPostInit()
 {
     shared_ptr<HealthComponent> pHealthComponent =
-        MakeStrongPtr(_owner->GetComponent<HealthComponent>(HealthComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<HealthComponent>());
     // If there is no health component then the object cannot explode
     assert(pHealthComponent);
     if (pHealthComponent)
@@ -68,7 +68,7 @@ TiXmlElement* ExplodeableComponent::VGenerateXml()
 void ExplodeableComponent::VOnHealthBelowZero(DamageType damageType)
 {
     shared_ptr<PositionComponent> pPositionComponent =
-        MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PositionComponent>());
     assert(pPositionComponent);
 
     ActorTemplates::CreateAreaDamage(pPositionComponent->GetPosition(), m_ExplosionSize, m_Damage, CollisionFlag_Explosion, "Circle", DamageType_Explosion, Direction_None, Point(0, 40));
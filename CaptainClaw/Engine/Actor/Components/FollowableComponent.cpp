@@ -25,7 +25,7 @@ FollowableComponent::FollowableComponent() :
 
 FollowableComponent::~FollowableComponent()
 {
-    shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(m_pFollowingActor->GetGUID()));
+    shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(m_pFollowingActor->GetGUID()));
     IEventMgr::Get()->VQueueEvent(pEvent);
 }
 
@@ -48,7 +48,7 @@ bool FollowableComponent::VInit(TiXmlElement* pData)
 void FollowableComponent::VPostInit()
 {
     m_pPositionComponent =
-        MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name)).get();
+        MakeStrongPtr(_owner->GetComponent<PositionComponent>()).get();
 
     Point ownerPos = m_pPositionComponent->GetPosition();
     m_pFollowingActor = ActorTemplates::CreateRenderedActor(
@@ -56,9 +56,9 @@ void FollowableComponent::VPostInit()
     assert(m_pFollowingActor != NULL);
 
     m_pTargetPositionComponent =
-        MakeStrongPtr(m_pFollowingActor->GetComponent<PositionComponent>(PositionComponent::g_Name)).get();
+        MakeStrongPtr(m_pFollowingActor->GetComponent<PositionComponent>()).get();
     m_pTargetRenderComponent =
-        MakeStrongPtr(m_pFollowingActor->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name)).get();
+        MakeStrongPtr(m_pFollowingActor->GetComponent<ActorRenderComponent>()).get();
 
     assert(m_pPositionComponent != NULL);
     assert(m_pTargetPositionComponent != NULL);
@@ -82,8 +82,7 @@ void FollowableComponent::VUpdate(uint32 msDiff)
         Point ownerPos = m_pPositionComponent->GetPosition();
         m_pTargetPositionComponent->SetPosition(ownerPos.x + m_Offset.x, ownerPos.y + m_Offset.y);
 
-        shared_ptr<EventData_Move_Actor> pEvent(
-            new EventData_Move_Actor(m_pFollowingActor->GetGUID(), m_pTargetPositionComponent->GetPosition()));
+        shared_ptr<EventData_Move_Actor> pEvent(MakeEvent<EventData_Move_Actor>(m_pFollowingActor->GetGUID(), m_pTargetPositionComponent->GetPosition()));
         IEventMgr::Get()->VTriggerEvent(pEvent);
     }
     else if (m_MsDuration > 0)
@@ -24,7 +24,7 @@ GlitterComponent::~GlitterComponent()
 {
     if (m_pGlitter)
     {
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(m_pGlitter->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(m_pGlitter->GetGUID()));
         IEventMgr::Get()->VTriggerEvent(pEvent);
     }
 }
@@ -52,7 +52,7 @@ bool GlitterComponent::VInit(TiXmlElement* pData)
 
 void GlitterComponent::VPostInit()
 {
-    m_pPositonComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name)).get();
+    m_pPositonComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>()).get();
     assert(m_pPositonComponent);
 
     if (m_SpawnImmediate)
@@ -75,14 +75,14 @@ void GlitterComponent::VUpdate(uint32 msDiff)
     // Update position if necessary
     if (m_pGlitter && m_FollowOwner)
     {
-        shared_ptr<EventData_Move_Actor> pEvent(new EventData_Move_Actor(m_pGlitter->GetGUID(), m_pPositonComponent->GetPosition()));
+        shared_ptr<EventData_Move_Actor> pEvent(MakeEvent<EventData_Move_Actor>(m_pGlitter->GetGUID(), m_pPositonComponent->GetPosition()));
         IEventMgr::Get()->VTriggerEvent(pEvent);
     }
     // Spawn glitter
     else if (!m_pGlitter && m_Active)
     {
         shared_ptr<PhysicsComponent> pPhysicsComponent = 
-            MakeStrongPtr(_owner->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<PhysicsComponent>());
         assert(pPhysicsComponent && "Sparkle not spawned in post init and sparkle cannot be spawned in update");
 
         // Spawn sparkle if actor is still
@@ -99,7 +99,7 @@ void GlitterComponent::Deactivate()
     {
         m_Active = false;
 
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(m_pGlitter->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(m_pGlitter->GetGUID()));
         IEventMgr::Get()->VTriggerEvent(pEvent);
 
         m_pGlitter.reset();
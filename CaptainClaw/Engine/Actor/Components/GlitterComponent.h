@@ -13,6 +13,7 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const override { return g_Name; }
+    virtual ActorComponent* VClone() const override { return new GlitterComponent(*this); }
 
     virtual bool VInit(TiXmlElement* pData) override;
     virtual void VPostInit() override;
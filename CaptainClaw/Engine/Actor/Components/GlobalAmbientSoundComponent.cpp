@@ -50,7 +50,7 @@ bool GlobalAmbientSoundComponent::VInit(TiXmlElement* pData)
 
     if (m_IsLooping)
     {
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(new EventData_Request_Play_Sound(m_Sound.c_str(), m_SoundVolume, false,-1)));
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(m_Sound.c_str(), m_SoundVolume, false,-1));
     }
 
     return true;
@@ -76,7 +76,7 @@ void GlobalAmbientSoundComponent::VUpdate(uint32 msDiff)
         int timeOn = Util::GetRandomNumber(m_MinTimeOn, m_MaxTimeOn);
         int soundLoops = timeOn / m_SoundDurationMs;
 
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(new EventData_Request_Play_Sound(m_Sound.c_str(), m_SoundVolume, false, soundLoops)));
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(m_Sound.c_str(), m_SoundVolume, false, soundLoops));
 
         m_TimeOff = Util::GetRandomNumber(m_MinTimeOff, m_MaxTimeOff) + soundLoops * m_SoundDurationMs;
 
@@ -86,7 +86,7 @@ void KinematicComponent::VPostInit()
     if (fabs(m_Size.x) < DBL_EPSILON || fabs(m_Size.y) < DBL_EPSILON)
     {
         shared_ptr<ActorRenderComponent> pRenderComponent =
-            MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
         assert(pRenderComponent);
 
         shared_ptr<Image> pImage = MakeStrongPtr(pRenderComponent->GetCurrentImage());
@@ -96,7 +96,7 @@ void KinematicComponent::VPostInit()
     }
 
     shared_ptr<PositionComponent> pPositionComponent =
-        MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PositionComponent>());
     assert(pPositionComponent);
 
     m_pPositionComponent = pPositionComponent.get();
@@ -249,7 +249,7 @@ void KinematicComponent::OnMoved(Point newPosition)
             assert(pActor);
             
             shared_ptr<PhysicsComponent> pPhysicsComponent =
-                MakeStrongPtr(pActor->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+                MakeStrongPtr(pActor->GetComponent<PhysicsComponent>());
 
             // Provide sanity check
             if (pPhysicsComponent && pPhysicsComponent->GetNumFootContacts() == 0)
@@ -273,7 +273,7 @@ void KinematicComponent::OnMoved(Point newPosition)
             }
 
             shared_ptr<PositionComponent> pPositionComponent =
-                MakeStrongPtr(pActor->GetComponent<PositionComponent>(PositionComponent::g_Name));
+                MakeStrongPtr(pActor->GetComponent<PositionComponent>());
             Point currentPos = pPositionComponent->GetPosition();*/
             //pPositionComponent->SetPosition(currentPos.x + positionDelta.x, currentPos.y + positionDelta.y);
             
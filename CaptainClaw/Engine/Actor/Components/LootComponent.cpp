@@ -23,7 +23,7 @@ bool LootComponent::VInit(TiXmlElement* pData)
 
 void LootComponent::VPostInit()
 {
-    shared_ptr<HealthComponent> pHealthComponent = MakeStrongPtr(_owner->GetComponent<HealthComponent>(HealthComponent::g_Name));
+    shared_ptr<HealthComponent> pHealthComponent = MakeStrongPtr(_owner->GetComponent<HealthComponent>());
     if (pHealthComponent)
     {
         pHealthComponent->AddObserver(this);
@@ -48,7 +48,7 @@ void LootComponent::VOnHealthBelowZero(DamageType damageType)
     for (PickupType item : m_Loot)
     {
         shared_ptr<PositionComponent> pPositionComponent =
-            MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<PositionComponent>());
         assert(pPositionComponent);
 
         StrongActorPtr pLoot = ActorTemplates::CreateActorPickup(item, pPositionComponent->GetPosition(), false);
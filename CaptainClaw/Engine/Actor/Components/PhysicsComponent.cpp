@@ -43,7 +43,11 @@ PhysicsComponent::PhysicsComponent() :
 
 PhysicsComponent::~PhysicsComponent()
 {
-    m_pPhysics->VRemoveActor(_owner->GetGUID());
+    // Prefab prototypes never have any owner
+    if (_owner)
+    {
+        m_pPhysics->VRemoveActor(_owner->GetGUID());
+    }
 }
 
 bool PhysicsComponent::VInit(TiXmlElement* data)
@@ -184,14 +188,14 @@ void PhysicsComponent::VPostInit()
     if (m_ActorBodyDef.collisionFlag != CollisionFlag_None)
     {
         shared_ptr<PositionComponent> pPositionComponent =
-            MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<PositionComponent>());
         assert(pPositionComponent);
         m_ActorBodyDef.position = pPositionComponent->GetPosition();
 
         if (fabs(m_ActorBodyDef.size.x) < DBL_EPSILON || fabs(m_ActorBodyDef.size.y) < DBL_EPSILON)
         {
             shared_ptr<ActorRenderComponent> pRenderComponent =
-                MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+                MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
             assert(pRenderComponent);
 
             shared_ptr<Image> pImage = MakeStrongPtr(pRenderComponent->GetCurrentImage());
@@ -776,7 +780,7 @@ bool PhysicsComponent::AttachToLadder()
     }
 
     shared_ptr<PositionComponent> pPositionComponent =
-        MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PositionComponent>());
     assert(pPositionComponent);
 
     Point actorPosition = pPositionComponent->GetPosition();
@@ -15,6 +15,7 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const override { return g_Name; }
+    virtual ActorComponent* VClone() const override { return new PhysicsComponent(*this); }
 
     virtual bool VInit(TiXmlElement* data) override;
     virtual TiXmlElement* VGenerateXml() override;
@@ -42,6 +43,9 @@ public:
     float GetDensity() { return m_Density; }
 
     Point GetBodySize() const { return m_ActorBodyDef.size; }
+    // Has effect only before body is created in VPostInit()
+    Point GetInitialSpeed() const { return m_ActorBodyDef.initialSpeed; }
+    void SetInitialSpeed(const Point& initialSpeed) { m_ActorBodyDef.initialSpeed = initialSpeed; }
     double GetBodyWidth() const { return m_ActorBodyDef.size.x; }
     double GetBodyHeight() const { return m_ActorBodyDef.size.y; }
 
@@ -54,7 +54,7 @@ bool PickupComponent::VInit(TiXmlElement* data)
 void PickupComponent::VPostInit()
 {
     shared_ptr<TriggerComponent> pTriggerComponent =
-        MakeStrongPtr(_owner->GetComponent<TriggerComponent>(TriggerComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<TriggerComponent>());
     assert(pTriggerComponent);
 
     pTriggerComponent->AddObserver(this);
@@ -74,7 +74,7 @@ void PickupComponent::VOnActorEnteredTrigger(Actor* pActorWhoEntered)
     {
         // TODO: Is this necessary ?
         shared_ptr<TriggerComponent> pTriggerComponent =
-            MakeStrongPtr(_owner->GetComponent<TriggerComponent>(TriggerComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<TriggerComponent>());
         if (pTriggerComponent)
         {
             //pTriggerComponent->Deactivate();
@@ -84,7 +84,7 @@ void PickupComponent::VOnActorEnteredTrigger(Actor* pActorWhoEntered)
         // Play pickup sound if applicable
         if (m_PickupSound.length() > 0)
         {
-            IEventMgr::Get()->VTriggerEvent(IEventDataPtr(new EventData_Request_Play_Sound(m_PickupSound.c_str(), 100, false)));
+            IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(m_PickupSound.c_str(), 100, false));
         }
 
         //LOG("Pickup up");
@@ -124,8 +124,8 @@ void TreasurePickupComponent::VPostInit()
 {
     PickupComponent::VPostInit();
 
-    m_pRenderComponent = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
-    m_pPositionComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+    m_pRenderComponent = MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
+    m_pPositionComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>());
     assert(m_pRenderComponent);
     assert(m_pPositionComponent);
 }
@@ -138,7 +138,7 @@ void TreasurePickupComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseEle
 bool TreasurePickupComponent::VOnApply(Actor* pActorWhoPickedThis)
 {
     shared_ptr<ScoreComponent> pScoreComponent =
-        MakeStrongPtr(pActorWhoPickedThis->GetComponent<ScoreComponent>(ScoreComponent::g_Name));
+        MakeStrongPtr(pActorWhoPickedThis->GetComponent<ScoreComponent>());
     if (pScoreComponent && !m_IsPickedUp)
     {
         pScoreComponent->AddScorePoints(m_ScorePoints);
@@ -147,7 +147,7 @@ bool TreasurePickupComponent::VOnApply(Actor* pActorWhoPickedThis)
 
         // Destroy glitter if possible
         shared_ptr<GlitterComponent> pGlitterComponent =
-            MakeStrongPtr(_owner->GetComponent<GlitterComponent>(GlitterComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<GlitterComponent>());
         if (pGlitterComponent)
         {
             pGlitterComponent->Deactivate();
@@ -175,7 +175,7 @@ void TreasurePickupComponent::VUpdate(uint32 msDiff)
             shared_ptr<CameraNode> pCamera = pHumanView->GetCamera();
             if (pCamera)
             {
-                shared_ptr<EventData_Move_Actor> pEvent(new EventData_Move_Actor(_owner->GetGUID(), m_pPositionComponent->GetPosition()));
+                shared_ptr<EventData_Move_Actor> pEvent(MakeEvent<EventData_Move_Actor>(_owner->GetGUID(), m_pPositionComponent->GetPosition()));
                 IEventMgr::Get()->VTriggerEvent(pEvent);
 
                 SDL_Rect dummy;
@@ -183,7 +183,7 @@ void TreasurePickupComponent::VUpdate(uint32 msDiff)
                 SDL_Rect cameraRect = pCamera->GetCameraRect();
                 if (!SDL_IntersectRect(&renderRect, &cameraRect, &dummy))
                 {
-                    shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+                    shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
                     IEventMgr::Get()->VQueueEvent(pEvent);
                 }
             }
@@ -226,12 +226,12 @@ void LifePickupComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseElement
 bool LifePickupComponent::VOnApply(Actor* pActorWhoPickedThis)
 {
     shared_ptr<LifeComponent> pLifeComponent =
-        MakeStrongPtr(pActorWhoPickedThis->GetComponent<LifeComponent>(LifeComponent::g_Name));
+        MakeStrongPtr(pActorWhoPickedThis->GetComponent<LifeComponent>());
     if (pLifeComponent)
     {
         pLifeComponent->AddLives(m_NumLives);
 
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
         IEventMgr::Get()->VQueueEvent(pEvent);
 
 
@@ -273,7 +273,7 @@ void HealthPickupComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseEleme
 bool HealthPickupComponent::VOnApply(Actor* pActorWhoPickedThis)
 {
     shared_ptr<HealthComponent> pHealthComponent =
-        MakeStrongPtr(pActorWhoPickedThis->GetComponent<HealthComponent>(HealthComponent::g_Name));
+        MakeStrongPtr(pActorWhoPickedThis->GetComponent<HealthComponent>());
     if (pHealthComponent)
     {
         if (pHealthComponent->HasMaxHealth())
@@ -283,7 +283,7 @@ bool HealthPickupComponent::VOnApply(Actor* pActorWhoPickedThis)
 
         pHealthComponent->AddHealth(m_NumRestoredHealth, DamageType_None, Point(0, 0));
 
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
         IEventMgr::Get()->VQueueEvent(pEvent);
 
         return true;
@@ -334,14 +334,13 @@ void TeleportPickupComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseEle
 
 bool TeleportPickupComponent::VOnApply(Actor* pActorWhoPickedThis)
 {
-    shared_ptr<EventData_Teleport_Actor> pTeleportEvent(new EventData_Teleport_Actor(pActorWhoPickedThis->GetGUID(), m_Destination, true));
+    shared_ptr<EventData_Teleport_Actor> pTeleportEvent(MakeEvent<EventData_Teleport_Actor>(pActorWhoPickedThis->GetGUID(), m_Destination, true));
     IEventMgr::Get()->VQueueEvent(pTeleportEvent);
 
-    shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+    shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
     IEventMgr::Get()->VQueueEvent(pEvent);
 
-    IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-        new EventData_Request_Play_Sound(SOUND_GAME_ENTER_WARP, 100, false)));
+    IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_GAME_ENTER_WARP, 100, false));
 
     return true;
 }
@@ -402,12 +401,12 @@ void PowerupPickupComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseElem
 bool PowerupPickupComponent::VOnApply(Actor* pActorWhoPickedThis)
 {
     shared_ptr<PowerupComponent> pPowerupComponent =
-        MakeStrongPtr(pActorWhoPickedThis->GetComponent<PowerupComponent>(PowerupComponent::g_Name));
+        MakeStrongPtr(pActorWhoPickedThis->GetComponent<PowerupComponent>());
     if (pPowerupComponent)
     {
         pPowerupComponent->ApplyPowerup(m_PowerupType, m_PowerupDuration);
 
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
         IEventMgr::Get()->VQueueEvent(pEvent);
 
         return true;
@@ -464,7 +463,7 @@ void AmmoPickupComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseElement
 bool AmmoPickupComponent::VOnApply(Actor* pActorWhoPickedThis)
 {
     shared_ptr<AmmoComponent> pAmmoComponent =
-        MakeStrongPtr(pActorWhoPickedThis->GetComponent<AmmoComponent>(AmmoComponent::g_Name));
+        MakeStrongPtr(pActorWhoPickedThis->GetComponent<AmmoComponent>());
     if (pAmmoComponent)
     {
         for (auto ammoPair : m_AmmoPickupList)
@@ -473,7 +472,7 @@ bool AmmoPickupComponent::VOnApply(Actor* pActorWhoPickedThis)
             pAmmoComponent->AddAmmo(ammoPair.first, ammoPair.second);
         }
 
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
         IEventMgr::Get()->VQueueEvent(pEvent);
 
         return true;
@@ -41,6 +41,7 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const override { return g_Name; }
+    virtual ActorComponent* VClone() const override { return new TreasurePickupComponent(*this); }
     virtual void VUpdate(uint32 msDiff) override;
     virtual void VPostInit() override;
 
@@ -69,6 +70,7 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const { return g_Name; }
+    virtual ActorComponent* VClone() const { return new LifePickupComponent(*this); }
 
     virtual bool VOnApply(Actor* pActorWhoPickedThis);
 
@@ -91,6 +93,7 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const { return g_Name; }
+    virtual ActorComponent* VClone() const { return new HealthPickupComponent(*this); }
 
     virtual bool VOnApply(Actor* pActorWhoPickedThis);
 
@@ -135,6 +138,7 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const { return g_Name; }
+    virtual ActorComponent* VClone() const { return new PowerupPickupComponent(*this); }
 
     virtual bool VOnApply(Actor* pActorWhoPickedThis);
 
@@ -160,6 +164,7 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const { return g_Name; }
+    virtual ActorComponent* VClone() const { return new AmmoPickupComponent(*this); }
 
     virtual bool VOnApply(Actor* pActorWhoPickedThis);
 
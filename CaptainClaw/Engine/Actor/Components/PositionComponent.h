@@ -9,6 +9,7 @@ class PositionComponent : public ActorComponent
 public:
     static const char* g_Name;
     virtual const char* VGetName() const override { return g_Name; }
+    virtual ActorComponent* VClone() const override { return new PositionComponent(*this); }
 
     virtual bool VInit(TiXmlElement* data) override;
     virtual TiXmlElement* VGenerateXml() override;
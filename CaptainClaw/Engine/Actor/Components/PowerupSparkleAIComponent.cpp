@@ -26,14 +26,14 @@ bool PowerupSparkleAIComponent::VInit(TiXmlElement* data)
 void PowerupSparkleAIComponent::VPostInit()
 {
     shared_ptr<AnimationComponent> pAnimationComponent =
-        MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
     assert(pAnimationComponent && pAnimationComponent->GetCurrentAnimation());
     pAnimationComponent->AddObserver(this);
 
     srand((long)this);
     pAnimationComponent->SetDelay(rand() % 1000);
 
-    m_pPositonComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name)).get();
+    m_pPositonComponent = MakeStrongPtr(_owner->GetComponent<PositionComponent>()).get();
     assert(m_pPositonComponent);
 }
 
@@ -56,7 +56,7 @@ void PowerupSparkleAIComponent::VOnAnimationLooped(Animation* pAnimation)
     m_pPositonComponent->SetX(targetPos.x - m_TargetSize.x / 2 + rand() % (int)m_TargetSize.x);
     m_pPositonComponent->SetY(targetPos.y - m_TargetSize.y / 2  + rand() % (int)m_TargetSize.y);
 
-    shared_ptr<EventData_Move_Actor> pEvent(new EventData_Move_Actor(_owner->GetGUID(), m_pPositonComponent->GetPosition()));
+    shared_ptr<EventData_Move_Actor> pEvent(MakeEvent<EventData_Move_Actor>(_owner->GetGUID(), m_pPositonComponent->GetPosition()));
     IEventMgr::Get()->VTriggerEvent(pEvent);
 }
 
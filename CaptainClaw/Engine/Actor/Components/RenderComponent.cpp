@@ -70,15 +70,23 @@ bool BaseRenderComponent::VInit(TiXmlElement* pXmlData)
             }
         }
 
-        for (std::string imagePath : matchingPathNames)
+        // Only load known image formats
+        std::vector<std::string> pidPaths;
+        for (const std::string& imagePath : matchingPathNames)
         {
-            // Only load known image formats
-            if (!WildcardMatch("*.pid", imagePath.c_str()))
+            if (WildcardMatch("*.pid", imagePath.c_str()))
             {
-                continue;
+                pidPaths.push_back(imagePath);
             }
+        }
 
-            shared_ptr<Image> image = PidResourceLoader::LoadAndReturnImage(imagePath.c_str(), palette);
+        // Whole image set shares few atlas textures so that its frames are drawn without texture switches
+        std::vector<shared_ptr<Image>> images = PidResourceLoader::LoadAndReturnImageSet(pidPaths, palette);
+
+        for (uint32 imageIdx = 0; imageIdx < pidPaths.size(); imageIdx++)
+        {
+            std::string imagePath = pidPaths[imageIdx];
+            shared_ptr<Image> image = images[imageIdx];
             if (!image)
             {
                 LOG_WARNING("Failed to load image: " + imagePath);
@@ -149,7 +157,7 @@ void BaseRenderComponent::VPostInit()
     shared_ptr<SceneNode> pNode = GetSceneNode();
     if (pNode)
     {
-        shared_ptr<EventData_New_Render_Component> pEvent(new EventData_New_Render_Component(_owner->GetGUID(), pNode));
+        shared_ptr<EventData_New_Render_Component> pEvent(MakeEvent<EventData_New_Render_Component>(_owner->GetGUID(), pNode));
         IEventMgr::Get()->VTriggerEvent(pEvent);
     }
 }
@@ -159,6 +167,14 @@ void BaseRenderComponent::VOnChanged()
 
 }
 
+void BaseRenderComponent::OnPositionRectResized()
+{
+    if (m_pSceneNode)
+    {
+        m_pSceneNode->OnResized();
+    }
+}
+
 shared_ptr<SceneNode> BaseRenderComponent::GetSceneNode()
 {
     if (!m_pSceneNode)
@@ -289,7 +305,7 @@ SDL_Rect ActorRenderComponent::VGetPositionRect() const
 shared_ptr<SceneNode> ActorRenderComponent::VCreateSceneNode()
 {
     shared_ptr<PositionComponent> pPositionComponent = 
-        MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PositionComponent>());
     if (!pPositionComponent)
     {
         // can't render without a transform
@@ -297,7 +313,8 @@ shared_ptr<SceneNode> ActorRenderComponent::VCreateSceneNode()
     }
 
     Point pos(pPositionComponent->GetX(), pPositionComponent->GetY());
-    shared_ptr<SceneNode> pActorNode(new SDL2ActorSceneNode(_owner->GetGUID(), this, RenderPass_Actor, pos, m_ZCoord));
+    shared_ptr<SceneNode> pActorNode =
+        MakePooled<SDL2ActorSceneNode>(_owner->GetGUID(), this, RenderPass_Actor, pos, m_ZCoord);
 
     return pActorNode;
 }
@@ -307,11 +324,26 @@ void ActorRenderComponent::VCreateInheritedXmlElements(TiXmlElement* pBaseElemen
 
 }
 
+void ActorRenderComponent::SetVisible(bool visible)
+{
+    if (visible != m_IsVisible)
+    {
+        m_IsVisible = visible;
+        // Invisible actor has empty rect
+        OnPositionRectResized();
+    }
+}
+
 void ActorRenderComponent::SetImage(std::string imageName)
 {
-    if (m_ImageMap.count(imageName) > 0)
+    auto findIt = m_ImageMap.find(imageName);
+    if (findIt != m_ImageMap.end())
     {
-        m_CurrentImage = m_ImageMap[imageName];
+        if (findIt->second != m_CurrentImage)
+        {
+            m_CurrentImage = findIt->second;
+            OnPositionRectResized();
+        }
     }
     else
     {
@@ -334,101 +366,11 @@ void ActorRenderComponent::SetImage(std::string imageName)
 
 void TilePlaneRenderComponent::ProcessMainPlaneTiles(const TileList& tileList)
 {
-    const int tilesCount = tileList.size();
-    int currentTileIdx = 0;
-    
-    while (currentTileIdx < tilesCount)
-    {
-        TileList continuousTiles = GetAllContinuousTiles(tileList, currentTileIdx);
-        assert(continuousTiles.size() >= 1);
-
-        // Discard all empty tiles
-        if (continuousTiles[0] != -1)
-        {
-            // Do stuff with continuous tiles
-            //-----
-            //-----
-            //-----
-            //
-
-            if (continuousTiles.size() > 1)
-            {
-                LOG("Continuous tiles on Y: " + ToStr(GetTileInfo(tileList, currentTileIdx).y));
-                std::string contTilesString;
-                for (int tileId : continuousTiles)
-                {
-                    contTilesString += ToStr(tileId) + "-";
-                }
-                LOG(contTilesString);
-            }
-
-            int tileWidth = m_PlaneProperties.tilePixelWidth;
-            TileInfo firstTileInfo = GetTileInfo(tileList, currentTileIdx);
-            int currentX = firstTileInfo.x;
-            int currentY = firstTileInfo.y;
-            for (int tileId : continuousTiles)
-            {
-                shared_ptr<EventData_Collideable_Tile_Created> pEvent(
-                    new EventData_Collideable_Tile_Created(tileId, currentX, currentY));
-                IEventMgr::Get()->VTriggerEvent(pEvent);
-
-                currentX += tileWidth;
-            }
-        }
-
-        currentTileIdx += continuousTiles.size();
-    }
-}
-
-TileList TilePlaneRenderComponent::GetAllContinuousTiles(const TileList& tileList, int fromTileIdx)
-{
-    const int tilesCount = tileList.size();
-
-    TileList continuousTileList;
-
-    // First tile always belongs in the list
-    TileInfo currentTile = GetTileInfo(tileList, fromTileIdx);
-    continuousTileList.push_back(currentTile.tileId);
-
-    // We already have the first tile, check next one
-    int currentTileIdx = fromTileIdx + 1;
-
-    // Continue adding tiles as long as its ID and Y position matches the first tile
-    while (true)
-    {
-        // Keep track of the idx so we do not step out of bounds
-        if (currentTileIdx >= tilesCount)
-        {
-            break;
-        }
-
-        TileInfo nextTile = GetTileInfo(tileList, currentTileIdx);
-        if ((nextTile.tileId == currentTile.tileId) && (nextTile.y == currentTile.y))
-        {
-            continuousTileList.push_back(nextTile.tileId);
-            currentTile = nextTile;
-            currentTileIdx++;
-        }
-        else
-        {
-            break;
-        }
-    }
-
-    return continuousTileList;
-}
-
-TileInfo TilePlaneRenderComponent::GetTileInfo(const TileList& tileList, int tileIdx)
-{
-    assert(tileIdx < tileList.size());
-
-    TileInfo tileInfo;
-
-    tileInfo.tileId = tileList[tileIdx];
-    tileInfo.x = (tileIdx * m_PlaneProperties.tilePixelWidth) % m_PlaneProperties.planePixelWidth;
-    tileInfo.y = ((tileIdx / m_PlaneProperties.tilesOnAxisX) * m_PlaneProperties.tilePixelHeight) % m_PlaneProperties.planePixelHeight;
-
-    return tileInfo;
+    // Whole plane is sent at once so that collision geometry of neighbouring tiles can be merged
+    shared_ptr<EventData_Collideable_Tile_Plane_Created> pEvent(MakeEvent<EventData_Collideable_Tile_Plane_Created>(
+        tileList, m_PlaneProperties.tilesOnAxisX, m_PlaneProperties.tilesOnAxisY,
+        m_PlaneProperties.tilePixelWidth, m_PlaneProperties.tilePixelHeight));
+    IEventMgr::Get()->VTriggerEvent(pEvent);
 }
 
 bool TilePlaneRenderComponent::VDelegateInit(TiXmlElement* pXmlData)
@@ -520,173 +462,27 @@ bool TilePlaneRenderComponent::VDelegateInit(TiXmlElement* pXmlData)
         return false;
     }
     PROFILE_CPU("PLANE CREATION");
-    int32 tileIdx = 0;
 
-    TileList tileList;
-    for (TiXmlElement* pTileNode = pTileElements->FirstChildElement(); 
-        pTileNode != NULL; 
-        pTileNode = pTileNode->NextSiblingElement())
+    TileList xmlTileList;
+    const TileList* pTileList = LoadTileList(pTileElements, g_pApp->GetGameLogic()->GetCurrentLevelData().get(), xmlTileList);
+    if (pTileList == NULL)
     {
-        std::string tileFileName(pTileNode->GetText());
-
-        // Temporarily keep track of the tiles stored
-        int32 tileId = std::stoi(tileFileName);
-        tileList.push_back(tileId);
-
-#if 0
-        //------ HACKERINO, should be in separate component, but...
-        //    Sends event that tile on the main (action) plane was created
-        //    It will be added into physics subsystem then but it is handled elsewhere. This just sends event that some
-        //    tile has been created. 
-        if (m_PlaneProperties.isMainPlane)
-        {
-            int32 tileId = std::stoi(tileFileName);
-
-            // Temporary - I guess ?
-            tileList.push_back(tileId);
-
-
-            if (tileId != -1) // Tiles with id == -1 are empty tiles (= air)
-            {
-                // THIS IS THE ORIGINAL CODE WHICH DOES NOT DEAL WITH MERGING CONTINUOUS TILES
-                /*
-                int32 posX = (tileIdx * m_PlaneProperties.tilePixelWidth) % m_PlaneProperties.planePixelWidth;
-                int32 posY = ((tileIdx / m_PlaneProperties.tilesOnAxisX) * m_PlaneProperties.tilePixelHeight) % m_PlaneProperties.planePixelHeight;
-                shared_ptr<EventData_Collideable_Tile_Created> pEvent(new EventData_Collideable_Tile_Created(tileId, posX, posY));
-                IEventMgr::Get()->VTriggerEvent(pEvent);
-                */
-
-                int32 posX = (tileIdx * m_PlaneProperties.tilePixelWidth) % m_PlaneProperties.planePixelWidth;
-                int32 posY = ((tileIdx / m_PlaneProperties.tilesOnAxisX) * m_PlaneProperties.tilePixelHeight) % m_PlaneProperties.planePixelHeight;
-
-                tilesInRow.push_back({ tileId, posX, posY });
-                lastPos = posY;
-            }
-
-            // This block of uncanny code deals with merging continuous tiles if possible
-            if (tileId == -1 || (prevTileId != tileId))
-            {
-                if (tilesInRow.size() > 1)
-                {
-                    std::string outString;
-                    for (auto tile : tilesInRow)
-                    {
-                        outString += ToStr(tile.tileId) + "-";
-                    }
-
-                    /*LOG("Row Y: " + ToStr(lastPos));
-                    LOG("Tiles: " + outString);*/
-
-                    //-----
-
-                    //if (tilesInRow.size() == 2 && tilesInRow[0].tileId != tilesInRow[1].tileId)
-
-                    // First and last are different - resolve last one separately and pop it
-                    if (tilesInRow.front().tileId != tilesInRow.back().tileId)
-                    {
-                        TileInfo tile = tilesInRow.back();
-                        shared_ptr<EventData_Collideable_Tile_Created> pEvent(
-                            new EventData_Collideable_Tile_Created(tile.tileId, tile.x, tile.y));
-                        IEventMgr::Get()->VTriggerEvent(pEvent);
-
-                        tilesInRow.pop_back();
-                    }
-                    // If there were only 2 tiles to begin with, it can happen that tehre can be only 1 now
-                    if (tilesInRow.size() == 1)
-                    {
-                        shared_ptr<EventData_Collideable_Tile_Created> pEvent(
-                            new EventData_Collideable_Tile_Created(tilesInRow[0].tileId, tilesInRow[0].x, tilesInRow[0].y));
-                        IEventMgr::Get()->VTriggerEvent(pEvent);
-                    }
-                    else
-                    {
-                        // Sanity check
-                        for (TileInfo& tile : tilesInRow)
-                        {
-                            assert(tile.tileId == tilesInRow[0].tileId);
-                        }
-
-                        // Try to merge here, multiple same tiles in the row
-                        auto findIt = pTilePrototypeMap->find(tilesInRow[0].tileId);
-                        assert(findIt != pTilePrototypeMap->end());
-                        TileCollisionPrototype tileProto = findIt->second;
-
-                        int countAttrTiles = 0;
-                        bool canBeMerged = true;
-                        TileCollisionRectangle mergedRect;
-                        for (TileCollisionRectangle& colRect : tileProto.collisionRectangles)
-                        {
-                            if (colRect.collisionType != CollisionType_None)
-                            {
-                                countAttrTiles++;
-                                mergedRect = colRect;
-
-                                if (colRect.collisionRect.w != m_PlaneProperties.tilePixelWidth)
-                                {
-                                    canBeMerged = false;
-                                }
-                            }
-                        }
-
-                        if (countAttrTiles != 1)
-                        {
-                            canBeMerged = false;
-                        }
-
-                        if (canBeMerged)
-                        {
-                            LOG("Can be merged !");
-                            for (TileInfo& tile : tilesInRow)
-                            {
-                                shared_ptr<EventData_Collideable_Tile_Created> pEvent(
-                                    new EventData_Collideable_Tile_Created(tile.tileId, tile.x, tile.y));
-                                IEventMgr::Get()->VTriggerEvent(pEvent);
-                            }
-                        }
-                        else
-                        {
-                            for (TileInfo& tile : tilesInRow)
-                            {
-                                shared_ptr<EventData_Collideable_Tile_Created> pEvent(
-                                    new EventData_Collideable_Tile_Created(tile.tileId, tile.x, tile.y));
-                                IEventMgr::Get()->VTriggerEvent(pEvent);
-                            }
-                        }
-                    }
-                }
-                else
-                {
-                    for (TileInfo& tile : tilesInRow)
-                    {
-                        shared_ptr<EventData_Collideable_Tile_Created> pEvent(
-                            new EventData_Collideable_Tile_Created(tile.tileId, tile.x, tile.y));
-                        IEventMgr::Get()->VTriggerEvent(pEvent);
-                    }
-                }
-
-                tilesInRow.clear();
-            }
-            prevTileId = tileId;
-        }
-#endif
+        return false;
+    }
 
-        // Convert to three digits, e.g. "2" -> "002" or "15" -> "015"
-        if (tileFileName.length() == 1) 
-        { 
-            tileFileName = "00" + tileFileName; 
-        }
-        else if (tileFileName.length() == 2 &&
-            !(g_pApp->GetGameLogic()->GetCurrentLevelData()->GetLevelNumber() == 1 && tileFileName == "74")) 
-        { 
-            tileFileName = "0" + tileFileName; 
-        }
+    // Image names are resolved to tile ids once, tiles then index straight into the table
+    std::vector<Image*> tileImageTable;
+    CreateTileImageTable(g_pApp->GetGameLogic()->GetCurrentLevelData()->GetLevelNumber(), tileImageTable);
 
-        auto findIt = m_ImageMap.find(tileFileName);
-        if (findIt != m_ImageMap.end())
+    m_TileImageList.reserve(pTileList->size());
+    for (int32 tileId : *pTileList)
+    {
+        Image* pTileImage = (tileId >= 0 && tileId < (int32)tileImageTable.size()) ? tileImageTable[tileId] : NULL;
+        if (pTileImage != NULL)
         {
-            m_TileImageList.push_back(findIt->second.get());
+            m_TileImageList.push_back(pTileImage);
         }
-        else if (tileFileName == "0-1" || tileFileName == "-1")
+        else if (tileId == -1)
         {
             m_TileImageList.push_back(NULL);
         }
@@ -698,16 +494,14 @@ bool TilePlaneRenderComponent::VDelegateInit(TiXmlElement* pXmlData)
         }
         else
         {
-            LOG_ERROR("Could not find plane tile: " + tileFileName);
+            LOG_ERROR("Could not find plane tile: " + ToStr(tileId));
             return false;
         }
-
-        tileIdx++;
     }
 
     if (m_PlaneProperties.isMainPlane)
     {
-        ProcessMainPlaneTiles(tileList);
+        ProcessMainPlaneTiles(*pTileList);
     }
 
     if (m_TileImageList.empty())
@@ -732,6 +526,57 @@ bool TilePlaneRenderComponent::VDelegateInit(TiXmlElement* pXmlData)
     return true;
 }
 
+const TileList* TilePlaneRenderComponent::LoadTileList(TiXmlElement* pTileElements, const LevelData* pLevelData, TileList& xmlTileList)
+{
+    int levelPlaneIdx = -1;
+    if (pTileElements->Attribute("LevelPlaneIdx", &levelPlaneIdx))
+    {
+        const TileList* pPlaneTiles = pLevelData ? pLevelData->GetPlaneTiles(levelPlaneIdx) : NULL;
+        if (!pPlaneTiles)
+        {
+            LOG_ERROR("Tiles of level plane " + ToStr(levelPlaneIdx) + " are not loaded.");
+        }
+
+        return pPlaneTiles;
+    }
+
+    for (TiXmlElement* pTileNode = pTileElements->FirstChildElement();
+        pTileNode != NULL;
+        pTileNode = pTileNode->NextSiblingElement())
+    {
+        xmlTileList.push_back(std::stoi(pTileNode->GetText()));
+    }
+
+    return &xmlTileList;
+}
+
+void TilePlaneRenderComponent::CreateTileImageTable(int levelNumber, std::vector<Image*>& tileImageTable) const
+{
+    for (const auto& imagePair : m_ImageMap)
+    {
+        // Tile images are named after their id, longer names were already turned into frameXXX
+        const std::string& imageName = imagePair.first;
+        if (imageName.empty() || imageName.length() > 3 || imageName.find_first_not_of("0123456789") != std::string::npos)
+        {
+            continue;
+        }
+
+        // Tile ids are looked up in three digits, e.g. 2 -> "002" or 15 -> "015", except for tile 74 of level 1
+        int32 tileId = std::stoi(imageName);
+        std::string tileFileName = (levelNumber == 1 && tileId == 74) ? "74" : Util::ConvertToThreeDigitsString(tileId);
+        if (imageName != tileFileName)
+        {
+            continue;
+        }
+
+        if (tileId >= (int32)tileImageTable.size())
+        {
+            tileImageTable.resize(tileId + 1, NULL);
+        }
+        tileImageTable[tileId] = imagePair.second.get();
+    }
+}
+
 SDL_Rect TilePlaneRenderComponent::VGetPositionRect() const
 {
     return m_PositionRect;
@@ -740,7 +585,7 @@ SDL_Rect TilePlaneRenderComponent::VGetPositionRect() const
 shared_ptr<SceneNode> TilePlaneRenderComponent::VCreateSceneNode()
 {
     shared_ptr<PositionComponent> pPositionComponent =
-        MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PositionComponent>());
     if (!pPositionComponent)
     {
         // can't render without a transform
@@ -822,7 +667,7 @@ SDL_Rect HUDRenderComponent::VGetPositionRect() const
 shared_ptr<SceneNode> HUDRenderComponent::VCreateSceneNode()
 {
     shared_ptr<PositionComponent> pPositionComponent =
-        MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PositionComponent>());
     if (!pPositionComponent)
     {
         // can't render without a transform
@@ -832,7 +677,7 @@ shared_ptr<SceneNode> HUDRenderComponent::VCreateSceneNode()
     Point pos(pPositionComponent->GetX(), pPositionComponent->GetY());
     shared_ptr<SDL2HUDSceneNode> pHUDNode(new SDL2HUDSceneNode(_owner->GetGUID(), this, RenderPass_HUD, pos, IsVisible()));
 
-    shared_ptr<EventData_New_HUD_Element> pEvent(new EventData_New_HUD_Element(_owner->GetGUID(), m_HUDElementKey, pHUDNode));
+    shared_ptr<EventData_New_HUD_Element> pEvent(MakeEvent<EventData_New_HUD_Element>(_owner->GetGUID(), m_HUDElementKey, pHUDNode));
     IEventMgr::Get()->VTriggerEvent(pEvent);
 
     return pHUDNode;
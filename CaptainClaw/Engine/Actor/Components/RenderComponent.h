@@ -5,6 +5,7 @@
 #include "../ActorComponent.h"
 
 class Image;
+class LevelData;
 typedef std::map<std::string, shared_ptr<Image>> ImageMap;
 
 //=================================================================================================
@@ -45,6 +46,9 @@ protected:
 
     shared_ptr<SceneNode> m_pSceneNode;
 
+    // Lets scene know that VGetPositionRect() changed without the actor moving
+    void OnPositionRectResized();
+
 private:
     shared_ptr<SceneNode> GetSceneNode();
 };
@@ -63,6 +67,7 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const override { return g_Name; }
+    virtual ActorComponent* VClone() const override { return new ActorRenderComponent(*this); }
 
     virtual bool VDelegateInit(TiXmlElement* pXmlData) override;
 
@@ -73,7 +78,7 @@ public:
 
     void SetMirrored(bool mirrored) { m_IsMirrored = mirrored; }
 
-    inline void SetVisible(bool visible) { m_IsVisible = visible; }
+    void SetVisible(bool visible);
     inline bool IsVisible() { return m_IsVisible; }
     inline bool IsMirrored() { return m_IsMirrored; }
     inline bool IsInverted() { return m_IsInverted; }
@@ -136,14 +141,6 @@ struct TilePlaneProperties
     bool isTileAutosized;
 };
 
-// Helper struct
-struct TileInfo
-{
-    int tileId;
-    int x;
-    int y;
-};
-
 typedef std::vector<int> TileList;
 class TilePlaneRenderComponent : public BaseRenderComponent
 {
@@ -155,6 +152,10 @@ public:
 
     virtual SDL_Rect VGetPositionRect() const override;
 
+    // Returns tiles kept in level data when level was loaded directly from WWD, otherwise reads <Tile> elements
+    // into xmlTileList and returns it. NULL if the tiles are missing.
+    static const TileList* LoadTileList(TiXmlElement* pTileElements, const LevelData* pLevelData, TileList& xmlTileList);
+
     const TilePlaneProperties* const GetTilePlaneProperties() const { return &m_PlaneProperties; }
     const TileImageList* const GetTileImageList() const { return &m_TileImageList; }
 
@@ -166,8 +167,8 @@ protected:
 
 private:
     void ProcessMainPlaneTiles(const TileList& tileList);
-    TileList GetAllContinuousTiles(const TileList& tileList, int fromTileIdx);
-    TileInfo GetTileInfo(const TileList& tileList, int tileIdx);
+    // Table of tile images indexed by tile id, ids without image are NULL
+    void CreateTileImageTable(int levelNumber, std::vector<Image*>& tileImageTable) const;
 
     // Background, action, foreground
     TilePlaneRenderPosition m_RenderLocation;
@@ -199,6 +200,7 @@ public:
 
     static const char* g_Name;
     virtual const char* VGetName() const override { return g_Name; }
+    virtual ActorComponent* VClone() const override { return new HUDRenderComponent(*this); }
     virtual bool VDelegateInit(TiXmlElement* pXmlData) override;
 
     virtual SDL_Rect VGetPositionRect() const override;
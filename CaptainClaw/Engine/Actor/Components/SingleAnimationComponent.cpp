@@ -24,7 +24,7 @@ void SingleAnimationComponent::VPostInit()
 void SingleAnimationComponent::VPostPostInit()
 {
     shared_ptr<AnimationComponent> pAnimationComponent =
-        MakeStrongPtr(_owner->GetComponent<AnimationComponent>(AnimationComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<AnimationComponent>());
     assert(pAnimationComponent != nullptr);
     assert(pAnimationComponent->GetCurrentAnimation() != NULL);
     pAnimationComponent->AddObserver(this);
@@ -32,6 +32,6 @@ void SingleAnimationComponent::VPostPostInit()
 
 void SingleAnimationComponent::VOnAnimationAtLastFrame(Animation* pAnimation)
 {
-    shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+    shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
     IEventMgr::Get()->VQueueEvent(pEvent);
 }
\ No newline at end of file
@@ -37,7 +37,7 @@ bool SoundTriggerComponent::VInit(TiXmlElement* pData)
 void SoundTriggerComponent::VPostInit()
 {
     shared_ptr<TriggerComponent> pTriggerComponent =
-        MakeStrongPtr(_owner->GetComponent<TriggerComponent>(TriggerComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<TriggerComponent>());
     assert(pTriggerComponent);
 
     pTriggerComponent->AddObserver(this);
@@ -52,17 +52,17 @@ TiXmlElement* SoundTriggerComponent::VGenerateXml()
 void SoundTriggerComponent::VOnActorEnteredTrigger(Actor* pActorWhoPickedThis)
 {
     shared_ptr<ClawControllableComponent> pClaw =
-        MakeStrongPtr(pActorWhoPickedThis->GetComponent<ClawControllableComponent>(ClawControllableComponent::g_Name));
+        MakeStrongPtr(pActorWhoPickedThis->GetComponent<ClawControllableComponent>());
     assert(pClaw != nullptr);
 
-    IEventMgr::Get()->VTriggerEvent(IEventDataPtr(new EventData_Request_Play_Sound(m_TriggerSound.c_str(), 100, false)));
+    IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(m_TriggerSound.c_str(), 100, false));
 
     if (!m_bIsInfinite)
     {
         m_EnterCount--;
         if (m_EnterCount == 0)
         {
-            shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+            shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
             IEventMgr::Get()->VQueueEvent(pEvent);
         }
     }
@@ -70,7 +70,7 @@ void SoundTriggerComponent::VOnActorEnteredTrigger(Actor* pActorWhoPickedThis)
     if (m_bActivateDialog)
     {
         shared_ptr<FollowableComponent> pExclamationMark =
-            MakeStrongPtr(pActorWhoPickedThis->GetComponent<FollowableComponent>(FollowableComponent::g_Name));
+            MakeStrongPtr(pActorWhoPickedThis->GetComponent<FollowableComponent>());
         if (pExclamationMark)
         {
             pExclamationMark->Activate(2000);
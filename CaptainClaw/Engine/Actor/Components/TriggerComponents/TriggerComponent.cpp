@@ -22,7 +22,11 @@ TriggerComponent::TriggerComponent()
 
 TriggerComponent::~TriggerComponent()
 {
-    m_pPhysics->VRemoveActor(_owner->GetGUID());
+    // Prefab prototypes never have any owner
+    if (_owner)
+    {
+        m_pPhysics->VRemoveActor(_owner->GetGUID());
+    }
 }
 
 bool TriggerComponent::VInit(TiXmlElement* data)
@@ -72,7 +76,7 @@ void TriggerComponent::VPostInit()
         if (fabs(m_Size.x) < DBL_EPSILON || fabs(m_Size.y) < DBL_EPSILON)
         {
             shared_ptr<ActorRenderComponent> pRenderComponent =
-                MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>(ActorRenderComponent::g_Name));
+                MakeStrongPtr(_owner->GetComponent<ActorRenderComponent>());
             //assert(pRenderComponent);
             if (pRenderComponent == nullptr)
             {
@@ -89,7 +93,7 @@ void TriggerComponent::VPostInit()
         }
 
         shared_ptr<PositionComponent> pPositionComponent =
-            MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+            MakeStrongPtr(_owner->GetComponent<PositionComponent>());
         assert(pPositionComponent);
 
         Point physPos = Point(pPositionComponent->GetX() + offsetX, pPositionComponent->GetY() + offsetY);
@@ -122,7 +126,7 @@ void TriggerComponent::OnActorEntered(Actor* pActor)
     /*m_TriggerRemaining--;
     if (!m_IsTriggerUnlimited && (m_IsTriggerOnce || (m_TriggerRemaining <= 0)))
     {
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(_owner->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(_owner->GetGUID()));
         IEventMgr::Get()->VQueueEvent(pEvent);
     }*/
 }
@@ -143,7 +147,7 @@ SDL_Rect TriggerComponent::GetTriggerArea()
     SDL_Rect triggerArea = { 0 };
 
     shared_ptr<PositionComponent> pPositionComponent =
-        MakeStrongPtr(_owner->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(_owner->GetComponent<PositionComponent>());
     if (!pPositionComponent)
     {
         return triggerArea;
@@ -111,7 +111,7 @@ void Audio::PlayMusic(const char* musicData, size_t musicSize, bool looping)
     }
     RpcEndExcept;
 #else
-    SDL_RWops* pRWops = SDL_RWFromMem((void*)musicData, musicSize);
+    SDL_RWops* pRWops = SDL_RWFromConstMem(musicData, musicSize);
     Mix_Music* pMusic = Mix_LoadMUS_RW(pRWops, 0);
     if(!pMusic) {
         LOG_ERROR("Mix_LoadMUS_RW: " + std::string(Mix_GetError()));
@@ -227,7 +227,7 @@ int Audio::GetMusicVolume()
 
 bool Audio::PlaySound(const char* soundData, size_t soundSize, int volumePercentage, int loops)
 {
-    SDL_RWops* soundRwOps = SDL_RWFromMem((void*)soundData, soundSize);
+    SDL_RWops* soundRwOps = SDL_RWFromConstMem(soundData, soundSize);
     Mix_Chunk* soundChunk = Mix_LoadWAV_RW(soundRwOps, 1);
 
     return PlaySound(soundChunk, volumePercentage, loops);
@@ -8,6 +8,7 @@
 #include <FastDelegate/FastDelegate.h>
 
 #include "../Interfaces.h"
+#include "EventPool.h"
 
 using fastdelegate::MakeDelegate;
 
@@ -56,6 +57,10 @@ class BaseEventData : public IEventData
 public:
     explicit BaseEventData(const float timeStamp = 0.0f) : m_TimeStamp(timeStamp) { }
 
+    // Events created by plain new are pooled as well, see MakeEvent() which also pools shared_ptr's counts
+    static void* operator new(size_t size) { return EventPool::Allocate(size); }
+    static void operator delete(void* pEvent, size_t size) { EventPool::Free(pEvent, size); }
+
     // Returns the type of the event
     virtual const EventType& VGetEventType(void) const = 0;
 
@@ -70,6 +75,31 @@ private:
 };
 
 
+//---------------------------------------------------------------------------------------------------------------------
+// EventMgrFrameStats - what went through event manager during one frame
+//---------------------------------------------------------------------------------------------------------------------
+struct EventMgrFrameStats
+{
+    EventMgrFrameStats() : numTriggeredEvents(0), numQueuedEvents(0), numDeliveredEvents(0),
+        numAllocatedEvents(0), numAllocatedBytes(0), numThreadSafeEvents(0), totalThreadSafeLatencyUs(0),
+        maxThreadSafeLatencyUs(0), numDroppedThreadSafeEvents(0) { }
+
+    uint32_t numTriggeredEvents;
+    uint32_t numQueuedEvents;
+    // Listener calls
+    uint32_t numDeliveredEvents;
+    // Pooled allocations of events and their reference counts
+    uint32_t numAllocatedEvents;
+    uint32_t numAllocatedBytes;
+    // Events from other threads and how long they waited until game thread picked them up
+    uint32_t numThreadSafeEvents;
+    uint64_t totalThreadSafeLatencyUs;
+    uint32_t maxThreadSafeLatencyUs;
+    // Since start, thread safe queue was full when they were pushed
+    uint32_t numDroppedThreadSafeEvents;
+};
+
+
 //---------------------------------------------------------------------------------------------------------------------
 // IEventManager Description
 //
@@ -108,6 +138,7 @@ public:
     // Fire off event.  This uses the queue and will call the delegate function on the next call to VTick(), assuming
     // there's enough time.
     virtual bool VQueueEvent(const IEventDataPtr& pEvent) = 0;
+    // Same as VQueueEvent() but can be called from any thread. Returns false if too many events are already waiting.
     virtual bool VThreadSafeQueueEvent(const IEventDataPtr& pEvent) = 0;
 
     // Find the next-available instance of the named event type and remove it from the processing queue.  This 
@@ -126,6 +157,10 @@ public:
     // returns true if all messages ready for processing were completed, false otherwise (e.g. timeout )
     virtual bool VUpdate(unsigned long maxMillis = kINFINITE) = 0;
 
+    // Closes counters of current frame, called once per rendered frame
+    virtual void VEndFrame() = 0;
+    virtual const EventMgrFrameStats& VGetLastFrameStats() const = 0;
+
     // Getter for the main global event manager.  This is the event manager that is used by the majority of the 
     // engine, though you are free to define your own as long as you instantiate it with setAsGlobal set to false.
     // It is not valid to have more than one global event manager.
@@ -2,14 +2,198 @@
 
 #include "../SharedDefines.h"
 
+//=====================================================================================================================
+// EventRingBuffer implementation
+//=====================================================================================================================
+
+static const size_t EVENT_RING_BUFFER_INITIAL_SIZE = 64;
+
+void EventRingBuffer::PushBack(const IEventDataPtr& pEvent)
+{
+    if (m_Size == m_Buffer.size())
+    {
+        Grow();
+    }
+
+    m_Size++;
+    Back() = pEvent;
+}
+
+void EventRingBuffer::PushFront(const IEventDataPtr& pEvent)
+{
+    if (m_Size == m_Buffer.size())
+    {
+        Grow();
+    }
+
+    m_Head = (m_Head - 1) & (m_Buffer.size() - 1);
+    m_Size++;
+    Front() = pEvent;
+}
+
+void EventRingBuffer::PopFront()
+{
+    Front().reset();
+    m_Head = (m_Head + 1) & (m_Buffer.size() - 1);
+    m_Size--;
+}
+
+void EventRingBuffer::PopBack()
+{
+    Back().reset();
+    m_Size--;
+}
+
+bool EventRingBuffer::Remove(const EventType& type, bool allOfType)
+{
+    bool success = false;
+    size_t numKept = 0;
+    for (size_t idx = 0; idx < m_Size; idx++)
+    {
+        IEventDataPtr& pEvent = At(idx);
+        if ((!success || allOfType) && pEvent->VGetEventType() == type)
+        {
+            pEvent.reset();
+            success = true;
+            continue;
+        }
+
+        if (numKept != idx)
+        {
+            At(numKept) = std::move(pEvent);
+        }
+        numKept++;
+    }
+
+    m_Size = numKept;
+    return success;
+}
+
+void EventRingBuffer::Clear()
+{
+    while (!IsEmpty())
+    {
+        PopFront();
+    }
+    m_Head = 0;
+}
+
+void EventRingBuffer::Grow()
+{
+    size_t newSize = m_Buffer.empty() ? EVENT_RING_BUFFER_INITIAL_SIZE : m_Buffer.size() * 2;
+
+    std::vector<IEventDataPtr> newBuffer(newSize);
+    for (size_t idx = 0; idx < m_Size; idx++)
+    {
+        newBuffer[idx] = std::move(At(idx));
+    }
+
+    m_Buffer.swap(newBuffer);
+    m_Head = 0;
+}
+
+//=====================================================================================================================
+// EventListenerTable implementation
+//=====================================================================================================================
+
+static const uint32_t EVENT_LISTENER_TABLE_INITIAL_BITS = 8;
+
+EventListenerTable::EventListenerTable()
+{
+    Slot freeSlot = { 0, -1 };
+    m_Slots.resize(1 << EVENT_LISTENER_TABLE_INITIAL_BITS, freeSlot);
+    m_SlotShift = 32 - EVENT_LISTENER_TABLE_INITIAL_BITS;
+}
+
+uint32_t EventListenerTable::GetSlotIdx(const EventType& type) const
+{
+    // Fibonacci hashing, event types are random GUIDs but some of them differ only in a few bits
+    return ((uint32_t)type * 2654435769u) >> m_SlotShift;
+}
+
+EventListenerTable::EventListenerList* EventListenerTable::Find(const EventType& type)
+{
+    const uint32_t slotMask = m_Slots.size() - 1;
+    for (uint32_t slotIdx = GetSlotIdx(type);; slotIdx = (slotIdx + 1) & slotMask)
+    {
+        const Slot& slot = m_Slots[slotIdx];
+        if (slot.listIdx < 0)
+        {
+            return NULL;
+        }
+        if (slot.type == type)
+        {
+            return m_ListenerLists[slot.listIdx].get();
+        }
+    }
+}
+
+EventListenerTable::EventListenerList& EventListenerTable::FindOrAdd(const EventType& type)
+{
+    if (EventListenerList* pListeners = Find(type))
+    {
+        return *pListeners;
+    }
+
+    // Keep at most half of the slots used so that probe sequences stay short
+    if ((m_ListenerLists.size() + 1) * 2 > m_Slots.size())
+    {
+        Grow();
+    }
+
+    const uint32_t slotMask = m_Slots.size() - 1;
+    uint32_t slotIdx = GetSlotIdx(type);
+    while (m_Slots[slotIdx].listIdx >= 0)
+    {
+        slotIdx = (slotIdx + 1) & slotMask;
+    }
+
+    m_Slots[slotIdx].type = type;
+    m_Slots[slotIdx].listIdx = m_ListenerLists.size();
+    m_ListenerLists.push_back(std::unique_ptr<EventListenerList>(new EventListenerList()));
+
+    return *m_ListenerLists.back();
+}
+
+void EventListenerTable::Grow()
+{
+    std::vector<Slot> oldSlots;
+    oldSlots.swap(m_Slots);
+
+    Slot freeSlot = { 0, -1 };
+    m_Slots.resize(oldSlots.size() * 2, freeSlot);
+    m_SlotShift--;
+
+    const uint32_t slotMask = m_Slots.size() - 1;
+    for (const Slot& oldSlot : oldSlots)
+    {
+        if (oldSlot.listIdx < 0)
+        {
+            continue;
+        }
+
+        uint32_t slotIdx = GetSlotIdx(oldSlot.type);
+        while (m_Slots[slotIdx].listIdx >= 0)
+        {
+            slotIdx = (slotIdx + 1) & slotMask;
+        }
+        m_Slots[slotIdx] = oldSlot;
+    }
+}
+
+//=====================================================================================================================
+// EventMgr implementation
+//=====================================================================================================================
 
 //---------------------------------------------------------------------------------------------------------------------
 // EventMgr::EventMgr
 //---------------------------------------------------------------------------------------------------------------------
 EventMgr::EventMgr(const char* pName, bool setAsGlobal)
-    : IEventMgr(pName, setAsGlobal)
+    : IEventMgr(pName, setAsGlobal),
+    m_RealtimeEventQueue(EVENTMANAGER_REALTIME_QUEUE_SIZE)
 {
     m_ActiveQueue = 0;
+    m_DispatchDepth = 0;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -26,10 +210,10 @@ bool EventMgr::VAddListener(const EventListenerDelegate& eventDelegate, const Ev
 {
     //LOG_TAG("Events", "Attempting to add delegate function for event type: " + ToStr(type, 16));
 
-    EventListenerList& eventListenerList = m_EventListeners[type];  // this will find or create the entry
-    for (auto it = eventListenerList.begin(); it != eventListenerList.end(); ++it)
+    EventListenerList& eventListenerList = m_EventListeners.FindOrAdd(type);
+    for (const EventListenerDelegate& listener : eventListenerList)
     {
-        if (eventDelegate == (*it))
+        if (eventDelegate == listener)
         {
             LOG_WARNING("Attempting to double-register a delegate");
             return false;
@@ -48,52 +232,87 @@ bool EventMgr::VAddListener(const EventListenerDelegate& eventDelegate, const Ev
 bool EventMgr::VRemoveListener(const EventListenerDelegate& eventDelegate, const EventType& type)
 {
     //LOG_TAG("Events", "Attempting to remove delegate function from event type: " + ToStr(type, 16));
-    bool success = false;
 
-    auto findIt = m_EventListeners.find(type);
-    if (findIt != m_EventListeners.end())
+    EventListenerList* pListeners = m_EventListeners.Find(type);
+    if (!pListeners)
     {
-        EventListenerList& listeners = findIt->second;
-        for (auto it = listeners.begin(); it != listeners.end(); ++it)
+        return false;
+    }
+
+    for (auto it = pListeners->begin(); it != pListeners->end(); ++it)
+    {
+        if (eventDelegate == (*it))
         {
-            if (eventDelegate == (*it))
+            // Listeners can remove themselves or others while the list is being iterated
+            if (m_DispatchDepth > 0)
+            {
+                it->clear();
+                m_ListsToCompact.push_back(pListeners);
+            }
+            else
             {
-                listeners.erase(it);
-                //LOG_TAG("Events", "Successfully removed delegate function from event type: " + ToStr(type, 16));
-                success = true;
-                break;  // we don't need to continue because it should be impossible for the same delegate function to be registered for the same event more than once
+                pListeners->erase(it);
             }
+            //LOG_TAG("Events", "Successfully removed delegate function from event type: " + ToStr(type, 16));
+            return true;  // we don't need to continue because it should be impossible for the same delegate function to be registered for the same event more than once
         }
     }
 
-    return success;
+    return false;
 }
 
-
 //---------------------------------------------------------------------------------------------------------------------
-// EventMgr::VTrigger
+// EventMgr::DispatchEvent
 //---------------------------------------------------------------------------------------------------------------------
-bool EventMgr::VTriggerEvent(const IEventDataPtr& pEvent) const
+bool EventMgr::DispatchEvent(const IEventDataPtr& pEvent) const
 {
-    //LOG_TAG("Events", "Attempting to trigger event " + std::string(pEvent->GetName()));
+    EventListenerList* pListeners = m_EventListeners.Find(pEvent->VGetEventType());
+    if (!pListeners)
+    {
+        return false;
+    }
+
     bool processed = false;
 
-    auto findIt = m_EventListeners.find(pEvent->VGetEventType());
-    if (findIt != m_EventListeners.end())
+    m_DispatchDepth++;
+    // List can grow while listeners are called, it is indexed so that reallocation does not matter
+    for (size_t listenerIdx = 0; listenerIdx < pListeners->size(); listenerIdx++)
     {
-        const EventListenerList& eventListenerList = findIt->second;
-        for (EventListenerList::const_iterator it = eventListenerList.begin(); it != eventListenerList.end(); ++it)
+        EventListenerDelegate listener = (*pListeners)[listenerIdx];
+        if (!listener.empty())
         {
-            EventListenerDelegate listener = (*it);
             //LOG_TAG("Events", "Sending Event " + std::string(pEvent->GetName()) + " to delegate.");
             listener(pEvent);  // call the delegate
+            m_FrameStats.numDeliveredEvents++;
             processed = true;
         }
     }
+    m_DispatchDepth--;
+
+    if (m_DispatchDepth == 0 && !m_ListsToCompact.empty())
+    {
+        for (EventListenerList* pList : m_ListsToCompact)
+        {
+            pList->erase(std::remove_if(pList->begin(), pList->end(),
+                [](const EventListenerDelegate& listener) { return listener.empty(); }), pList->end());
+        }
+        m_ListsToCompact.clear();
+    }
 
     return processed;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+// EventMgr::VTrigger
+//---------------------------------------------------------------------------------------------------------------------
+bool EventMgr::VTriggerEvent(const IEventDataPtr& pEvent) const
+{
+    //LOG_TAG("Events", "Attempting to trigger event " + std::string(pEvent->GetName()));
+    m_FrameStats.numTriggeredEvents++;
+
+    return DispatchEvent(pEvent);
+}
+
 
 //---------------------------------------------------------------------------------------------------------------------
 // EventMgr::VQueueEvent
@@ -112,10 +331,10 @@ bool EventMgr::VQueueEvent(const IEventDataPtr& pEvent)
 
     //LOG_TAG("Events", "Attempting to queue event: " + std::string(pEvent->GetName()));
 
-    auto findIt = m_EventListeners.find(pEvent->VGetEventType());
-    if (findIt != m_EventListeners.end())
+    if (m_EventListeners.Find(pEvent->VGetEventType()))
     {
-        m_Queues[m_ActiveQueue].push_back(pEvent);
+        m_Queues[m_ActiveQueue].PushBack(pEvent);
+        m_FrameStats.numQueuedEvents++;
         //LOG_TAG("Events", "Successfully queued event: " + std::string(pEvent->GetName()));
         return true;
     }
@@ -132,8 +351,12 @@ bool EventMgr::VQueueEvent(const IEventDataPtr& pEvent)
 //---------------------------------------------------------------------------------------------------------------------
 bool EventMgr::VThreadSafeQueueEvent(const IEventDataPtr& pEvent)
 {
-    //m_RealtimeEventQueue.push(pEvent);
-    return true;
+    if (!pEvent)
+    {
+        return false;
+    }
+
+    return m_RealtimeEventQueue.TryPush(pEvent);
 }
 
 
@@ -145,31 +368,12 @@ bool EventMgr::VAbortEvent(const EventType& inType, bool allOfType)
     assert(m_ActiveQueue >= 0);
     assert(m_ActiveQueue < EVENTMANAGER_NUM_QUEUES);
 
-    bool success = false;
-    EventListenerMap::iterator findIt = m_EventListeners.find(inType);
-
-    if (findIt != m_EventListeners.end())
+    if (!m_EventListeners.Find(inType))
     {
-        EventQueue& eventQueue = m_Queues[m_ActiveQueue];
-        auto it = eventQueue.begin();
-        while (it != eventQueue.end())
-        {
-            // Removing an item from the queue will invalidate the iterator, so have it point to the next member.  All
-            // work inside this loop will be done using thisIt.
-            auto thisIt = it;
-            ++it;
-
-            if ((*thisIt)->VGetEventType() == inType)
-            {
-                eventQueue.erase(thisIt);
-                success = true;
-                if (!allOfType)
-                    break;
-            }
-        }
+        return false;
     }
 
-    return success;
+    return m_Queues[m_ActiveQueue].Remove(inType, allOfType);
 }
 
 
@@ -181,54 +385,45 @@ bool EventMgr::VUpdate(unsigned long maxMillis)
     unsigned long currMs = SDL_GetTicks();
     unsigned long maxMs = ((maxMillis == IEventMgr::kINFINITE) ? (IEventMgr::kINFINITE) : (currMs + maxMillis));
 
-    // This section added to handle events from other threads.  Check out Chapter 20.
-    /*IEventDataPtr pRealtimeEvent;
-    while (m_RealtimeEventQueue.try_pop(pRealtimeEvent))
+    // Events from other threads are processed together with events queued on this thread
+    const uint64_t counterFrequency = SDL_GetPerformanceFrequency();
+    IEventDataPtr pRealtimeEvent;
+    uint64_t pushTime = 0;
+    while (m_RealtimeEventQueue.TryPop(pRealtimeEvent, pushTime))
     {
+        uint64_t latencyUs = ((SDL_GetPerformanceCounter() - pushTime) * 1000000) / counterFrequency;
+        m_FrameStats.numThreadSafeEvents++;
+        m_FrameStats.totalThreadSafeLatencyUs += latencyUs;
+        m_FrameStats.maxThreadSafeLatencyUs = max(m_FrameStats.maxThreadSafeLatencyUs, (uint32_t)latencyUs);
+
         VQueueEvent(pRealtimeEvent);
 
-        currMs = GetTickCount();
-        if (maxMillis != IEventManager::kINFINITE)
+        currMs = SDL_GetTicks();
+        if (maxMillis != IEventMgr::kINFINITE && currMs >= maxMs)
         {
-            if (currMs >= maxMs)
-            {
-                GCC_ERROR("A realtime process is spamming the event manager!");
-            }
+            // Rest stays in the queue for the next update
+            LOG_ERROR("A realtime process is spamming the event manager!");
+            break;
         }
-    }*/
+    }
 
     // swap active queues and clear the new queue after the swap
     int queueToProcess = m_ActiveQueue;
     m_ActiveQueue = (m_ActiveQueue + 1) % EVENTMANAGER_NUM_QUEUES;
-    m_Queues[m_ActiveQueue].clear();
+    m_Queues[m_ActiveQueue].Clear();
 
-    //LOG_TAG("EventLoop", "Processing Event Queue " + ToStr(queueToProcess) + "; " + ToStr((unsigned long)m_Queues[queueToProcess].size()) + " events to process");
+    //LOG_TAG("EventLoop", "Processing Event Queue " + ToStr(queueToProcess) + "; " + ToStr((unsigned long)m_Queues[queueToProcess].GetSize()) + " events to process");
 
     // Process the queue
-    while (!m_Queues[queueToProcess].empty())
+    while (!m_Queues[queueToProcess].IsEmpty())
     {
         // pop the front of the queue
-        IEventDataPtr pEvent = m_Queues[queueToProcess].front();
-        m_Queues[queueToProcess].pop_front();
+        IEventDataPtr pEvent = std::move(m_Queues[queueToProcess].Front());
+        m_Queues[queueToProcess].PopFront();
         //LOG_TAG("EventLoop", "\t\tProcessing Event " + std::string(pEvent->GetName()));
 
-        const EventType& eventType = pEvent->VGetEventType();
-
-        // find all the delegate functions registered for this event
-        auto findIt = m_EventListeners.find(eventType);
-        if (findIt != m_EventListeners.end())
-        {
-            const EventListenerList& eventListeners = findIt->second;
-            //LOG_TAG("EventLoop", "\t\tFound " + ToStr((unsigned long)eventListeners.size()) + " delegates");
-
-            // call each listener
-            for (auto it = eventListeners.begin(); it != eventListeners.end(); ++it)
-            {
-                EventListenerDelegate listener = (*it);
-                //LOG_TAG("EventLoop", "\t\tSending event " + std::string(pEvent->GetName()) + " to delegate");
-                listener(pEvent);
-            }
-        }
+        // call each delegate function registered for this event
+        DispatchEvent(pEvent);
 
         // check to see if time ran out
         currMs = SDL_GetTicks();
@@ -241,17 +436,30 @@ bool EventMgr::VUpdate(unsigned long maxMillis)
 
     // If we couldn't process all of the events, push the remaining events to the new active queue.
     // Note: To preserve sequencing, go back-to-front, inserting them at the head of the active queue
-    bool queueFlushed = (m_Queues[queueToProcess].empty());
+    bool queueFlushed = (m_Queues[queueToProcess].IsEmpty());
     if (!queueFlushed)
     {
-        while (!m_Queues[queueToProcess].empty())
+        while (!m_Queues[queueToProcess].IsEmpty())
         {
-            IEventDataPtr pEvent = m_Queues[queueToProcess].back();
-            m_Queues[queueToProcess].pop_back();
-            m_Queues[m_ActiveQueue].push_front(pEvent);
+            m_Queues[m_ActiveQueue].PushFront(m_Queues[queueToProcess].Back());
+            m_Queues[queueToProcess].PopBack();
         }
     }
 
     return queueFlushed;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+// EventMgr::VEndFrame
+//---------------------------------------------------------------------------------------------------------------------
+void EventMgr::VEndFrame()
+{
+    EventPool::Stats poolStats = EventPool::GetStats();
+    m_FrameStats.numAllocatedEvents = poolStats.numFrameAllocations;
+    m_FrameStats.numAllocatedBytes = poolStats.numFrameAllocatedBytes;
+    EventPool::ResetFrameStats();
+    m_FrameStats.numDroppedThreadSafeEvents = m_RealtimeEventQueue.GetNumDroppedEvents();
+
+    m_LastFrameStats = m_FrameStats;
+    m_FrameStats = EventMgrFrameStats();
+}
@@ -1,12 +1,87 @@
 #ifndef __EVENTMGRIMPL_H__
 #define __EVENTMGRIMPL_H__
 
-#include <map>
-#include <list>
+#include <assert.h>
+#include <vector>
+#include <memory>
 
 #include "EventMgr.h"
+#include "ThreadSafeEventQueue.h"
 
 const unsigned int EVENTMANAGER_NUM_QUEUES = 2;
+// Events from other threads which can wait for the game thread at once
+const unsigned int EVENTMANAGER_REALTIME_QUEUE_SIZE = 4096;
+
+//---------------------------------------------------------------------------------------------------------------------
+// EventRingBuffer
+//
+// Queue of events kept in one contiguous circular buffer. Buffer only grows, once it is big enough for the busiest
+// frame queueing events does not allocate.
+//---------------------------------------------------------------------------------------------------------------------
+class EventRingBuffer
+{
+public:
+    EventRingBuffer() : m_Head(0), m_Size(0) { }
+
+    bool IsEmpty() const { return m_Size == 0; }
+    size_t GetSize() const { return m_Size; }
+
+    IEventDataPtr& Front() { assert(m_Size > 0); return m_Buffer[m_Head]; }
+    IEventDataPtr& Back() { assert(m_Size > 0); return At(m_Size - 1); }
+    IEventDataPtr& At(size_t idx) { return m_Buffer[(m_Head + idx) & (m_Buffer.size() - 1)]; }
+
+    void PushBack(const IEventDataPtr& pEvent);
+    void PushFront(const IEventDataPtr& pEvent);
+    void PopFront();
+    void PopBack();
+
+    // Removes first or all events of given type keeping order of the rest, returns true if any was removed
+    bool Remove(const EventType& type, bool allOfType);
+    void Clear();
+
+private:
+    void Grow();
+
+    // Size is always power of two
+    std::vector<IEventDataPtr> m_Buffer;
+    size_t m_Head;
+    size_t m_Size;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+// EventListenerTable
+//
+// Flat open addressing table from event type to its listeners. Event types are hashed straight into the slot array,
+// so finding listeners is one multiplication and usually one load. Listener lists never move in memory, they can be
+// safely iterated while listeners register new event types.
+//---------------------------------------------------------------------------------------------------------------------
+class EventListenerTable
+{
+public:
+    typedef std::vector<EventListenerDelegate> EventListenerList;
+
+    EventListenerTable();
+
+    // Returns NULL if nothing ever listened to this type
+    EventListenerList* Find(const EventType& type);
+    EventListenerList& FindOrAdd(const EventType& type);
+
+private:
+    struct Slot
+    {
+        EventType type;
+        // Index to m_ListenerLists, -1 if slot is free
+        int32_t listIdx;
+    };
+
+    uint32_t GetSlotIdx(const EventType& type) const;
+    void Grow();
+
+    std::vector<Slot> m_Slots;
+    uint32_t m_SlotShift;
+    // Lists are allocated one by one so that growing this vector does not move them
+    std::vector<std::unique_ptr<EventListenerList>> m_ListenerLists;
+};
 
 class EventMgr : public IEventMgr
 {
@@ -24,16 +99,28 @@ public:
 
     virtual bool VUpdate(unsigned long maxMilis = kINFINITE);
 
+    virtual void VEndFrame();
+    virtual const EventMgrFrameStats& VGetLastFrameStats() const { return m_LastFrameStats; }
+
 private:
-    typedef std::list<EventListenerDelegate> EventListenerList;
-    typedef std::map<EventType, EventListenerList> EventListenerMap;
-    typedef std::list<IEventDataPtr> EventQueue;
+    typedef EventListenerTable::EventListenerList EventListenerList;
 
-    EventListenerMap m_EventListeners;
-    EventQueue m_Queues[EVENTMANAGER_NUM_QUEUES];
+    // Calls all listeners of event's type, returns true if there was any
+    bool DispatchEvent(const IEventDataPtr& pEvent) const;
+
+    // Dispatching is const but listeners removed while it runs are only cleared and the lists are
+    // compacted once the outermost dispatch returns
+    mutable EventListenerTable m_EventListeners;
+    mutable std::vector<EventListenerList*> m_ListsToCompact;
+    mutable uint32_t m_DispatchDepth;
+
+    EventRingBuffer m_Queues[EVENTMANAGER_NUM_QUEUES];
     int m_ActiveQueue;  // index of actively processing queue; events enque to the opposing queue
 
-    //ThreadSafeEventQueue m_realtimeEventQueue;
+    mutable EventMgrFrameStats m_FrameStats;
+    EventMgrFrameStats m_LastFrameStats;
+
+    ThreadSafeEventQueue m_RealtimeEventQueue;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,117 @@
+#include <SDL2/SDL.h>
+
+#include "EventPool.h"
+#include "../SharedDefines.h"
+
+// Block sizes are multiples of this which also keeps every block 16 byte aligned
+static const size_t EVENT_POOL_GRANULARITY = 16;
+// Bigger allocations are rare and go straight to the heap
+static const size_t EVENT_POOL_MAX_BLOCK_SIZE = 256;
+static const size_t EVENT_POOL_CHUNK_SIZE = 16 * 1024;
+static const size_t EVENT_POOL_NUM_SIZE_CLASSES = EVENT_POOL_MAX_BLOCK_SIZE / EVENT_POOL_GRANULARITY;
+
+struct FreeBlock
+{
+    FreeBlock* pNext;
+};
+
+static SDL_SpinLock s_PoolLock = 0;
+// Chunks are never released, events can still be destroyed during static destruction
+static FreeBlock* s_FreeLists[EVENT_POOL_NUM_SIZE_CLASSES] = { NULL };
+static EventPool::Stats s_Stats = { 0, 0, 0, 0 };
+
+static size_t GetSizeClass(size_t size)
+{
+    return (size + EVENT_POOL_GRANULARITY - 1) / EVENT_POOL_GRANULARITY - 1;
+}
+
+// Has to be called with s_PoolLock held
+static void AddChunk(size_t sizeClass)
+{
+    size_t blockSize = (sizeClass + 1) * EVENT_POOL_GRANULARITY;
+    size_t numBlocks = EVENT_POOL_CHUNK_SIZE / blockSize;
+
+    char* pChunk = static_cast<char*>(::operator new(numBlocks * blockSize));
+    for (size_t blockIdx = 0; blockIdx < numBlocks; blockIdx++)
+    {
+        FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(pChunk + blockIdx * blockSize);
+        pBlock->pNext = s_FreeLists[sizeClass];
+        s_FreeLists[sizeClass] = pBlock;
+    }
+
+    s_Stats.numReservedBytes += numBlocks * blockSize;
+}
+
+void* EventPool::Allocate(size_t size)
+{
+    assert(size > 0);
+
+    SDL_AtomicLock(&s_PoolLock);
+
+    s_Stats.numFrameAllocations++;
+    s_Stats.numFrameAllocatedBytes += size;
+    s_Stats.numBlocksInUse++;
+
+    if (size > EVENT_POOL_MAX_BLOCK_SIZE)
+    {
+        SDL_AtomicUnlock(&s_PoolLock);
+        return ::operator new(size);
+    }
+
+    size_t sizeClass = GetSizeClass(size);
+    if (!s_FreeLists[sizeClass])
+    {
+        AddChunk(sizeClass);
+    }
+
+    FreeBlock* pBlock = s_FreeLists[sizeClass];
+    s_FreeLists[sizeClass] = pBlock->pNext;
+
+    SDL_AtomicUnlock(&s_PoolLock);
+
+    return pBlock;
+}
+
+void EventPool::Free(void* pBlock, size_t size)
+{
+    if (!pBlock)
+    {
+        return;
+    }
+
+    SDL_AtomicLock(&s_PoolLock);
+
+    assert(s_Stats.numBlocksInUse > 0);
+    s_Stats.numBlocksInUse--;
+
+    if (size > EVENT_POOL_MAX_BLOCK_SIZE)
+    {
+        SDL_AtomicUnlock(&s_PoolLock);
+        ::operator delete(pBlock);
+        return;
+    }
+
+    size_t sizeClass = GetSizeClass(size);
+    FreeBlock* pFreeBlock = static_cast<FreeBlock*>(pBlock);
+    pFreeBlock->pNext = s_FreeLists[sizeClass];
+    s_FreeLists[sizeClass] = pFreeBlock;
+
+    SDL_AtomicUnlock(&s_PoolLock);
+}
+
+EventPool::Stats EventPool::GetStats()
+{
+    SDL_AtomicLock(&s_PoolLock);
+    Stats stats = s_Stats;
+    SDL_AtomicUnlock(&s_PoolLock);
+
+    return stats;
+}
+
+void EventPool::ResetFrameStats()
+{
+    SDL_AtomicLock(&s_PoolLock);
+    s_Stats.numFrameAllocations = 0;
+    s_Stats.numFrameAllocatedBytes = 0;
+    SDL_AtomicUnlock(&s_PoolLock);
+}
@@ -0,0 +1,64 @@
+#ifndef __EVENTPOOL_H__
+#define __EVENTPOOL_H__
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+//---------------------------------------------------------------------------------------------------------------------
+// EventPool
+//
+// Allocates events from free lists of fixed size blocks, one list per 16 byte size class, so events of the same type
+// always reuse blocks of each other. Blocks are carved from larger chunks which are kept for the whole run, after
+// first few frames creating and destroying events does not touch the heap at all. Safe to use from any thread.
+//---------------------------------------------------------------------------------------------------------------------
+namespace EventPool
+{
+    struct Stats
+    {
+        // Since last ResetFrameStats()
+        uint32_t numFrameAllocations;
+        uint32_t numFrameAllocatedBytes;
+
+        uint32_t numBlocksInUse;
+        uint32_t numReservedBytes;
+    };
+
+    void* Allocate(size_t size);
+    void Free(void* pBlock, size_t size);
+
+    Stats GetStats();
+    void ResetFrameStats();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// EventPoolAllocator - lets std::allocate_shared place event together with its reference counts into one pooled block
+//---------------------------------------------------------------------------------------------------------------------
+template <class T>
+class EventPoolAllocator
+{
+public:
+    typedef T value_type;
+
+    EventPoolAllocator() { }
+    template <class U> EventPoolAllocator(const EventPoolAllocator<U>&) { }
+
+    T* allocate(size_t count) { return static_cast<T*>(EventPool::Allocate(count * sizeof(T))); }
+    void deallocate(T* pBlock, size_t count) { EventPool::Free(pBlock, count * sizeof(T)); }
+};
+
+template <class T, class U>
+bool operator==(const EventPoolAllocator<T>&, const EventPoolAllocator<U>&) { return true; }
+
+template <class T, class U>
+bool operator!=(const EventPoolAllocator<T>&, const EventPoolAllocator<U>&) { return false; }
+
+// Creates pooled event, use instead of shared_ptr<EventData_X>(new EventData_X(...))
+template <class EventClass, class... Args>
+std::shared_ptr<EventClass> MakeEvent(Args&&... args)
+{
+    return std::allocate_shared<EventClass>(EventPoolAllocator<EventClass>(), std::forward<Args>(args)...);
+}
+
+#endif
@@ -7,6 +7,7 @@ const EventType EventData_Environment_Loaded::sk_EventType(0xa3814acd);
 const EventType EventData_Remote_Environment_Loaded::sk_EventType(0x8E2AD6E6);
 const EventType EventData_New_Actor::sk_EventType(0xe86c7c31);
 const EventType EventData_Move_Actor::sk_EventType(0xeeaa0a40);
+const EventType EventData_Move_Actors_Batch::sk_EventType(0x3b7e51d2);
 const EventType EventData_Destroy_Actor::sk_EventType(0x77dd2b3a);
 const EventType EventData_New_Render_Component::sk_EventType(0xaf4aff75);
 const EventType EventData_Modified_Render_Component::sk_EventType(0x80fe9766);
@@ -20,7 +21,7 @@ const EventType EventData_Request_New_Actor::sk_EventType(0x40378c64);
 //const EventType EventData_Request_Destroy_Actor::sk_EventType(0xf5395770);
 const EventType EventData_PlaySound::sk_EventType(0x3d8118ee);
 const EventType EventData_Attach_Actor::sk_EventType(0x3dac18ee);
-const EventType EventData_Collideable_Tile_Created::sk_EventType(0x8cac18ee);
+const EventType EventData_Collideable_Tile_Plane_Created::sk_EventType(0x8cad18ee);
 const EventType EventData_Start_Climb::sk_EventType(0x8bab18ee);
 const EventType EventData_Actor_Fire::sk_EventType(0x123418ee);
 const EventType EventData_Actor_Attack::sk_EventType(0x567818ee);
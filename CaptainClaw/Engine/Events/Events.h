@@ -98,7 +98,7 @@ public:
 
     virtual IEventDataPtr VCopy(void) const
     {
-        return IEventDataPtr(new EventData_New_Actor(m_ActorId, m_ViewId));
+        return MakeEvent<EventData_New_Actor>(m_ActorId, m_ViewId);
     }
 
     virtual const char* GetName(void) const
@@ -143,7 +143,7 @@ public:
 
     virtual IEventDataPtr VCopy(void) const
     {
-        return IEventDataPtr(new EventData_Destroy_Actor(m_Id));
+        return MakeEvent<EventData_Destroy_Actor>(m_Id);
     }
 
     virtual void VSerialize(std::ostringstream &out) const
@@ -208,7 +208,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Move_Actor(m_Id, m_Move));
+        return MakeEvent<EventData_Move_Actor>(m_Id, m_Move);
     }
 
     virtual const char* GetName(void) const
@@ -231,6 +231,90 @@ private:
     Point m_Move;
 };
 
+//---------------------------------------------------------------------------------------------------------------------
+// EventData_Move_Actors_Batch - sent once per physics sync with all actors moved by physics
+//---------------------------------------------------------------------------------------------------------------------
+struct ActorMove
+{
+    ActorMove() : actorId(INVALID_ACTOR_ID) { }
+    ActorMove(uint32_t id, const Point& move) : actorId(id), move(move) { }
+
+    uint32_t actorId;
+    Point move;
+};
+
+typedef std::vector<ActorMove> ActorMoveList;
+
+class EventData_Move_Actors_Batch : public BaseEventData
+{
+public:
+    static const EventType sk_EventType;
+
+    virtual const EventType& VGetEventType(void) const
+    {
+        return sk_EventType;
+    }
+
+    EventData_Move_Actors_Batch(void)
+    {
+        //
+    }
+
+    // Takes content of given list, sender can get its storage back by SwapMoves()
+    explicit EventData_Move_Actors_Batch(ActorMoveList& moves)
+    {
+        m_Moves.swap(moves);
+    }
+
+    virtual void VSerialize(std::ostringstream &out) const
+    {
+        out << m_Moves.size() << " ";
+        for (const ActorMove& actorMove : m_Moves)
+        {
+            out << actorMove.actorId << " ";
+            out << actorMove.move.x << " ";
+            out << actorMove.move.y << " ";
+        }
+    }
+
+    virtual void VDeserialize(std::istringstream& in)
+    {
+        size_t numMoves = 0;
+        in >> numMoves;
+        m_Moves.resize(numMoves);
+        for (ActorMove& actorMove : m_Moves)
+        {
+            in >> actorMove.actorId;
+            in >> actorMove.move.x;
+            in >> actorMove.move.y;
+        }
+    }
+
+    virtual IEventDataPtr VCopy() const
+    {
+        ActorMoveList moves(m_Moves);
+        return MakeEvent<EventData_Move_Actors_Batch>(moves);
+    }
+
+    virtual const char* GetName(void) const
+    {
+        return "EventData_Move_Actors_Batch";
+    }
+
+    const ActorMoveList& GetMoves(void) const
+    {
+        return m_Moves;
+    }
+
+    void SwapMoves(ActorMoveList& moves)
+    {
+        m_Moves.swap(moves);
+    }
+
+private:
+    ActorMoveList m_Moves;
+};
+
 
 //---------------------------------------------------------------------------------------------------------------------
 // EventData_New_Render_Component - This event is sent out when an actor is *actually* created.
@@ -268,7 +352,7 @@ public:
 
     virtual IEventDataPtr VCopy(void) const
     {
-        return IEventDataPtr(new EventData_New_Render_Component(m_ActorId, m_pSceneNode));
+        return MakeEvent<EventData_New_Render_Component>(m_ActorId, m_pSceneNode);
     }
 
     virtual const char* GetName(void) const
@@ -327,7 +411,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Modified_Render_Component(m_ActorId));
+        return MakeEvent<EventData_Modified_Render_Component>(m_ActorId);
     }
 
     virtual const char* GetName(void) const
@@ -358,7 +442,7 @@ public:
     virtual const EventType& VGetEventType(void) const	{ return sk_EventType; }
     virtual IEventDataPtr VCopy(void) const
     {
-        return IEventDataPtr(new EventData_Environment_Loaded());
+        return MakeEvent<EventData_Environment_Loaded>();
     }
     virtual const char* GetName(void) const  { return "EventData_Environment_Loaded"; }
 };
@@ -383,7 +467,7 @@ public:
     virtual const EventType& VGetEventType(void) const	{ return sk_EventType; }
     virtual IEventDataPtr VCopy(void) const
     {
-        return IEventDataPtr(new EventData_Remote_Environment_Loaded());
+        return MakeEvent<EventData_Remote_Environment_Loaded>();
     }
     virtual const char* GetName(void) const  { return "EventData_Remote_Environment_Loaded"; }
 };
@@ -407,7 +491,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Request_Start_Game());
+        return MakeEvent<EventData_Request_Start_Game>();
     }
 
     virtual const char* GetName(void) const
@@ -446,7 +530,7 @@ return sk_EventType;
 
 virtual IEventDataPtr VCopy() const
 {
-return IEventDataPtr( new EventData_Game_State( m_gameState, m_parameter ) );
+return MakeEvent<EventData_Game_State>( m_gameState, m_parameter );
 }
 
 virtual void VSerialize(std::ostringstream &out) const
@@ -510,7 +594,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Remote_Client(m_SocketId, m_IpAddress));
+        return MakeEvent<EventData_Remote_Client>(m_SocketId, m_IpAddress);
     }
 
     virtual const char* GetName(void) const
@@ -566,7 +650,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Update_Tick(m_DeltaMilliseconds));
+        return MakeEvent<EventData_Update_Tick>(m_DeltaMilliseconds);
     }
 
     virtual void VSerialize(std::ostringstream & out)
@@ -611,7 +695,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Network_Player_Actor_Assignment(m_ActorId, m_SocketId));
+        return MakeEvent<EventData_Network_Player_Actor_Assignment>(m_ActorId, m_SocketId);
     }
 
     virtual const char* GetName(void) const
@@ -669,7 +753,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Decompress_Request(m_ResourceFileName, m_FileName));
+        return MakeEvent<EventData_Decompress_Request>(m_ResourceFileName, m_FileName);
     }
 
     virtual void VSerialize(std::ostringstream & out)
@@ -720,7 +804,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Decompression_Progress(m_Progress, m_ResourceFileName, m_FileName, m_pBuffer));
+        return MakeEvent<EventData_Decompression_Progress>(m_Progress, m_ResourceFileName, m_FileName, m_pBuffer);
     }
 
     virtual void VSerialize(std::ostringstream & out)
@@ -796,7 +880,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Request_New_Actor(m_ActorResource, (m_HasInitialPosition) ? &m_InitialPosition : NULL, m_ServerActorId, m_ViewId));
+        return MakeEvent<EventData_Request_New_Actor>(m_ActorResource, (m_HasInitialPosition) ? &m_InitialPosition : NULL, m_ServerActorId, m_ViewId);
     }
 
     virtual void VSerialize(std::ostringstream & out) const
@@ -861,7 +945,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Request_Destroy_Actor(m_ActorId));
+        return MakeEvent<EventData_Request_Destroy_Actor>(m_ActorId);
     }
 
     virtual void VSerialize(std::ostringstream & out) const
@@ -912,7 +996,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_PlaySound(m_SoundResource));
+        return MakeEvent<EventData_PlaySound>(m_SoundResource);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -970,7 +1054,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Attach_Actor(m_ActorId));
+        return MakeEvent<EventData_Attach_Actor>(m_ActorId);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1000,73 +1084,69 @@ private:
 };
 
 //---------------------------------------------------------------------------------------------------------------------
-// EventData_Collideable_Tile_Created - sent when collidable tile has been created
+// EventData_Collideable_Tile_Plane_Created - sent once with all tiles of the plane which has collisions, its collision
+//    geometry is then built for the whole plane at once instead of tile by tile
 //---------------------------------------------------------------------------------------------------------------------
-class EventData_Collideable_Tile_Created : public BaseEventData
+class EventData_Collideable_Tile_Plane_Created : public BaseEventData
 {
 public:
     static const EventType sk_EventType;
 
-    EventData_Collideable_Tile_Created(void)
+    EventData_Collideable_Tile_Plane_Created(void)
     {
-        m_TileId = -1;
-        m_PositionX = 0;
-        m_PositionY = 0;
+        m_TilesOnAxisX = 0;
+        m_TilesOnAxisY = 0;
+        m_TileWidth = 0;
+        m_TileHeight = 0;
     }
 
-    EventData_Collideable_Tile_Created(int32 tileId, int32 positionX, int32 positionY)
+    EventData_Collideable_Tile_Plane_Created(const std::vector<int32>& tiles, int32 tilesOnAxisX, int32 tilesOnAxisY, int32 tileWidth, int32 tileHeight)
     {
-        m_TileId = tileId;
-        m_PositionX = positionX;
-        m_PositionY = positionY;
-    }
-
-    virtual const EventType& VGetEventType(void) const
-    {
-        return sk_EventType;
+        m_Tiles = tiles;
+        m_TilesOnAxisX = tilesOnAxisX;
+        m_TilesOnAxisY = tilesOnAxisY;
+        m_TileWidth = tileWidth;
+        m_TileHeight = tileHeight;
     }
 
+    virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Collideable_Tile_Created(m_TileId, m_PositionX, m_PositionY));
+        return MakeEvent<EventData_Collideable_Tile_Plane_Created>(m_Tiles, m_TilesOnAxisX, m_TilesOnAxisY, m_TileWidth, m_TileHeight);
     }
-
     virtual void VSerialize(std::ostringstream& out) const
     {
-        out << m_TileId << " " << m_PositionX << " " << m_PositionY;
+        out << m_TilesOnAxisX << " " << m_TilesOnAxisY << " " << m_TileWidth << " " << m_TileHeight;
+        for (int32 tileId : m_Tiles)
+        {
+            out << " " << tileId;
+        }
     }
-
     virtual void VDeserialize(std::istringstream& in)
     {
-        in >> m_TileId >> m_PositionX >> m_PositionY;
-    }
-
-    int32 GetTileId(void) const
-    {
-        return m_TileId;
-    }
-
-    int32 GetPositionX(void) const
-    {
-        return m_PositionX;
+        in >> m_TilesOnAxisX >> m_TilesOnAxisY >> m_TileWidth >> m_TileHeight;
+        m_Tiles.resize(m_TilesOnAxisX * m_TilesOnAxisY);
+        for (int32& tileId : m_Tiles)
+        {
+            in >> tileId;
+        }
     }
 
-    int32 GetPositionY(void) const
-    {
-        return m_PositionY;
-    }
+    // Row by row, -1 is empty tile
+    const std::vector<int32>& GetTiles() const { return m_Tiles; }
+    int32 GetTilesOnAxisX() const { return m_TilesOnAxisX; }
+    int32 GetTilesOnAxisY() const { return m_TilesOnAxisY; }
+    int32 GetTileWidth() const { return m_TileWidth; }
+    int32 GetTileHeight() const { return m_TileHeight; }
 
-    virtual const char* GetName(void) const
-    {
-        return "EventData_Collideable_Tile_Created";
-    }
-
-    //virtual bool VBuildEventFromScript(void);
+    virtual const char* GetName(void) const { return "EventData_Collideable_Tile_Plane_Created"; }
 
 private:
-    int32 m_TileId;
-    int32 m_PositionX;
-    int32 m_PositionY;
+    std::vector<int32> m_Tiles;
+    int32 m_TilesOnAxisX;
+    int32 m_TilesOnAxisY;
+    int32 m_TileWidth;
+    int32 m_TileHeight;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1087,7 +1167,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Add_Static_Geometry(m_Position, m_Size, m_CollisionType));
+        return MakeEvent<EventData_Add_Static_Geometry>(m_Position, m_Size, m_CollisionType);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_Position.x << m_Position.y << m_Size.x << m_Size.y << (int)m_CollisionType; }
     virtual void VDeserialize(std::istringstream& in) { /* TODO: in >> m_Position.x >> m_Position.y >> m_Size.x >> m_Size.y >> (int)(m_CollisionType);*/ }
@@ -1131,7 +1211,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Start_Climb(m_ActorId, m_ClimbMovement));
+        return MakeEvent<EventData_Start_Climb>(m_ActorId, m_ClimbMovement);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1191,7 +1271,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Actor_Fire(m_ActorId));
+        return MakeEvent<EventData_Actor_Fire>(m_ActorId);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1243,7 +1323,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Actor_Attack(m_ActorId));
+        return MakeEvent<EventData_Actor_Attack>(m_ActorId);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1297,7 +1377,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_New_HUD_Element(m_ActorId, m_pKey, m_pHUDSceneNode));
+        return MakeEvent<EventData_New_HUD_Element>(m_ActorId, m_pKey, m_pHUDSceneNode);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1352,7 +1432,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Modify_Player_Stat(m_ActorId, PlayerStat(m_Stat), m_Value, m_AddToExistingStat));
+        return MakeEvent<EventData_Modify_Player_Stat>(m_ActorId, PlayerStat(m_Stat), m_Value, m_AddToExistingStat);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_ActorId << m_Stat << m_Value << m_AddToExistingStat; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_ActorId >> m_Stat >> m_Value >> m_AddToExistingStat; }
@@ -1393,7 +1473,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Updated_Score(m_ActorId, m_OldScore, m_NewScore, m_IsInitialScore));
+        return MakeEvent<EventData_Updated_Score>(m_ActorId, m_OldScore, m_NewScore, m_IsInitialScore);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1465,7 +1545,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_New_Life(m_ActorId, m_NumNewLives));
+        return MakeEvent<EventData_New_Life>(m_ActorId, m_NumNewLives);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1525,7 +1605,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Updated_Lives(m_OldLivesCount, m_NewLivesCount, m_IsInitialLives));
+        return MakeEvent<EventData_Updated_Lives>(m_OldLivesCount, m_NewLivesCount, m_IsInitialLives);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1586,7 +1666,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Updated_Health(m_OldHealth, m_NewHealth, m_IsInitialHealth));
+        return MakeEvent<EventData_Updated_Health>(m_OldHealth, m_NewHealth, m_IsInitialHealth);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1646,7 +1726,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Updated_Ammo(m_AmmoType, m_AmmoCount));
+        return MakeEvent<EventData_Updated_Ammo>(m_AmmoType, m_AmmoCount);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1700,7 +1780,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Request_Change_Ammo_Type(m_ActorId, m_AmmoType));
+        return MakeEvent<EventData_Request_Change_Ammo_Type>(m_ActorId, m_AmmoType);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1754,7 +1834,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Updated_Ammo_Type(m_ActorId, m_AmmoType));
+        return MakeEvent<EventData_Updated_Ammo_Type>(m_ActorId, m_AmmoType);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1809,7 +1889,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Teleport_Actor(m_ActorId, m_Destination, m_bHasScreenSfx));
+        return MakeEvent<EventData_Teleport_Actor>(m_ActorId, m_Destination, m_bHasScreenSfx);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1877,7 +1957,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Updated_Powerup_Time(m_ActorId, m_PowerupType, m_SecondsRemaining));
+        return MakeEvent<EventData_Updated_Powerup_Time>(m_ActorId, m_PowerupType, m_SecondsRemaining);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -1945,7 +2025,7 @@ public:
 
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Updated_Powerup_Status(m_ActorId, PowerupType(m_PowerupType), m_IsPowerupFinished));
+        return MakeEvent<EventData_Updated_Powerup_Status>(m_ActorId, PowerupType(m_PowerupType), m_IsPowerupFinished);
     }
 
     virtual void VSerialize(std::ostringstream& out) const
@@ -2000,7 +2080,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Checkpoint_Reached(m_ActorId, m_SpawnPoint, m_IsSaveCheckpoint, m_SaveCheckpointNumber));
+        return MakeEvent<EventData_Checkpoint_Reached>(m_ActorId, m_SpawnPoint, m_IsSaveCheckpoint, m_SaveCheckpointNumber);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_ActorId << m_SpawnPoint.x << m_SpawnPoint.y << m_IsSaveCheckpoint << m_SaveCheckpointNumber; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_ActorId >> m_SpawnPoint.x >> m_SpawnPoint.y >> m_IsSaveCheckpoint >> m_SaveCheckpointNumber; }
@@ -2035,7 +2115,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Claw_Died(m_ActorId, m_DeathPosition));
+        return MakeEvent<EventData_Claw_Died>(m_ActorId, m_DeathPosition);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_ActorId << m_DeathPosition.x << m_DeathPosition.y; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_ActorId >> m_DeathPosition.x >> m_DeathPosition.y; }
@@ -2068,7 +2148,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Request_Play_Sound(m_MusicPath, m_Volume, m_bIsMusic, m_Loops));
+        return MakeEvent<EventData_Request_Play_Sound>(m_MusicPath, m_Volume, m_bIsMusic, m_Loops);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_MusicPath << m_Volume << m_bIsMusic << m_Loops; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_MusicPath >> m_Volume >> m_bIsMusic >> m_Loops; }
@@ -2098,7 +2178,7 @@ public:
     EventData_Request_Reset_Level() { }
 
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
-    virtual IEventDataPtr VCopy() const { return IEventDataPtr(new EventData_Request_Reset_Level()); }
+    virtual IEventDataPtr VCopy() const { return MakeEvent<EventData_Request_Reset_Level>(); }
     virtual void VSerialize(std::ostringstream& out) const { assert(false && "This event CANNOT be serialized"); }
     virtual void VDeserialize(std::istringstream& in) { assert(false && "This event CANNOT be deserialized"); }
 
@@ -2126,7 +2206,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Menu_SwitchPage(m_NewPageName));
+        return MakeEvent<EventData_Menu_SwitchPage>(m_NewPageName);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_NewPageName; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_NewPageName; }
@@ -2161,7 +2241,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Menu_Modifiy_Item_Visibility(m_MenuItemName, m_bVisible));
+        return MakeEvent<EventData_Menu_Modifiy_Item_Visibility>(m_MenuItemName, m_bVisible);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_MenuItemName << m_bVisible; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_MenuItemName >> m_bVisible; }
@@ -2198,7 +2278,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Menu_Modify_Item_State(m_MenuItemName, m_MenuItemStateStr));
+        return MakeEvent<EventData_Menu_Modify_Item_State>(m_MenuItemName, m_MenuItemStateStr);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_MenuItemName << m_MenuItemStateStr; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_MenuItemName >> m_MenuItemStateStr; }
@@ -2238,7 +2318,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Menu_LoadGame(m_LevelNumber, m_bIsNewGame, m_CheckpointNumber));
+        return MakeEvent<EventData_Menu_LoadGame>(m_LevelNumber, m_bIsNewGame, m_CheckpointNumber);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_LevelNumber << m_bIsNewGame << m_CheckpointNumber; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_LevelNumber >> m_bIsNewGame >> m_CheckpointNumber; }
@@ -2266,7 +2346,7 @@ public:
     EventData_Quit_Game() { }
 
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
-    virtual IEventDataPtr VCopy() const { return IEventDataPtr(new EventData_Request_Reset_Level()); }
+    virtual IEventDataPtr VCopy() const { return MakeEvent<EventData_Request_Reset_Level>(); }
     virtual void VSerialize(std::ostringstream& out) const { assert(false && "This event CANNOT be serialized"); }
     virtual void VDeserialize(std::istringstream& in) { assert(false && "This event CANNOT be deserialized"); }
 
@@ -2298,7 +2378,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Set_Volume(m_Volume, m_bIsDelta, m_bIsMusicVolume));
+        return MakeEvent<EventData_Set_Volume>(m_Volume, m_bIsDelta, m_bIsMusicVolume);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_Volume << m_bIsDelta << m_bIsMusicVolume; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_Volume >> m_bIsDelta >> m_bIsMusicVolume; }
@@ -2338,7 +2418,7 @@ public:
     virtual const EventType& VGetEventType(void) const { return sk_EventType; }
     virtual IEventDataPtr VCopy() const
     {
-        return IEventDataPtr(new EventData_Sound_Enabled_Changed(m_bIsEnabled, m_bIsMusic));
+        return MakeEvent<EventData_Sound_Enabled_Changed>(m_bIsEnabled, m_bIsMusic);
     }
     virtual void VSerialize(std::ostringstream& out) const { out << m_bIsEnabled << m_bIsMusic; }
     virtual void VDeserialize(std::istringstream& in) { in >> m_bIsEnabled >> m_bIsMusic; }
@@ -0,0 +1,86 @@
+#include <SDL2/SDL.h>
+
+#include "ThreadSafeEventQueue.h"
+#include "../SharedDefines.h"
+
+static size_t GetNumCells(uint32_t capacity)
+{
+    size_t numCells = 2;
+    while (numCells < capacity)
+    {
+        numCells *= 2;
+    }
+
+    return numCells;
+}
+
+ThreadSafeEventQueue::ThreadSafeEventQueue(uint32_t capacity)
+    :
+    m_Cells(GetNumCells(capacity)),
+    m_CellMask(m_Cells.size() - 1),
+    m_EnqueuePos(0),
+    m_DequeuePos(0),
+    m_NumDroppedEvents(0)
+{
+    for (size_t cellIdx = 0; cellIdx < m_Cells.size(); cellIdx++)
+    {
+        m_Cells[cellIdx].sequence.store(cellIdx, std::memory_order_relaxed);
+        m_Cells[cellIdx].pushTime = 0;
+    }
+}
+
+bool ThreadSafeEventQueue::TryPush(const IEventDataPtr& pEvent)
+{
+    Cell* pCell = NULL;
+    size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        pCell = &m_Cells[pos & m_CellMask];
+        size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+        if (diff == 0)
+        {
+            // Cell is free, claim it unless other producer was faster
+            if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Consumer did not free the cell from previous lap yet
+            m_NumDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            pos = m_EnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    pCell->pEvent = pEvent;
+    pCell->pushTime = SDL_GetPerformanceCounter();
+    // Publishes the event to consumer
+    pCell->sequence.store(pos + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool ThreadSafeEventQueue::TryPop(IEventDataPtr& pEvent, uint64_t& pushTime)
+{
+    Cell& cell = m_Cells[m_DequeuePos & m_CellMask];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != m_DequeuePos + 1)
+    {
+        return false;
+    }
+
+    pEvent = std::move(cell.pEvent);
+    cell.pEvent.reset();
+    pushTime = cell.pushTime;
+    // Frees the cell for producers of next lap
+    cell.sequence.store(m_DequeuePos + m_CellMask + 1, std::memory_order_release);
+    m_DequeuePos++;
+
+    return true;
+}
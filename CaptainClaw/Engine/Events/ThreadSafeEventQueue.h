@@ -0,0 +1,55 @@
+#ifndef __THREADSAFEEVENTQUEUE_H__
+#define __THREADSAFEEVENTQUEUE_H__
+
+#include <atomic>
+#include <vector>
+
+#include "EventMgr.h"
+
+//---------------------------------------------------------------------------------------------------------------------
+// ThreadSafeEventQueue
+//
+// Bounded lock-free queue which any number of threads can push events to and a single thread pops them from. Each
+// cell carries a sequence number telling whether it is free for a producer or ready for the consumer, producers only
+// compete for the enqueue position with one compare-and-swap. Pushing to a full queue fails rather than blocks, so
+// producers never wait for the game thread.
+//---------------------------------------------------------------------------------------------------------------------
+class ThreadSafeEventQueue
+{
+public:
+    // Capacity is rounded up to power of two
+    explicit ThreadSafeEventQueue(uint32_t capacity);
+
+    // Safe to call from any thread, returns false if the queue is full
+    bool TryPush(const IEventDataPtr& pEvent);
+
+    // Only one thread may pop, returns false if the queue is empty. Push time is in performance counter ticks
+    // (SDL_GetPerformanceCounter) so that consumer can measure how long the event waited.
+    bool TryPop(IEventDataPtr& pEvent, uint64_t& pushTime);
+
+    uint32_t GetCapacity() const { return m_Cells.size(); }
+    // Events which did not fit since the queue was created
+    uint32_t GetNumDroppedEvents() const { return m_NumDroppedEvents.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        IEventDataPtr pEvent;
+        uint64_t pushTime;
+    };
+
+    // Producers and consumer write different positions, padding keeps them on separate cache lines
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<Cell> m_Cells;
+    size_t m_CellMask;
+    char m_Padding0[CACHE_LINE_SIZE];
+    std::atomic<size_t> m_EnqueuePos;
+    char m_Padding1[CACHE_LINE_SIZE];
+    size_t m_DequeuePos;
+    char m_Padding2[CACHE_LINE_SIZE];
+    std::atomic<uint32_t> m_NumDroppedEvents;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include "../Events/EventMgrImpl.h"
 #include "../Events/Events.h"
 #include "BaseGameLogic.h"
+#include "../Actor/ActorPool.h"
 #include "../UserInterface/HumanView.h"
 #include "../Resource/ResourceMgr.h"
 #include "../Graphics2D/Image.h"
@@ -21,6 +22,7 @@
 #include "../Resource/Loaders/PngLoader.h"
 
 #include "BaseGameApp.h"
+#include "LevelCache.h"
 
 TiXmlElement* CreateDefaultDisplayConfig();
 TiXmlElement* CreateDefaultAudioConfig();
@@ -45,6 +47,8 @@ BaseGameApp::BaseGameApp()
     m_IsRunning = false;
     m_QuitRequested = false;
     m_IsQuitting = false;
+    m_SimulationStep = 0;
+    m_InterpolationAlpha = 1.0f;
 }
 
 bool BaseGameApp::Initialize(int argc, char** argv)
@@ -109,6 +113,16 @@ int32 BaseGameApp::Run()
     SDL_Event event;
     int consecutiveLagSpikes = 0;
 
+    // Simulation runs in fixed steps, frames are rendered in between them. Step is kept in microseconds,
+    // whole milliseconds would make e.g. 60 Hz steps 16 ms long and the game would run at 62.5 Hz.
+    const uint32 simulationRate = std::min(max(1, m_GlobalOptions.simulationRate), 1000);
+    const uint32 simulationStepUs = 1000000 / simulationRate;
+    const uint32 maxSimulationSteps = max(1, m_GlobalOptions.maxSimulationStepsPerFrame);
+    uint32 simulationAccumulatorUs = 0;
+    // Game is updated in whole milliseconds, they are taken from simulated time so that they add up to it,
+    // e.g. 60 Hz steps are 16, 17 and 17 ms long
+    uint64 simulationTimeUs = 0;
+
     while (m_IsRunning)
     {
         //PROFILE_CPU("MAINLOOP");
@@ -141,8 +155,29 @@ int32 BaseGameApp::Run()
             // Update game
             {
                 //PROFILE_CPU("ONLY GAME UPDATE");
-                IEventMgr::Get()->VUpdate(20); // Allow event queue to process for up to 20 ms
-                m_pGame->VOnUpdate(elapsedTime);
+                simulationAccumulatorUs += elapsedTime * 1000;
+
+                uint32 numSteps = 0;
+                while (simulationAccumulatorUs >= simulationStepUs && numSteps < maxSimulationSteps)
+                {
+                    uint32 stepMs = (uint32)((simulationTimeUs + simulationStepUs) / 1000 - simulationTimeUs / 1000);
+                    simulationTimeUs += simulationStepUs;
+
+                    m_SimulationStep++;
+                    IEventMgr::Get()->VUpdate(20); // Allow event queue to process for up to 20 ms
+                    m_pGame->VOnUpdate(stepMs);
+
+                    simulationAccumulatorUs -= simulationStepUs;
+                    numSteps++;
+                }
+
+                // Game runs slower for a moment rather than stalling on steps it cannot keep up with
+                if (simulationAccumulatorUs >= simulationStepUs)
+                {
+                    simulationAccumulatorUs = simulationStepUs - 1;
+                }
+
+                m_InterpolationAlpha = (float)simulationAccumulatorUs / simulationStepUs;
             }
 
             // Render game
@@ -155,6 +190,9 @@ int32 BaseGameApp::Run()
             //m_pGame->VRenderDiagnostics();
         }
 
+        IEventMgr::Get()->VEndFrame();
+        ActorPool::EndFrame();
+
         // Artificially decrease fps. Configurable from console
         SDL_Delay(m_GlobalOptions.cpuDelayMs);
     }
@@ -193,6 +231,19 @@ void BaseGameApp::OnEvent(SDL_Event& event)
             break;
         }
 
+        case SDL_RENDER_TARGETS_RESET:
+        case SDL_RENDER_DEVICE_RESET:
+        {
+            if (m_pGame)
+            {
+                for (auto pGameView : m_pGame->m_GameViews)
+                {
+                    pGameView->VOnLostDevice();
+                }
+            }
+            break;
+        }
+
         case SDL_APP_LOWMEMORY:
         {
             LOG_WARNING("Running low on memory");
@@ -354,11 +405,19 @@ bool BaseGameApp::LoadGameOptions(const char* inConfigFile)
             assetsElem->FirstChildElement("CustomArchive"));
         ParseValueFromXmlElem(&m_GameOptions.resourceCacheSize,
             assetsElem->FirstChildElement("ResourceCacheSize"));
+        ParseValueFromXmlElem(&m_GameOptions.textureCacheSize,
+            assetsElem->FirstChildElement("TextureCacheSize"));
         ParseValueFromXmlElem(&m_GameOptions.tempDir,
             assetsElem->FirstChildElement("TempDir"));
+        ParseValueFromXmlElem(&m_GameOptions.levelCacheDir,
+            assetsElem->FirstChildElement("LevelCacheDir"));
         ParseValueFromXmlElem(&m_GameOptions.savesFile,
             assetsElem->FirstChildElement("SavesFile"));
     }
+    if (m_GameOptions.levelCacheDir.empty())
+    {
+        m_GameOptions.levelCacheDir = LevelCache::GetDefaultCacheDir();
+    }
 
     //-------------------------------------------------------------------------
     // Font
@@ -451,6 +510,12 @@ bool BaseGameApp::LoadGameOptions(const char* inConfigFile)
             pGlobalOptionsRootElem->FirstChildElement("PowerupMaxJumpHeight"));
         ParseValueFromXmlElem(&m_GlobalOptions.skipMenu,
             pGlobalOptionsRootElem->FirstChildElement("SkipMenu"));
+        ParseValueFromXmlElem(&m_GlobalOptions.actorActivityMargin,
+            pGlobalOptionsRootElem->FirstChildElement("ActorActivityMargin"));
+        ParseValueFromXmlElem(&m_GlobalOptions.simulationRate,
+            pGlobalOptionsRootElem->FirstChildElement("SimulationRate"));
+        ParseValueFromXmlElem(&m_GlobalOptions.maxSimulationStepsPerFrame,
+            pGlobalOptionsRootElem->FirstChildElement("MaxSimulationStepsPerFrame"));
     }
 
     return true;
@@ -478,7 +543,7 @@ void BaseGameApp::RegisterEngineEvents()
     REGISTER_EVENT(EventData_Request_New_Actor);
     REGISTER_EVENT(EventData_Network_Player_Actor_Assignment);
     REGISTER_EVENT(EventData_Attach_Actor);
-    REGISTER_EVENT(EventData_Collideable_Tile_Created);
+    REGISTER_EVENT(EventData_Collideable_Tile_Plane_Created);
     REGISTER_EVENT(EventData_Start_Climb);
     REGISTER_EVENT(EventData_Actor_Fire);
     REGISTER_EVENT(EventData_Actor_Attack);
@@ -587,7 +652,7 @@ bool BaseGameApp::InitializeResources(GameOptions& gameOptions)
 
     IResourceFile* rezArchive = new ResourceRezArchive(gameOptions.rezArchivePath);
 
-    m_pResourceCache = new ResourceCache(gameOptions.resourceCacheSize, rezArchive, ORIGINAL_RESOURCE);
+    m_pResourceCache = new ResourceCache(gameOptions.resourceCacheSize, gameOptions.textureCacheSize, rezArchive, ORIGINAL_RESOURCE);
     if (!m_pResourceCache->Init())
     {
         LOG_ERROR("Failed to initialize resource cachce from resource file: " + std::string(gameOptions.rezArchivePath));
@@ -605,7 +670,7 @@ bool BaseGameApp::InitializeResources(GameOptions& gameOptions)
     m_pResourceCache->RegisterLoader(PcxResourceLoader::Create());
 
     IResourceFile* pCustomArchive = new ResourceZipArchive(gameOptions.customArchivePath);
-    ResourceCache* pCustomCache = new ResourceCache(50, pCustomArchive, CUSTOM_RESOURCE);
+    ResourceCache* pCustomCache = new ResourceCache(50, 50, pCustomArchive, CUSTOM_RESOURCE);
     if (!pCustomCache->Init())
     {
         LOG_ERROR("Failed to initialize resource cachce from resource file: " + gameOptions.customArchivePath);
@@ -764,7 +829,9 @@ TiXmlElement* CreateDefaultAssetsConfig()
 
     XML_ADD_TEXT_ELEMENT("RezArchive", "CLAW.REZ", assets);
     XML_ADD_TEXT_ELEMENT("ResourceCacheSize", "50", assets);
+    XML_ADD_TEXT_ELEMENT("TextureCacheSize", "256", assets);
     XML_ADD_TEXT_ELEMENT("TempDir", ".", assets);
+    XML_ADD_TEXT_ELEMENT("LevelCacheDir", "", assets);
     XML_ADD_TEXT_ELEMENT("SavesFile", "SAVES.XML", assets);
 
     return assets;
@@ -40,7 +40,9 @@ struct GameOptions
         rezArchivePath = "CLAW.REZ";
         customArchivePath = "ASSETS.ZIP";
         resourceCacheSize = 50;
+        textureCacheSize = 256;
         tempDir = ".";
+        levelCacheDir = "";
         savesFile = "SAVES.XML";
 
         startupCommandsFile = "startup_commands.txt";
@@ -79,7 +81,11 @@ struct GameOptions
     std::string rezArchivePath;
     std::string customArchivePath;
     unsigned resourceCacheSize;
+    unsigned textureCacheSize;
     std::string tempDir;
+    // Directory with compiled levels, empty in config means per-user directory (see LevelCache::GetDefaultCacheDir)
+    // and stays empty only if there is no such directory, which disables level cache
+    std::string levelCacheDir;
     std::string savesFile;
 
     // Console config
@@ -124,6 +130,9 @@ struct GlobalOptions
         maxJumpHeight = 150;
         powerupMaxJumpHeight = 200;
         skipMenu = false;
+        actorActivityMargin = 640;
+        simulationRate = 60;
+        maxSimulationStepsPerFrame = 5;
     }
 
     int cpuDelayMs;
@@ -134,6 +143,12 @@ struct GlobalOptions
     float maxJumpHeight;
     float powerupMaxJumpHeight;
     bool skipMenu;
+    // Level objects farther than this from camera are suspended, negative keeps all of them active
+    int actorActivityMargin;
+    // Game logic and physics run this many times per second regardless of frame rate
+    int simulationRate;
+    // Time exceeding this many steps in one frame is dropped instead of being caught up with
+    int maxSimulationStepsPerFrame;
 };
 
 class EventMgr;
@@ -211,6 +226,11 @@ public:
     const GameOptions* GetGameConfig() const { return &m_GameOptions; }
     GlobalOptions* GetGlobalOptions() { return &m_GlobalOptions; }
 
+    // Number of fixed simulation steps run so far
+    uint32 GetSimulationStep() const { return m_SimulationStep; }
+    // How far between the last two simulation steps rendered frame is, in range [0, 1]
+    float GetInterpolationAlpha() const { return m_InterpolationAlpha; }
+
 protected:
     virtual void VRegisterGameEvents() { }
 
@@ -259,6 +279,9 @@ private:
 
     GameCheats m_GameCheats;
     GlobalOptions m_GlobalOptions;
+
+    uint32 m_SimulationStep;
+    float m_InterpolationAlpha;
 };
 
 extern BaseGameApp* g_pApp;
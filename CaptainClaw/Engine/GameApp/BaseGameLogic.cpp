@@ -5,7 +5,10 @@
 #include "../Resource/Loaders/PalLoader.h"
 #include "../Resource/Loaders/WwdLoader.h"
 #include "../Resource/Loaders/PcxLoader.h"
+#include "../Resource/Loaders/AniLoader.h"
+#include "../Actor/Components/Animation.h"
 #include "../Events/EventMgr.h"
+#include "../Resource/ResourceLoadPipeline.h"
 #include "../Graphics2D/Image.h"
 #include "../Audio/Audio.h"
 
@@ -13,13 +16,20 @@
 
 #include "GameSaves.h"
 #include "BaseGameLogic.h"
+#include "LevelCache.h"
 
 #include "../Physics/ClawPhysics.h"
+#include "../Physics/TileGeometryCompiler.h"
 
 #include <algorithm>
 #include <fstream>
-//#include <thread>
 #include <iostream>
+#include <set>
+
+// How long can level resource streaming block loading screen from being redrawn
+const uint32 LOADING_SCREEN_FRAME_MS = 16;
+// Part of loading progress bar taken by level resource streaming
+const float LEVEL_RESOURCES_LOAD_PERCENT = 40.0f;
 
 //=================================================================================================
 //
@@ -41,6 +51,9 @@ BaseGameLogic::BaseGameLogic()
     m_RenderDiagnostics = true;
     m_SelectedLevel = -1;
     m_bRunning = true;
+    m_NumTileCollisionRects = 0;
+    m_NumTileGeometryRects = 0;
+    m_TileGeometryCompileMs = 0.0;
 
     m_pGameSaveMgr.reset(new GameSaveMgr());
 
@@ -59,7 +72,9 @@ BaseGameLogic::~BaseGameLogic()
     SAFE_DELETE(m_pActorFactory);
 
     // Destroy all actors
-    for (auto actorIter : m_ActorMap)
+    m_ComponentUpdateScheduler.Clear();
+    m_ActorActivityMgr.Clear();
+    for (auto& actorIter : m_ActorMap)
     {
         actorIter.second->Destroy();
     }
@@ -76,6 +91,7 @@ BaseGameLogic::~BaseGameLogic()
 bool BaseGameLogic::Initialize()
 {
     m_pActorFactory = VCreateActorFactory();
+    m_ActorActivityMgr.SetMargin(g_pApp->GetGlobalOptions()->actorActivityMargin);
 
     std::string savesFile = g_pApp->GetGameConfig()->savesFile;
 
@@ -138,6 +154,78 @@ bool BaseGameLogic::VEnterMenu(const char* xmlMenuResource)
     return true;
 }
 
+static bool IsWavSound(const std::string& resourceName)
+{
+    const std::string wavExtension = ".wav";
+    return resourceName.size() > wavExtension.size() &&
+        resourceName.compare(resourceName.size() - wavExtension.size(), wavExtension.size(), wavExtension) == 0;
+}
+
+static void CollectActorSounds(TiXmlElement* pElem, std::set<std::string>& sounds, std::set<std::string>& visitedPatterns)
+{
+    ResourceCache* pCache = g_pApp->GetResourceCache();
+
+    for (TiXmlElement* pChildElem = pElem->FirstChildElement(); pChildElem; pChildElem = pChildElem->NextSiblingElement())
+    {
+        if (pChildElem->GetText() != NULL)
+        {
+            std::string elemName = pChildElem->Value();
+            // Resource names are lower case
+            std::string value = Resource(pChildElem->GetText()).GetName();
+
+            if (elemName == "SoundPath" && visitedPatterns.insert(value).second)
+            {
+                for (const std::string& soundName : pCache->Match(value))
+                {
+                    if (IsWavSound(soundName))
+                    {
+                        sounds.insert(soundName);
+                    }
+                }
+            }
+            else if (elemName == "AnimationPath" && visitedPatterns.insert(value).second)
+            {
+                // Animation frames can play sounds too
+                for (const std::string& aniName : pCache->Match(value))
+                {
+                    WapAni* pAni = AniResourceLoader::LoadAndReturnAni(aniName.c_str());
+                    for (uint32 frameIdx = 0; pAni != NULL && frameIdx < pAni->animationFramesCount; frameIdx++)
+                    {
+                        const char* eventName = pAni->animationFrames[frameIdx].eventFilePath;
+                        std::string soundPath = (eventName != NULL) ? Animation::GetFrameEventSoundPath(eventName) : "";
+                        if (!soundPath.empty())
+                        {
+                            sounds.insert(Resource(soundPath).GetName());
+                        }
+                    }
+                }
+            }
+            else if (IsWavSound(value))
+            {
+                sounds.insert(value);
+            }
+        }
+
+        CollectActorSounds(pChildElem, sounds, visitedPatterns);
+    }
+}
+
+// All sounds which actors of given level can play - sounds referenced by their definitions,
+// contents of their sound paths and sounds played by their animation frames
+static std::vector<std::string> CollectLevelSounds(TiXmlElement* pXmlLevelRoot)
+{
+    std::set<std::string> sounds;
+    std::set<std::string> visitedPatterns;
+
+    for (TiXmlElement* pActorElem = pXmlLevelRoot->FirstChildElement("Actor"); pActorElem;
+        pActorElem = pActorElem->NextSiblingElement("Actor"))
+    {
+        CollectActorSounds(pActorElem, sounds, visitedPatterns);
+    }
+
+    return std::vector<std::string>(sounds.begin(), sounds.end());
+}
+
 void RenderLoadingScreen(shared_ptr<Image> pBackground, SDL_Rect& renderRect, Point& scale, float progress)
 {
     // While we are at it, eat incoming events
@@ -174,6 +262,45 @@ void RenderLoadingScreen(shared_ptr<Image> pBackground, SDL_Rect& renderRect, Po
 }
 
 bool BaseGameLogic::VLoadGame(const char* xmlLevelResource)
+{
+    // Level is going to be loaded from XML WWD
+    TiXmlElement* pXmlLevelRoot = XmlResourceLoader::LoadAndReturnRootXmlElement(xmlLevelResource, true);
+    if (pXmlLevelRoot == NULL)
+    {
+        LOG_ERROR("Could not load level resource file: " + std::string(xmlLevelResource));
+        return false;
+    }
+
+    if (!m_pCurrentLevel->LoadPropertiesFromXml(pXmlLevelRoot))
+    {
+        LOG_ERROR("Level: " + std::string(xmlLevelResource) + " does not have valid level properties.");
+        SAFE_DELETE(pXmlLevelRoot);
+        return false;
+    }
+
+    return LoadLevel(pXmlLevelRoot);
+}
+
+bool BaseGameLogic::LoadGameFromWwd(WapWwd* pWwd)
+{
+    m_pCurrentLevel->LoadPropertiesFromWwd(pWwd);
+
+    // Actor factory builds actors from XML so level actors are still converted, but only in memory
+    // and without tiles which plane components take from the level data
+    TiXmlElement* pXmlLevelRoot = WwdToXml(pWwd, false);
+    if (pXmlLevelRoot == NULL)
+    {
+        LOG_ERROR("Could not convert level WWD");
+        return false;
+    }
+
+    bool isLoaded = LoadLevel(pXmlLevelRoot);
+    m_pCurrentLevel->ClearLoadingData();
+
+    return isLoaded;
+}
+
+bool BaseGameLogic::LoadLevel(TiXmlElement* pXmlLevelRoot)
 {
     PROFILE_CPU("GAME LOADING");
     PROFILE_MEMORY("GAME LOADING");
@@ -182,14 +309,12 @@ bool BaseGameLogic::VLoadGame(const char* xmlLevelResource)
     g_pApp->GetAudio()->StopAllSounds();
 
     m_pPhysics.reset(CreateClawPhysics());
+    // Prefab components were initialized with previous level's physics
+    m_pActorFactory->ClearPrefabs();
 
     float loadingProgress = 0.0f;
     float lastProgress = 0.0f;
 
-    // Preload level resources
-    std::string levelPath = "/LEVEL" + ToStr(m_pCurrentLevel->GetLevelNumber()) + "/*";
-    g_pApp->GetResourceCache()->Preload(levelPath, NULL);
-
     // Start rendering the loading screen
     Point windowSize = g_pApp->GetWindowSize();
     Point scale = g_pApp->GetScale();
@@ -204,90 +329,25 @@ bool BaseGameLogic::VLoadGame(const char* xmlLevelResource)
 
     RenderLoadingScreen(pBackgroundImage, backgroundRect, scale, loadingProgress);
 
-    // Level is going to be loaded from XML WWD
-    TiXmlElement* pXmlLevelRoot = XmlResourceLoader::LoadAndReturnRootXmlElement(xmlLevelResource, true);
-    if (pXmlLevelRoot == NULL)
-    {
-        LOG_ERROR("Could not load level resource file: " + std::string(xmlLevelResource));
-        return false;
-    }
-
-    // Get level palette
-    TiXmlElement* pLevelProperties = pXmlLevelRoot->FirstChildElement("LevelProperties");
-    if (!pLevelProperties)
-    {
-        LOG_ERROR("Level: " + std::string(xmlLevelResource) + " does not have level properties node.");
-        return false;
-    }
-
-    if (TiXmlElement* pLevelNameElem = pLevelProperties->FirstChildElement("LevelName"))
-    {
-        m_pCurrentLevel->m_LevelName = pLevelNameElem->GetText();
-    }
-    if (TiXmlElement* pLevelAuthorElem = pLevelProperties->FirstChildElement("Author"))
-    {
-        m_pCurrentLevel->m_LevelAuthor = pLevelAuthorElem->GetText();
-    }
-    if (TiXmlElement* pLevelCreatedDateElem = pLevelProperties->FirstChildElement("Created"))
-    {
-        m_pCurrentLevel->m_LevelCreatedDate = pLevelCreatedDateElem->GetText();
-    }
-
-    // Tile descriptions
-    if (TiXmlElement* pTileDescRootElem = pLevelProperties->FirstChildElement("TileDescriptions"))
-    {
-        for (TiXmlElement* pTileDescElem = pTileDescRootElem->FirstChildElement("TileDescription");
-            pTileDescElem; pTileDescElem = pTileDescElem->NextSiblingElement("TileDescription"))
-        {
-
-            // Maybe code more deffensively here, revisit in future probably.. right now I dont want to
-            // add 10000 conditions to assert correct xml format
+    // Palette has to be known before level images are decoded
+    g_pApp->SetCurrentPalette(PalResourceLoader::LoadAndReturnPal(m_pCurrentLevel->m_PalettePath.c_str()));
 
-            // TileDescription will maybe be used by editor, it is not used directly by game
-            //    but only to parse TileCollisionPrototype from it which is used by physics subsystem
-            TileDescription tileDesc;
-            tileDesc.tileId = std::stoi(pTileDescElem->FirstChildElement("TileId")->GetText());
-
-            TiXmlElement* pTileSizeElem = pTileDescElem->FirstChildElement("Size");
-            tileDesc.width = std::stoi(pTileSizeElem->Attribute("width"));
-            tileDesc.height = std::stoi(pTileSizeElem->Attribute("height"));
-
-            if (std::string(pTileDescElem->FirstChildElement("Type")->GetText()) == "single")
-            {
-                tileDesc.type = WAP_TILE_TYPE_SINGLE;
-            }
-            else
-            {
-                tileDesc.type = WAP_TILE_TYPE_DOUBLE;
-                tileDesc.outsideAttrib = std::stoi(pTileDescElem->FirstChildElement("OutsideAttrib")->GetText());
-            }
-            tileDesc.insideAttrib = std::stoi(pTileDescElem->FirstChildElement("InsideAttrib")->GetText());
-
-            TiXmlElement* pTileRectElem = pTileDescElem->FirstChildElement("TileRect");
-            tileDesc.rect.left = std::stoi(pTileRectElem->Attribute("left"));
-            tileDesc.rect.top = std::stoi(pTileRectElem->Attribute("top"));
-            tileDesc.rect.right = std::stoi(pTileRectElem->Attribute("right"));
-            tileDesc.rect.bottom = std::stoi(pTileRectElem->Attribute("bottom"));
-
-            m_pCurrentLevel->m_TileDescriptionMap.insert(std::make_pair(tileDesc.tileId, tileDesc));
-
-            // This structure is actually used in game in order to prevent recalculating the collision rects
-            //    over and over again
-            TileCollisionPrototype tileProto;
-            tileProto.id = tileDesc.tileId;
-            tileProto.width = tileDesc.width;
-            tileProto.height = tileDesc.height;
-            Util::ParseCollisionRectanglesFromTile(&tileProto, &tileDesc);
-
-            m_pCurrentLevel->m_TileCollisionPrototypeMap.insert(std::make_pair(tileProto.id, tileProto));
-        }
-    }
-    else
+    // Stream level resources - worker threads read and decode them while this thread
+    // inserts them into resource cache and keeps the loading screen alive. Decoded PIDs
+    // get their textures when actors pack their image sets into atlases.
+    std::string levelPath = "/LEVEL" + ToStr(m_pCurrentLevel->GetLevelNumber()) + "/*";
+    ResourceLoadPipeline levelLoadPipeline(g_pApp->GetResourceCache());
+    levelLoadPipeline.Start(levelPath);
+    while (!levelLoadPipeline.Pump(LOADING_SCREEN_FRAME_MS))
     {
-        assert(false && "Tile descriptions element not found.");
+        loadingProgress = levelLoadPipeline.GetProgress() * (LEVEL_RESOURCES_LOAD_PERCENT / 100.0f);
+        RenderLoadingScreen(pBackgroundImage, backgroundRect, scale, loadingProgress);
     }
+    loadingProgress = LEVEL_RESOURCES_LOAD_PERCENT;
+    RenderLoadingScreen(pBackgroundImage, backgroundRect, scale, loadingProgress);
 
-    loadingProgress = 10.0f;
+    loadingProgress += 5.0f;
+    lastProgress = loadingProgress;
     RenderLoadingScreen(pBackgroundImage, backgroundRect, scale, loadingProgress);
 
     // Get number of actors to estimate loading progress
@@ -296,12 +356,15 @@ bool BaseGameLogic::VLoadGame(const char* xmlLevelResource)
         pActorElem != NULL;
         pActorElem = pActorElem->NextSiblingElement("Actor"), numActors++);
 
-    // Leave 90% for actor's processing
+    // Leave the rest up to 95% for actor's processing
     float actorToPercent = (100.0f - loadingProgress - 5.0f) / (float)numActors;
 
-    std::string palettePath = pLevelProperties->FirstChildElement("Palette")->GetText();
-    std::replace(palettePath.begin(), palettePath.end(), '\\', '/');
-    g_pApp->SetCurrentPalette(PalResourceLoader::LoadAndReturnPal(palettePath.c_str()));
+    // Sounds are decoded in background while actors are being created so that their first
+    // playback does not have to load them
+    ResourceLoadPipeline soundPrefetchPipeline(g_pApp->GetResourceCache());
+    soundPrefetchPipeline.Start(CollectLevelSounds(pXmlLevelRoot));
+
+    uint64 actorCreationStartTicks = SDL_GetPerformanceCounter();
 
     uint32 clawId = -1;
     for (TiXmlElement* pActorElem = pXmlLevelRoot->FirstChildElement("Actor"); pActorElem;
@@ -312,7 +375,11 @@ bool BaseGameLogic::VLoadGame(const char* xmlLevelResource)
         StrongActorPtr pActor = VCreateActor(pActorElem, NULL);
         if (pActor)
         {
-            shared_ptr<EventData_New_Actor> pNewActorEvent(new EventData_New_Actor(pActor->GetGUID()));
+            // Only level objects are suspended when far from camera, actors spawned during
+            // gameplay (projectiles, loot, effects) are short lived and always updated
+            m_ActorActivityMgr.AddActor(pActor);
+
+            shared_ptr<EventData_New_Actor> pNewActorEvent(MakeEvent<EventData_New_Actor>(pActor->GetGUID()));
             IEventMgr::Get()->VQueueEvent(pNewActorEvent);
 
             // Get Claw's GUID
@@ -335,6 +402,13 @@ bool BaseGameLogic::VLoadGame(const char* xmlLevelResource)
         }
     }
 
+    uint64 actorCreationTime = ((SDL_GetPerformanceCounter() - actorCreationStartTicks) * 1000000) / SDL_GetPerformanceFrequency();
+
+    while (!soundPrefetchPipeline.Pump(LOADING_SCREEN_FRAME_MS))
+    {
+        RenderLoadingScreen(pBackgroundImage, backgroundRect, scale, loadingProgress);
+    }
+
     // Notify all human views
     for (auto pGameView : m_GameViews)
     {
@@ -355,22 +429,22 @@ bool BaseGameLogic::VLoadGame(const char* xmlLevelResource)
 
     // Load claw stats: Score, Health, Lives, Ammo: Bullets, Magic, Dynamite
     IEventMgr* pEventMgr = IEventMgr::Get();
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Score, pCheckpointSave->score, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Health, pCheckpointSave->health, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Lives, pCheckpointSave->lives, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Bullets, pCheckpointSave->bulletCount, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Magic, pCheckpointSave->magicCount, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Dynamite, pCheckpointSave->dynamiteCount, false)));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Score, pCheckpointSave->score, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Health, pCheckpointSave->health, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Lives, pCheckpointSave->lives, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Bullets, pCheckpointSave->bulletCount, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Magic, pCheckpointSave->magicCount, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Dynamite, pCheckpointSave->dynamiteCount, false));
 
     // Set claw to spawn location
     m_CurrentSpawnPosition = GetSpawnPosition(m_pCurrentLevel->m_LeveNumber, m_pCurrentLevel->m_LoadedCheckpoint);
-    pEventMgr->VTriggerEvent(IEventDataPtr(new EventData_Teleport_Actor(clawId, m_CurrentSpawnPosition)));
+    pEventMgr->VTriggerEvent(MakeEvent<EventData_Teleport_Actor>(clawId, m_CurrentSpawnPosition));
 
     // Start playing background music
     std::string backgroundMusicPath = "/LEVEL" + ToStr(m_pCurrentLevel->GetLevelNumber()) +
         "/MUSIC/PLAY.XMI";
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Request_Play_Sound(
-        backgroundMusicPath, g_pApp->GetGameConfig()->musicVolume, true, -1)));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Request_Play_Sound>(
+        backgroundMusicPath, g_pApp->GetGameConfig()->musicVolume, true, -1));
 
     loadingProgress = 100.0f;   
     RenderLoadingScreen(pBackgroundImage, backgroundRect, scale, loadingProgress);
@@ -379,6 +453,9 @@ bool BaseGameLogic::VLoadGame(const char* xmlLevelResource)
     LOG("Level name: " + m_pCurrentLevel->m_LevelName);
     LOG("Level author: " + m_pCurrentLevel->m_LevelAuthor);
     LOG("Level created date: " + m_pCurrentLevel->m_LevelCreatedDate);
+    LOG("Level resources: " + levelLoadPipeline.GetStats().ToString());
+    LOG("Actor construction: " + ToStr((unsigned long)(actorCreationTime / 1000)) + " ms");
+    LOG("Sound prefetch: " + soundPrefetchPipeline.GetStats().ToString());
 
     SAFE_DELETE(pXmlLevelRoot);
 
@@ -402,6 +479,7 @@ StrongActorPtr BaseGameLogic::VCreateActor(const std::string& xmlActorResource,
     if (pActor)
     {
         m_ActorMap.insert(std::make_pair(pActor->GetGUID(), pActor));
+        m_ComponentUpdateScheduler.AddActor(pActor);
         if (m_GameState == GameState_IngameRunning)
         {
             // Create event that actor was created
@@ -422,6 +500,7 @@ StrongActorPtr BaseGameLogic::VCreateActor(TiXmlElement* pActorRoot, TiXmlElemen
     if (pActor)
     {
         m_ActorMap.insert(std::make_pair(pActor->GetGUID(), pActor));
+        m_ComponentUpdateScheduler.AddActor(pActor);
         if (m_GameState == GameState_IngameRunning)
         {
             // Create event that actor was created
@@ -434,6 +513,20 @@ StrongActorPtr BaseGameLogic::VCreateActor(TiXmlElement* pActorRoot, TiXmlElemen
     }
 }
 
+StrongActorPtr BaseGameLogic::CreateActor(const ActorPrefab* pPrefab, const ActorPrefabOverrides& overrides)
+{
+    assert(m_pActorFactory);
+
+    StrongActorPtr pActor = m_pActorFactory->CreateActor(pPrefab, overrides);
+    if (pActor)
+    {
+        m_ActorMap.insert(std::make_pair(pActor->GetGUID(), pActor));
+        m_ComponentUpdateScheduler.AddActor(pActor);
+    }
+
+    return pActor;
+}
+
 void BaseGameLogic::VDestroyActor(const uint32 actorId)
 {
     // Trigger actor destroyed event prior removing it here
@@ -442,6 +535,8 @@ void BaseGameLogic::VDestroyActor(const uint32 actorId)
     if (findIter != m_ActorMap.end())
     {
         //LOG("Destroying: " + ToStr(actorId));
+        m_ComponentUpdateScheduler.RemoveActor(findIter->second);
+        m_ActorActivityMgr.RemoveActor(findIter->second);
         findIter->second->Destroy();
         m_ActorMap.erase(findIter);
     }
@@ -462,10 +557,12 @@ void BaseGameLogic::VModifyActor(const uint32 actorId, TiXmlElement* overrides)
 {
     assert(m_pActorFactory);
 
-    auto findIter = m_ActorMap.begin();
+    auto findIter = m_ActorMap.find(actorId);
     if (findIter != m_ActorMap.end())
     {
         m_pActorFactory->ModifyActor(findIter->second, overrides);
+        // Overrides can add new components
+        m_ComponentUpdateScheduler.AddActor(findIter->second);
     }
 }
 
@@ -520,32 +617,20 @@ void BaseGameLogic::VOnUpdate(uint32 msDiff)
             {
                 m_pProcessMgr->UpdateProcesses(msDiff);
             }
+
+            // Suspend level objects far from camera before they are simulated
+            HumanView* pHumanView = g_pApp->GetHumanView();
+            if (pHumanView && pHumanView->GetCamera())
+            {
+                m_ActorActivityMgr.Update(pHumanView->GetCamera()->GetCameraRect(), &m_ComponentUpdateScheduler, m_pPhysics.get());
+            }
             
             if (m_pPhysics)
             {
                 //PROFILE_CPU("PHYSICS");
-                // TODO: Add config to choose between fixed physics timestep and variable
-                if (true)
-                {
-                    m_pPhysics->VOnUpdate(msDiff);
-                    m_pPhysics->VSyncVisibleScene();
-                }
-                else
-                {
-                    static uint32 timeSinceLastUpdate = 0;
-                    const uint32 updateInterval = 1000 / 120;
-
-                    timeSinceLastUpdate += msDiff;
-                    if (timeSinceLastUpdate >= updateInterval)
-                    {
-                        //PROFILE_CPU("PHYSICS");
-                        //LOG(ToStr(timeSinceLastUpdate));
-                        m_pPhysics->VOnUpdate(timeSinceLastUpdate);
-                        m_pPhysics->VSyncVisibleScene();
-
-                        timeSinceLastUpdate = 0;
-                    }
-                }
+                // msDiff is a fixed simulation step, see BaseGameApp::Run()
+                m_pPhysics->VOnUpdate(msDiff);
+                m_pPhysics->VSyncVisibleScene();
                 break;
             }
 
@@ -565,18 +650,8 @@ void BaseGameLogic::VOnUpdate(uint32 msDiff)
         pGameView->VOnUpdate(msDiff);
     }
 
-    // Limit update to max 100 times / second
-    static int msAccumulation = 0;
-    msAccumulation += msDiff;
-    if (msAccumulation >= 5)
-    {
-        // Update all game actors
-        for (auto actorIter : m_ActorMap)
-        {
-            actorIter.second->Update(msAccumulation);
-        }
-        msAccumulation = 0;
-    }
+    // Update all game actors
+    m_ComponentUpdateScheduler.Update(msDiff);
 }
 
 void BaseGameLogic::VChangeState(GameState newState)
@@ -611,21 +686,39 @@ void BaseGameLogic::VChangeState(GameState newState)
         // Load Monolith's WWD, they are located in /LEVEL[1-14]/WORLDS/WORLD.WWD
         std::string levelName = "LEVEL" + ToStr(levelNumber);
         std::string pathToLevelWwd = "/" + levelName + "/WORLDS/WORLD.WWD";
-        WapWwd* pWwd = WwdResourceLoader::LoadAndReturnWwd(pathToLevelWwd.c_str());
-        assert(pWwd != NULL);
 
-        // Convert Monolith .WWD format to my .XML format
-        TiXmlElement* pXmlLevel = WwdToXml(pWwd);
-        assert(pXmlLevel != NULL);
+        // Level compiled from this exact WWD is used when there is one, otherwise WWD is loaded
+        // and compiled for next time
+        const std::string& levelCacheDir = g_pApp->GetGameConfig()->levelCacheDir;
+        LevelCache::RawWwd rawWwd;
+        bool useLevelCache = !levelCacheDir.empty() && LevelCache::ReadWwdResource(pathToLevelWwd, rawWwd);
 
-        // Save converted level to file, e.g. LEVEL1.xml
-        TiXmlDocument xmlDoc;
-        xmlDoc.LinkEndChild(pXmlLevel);
-        std::string outFileLevelName = g_pApp->GetGameConfig()->tempDir + "/" + levelName + ".xml";
-        xmlDoc.SaveFile(outFileLevelName.c_str());
+        TiXmlElement* pCompiledLevelRoot = useLevelCache ? LevelCache::Load(rawWwd.hash, levelCacheDir, m_pCurrentLevel.get()) : NULL;
 
-        // Load saved level file, e.g. LEVEL1.xml
-        if (!VLoadGame(outFileLevelName.c_str()))
+        bool isLoaded = false;
+        if (pCompiledLevelRoot != NULL)
+        {
+            isLoaded = LoadLevel(pCompiledLevelRoot);
+            m_pCurrentLevel->ClearLoadingData();
+        }
+        else
+        {
+            // WWD which was already read for its hash is not read again
+            WapWwd* pWwd = useLevelCache ?
+                WwdResourceLoader::LoadAndReturnWwd(pathToLevelWwd.c_str(), rawWwd.pData, rawWwd.size) :
+                WwdResourceLoader::LoadAndReturnWwd(pathToLevelWwd.c_str());
+            assert(pWwd != NULL);
+
+            if (useLevelCache)
+            {
+                LevelCache::Compile(pWwd, rawWwd.hash, levelNumber, levelCacheDir);
+            }
+
+            // Tiles and tile descriptions are taken straight from WWD, no XML file is written
+            isLoaded = LoadGameFromWwd(pWwd);
+        }
+
+        if (!isLoaded)
         {
             LOG_ERROR("Could not load level");
             exit(1);
@@ -677,42 +770,34 @@ void BaseGameLogic::RequestNewActorDelegate(IEventDataPtr pEventData)
 
 }
 
-void BaseGameLogic::CollideableTileCreatedDelegate(IEventDataPtr pEventData)
+void BaseGameLogic::CollideableTilePlaneCreatedDelegate(IEventDataPtr pEventData)
 {
-    shared_ptr<EventData_Collideable_Tile_Created> pCastEventData = static_pointer_cast<EventData_Collideable_Tile_Created>(pEventData);
-
-    auto findIt = m_pCurrentLevel->m_TileCollisionPrototypeMap.find(pCastEventData->GetTileId());
-    if (findIt != m_pCurrentLevel->m_TileCollisionPrototypeMap.end())
-    {
-        TileCollisionPrototype& tileProto = findIt->second;
+    shared_ptr<EventData_Collideable_Tile_Plane_Created> pCastEventData =
+        static_pointer_cast<EventData_Collideable_Tile_Plane_Created>(pEventData);
 
-        for (auto tileCollisionRect : tileProto.collisionRectangles)
-        {
-            Point position = Point(pCastEventData->GetPositionX() + tileCollisionRect.collisionRect.x,
-                                   pCastEventData->GetPositionY() + tileCollisionRect.collisionRect.y);
-            Point size = Point(tileCollisionRect.collisionRect.w, tileCollisionRect.collisionRect.h);
-
-            m_pPhysics->VAddStaticGeometry(position, size, tileCollisionRect.collisionType);
-        }
+    uint64 startTime = SDL_GetPerformanceCounter();
 
-        // LEVEL1: Top of the ladder
-        if (m_pCurrentLevel->GetLevelNumber() == 1 && tileProto.id == 310)
-        {
-            Point position(pCastEventData->GetPositionX(), pCastEventData->GetPositionY());
-            Point size(64, 10);
-            m_pPhysics->VAddStaticGeometry(position, size, CollisionType_Ground);
-        }
-        else if (m_pCurrentLevel->GetLevelNumber() == 2 && tileProto.id == 16)
-        {
-            Point position(pCastEventData->GetPositionX(), pCastEventData->GetPositionY() + 50);
-            Point size(64, 10);
-            m_pPhysics->VAddStaticGeometry(position, size, CollisionType_Ground);
-        }
+    // Compiled level already has the merged geometry
+    StaticGeometryList compiledGeometry;
+    uint32 numTileCollisionRects = 0;
+    const StaticGeometryList* pGeometry = m_pCurrentLevel->GetCompiledTileGeometry(numTileCollisionRects);
+    if (pGeometry == NULL)
+    {
+        numTileCollisionRects = m_pCurrentLevel->CompileTileGeometry(pCastEventData->GetTiles(),
+            pCastEventData->GetTilesOnAxisX(), pCastEventData->GetTilesOnAxisY(),
+            pCastEventData->GetTileWidth(), pCastEventData->GetTileHeight(), compiledGeometry);
+        pGeometry = &compiledGeometry;
     }
-    else
+
+    for (const StaticGeometryRect& geometryRect : *pGeometry)
     {
-        LOG_WARNING("Unknown tile! Id = " + ToStr(pCastEventData->GetTileId()));
+        m_pPhysics->VAddStaticGeometry(Point(geometryRect.rect.x, geometryRect.rect.y),
+            Point(geometryRect.rect.w, geometryRect.rect.h), geometryRect.collisionType);
     }
+
+    m_NumTileCollisionRects = numTileCollisionRects;
+    m_NumTileGeometryRects = pGeometry->size();
+    m_TileGeometryCompileMs = (SDL_GetPerformanceCounter() - startTime) * 1000.0 / SDL_GetPerformanceFrequency();
 }
 
 void BaseGameLogic::CreateStaticGeometryDelegate(IEventDataPtr pEventData)
@@ -741,7 +826,7 @@ void BaseGameLogic::UnloadLevel()
 
     for (auto actorIter : m_ActorMap)
     {
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(actorIter.second->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(actorIter.second->GetGUID()));
         IEventMgr::Get()->VTriggerEvent(pEvent);
     }
 
@@ -750,6 +835,7 @@ void BaseGameLogic::UnloadLevel()
     // Process any pending events which could have arose from deleting all actors
     IEventMgr::Get()->VUpdate(IEventMgr::kINFINITE);
 
+    m_pActorFactory->ClearPrefabs();
     m_pPhysics.reset();
 }
 
@@ -760,7 +846,7 @@ void BaseGameLogic::VResetLevel()
 
     for (auto actorIter : m_ActorMap)
     {
-        shared_ptr<EventData_Destroy_Actor> pEvent(new EventData_Destroy_Actor(actorIter.second->GetGUID()));
+        shared_ptr<EventData_Destroy_Actor> pEvent(MakeEvent<EventData_Destroy_Actor>(actorIter.second->GetGUID()));
         IEventMgr::Get()->VTriggerEvent(pEvent);
     }
 
@@ -776,20 +862,229 @@ void BaseGameLogic::VResetLevel()
     VChangeState(GameState_LoadingLevel);
 }
 
+//=====================================================================================================================
+// LevelData
+//=====================================================================================================================
+
+bool LevelData::LoadPropertiesFromXml(TiXmlElement* pXmlLevelRoot)
+{
+    TiXmlElement* pLevelProperties = pXmlLevelRoot->FirstChildElement("LevelProperties");
+    if (!pLevelProperties)
+    {
+        LOG_ERROR("Level does not have level properties node.");
+        return false;
+    }
+
+    if (TiXmlElement* pLevelNameElem = pLevelProperties->FirstChildElement("LevelName"))
+    {
+        m_LevelName = pLevelNameElem->GetText();
+    }
+    if (TiXmlElement* pLevelAuthorElem = pLevelProperties->FirstChildElement("Author"))
+    {
+        m_LevelAuthor = pLevelAuthorElem->GetText();
+    }
+    if (TiXmlElement* pLevelCreatedDateElem = pLevelProperties->FirstChildElement("Created"))
+    {
+        m_LevelCreatedDate = pLevelCreatedDateElem->GetText();
+    }
+
+    m_PalettePath = pLevelProperties->FirstChildElement("Palette")->GetText();
+    std::replace(m_PalettePath.begin(), m_PalettePath.end(), '\\', '/');
+
+    TiXmlElement* pTileDescRootElem = pLevelProperties->FirstChildElement("TileDescriptions");
+    if (!pTileDescRootElem)
+    {
+        LOG_ERROR("Tile descriptions element not found.");
+        return false;
+    }
+
+    m_TileDescriptionMap.clear();
+    m_TileCollisionPrototypeMap.clear();
+    m_PlaneTiles.clear();
+
+    for (TiXmlElement* pTileDescElem = pTileDescRootElem->FirstChildElement("TileDescription");
+        pTileDescElem; pTileDescElem = pTileDescElem->NextSiblingElement("TileDescription"))
+    {
+        // Maybe code more deffensively here, revisit in future probably.. right now I dont want to
+        // add 10000 conditions to assert correct xml format
+        TileDescription tileDesc;
+        tileDesc.tileId = std::stoi(pTileDescElem->FirstChildElement("TileId")->GetText());
+
+        TiXmlElement* pTileSizeElem = pTileDescElem->FirstChildElement("Size");
+        tileDesc.width = std::stoi(pTileSizeElem->Attribute("width"));
+        tileDesc.height = std::stoi(pTileSizeElem->Attribute("height"));
+
+        if (std::string(pTileDescElem->FirstChildElement("Type")->GetText()) == "single")
+        {
+            tileDesc.type = WAP_TILE_TYPE_SINGLE;
+            tileDesc.outsideAttrib = 0;
+        }
+        else
+        {
+            tileDesc.type = WAP_TILE_TYPE_DOUBLE;
+            tileDesc.outsideAttrib = std::stoi(pTileDescElem->FirstChildElement("OutsideAttrib")->GetText());
+        }
+        tileDesc.insideAttrib = std::stoi(pTileDescElem->FirstChildElement("InsideAttrib")->GetText());
+
+        TiXmlElement* pTileRectElem = pTileDescElem->FirstChildElement("TileRect");
+        tileDesc.rect.left = std::stoi(pTileRectElem->Attribute("left"));
+        tileDesc.rect.top = std::stoi(pTileRectElem->Attribute("top"));
+        tileDesc.rect.right = std::stoi(pTileRectElem->Attribute("right"));
+        tileDesc.rect.bottom = std::stoi(pTileRectElem->Attribute("bottom"));
+
+        AddTileDescription(tileDesc);
+    }
+
+    return true;
+}
+
+void LevelData::LoadPropertiesFromWwd(WapWwd* pWwd)
+{
+    m_LevelName = pWwd->properties.levelName;
+    m_LevelAuthor = pWwd->properties.author;
+    m_LevelCreatedDate = pWwd->properties.birth;
+
+    m_PalettePath = pWwd->properties.rezPalettePath;
+    std::replace(m_PalettePath.begin(), m_PalettePath.end(), '\\', '/');
+
+    m_TileDescriptionMap.clear();
+    m_TileCollisionPrototypeMap.clear();
+
+    // Same descriptions WwdToXml() would write
+    for (uint32 tileDescIdx = 0; tileDescIdx < pWwd->tileDescriptionsCount; tileDescIdx++)
+    {
+        const WwdTileDescription& wwdTileDesc = pWwd->tileDescriptions[tileDescIdx];
+
+        TileDescription tileDesc;
+        tileDesc.tileId = tileDescIdx;
+        tileDesc.type = wwdTileDesc.type;
+        tileDesc.width = wwdTileDesc.width;
+        tileDesc.height = wwdTileDesc.height;
+        tileDesc.insideAttrib = wwdTileDesc.insideAttrib;
+        if (wwdTileDesc.type == WAP_TILE_TYPE_SINGLE)
+        {
+            tileDesc.outsideAttrib = 0;
+            tileDesc.rect = { 0, 0, (int32)wwdTileDesc.width, (int32)wwdTileDesc.height };
+        }
+        else
+        {
+            tileDesc.outsideAttrib = wwdTileDesc.outsideAttrib;
+            tileDesc.rect = { (int32)wwdTileDesc.rect.left, (int32)wwdTileDesc.rect.top,
+                (int32)wwdTileDesc.rect.right, (int32)wwdTileDesc.rect.bottom };
+        }
+
+        AddTileDescription(tileDesc);
+    }
+
+    m_PlaneTiles.resize(pWwd->planesCount);
+    for (uint32 planeIdx = 0; planeIdx < pWwd->planesCount; planeIdx++)
+    {
+        const WwdPlane& wwdPlane = pWwd->planes[planeIdx];
+        m_PlaneTiles[planeIdx].assign(wwdPlane.tiles, wwdPlane.tiles + wwdPlane.tilesCount);
+    }
+}
+
+void LevelData::AddTileDescription(const TileDescription& tileDesc)
+{
+    // TileDescription will maybe be used by editor, it is not used directly by game
+    //    but only to parse TileCollisionPrototype from it which is used by physics subsystem
+    TileDescription& storedTileDesc = m_TileDescriptionMap.insert(std::make_pair(tileDesc.tileId, tileDesc)).first->second;
+
+    // This structure is actually used in game in order to prevent recalculating the collision rects
+    //    over and over again
+    TileCollisionPrototype tileProto;
+    tileProto.id = tileDesc.tileId;
+    tileProto.width = tileDesc.width;
+    tileProto.height = tileDesc.height;
+    Util::ParseCollisionRectanglesFromTile(&tileProto, &storedTileDesc);
+
+    m_TileCollisionPrototypeMap.insert(std::make_pair(tileProto.id, tileProto));
+}
+
+const std::vector<int32>* LevelData::GetPlaneTiles(uint32 planeIdx) const
+{
+    return planeIdx < m_PlaneTiles.size() ? &m_PlaneTiles[planeIdx] : NULL;
+}
+
+uint32 LevelData::CompileTileGeometry(const std::vector<int32>& tiles, int32 tilesOnAxisX, int32 tilesOnAxisY,
+    int32 tileWidth, int32 tileHeight, StaticGeometryList& geometry) const
+{
+    assert(tiles.size() >= (size_t)(tilesOnAxisX * tilesOnAxisY));
+
+    TileGeometryCompiler geometryCompiler(tilesOnAxisX, tilesOnAxisY, tileWidth, tileHeight);
+    for (int32 tileY = 0; tileY < tilesOnAxisY; tileY++)
+    {
+        for (int32 tileX = 0; tileX < tilesOnAxisX; tileX++)
+        {
+            int32 tileId = tiles[tileY * tilesOnAxisX + tileX];
+            if (tileId == -1)
+            {
+                continue;
+            }
+
+            auto findIt = m_TileCollisionPrototypeMap.find(tileId);
+            if (findIt == m_TileCollisionPrototypeMap.end())
+            {
+                LOG_WARNING("Unknown tile! Id = " + ToStr(tileId));
+                continue;
+            }
+
+            for (const TileCollisionRectangle& tileCollisionRect : findIt->second.collisionRectangles)
+            {
+                geometryCompiler.AddTileRect(tileX, tileY, tileCollisionRect.collisionType, tileCollisionRect.collisionRect);
+            }
+
+            // LEVEL1: Top of the ladder
+            if (m_LeveNumber == 1 && tileId == 310)
+            {
+                SDL_Rect groundRect = { tileX * tileWidth, tileY * tileHeight, 64, 10 };
+                geometryCompiler.AddRect(CollisionType_Ground, groundRect);
+            }
+            else if (m_LeveNumber == 2 && tileId == 16)
+            {
+                SDL_Rect groundRect = { tileX * tileWidth, tileY * tileHeight + 50, 64, 10 };
+                geometryCompiler.AddRect(CollisionType_Ground, groundRect);
+            }
+        }
+    }
+
+    geometryCompiler.Compile(geometry);
+    return geometryCompiler.GetNumAddedRects();
+}
+
+const StaticGeometryList* LevelData::GetCompiledTileGeometry(uint32& numTileCollisionRects) const
+{
+    numTileCollisionRects = m_NumTileCollisionRects;
+    return m_bHasTileGeometry ? &m_TileGeometry : NULL;
+}
+
+void LevelData::ClearLoadingData()
+{
+    m_PlaneTiles.clear();
+    StaticGeometryList().swap(m_TileGeometry);
+    m_NumTileCollisionRects = 0;
+    m_bHasTileGeometry = false;
+}
+
+const char* LevelData::GetBuildStamp()
+{
+    return __DATE__ " " __TIME__;
+}
+
 //=====================================================================================================================
 // Private
 //=====================================================================================================================
 
 void BaseGameLogic::RegisterAllDelegates()
 {
-    IEventMgr::Get()->VAddListener(MakeDelegate(this, &BaseGameLogic::CollideableTileCreatedDelegate), EventData_Collideable_Tile_Created::sk_EventType);
+    IEventMgr::Get()->VAddListener(MakeDelegate(this, &BaseGameLogic::CollideableTilePlaneCreatedDelegate), EventData_Collideable_Tile_Plane_Created::sk_EventType);
     IEventMgr::Get()->VAddListener(MakeDelegate(this, &BaseGameLogic::RequestDestroyActorDelegate), EventData_Destroy_Actor::sk_EventType);
     IEventMgr::Get()->VAddListener(MakeDelegate(this, &BaseGameLogic::CreateStaticGeometryDelegate), EventData_Add_Static_Geometry::sk_EventType);
 }
 
 void BaseGameLogic::RemoveAllDelegates()
 {
-    IEventMgr::Get()->VRemoveListener(MakeDelegate(this, &BaseGameLogic::CollideableTileCreatedDelegate), EventData_Collideable_Tile_Created::sk_EventType);
+    IEventMgr::Get()->VRemoveListener(MakeDelegate(this, &BaseGameLogic::CollideableTilePlaneCreatedDelegate), EventData_Collideable_Tile_Plane_Created::sk_EventType);
     IEventMgr::Get()->VRemoveListener(MakeDelegate(this, &BaseGameLogic::RequestDestroyActorDelegate), EventData_Destroy_Actor::sk_EventType);
     IEventMgr::Get()->VRemoveListener(MakeDelegate(this, &BaseGameLogic::CreateStaticGeometryDelegate), EventData_Add_Static_Geometry::sk_EventType);
 }
@@ -938,7 +1233,7 @@ void BaseGameLogic::LoadGameWorkerThread(const char* pXmlLevelPath, float* pProg
         StrongActorPtr pActor = VCreateActor(pActorElem, NULL);
         if (pActor)
         {
-            shared_ptr<EventData_New_Actor> pNewActorEvent(new EventData_New_Actor(pActor->GetGUID()));
+            shared_ptr<EventData_New_Actor> pNewActorEvent(MakeEvent<EventData_New_Actor>(pActor->GetGUID()));
             IEventMgr::Get()->VQueueEvent(pNewActorEvent);
 
             // Get Claw's GUID
@@ -975,24 +1270,24 @@ void BaseGameLogic::LoadGameWorkerThread(const char* pXmlLevelPath, float* pProg
 
     // Load claw stats: Score, Health, Lives, Ammo: Bullets, Magic, Dynamite
     IEventMgr* pEventMgr = IEventMgr::Get();
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Score, pCheckpointSave->score, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Health, pCheckpointSave->health, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Lives, pCheckpointSave->lives, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Bullets, pCheckpointSave->bulletCount, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Magic, pCheckpointSave->magicCount, false)));
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Modify_Player_Stat(clawId, PlayerStat_Dynamite, pCheckpointSave->dynamiteCount, false)));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Score, pCheckpointSave->score, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Health, pCheckpointSave->health, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Lives, pCheckpointSave->lives, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Bullets, pCheckpointSave->bulletCount, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Magic, pCheckpointSave->magicCount, false));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Modify_Player_Stat>(clawId, PlayerStat_Dynamite, pCheckpointSave->dynamiteCount, false));
     LOG("-------------");
     *pProgress = 97.0f;
 
     // Set claw to spawn location
     m_CurrentSpawnPosition = GetSpawnPosition(m_pCurrentLevel->m_LeveNumber, m_pCurrentLevel->m_LoadedCheckpoint);
-    //pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Teleport_Actor(clawId, m_CurrentSpawnPosition)));
+    //pEventMgr->VQueueEvent(MakeEvent<EventData_Teleport_Actor>(clawId, m_CurrentSpawnPosition));
 
     // Start playing background music
     std::string backgroundMusicPath = "/LEVEL" + ToStr(m_pCurrentLevel->GetLevelNumber()) +
         "/MUSIC/PLAY.XMI";
-    pEventMgr->VQueueEvent(IEventDataPtr(new EventData_Request_Play_Sound(
-        backgroundMusicPath, g_pApp->GetGameConfig()->musicVolume, true)));
+    pEventMgr->VQueueEvent(MakeEvent<EventData_Request_Play_Sound>(
+        backgroundMusicPath, g_pApp->GetGameConfig()->musicVolume, true));
 
     LOG("Level loaded !");
     LOG("Level name: " + m_pCurrentLevel->m_LevelName);
@@ -1,12 +1,20 @@
 #ifndef __BASE_GAME_LOGIC__
 #define __BASE_GAME_LOGIC__
 
+#include <libwap.h>
+
 #include "../SharedDefines.h"
 #include "../Process/ProcessMgr.h"
 #include "../Actor/Actor.h"
+#include "../Actor/ActorPool.h"
+#include "../Actor/ComponentUpdateScheduler.h"
+#include "../Actor/ActorActivityMgr.h"
+#include "../Physics/TileGeometryCompiler.h"
 #include "CommandHandler.h"
 
-typedef std::map<uint32, StrongActorPtr> ActorMap;
+// Nodes are pooled, adding and removing spawned actors does not touch the heap
+typedef std::map<uint32, StrongActorPtr, std::less<uint32>,
+    ActorPoolAllocator<std::pair<const uint32, StrongActorPtr>>> ActorMap;
 
 class GameSaveMgr;
 class LevelData;
@@ -46,6 +54,9 @@ public:
     // Actor management
     virtual StrongActorPtr VCreateActor(const std::string& xmlActorResource, TiXmlElement* overrides);
     virtual StrongActorPtr VCreateActor(TiXmlElement* pActorRoot, TiXmlElement* overrides);
+    // Runtime spawns, prefabs are kept by actor factory until next level is loaded
+    StrongActorPtr CreateActor(const ActorPrefab* pPrefab, const ActorPrefabOverrides& overrides);
+    ActorFactory* GetActorFactory() const { return m_pActorFactory; }
     virtual void VDestroyActor(const uint32 actorId);
     virtual WeakActorPtr VGetActor(const uint32 actorId);
     virtual void VModifyActor(const uint32 actorId, TiXmlElement* overrides);
@@ -58,6 +69,8 @@ public:
 
     // Subclasses can't override this function, they have to use VLoadGameDelegate() instead
     virtual bool VLoadGame(const char* xmlLevelResource);
+    // Loads level straight from Monolith's WWD without converting it to XML file first
+    bool LoadGameFromWwd(WapWwd* pWwd);
     virtual bool VEnterMenu(const char* xmlMenuResource);
     virtual void VSetProxy();
 
@@ -94,7 +107,7 @@ protected:
 
     void MoveActorDelegate(IEventDataPtr pEventData);
     void RequestNewActorDelegate(IEventDataPtr pEventData);
-    void CollideableTileCreatedDelegate(IEventDataPtr pEventData);
+    void CollideableTilePlaneCreatedDelegate(IEventDataPtr pEventData);
     void CreateStaticGeometryDelegate(IEventDataPtr pEventData);
     void RequestDestroyActorDelegate(IEventDataPtr pEventData);
 
@@ -103,6 +116,8 @@ protected:
     uint32 m_Lifetime;
     ProcessMgr* m_pProcessMgr;
     ActorMap m_ActorMap;
+    ComponentUpdateScheduler m_ComponentUpdateScheduler;
+    ActorActivityMgr m_ActorActivityMgr;
     uint32 m_LastActorId;
     GameState m_GameState;
 
@@ -125,7 +140,16 @@ protected:
 
     Point m_CurrentSpawnPosition;
 
+    // Tile collision rectangles and fixtures created from them for current level
+    uint32 m_NumTileCollisionRects;
+    uint32 m_NumTileGeometryRects;
+    double m_TileGeometryCompileMs;
+
 private:
+    // Common part of level loading, level properties are expected to be already in current level data.
+    // Takes ownership of the level root.
+    bool LoadLevel(TiXmlElement* pXmlLevelRoot);
+
     void ExecuteStartupCommands(const std::string& startupCommandsFile);
     
     //void LoadGameWorkerThread(const char* pXmlLevelPath, float* pProgress, bool* pRet);
@@ -178,6 +202,7 @@ typedef std::map<int32, TileCollisionPrototype> TileCollisionPrototypeMap;
 class LevelData
 {
     friend class BaseGameLogic;
+    friend class LevelCache;
 
 public:
     LevelData(int levelNumber, bool isNewGame, int loadedCheckpoint)
@@ -185,6 +210,8 @@ public:
         m_bIsNewGame = isNewGame;
         m_LeveNumber = levelNumber;
         m_LoadedCheckpoint = loadedCheckpoint;
+        m_NumTileCollisionRects = 0;
+        m_bHasTileGeometry = false;
     }
 
     LevelData()
@@ -196,8 +223,30 @@ public:
         m_bIsNewGame = true;
         m_LeveNumber = -1;
         m_LoadedCheckpoint = -1;
+        m_NumTileCollisionRects = 0;
+        m_bHasTileGeometry = false;
     }
 
+    // Fills level properties and tile descriptions from level XML or directly from WWD
+    bool LoadPropertiesFromXml(TiXmlElement* pXmlLevelRoot);
+    void LoadPropertiesFromWwd(WapWwd* pWwd);
+    void AddTileDescription(const TileDescription& tileDesc);
+
+    // Tiles of plane loaded from WWD, NULL if plane came with its tiles in XML
+    const std::vector<int32>* GetPlaneTiles(uint32 planeIdx) const;
+
+    // Merges collision rectangles of main plane tiles, returns number of rectangles which went in
+    uint32 CompileTileGeometry(const std::vector<int32>& tiles, int32 tilesOnAxisX, int32 tilesOnAxisY,
+        int32 tileWidth, int32 tileHeight, StaticGeometryList& geometry) const;
+    // Merged geometry of main plane taken from compiled level, NULL if it has to be compiled from tiles
+    const StaticGeometryList* GetCompiledTileGeometry(uint32& numTileCollisionRects) const;
+
+    // Plane tiles and compiled geometry are only needed while level is being loaded
+    void ClearLoadingData();
+
+    // Time LevelData was compiled, part of LevelCache::GetConverterVersion()
+    static const char* GetBuildStamp();
+
     std::string GetLevelName() const { return m_LevelName; }
     std::string GetLevelAuthor() const { return m_LevelAuthor; }
     std::string GetLevelCreatedDate() const { return m_LevelCreatedDate; }
@@ -208,6 +257,7 @@ private:
     std::string m_LevelName;
     std::string m_LevelAuthor;
     std::string m_LevelCreatedDate;
+    std::string m_PalettePath;
 
     bool m_bIsNewGame;
     uint32 m_LeveNumber;
@@ -215,6 +265,12 @@ private:
 
     TileDescriptionMap m_TileDescriptionMap;
     TileCollisionPrototypeMap m_TileCollisionPrototypeMap;
+
+    // Only kept while the level is being loaded
+    std::vector<std::vector<int32>> m_PlaneTiles;
+    StaticGeometryList m_TileGeometry;
+    uint32 m_NumTileCollisionRects;
+    bool m_bHasTileGeometry;
 };
 
 #endif
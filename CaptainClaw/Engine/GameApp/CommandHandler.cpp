@@ -1,14 +1,124 @@
+#include <thread>
+
 #include "BaseGameApp.h"
 #include "BaseGameLogic.h"
 #include "../UserInterface/Console.h"
+#include "../UserInterface/HumanView.h"
 
 #include "../Actor/Components/ControllerComponents/PowerupComponent.h"
+#include "../Actor/Components/PositionComponent.h"
 
 #include "../Events/EventMgr.h"
 #include "../Events/Events.h"
+#include "../Events/ThreadSafeEventQueue.h"
+#include "../Actor/ActorPool.h"
+
+#include "../Resource/ResourceCache.h"
+#include "../Resource/Loaders/DefaultLoader.h"
+#include "../Resource/Loaders/WwdLoader.h"
+#include "../Resource/Loaders/XmlLoader.h"
+#include "LevelCache.h"
+#include "../Actor/Components/RenderComponent.h"
+#include "../Util/Converters.h"
+#include "../Graphics2D/Image.h"
+#include "../Scene/TilePlaneSceneNode.h"
 
 std::vector<std::string> g_AvailableCheats;
 
+// Loads tiles of all planes of converted level, returns total number of tiles
+static uint32 LoadBenchmarkLevelTiles(TiXmlElement* pXmlLevelRoot, const LevelData* pLevelData)
+{
+    uint32 numTiles = 0;
+    for (TiXmlElement* pActorElem = pXmlLevelRoot->FirstChildElement("Actor");
+        pActorElem != NULL;
+        pActorElem = pActorElem->NextSiblingElement("Actor"))
+    {
+        TiXmlElement* pRenderComponentElem = pActorElem->FirstChildElement("TilePlaneRenderComponent");
+        TiXmlElement* pTilesElem = pRenderComponentElem ? pRenderComponentElem->FirstChildElement("Tiles") : NULL;
+        TileList xmlTileList;
+        const TileList* pTileList = pTilesElem ? TilePlaneRenderComponent::LoadTileList(pTilesElem, pLevelData, xmlTileList) : NULL;
+        if (pTileList != NULL)
+        {
+            numTiles += pTileList->size();
+        }
+    }
+
+    return numTiles;
+}
+
+// Spawns the same actors as a busy fight does - shots, hit animations, glitters, score popups and pickups. Each actor
+// is destroyed right away, returns number of spawned actors.
+static uint32 SpawnBenchmarkActors(uint32 numRounds, const Point& position)
+{
+    uint32 numSpawned = 0;
+    for (uint32 round = 0; round < numRounds; round++)
+    {
+        Direction direction = (round % 2 == 0) ? Direction_Right : Direction_Left;
+        StrongActorPtr spawnedActors[] =
+        {
+            ActorTemplates::CreateClawProjectile(AmmoType_Pistol, direction, position),
+            ActorTemplates::CreateSingleAnimation(position, AnimationType_RedHitPoint),
+            ActorTemplates::CreateGlitter("Glitter_Yellow", position),
+            ActorTemplates::CreateScorePopupActor(position, 100),
+            ActorTemplates::CreateActorPickup(PickupType_Treasure_Coins, position)
+        };
+
+        for (StrongActorPtr& pActor : spawnedActors)
+        {
+            if (pActor)
+            {
+                IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Destroy_Actor>(pActor->GetGUID()));
+                numSpawned++;
+            }
+        }
+    }
+
+    return numSpawned;
+}
+
+struct SpawnBenchmarkResult
+{
+    uint32 numSpawns;
+    uint32 numHeapAllocations;
+    double seconds;
+};
+
+// Adds spawning of numRounds rounds through one path to its result
+static void RunSpawnBenchmark(bool useActorPrefabs, uint32 numRounds, const Point& position, SpawnBenchmarkResult& result)
+{
+    ActorTemplates::SetUseActorPrefabs(useActorPrefabs);
+
+    uint32 numHeapAllocations = ActorPool::GetStats().numHeapAllocations;
+    uint64 startTime = SDL_GetPerformanceCounter();
+    result.numSpawns += SpawnBenchmarkActors(numRounds, position);
+    result.seconds += (SDL_GetPerformanceCounter() - startTime) / (double)SDL_GetPerformanceFrequency();
+    result.numHeapAllocations += ActorPool::GetStats().numHeapAllocations - numHeapAllocations;
+}
+
+static std::string GetBenchmarkResourceName(int32 num)
+{
+    return "/BENCH/IMAGES/ACTOR" + ToStr(num / 100) + "/FRAME" + ToStr(num % 100) + ".RAW";
+}
+
+// In-memory resource file used to benchmark resource cache itself without any I/O
+class BenchmarkResourceFile : public IResourceFile
+{
+public:
+    BenchmarkResourceFile(int32 numResources) : m_NumResources(numResources) { }
+
+    virtual bool VOpen() { return true; }
+    virtual std::string VGetName() const { return "BENCHMARK"; }
+    virtual int32 VGetRawResourceSize(Resource* r) { return sizeof(uint32); }
+    virtual int32 VGetRawResource(Resource* r, char* outBuffer) { memset(outBuffer, 0, sizeof(uint32)); return sizeof(uint32); }
+    virtual int32 VGetNumResources() const { return m_NumResources; }
+    virtual std::string VGetResourceName(int32 num) const { return GetBenchmarkResourceName(num); }
+    virtual bool VIsUsingDevelopmentDIrectories() const { return false; }
+    virtual std::vector<std::string> GetAllFilesInDirectory(const char* directoryPath) { return std::vector<std::string>(); }
+
+private:
+    int32 m_NumResources;
+};
+
 #define COMMAND_SET_BOOL_VALUE(targetCommandName, targetValue) \
 { \
     std::string targetCommandNameStr = std::string(targetCommandName); \
@@ -60,7 +170,7 @@ void CommandHandler::HandleCommand(const char* command, void* userdata)
         if (StrongActorPtr pClaw = g_pApp->GetGameLogic()->GetClawActor())
         {
             shared_ptr<PowerupComponent> pPowerupComponent =
-                MakeStrongPtr(pClaw->GetComponent<PowerupComponent>(PowerupComponent::g_Name));
+                MakeStrongPtr(pClaw->GetComponent<PowerupComponent>());
             assert(pPowerupComponent);
 
             pPowerupComponent->ApplyPowerup(PowerupType_Catnip, 30000);
@@ -76,7 +186,7 @@ void CommandHandler::HandleCommand(const char* command, void* userdata)
 
     if (commandStr == "reset level")
     {
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(new EventData_Request_Reset_Level));
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Reset_Level>());
         pConsole->AddLine("Requested level reset.", COLOR_GREEN);
         wasCommandExecuted = true;
     }
@@ -90,7 +200,7 @@ void CommandHandler::HandleCommand(const char* command, void* userdata)
 
             if (StrongActorPtr pClaw = g_pApp->GetGameLogic()->GetClawActor())
             {
-                shared_ptr<EventData_Teleport_Actor> pEvent(new EventData_Teleport_Actor(pClaw->GetGUID(), Point(x, y)));
+                shared_ptr<EventData_Teleport_Actor> pEvent(MakeEvent<EventData_Teleport_Actor>(pClaw->GetGUID(), Point(x, y)));
                 IEventMgr::Get()->VTriggerEvent(pEvent);
                 wasCommandExecuted = true;
             }
@@ -108,6 +218,599 @@ void CommandHandler::HandleCommand(const char* command, void* userdata)
         wasCommandExecuted = true;
     }
 
+    if (commandStr.find("bench match ") == 0 && commandArgs.size() == 3)
+    {
+        const std::string& pattern = commandArgs[2];
+        const int numIterations = 100;
+
+        ResourceCache* pResourceCache = g_pApp->GetResourceCache();
+
+        uint64 startTime = SDL_GetPerformanceCounter();
+        size_t numLinearMatches = 0;
+        for (int i = 0; i < numIterations; i++)
+        {
+            numLinearMatches = pResourceCache->MatchLinear(pattern).size();
+        }
+        uint64 linearTime = SDL_GetPerformanceCounter() - startTime;
+
+        startTime = SDL_GetPerformanceCounter();
+        size_t numIndexedMatches = 0;
+        for (int i = 0; i < numIterations; i++)
+        {
+            numIndexedMatches = pResourceCache->Match(pattern).size();
+        }
+        uint64 indexedTime = SDL_GetPerformanceCounter() - startTime;
+
+        uint64 frequency = SDL_GetPerformanceFrequency();
+        uint64 linearMicroseconds = (linearTime * 1000000) / (frequency * numIterations);
+        uint64 indexedMicroseconds = (indexedTime * 1000000) / (frequency * numIterations);
+
+        pConsole->AddLine("Linear: " + ToStr((unsigned long)linearMicroseconds) + " us, " +
+            ToStr((unsigned long)numLinearMatches) + " matches", COLOR_GREEN);
+        pConsole->AddLine("Indexed: " + ToStr((unsigned long)indexedMicroseconds) + " us, " +
+            ToStr((unsigned long)numIndexedMatches) + " matches", COLOR_GREEN);
+        wasCommandExecuted = true;
+    }
+
+    if (commandStr == "bench cache")
+    {
+        const int32 numResources = 10000;
+        const int32 numPasses = 100;
+        // Coprime with numResources so that every pass touches all resources in scattered order
+        const int32 stride = 7919;
+
+        ResourceCache benchCache(64, 0, new BenchmarkResourceFile(numResources), "BENCHMARK");
+        benchCache.Init();
+        benchCache.RegisterLoader(DefaultResourceLoader::Create());
+
+        std::vector<std::string> names;
+        std::vector<Resource> resources;
+        names.reserve(numResources);
+        resources.reserve(numResources);
+        for (int32 resourceIdx = 0; resourceIdx < numResources; resourceIdx++)
+        {
+            names.push_back(GetBenchmarkResourceName((resourceIdx * stride) % numResources));
+            resources.push_back(Resource(names.back()));
+            benchCache.GetHandle(&resources.back());
+        }
+
+        // Lookup and LRU touch only
+        uint64 startTime = SDL_GetPerformanceCounter();
+        for (int32 pass = 0; pass < numPasses; pass++)
+        {
+            for (Resource& resource : resources)
+            {
+                benchCache.GetHandle(&resource);
+            }
+        }
+        uint64 hitTime = SDL_GetPerformanceCounter() - startTime;
+
+        // Same as LoadAndReturn* helpers which build resource from its name on each call
+        startTime = SDL_GetPerformanceCounter();
+        for (int32 pass = 0; pass < numPasses; pass++)
+        {
+            for (const std::string& name : names)
+            {
+                Resource resource(name);
+                benchCache.GetHandle(&resource);
+            }
+        }
+        uint64 namedHitTime = SDL_GetPerformanceCounter() - startTime;
+
+        uint64 frequency = SDL_GetPerformanceFrequency();
+        uint64 numHits = (uint64)numResources * numPasses;
+        uint64 hitNanoseconds = (hitTime * 1000000000) / (frequency * numHits);
+        uint64 namedHitNanoseconds = (namedHitTime * 1000000000) / (frequency * numHits);
+
+        pConsole->AddLine("Resident: " + ToStr((unsigned long)benchCache.GetNumResidentResources()) + " resources", COLOR_GREEN);
+        pConsole->AddLine("Hit: " + ToStr((unsigned long)hitNanoseconds) + " ns", COLOR_GREEN);
+        pConsole->AddLine("Hit from name: " + ToStr((unsigned long)namedHitNanoseconds) + " ns", COLOR_GREEN);
+        wasCommandExecuted = true;
+    }
+
+    // e.g. "bench pid /level1/*.pid", level has to be loaded so that its palette is set
+    if (commandStr.find("bench pid ") == 0 && commandArgs.size() == 3)
+    {
+        ResourceCache* pResourceCache = g_pApp->GetResourceCache();
+        IResourceFile* pResourceFile = pResourceCache->GetResourceFile();
+        WapPal* pPalette = g_pApp->GetCurrentPalette();
+        SDL_Renderer* pRenderer = g_pApp->GetRenderer();
+        if (pPalette == NULL)
+        {
+            pConsole->AddLine("No palette is set, load level first", COLOR_RED);
+            return;
+        }
+
+        // Read everything up front so that only decoding and uploading is measured
+        std::vector<std::vector<char>> rawPids;
+        for (const std::string& pidPath : pResourceCache->Match(commandArgs[2]))
+        {
+            Resource resource(pidPath);
+            int32 rawSize = pResourceFile->VGetRawResourceSize(&resource);
+            if (rawSize <= 0)
+            {
+                continue;
+            }
+
+            rawPids.push_back(std::vector<char>(rawSize));
+            pResourceFile->VGetRawResource(&resource, rawPids.back().data());
+        }
+
+        uint64 oldDecodeTime = 0, oldTotalTime = 0, newDecodeTime = 0, newTotalTime = 0;
+        uint64 numPixels = 0;
+        uint32 numMismatches = 0;
+        PidPixelData pixelData;
+        for (std::vector<char>& rawPid : rawPids)
+        {
+            // Current path: WapPid -> surface pixel by pixel -> texture
+            uint64 startTime = SDL_GetPerformanceCounter();
+            WapPid* pPid = WAP_PidLoadFromData(rawPid.data(), rawPid.size(), pPalette);
+            oldDecodeTime += SDL_GetPerformanceCounter() - startTime;
+            if (pPid == NULL)
+            {
+                continue;
+            }
+            SDL_Texture* pTexture = Image::GetTextureFromPid(pPid, pRenderer);
+            oldTotalTime += SDL_GetPerformanceCounter() - startTime;
+            SDL_DestroyTexture(pTexture);
+
+            // Direct path: pitch-aligned pixels -> texture
+            startTime = SDL_GetPerformanceCounter();
+            bool decoded = Image::DecodePid(rawPid.data(), rawPid.size(), pPalette, pixelData);
+            newDecodeTime += SDL_GetPerformanceCounter() - startTime;
+            if (decoded)
+            {
+                pTexture = Image::GetTextureFromPidPixels(pixelData, pRenderer);
+                newTotalTime += SDL_GetPerformanceCounter() - startTime;
+                SDL_DestroyTexture(pTexture);
+
+                for (uint32 y = 0; y < pPid->height; y++)
+                {
+                    if (memcmp(&pPid->colors[y * pPid->width], &pixelData.pixels[y * (pixelData.pitch / sizeof(uint32_t))],
+                        pPid->width * sizeof(uint32_t)) != 0)
+                    {
+                        numMismatches++;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                numMismatches++;
+            }
+
+            numPixels += pPid->colorsCount;
+            WAP_PidDestroy(pPid);
+        }
+
+        uint64 frequency = SDL_GetPerformanceFrequency();
+        pConsole->AddLine("PIDs: " + ToStr((unsigned long)rawPids.size()) + ", pixels: " + ToStr((unsigned long)numPixels) +
+            ", mismatches: " + ToStr((unsigned long)numMismatches), COLOR_GREEN);
+        pConsole->AddLine("Current: decode " + ToStr((unsigned long)((oldDecodeTime * 1000000) / frequency)) + " us, total " +
+            ToStr((unsigned long)((oldTotalTime * 1000000) / frequency)) + " us", COLOR_GREEN);
+        pConsole->AddLine("Direct: decode " + ToStr((unsigned long)((newDecodeTime * 1000000) / frequency)) + " us, total " +
+            ToStr((unsigned long)((newTotalTime * 1000000) / frequency)) + " us", COLOR_GREEN);
+        wasCommandExecuted = true;
+    }
+
+    if (commandStr == "sound misses")
+    {
+        if (HumanView* pHumanView = g_pApp->GetHumanView())
+        {
+            pConsole->AddLine("Sound cache misses: " + ToStr((unsigned long)pHumanView->GetNumSoundCacheMisses()) + ", stalled: " +
+                ToStr((unsigned long)(pHumanView->GetSoundCacheMissTime() / 1000)) + " ms", COLOR_GREEN);
+        }
+        wasCommandExecuted = true;
+    }
+
+    if (commandStr == "cache residency")
+    {
+        ResourceCache* pResourceCache = g_pApp->GetResourceCache();
+
+        uint32 numResources = 0;
+        for (auto residencyIter : pResourceCache->GetResidencyByType())
+        {
+            const ResourceResidency& residency = residencyIter.second;
+            numResources += residency.numResources;
+
+            pConsole->AddLine(residencyIter.first + ": " + ToStr((unsigned long)residency.numResources) + " resources, " +
+                ToStr((unsigned long)(residency.memorySize / 1024)) + " kB memory, " +
+                ToStr((unsigned long)(residency.textureMemorySize / 1024)) + " kB texture", COLOR_GREEN);
+        }
+
+        pConsole->AddLine("Total: " + ToStr((unsigned long)numResources) + " resources, " +
+            ToStr((unsigned long)(pResourceCache->GetAllocated() / 1024)) + " / " +
+            ToStr((unsigned long)(pResourceCache->GetCacheSize() / 1024)) + " kB memory, " +
+            ToStr((unsigned long)(pResourceCache->GetTextureAllocated() / 1024)) + " / " +
+            ToStr((unsigned long)(pResourceCache->GetTextureCacheSize() / 1024)) + " kB texture", COLOR_GREEN);
+        wasCommandExecuted = true;
+    }
+
+    if (commandStr == "actor activity")
+    {
+        const ActorActivityMgr& activityMgr = g_pApp->GetGameLogic()->m_ActorActivityMgr;
+        pConsole->AddLine("Level objects: " + ToStr((unsigned long)activityMgr.GetNumTrackedActors()) + ", suspended: " +
+            ToStr((unsigned long)activityMgr.GetNumSuspendedActors()) + ", margin: " + ToStr(activityMgr.GetMargin()) + " px", COLOR_GREEN);
+        pConsole->AddLine("Updated components: " +
+            ToStr((unsigned long)g_pApp->GetGameLogic()->m_ComponentUpdateScheduler.GetNumScheduledComponents()), COLOR_GREEN);
+        wasCommandExecuted = true;
+    }
+
+    if (commandStr == "tile geometry")
+    {
+        const BaseGameLogic* pLogic = g_pApp->GetGameLogic();
+        pConsole->AddLine("Tile collision rectangles: " + ToStr((unsigned long)pLogic->m_NumTileCollisionRects) +
+            ", static fixtures: " + ToStr((unsigned long)pLogic->m_NumTileGeometryRects), COLOR_GREEN);
+        pConsole->AddLine("Merged in " + ToStr(pLogic->m_TileGeometryCompileMs) + " ms", COLOR_GREEN);
+        wasCommandExecuted = true;
+    }
+
+    if (commandStr == "scene stats")
+    {
+        HumanView* pHumanView = g_pApp->GetHumanView();
+        if (pHumanView && pHumanView->GetScene())
+        {
+            const char* passNames[] = { "Background", "Action", "Actor", "Foreground", "HUD" };
+            for (uint32 pass = RenderPass_0; pass < RenderPass_NotRendered; pass++)
+            {
+                const RenderPassNode* pPassNode = pHumanView->GetScene()->GetRenderPassNode((RenderPass)pass);
+                pConsole->AddLine(std::string(passNames[pass]) + ": " + ToStr((unsigned long)pPassNode->GetNumChildren()) +
+                    " nodes, visibility tests last frame: " + ToStr((unsigned long)pPassNode->GetNumLastVisibilityTests()), COLOR_GREEN);
+            }
+        }
+        pConsole->AddLine("Tile chunk textures: " + ToStr((unsigned long)SDL2TilePlaneSceneNode::GetNumAllChunkTextures()) + ", " +
+            ToStr((unsigned long)(SDL2TilePlaneSceneNode::GetAllChunkTexturesSize() / 1024)) + " kB", COLOR_GREEN);
+        wasCommandExecuted = true;
+    }
+
+    if (commandStr == "event stats")
+    {
+        const EventMgrFrameStats& frameStats = IEventMgr::Get()->VGetLastFrameStats();
+        pConsole->AddLine("Last frame: " + ToStr((unsigned long)frameStats.numTriggeredEvents) + " triggered, " +
+            ToStr((unsigned long)frameStats.numQueuedEvents) + " queued, " +
+            ToStr((unsigned long)frameStats.numDeliveredEvents) + " delivered events", COLOR_GREEN);
+        pConsole->AddLine("Last frame allocations: " + ToStr((unsigned long)frameStats.numAllocatedEvents) + " events, " +
+            ToStr((unsigned long)frameStats.numAllocatedBytes) + " bytes", COLOR_GREEN);
+
+        EventPool::Stats poolStats = EventPool::GetStats();
+        pConsole->AddLine("Event pool: " + ToStr((unsigned long)poolStats.numBlocksInUse) + " blocks in use, " +
+            ToStr((unsigned long)(poolStats.numReservedBytes / 1024)) + " kB reserved", COLOR_GREEN);
+
+        uint32 avgLatencyUs = frameStats.numThreadSafeEvents > 0 ?
+            (uint32)(frameStats.totalThreadSafeLatencyUs / frameStats.numThreadSafeEvents) : 0;
+        pConsole->AddLine("Last frame from other threads: " + ToStr((unsigned long)frameStats.numThreadSafeEvents) +
+            " events, latency avg: " + ToStr((unsigned long)avgLatencyUs) + " us, max: " +
+            ToStr((unsigned long)frameStats.maxThreadSafeLatencyUs) + " us, dropped since start: " +
+            ToStr((unsigned long)frameStats.numDroppedThreadSafeEvents), COLOR_GREEN);
+        wasCommandExecuted = true;
+    }
+
+    if (commandStr == "actor pool stats")
+    {
+        ActorPool::Stats poolStats = ActorPool::GetStats();
+        pConsole->AddLine("Last frame allocations: " + ToStr((unsigned long)poolStats.numLastFrameAllocations) + " pooled, " +
+            ToStr((unsigned long)poolStats.numLastFrameHeapAllocations) + " pool heap allocations", COLOR_GREEN);
+        pConsole->AddLine("Since start: " + ToStr((unsigned long)poolStats.numAllocations) + " pooled, " +
+            ToStr((unsigned long)poolStats.numHeapAllocations) + " pool heap allocations", COLOR_GREEN);
+        pConsole->AddLine("Actor pool: " + ToStr((unsigned long)poolStats.numBlocksInUse) + " blocks in use, " +
+            ToStr((unsigned long)(poolStats.numReservedBytes / 1024)) + " kB reserved", COLOR_GREEN);
+        if (ActorPool::CountsNewCalls())
+        {
+            pConsole->AddLine("All heap allocations on main thread: " + ToStr((unsigned long)poolStats.numLastFrameNewCalls) +
+                " last frame, " + ToStr((unsigned long)poolStats.numNewCalls) + " since start", COLOR_GREEN);
+        }
+        else
+        {
+            pConsole->AddLine("Heap allocations outside of actor pool are not counted, build with ActorPoolStats", COLOR_RED);
+        }
+        wasCommandExecuted = true;
+    }
+
+    // e.g. "bench levelload 3", compares loading level data through XML file written to temp directory
+    // with loading it straight from WWD and from compiled level. Only level properties, tile descriptions
+    // and tiles are loaded, actors are created from XML the same way on all paths
+    if (commandStr.find("bench levelload ") == 0 && commandArgs.size() == 3)
+    {
+        int levelNumber = std::stoi(commandArgs[2]);
+        if (levelNumber < 1 || levelNumber > 14)
+        {
+            pConsole->AddLine("Level number has to be 1-14", COLOR_RED);
+            return;
+        }
+
+        std::string levelName = "LEVEL" + ToStr(levelNumber);
+        std::string wwdPath = "/" + levelName + "/WORLDS/WORLD.WWD";
+        WapWwd* pWwd = WwdResourceLoader::LoadAndReturnWwd(wwdPath.c_str());
+        if (pWwd == NULL)
+        {
+            pConsole->AddLine("Could not load WWD of " + levelName, COLOR_RED);
+            return;
+        }
+
+        // XML path: WWD -> XML file -> parsed XML -> level data
+        std::string xmlLevelPath = g_pApp->GetGameConfig()->tempDir + "/" + levelName + "_BENCH.xml";
+        uint64 startTime = SDL_GetPerformanceCounter();
+        {
+            TiXmlDocument xmlDoc;
+            xmlDoc.LinkEndChild(WwdToXml(pWwd));
+            xmlDoc.SaveFile(xmlLevelPath.c_str());
+        }
+        uint64 xmlWriteTime = SDL_GetPerformanceCounter() - startTime;
+
+        TiXmlElement* pXmlLevelRoot = XmlResourceLoader::LoadAndReturnRootXmlElement(xmlLevelPath.c_str(), true);
+        if (pXmlLevelRoot == NULL)
+        {
+            pConsole->AddLine("Could not read " + xmlLevelPath, COLOR_RED);
+            return;
+        }
+        LevelData xmlLevelData;
+        xmlLevelData.LoadPropertiesFromXml(pXmlLevelRoot);
+        uint32 numXmlTiles = LoadBenchmarkLevelTiles(pXmlLevelRoot, &xmlLevelData);
+        uint64 xmlTime = SDL_GetPerformanceCounter() - startTime;
+        SAFE_DELETE(pXmlLevelRoot);
+        std::remove(xmlLevelPath.c_str());
+
+        // Direct path: WWD -> level data, XML only for actors
+        startTime = SDL_GetPerformanceCounter();
+        LevelData wwdLevelData;
+        wwdLevelData.LoadPropertiesFromWwd(pWwd);
+        pXmlLevelRoot = WwdToXml(pWwd, false);
+        uint32 numWwdTiles = LoadBenchmarkLevelTiles(pXmlLevelRoot, &wwdLevelData);
+        uint64 wwdTime = SDL_GetPerformanceCounter() - startTime;
+        SAFE_DELETE(pXmlLevelRoot);
+
+        // Compiled path: WWD hash -> mapped compiled level -> level data, compiled first if it is missing
+        const std::string& levelCacheDir = g_pApp->GetGameConfig()->levelCacheDir;
+        LevelCache::RawWwd rawWwd;
+        if (!levelCacheDir.empty() && LevelCache::ReadWwdResource(wwdPath, rawWwd))
+        {
+            LevelData compiledLevelData;
+            TiXmlElement* pCompiledLevelRoot = LevelCache::Load(rawWwd.hash, levelCacheDir, &compiledLevelData);
+            if (pCompiledLevelRoot == NULL)
+            {
+                LevelCache::Compile(pWwd, rawWwd.hash, levelNumber, levelCacheDir);
+            }
+            SAFE_DELETE(pCompiledLevelRoot);
+        }
+
+        startTime = SDL_GetPerformanceCounter();
+        LevelData compiledLevelData;
+        pXmlLevelRoot = !levelCacheDir.empty() && LevelCache::ReadWwdResource(wwdPath, rawWwd) ?
+            LevelCache::Load(rawWwd.hash, levelCacheDir, &compiledLevelData) : NULL;
+        uint32 numCompiledTiles = pXmlLevelRoot ? LoadBenchmarkLevelTiles(pXmlLevelRoot, &compiledLevelData) : 0;
+        uint64 compiledTime = SDL_GetPerformanceCounter() - startTime;
+        SAFE_DELETE(pXmlLevelRoot);
+
+        double counterFrequency = (double)SDL_GetPerformanceFrequency();
+        double xmlMs = xmlTime * 1000.0 / counterFrequency;
+        double wwdMs = wwdTime * 1000.0 / counterFrequency;
+        double compiledMs = compiledTime * 1000.0 / counterFrequency;
+
+        pConsole->AddLine(levelName + ": " + ToStr(numWwdTiles) + " tiles", COLOR_GREEN);
+        pConsole->AddLine("XML: " + ToStr(xmlMs) + " ms (writing file " + ToStr(xmlWriteTime * 1000.0 / counterFrequency) + " ms)", COLOR_GREEN);
+        pConsole->AddLine("WWD: " + ToStr(wwdMs) + " ms", COLOR_GREEN);
+        pConsole->AddLine("Speedup: " + ToStr(xmlMs / max(wwdMs, 0.001)) + "x", COLOR_GREEN);
+        if (numCompiledTiles > 0)
+        {
+            pConsole->AddLine("Compiled: " + ToStr(compiledMs) + " ms, speedup: " + ToStr(xmlMs / max(compiledMs, 0.001)) + "x", COLOR_GREEN);
+        }
+        else
+        {
+            pConsole->AddLine("Compiled: level cache is disabled or not writable", COLOR_RED);
+        }
+        if (numXmlTiles != numWwdTiles || (numCompiledTiles > 0 && numCompiledTiles != numWwdTiles))
+        {
+            pConsole->AddLine("Tile count mismatch: " + ToStr(numXmlTiles) + " vs " + ToStr(numWwdTiles) + " vs " + ToStr(numCompiledTiles), COLOR_RED);
+        }
+        wasCommandExecuted = true;
+    }
+
+    // e.g. "bench spawn 1000", spawns 1000 rounds of runtime actors next to Claw from their XML data and from
+    // prefabs. Both paths are warmed up first and then run in alternating batches, so neither of them pays for
+    // building prefabs, loading resources or growing pools and neither always runs first.
+    if (commandStr.find("bench spawn ") == 0 && commandArgs.size() == 3)
+    {
+        StrongActorPtr pClaw = g_pApp->GetGameLogic()->GetClawActor();
+        if (!pClaw)
+        {
+            pConsole->AddLine("Claw is not yet created, cannot spawn actors", COLOR_RED);
+            return;
+        }
+
+        const uint32 numRounds = max(1, std::stoi(commandArgs[2]));
+        const Point position = pClaw->GetPositionComponent()->GetPosition() + Point(0, -200);
+        const bool usedActorPrefabs = ActorTemplates::GetUseActorPrefabs();
+        const uint32 numBatches = std::min(numRounds, (uint32)10);
+
+        // Builds the prefabs and brings resources and pools of both paths to the same state
+        SpawnBenchmarkResult warmupResult = { 0, 0, 0.0 };
+        RunSpawnBenchmark(false, 1, position, warmupResult);
+        RunSpawnBenchmark(true, 1, position, warmupResult);
+
+        SpawnBenchmarkResult xmlResult = { 0, 0, 0.0 };
+        SpawnBenchmarkResult prefabResult = { 0, 0, 0.0 };
+        for (uint32 batchIdx = 0; batchIdx < numBatches; batchIdx++)
+        {
+            uint32 numBatchRounds = numRounds / numBatches + (batchIdx < numRounds % numBatches ? 1 : 0);
+            bool isXmlFirst = batchIdx % 2 == 0;
+            RunSpawnBenchmark(!isXmlFirst, numBatchRounds, position, isXmlFirst ? xmlResult : prefabResult);
+            RunSpawnBenchmark(isXmlFirst, numBatchRounds, position, isXmlFirst ? prefabResult : xmlResult);
+        }
+
+        ActorTemplates::SetUseActorPrefabs(usedActorPrefabs);
+
+        double xmlSpawnsPerSecond = xmlResult.numSpawns / max(xmlResult.seconds, 0.000001);
+        double prefabSpawnsPerSecond = prefabResult.numSpawns / max(prefabResult.seconds, 0.000001);
+
+        pConsole->AddLine("XML: " + ToStr(xmlResult.numSpawns) + " actors, " + ToStr((int)xmlSpawnsPerSecond) + " spawns/s, " +
+            ToStr(xmlResult.numHeapAllocations) + " actor pool heap allocations", COLOR_GREEN);
+        pConsole->AddLine("Prefab: " + ToStr(prefabResult.numSpawns) + " actors, " + ToStr((int)prefabSpawnsPerSecond) + " spawns/s, " +
+            ToStr(prefabResult.numHeapAllocations) + " actor pool heap allocations", COLOR_GREEN);
+        pConsole->AddLine("Speedup: " + ToStr(prefabSpawnsPerSecond / max(xmlSpawnsPerSecond, 1.0)) + "x", COLOR_GREEN);
+        wasCommandExecuted = true;
+    }
+
+    // e.g. "bench eventqueue 8 100000", 8 threads push 100000 events each to a thread safe queue which this
+    // thread drains, checks that nothing was lost or reordered and measures how long events waited
+    if (commandStr.find("bench eventqueue ") == 0 && commandArgs.size() == 4)
+    {
+        const uint32 numProducers = max(1, std::stoi(commandArgs[2]));
+        const uint32 numEventsPerProducer = max(1, std::stoi(commandArgs[3]));
+        const uint32 numEvents = numProducers * numEventsPerProducer;
+
+        // Small queue so that producers keep running into a full queue
+        ThreadSafeEventQueue queue(1024);
+        std::atomic<uint32> numFullQueueRetries(0);
+
+        uint64 frequency = SDL_GetPerformanceFrequency();
+        uint64 startTime = SDL_GetPerformanceCounter();
+
+        std::vector<std::thread> producers;
+        for (uint32 producerIdx = 0; producerIdx < numProducers; producerIdx++)
+        {
+            producers.push_back(std::thread([&queue, &numFullQueueRetries, producerIdx, numEventsPerProducer]()
+            {
+                for (uint32 eventIdx = 0; eventIdx < numEventsPerProducer; eventIdx++)
+                {
+                    // Actor id says who sent it and position in which order
+                    IEventDataPtr pEvent = MakeEvent<EventData_Move_Actor>(producerIdx, Point(eventIdx, 0));
+                    while (!queue.TryPush(pEvent))
+                    {
+                        numFullQueueRetries++;
+                        std::this_thread::yield();
+                    }
+                }
+            }));
+        }
+
+        std::vector<uint32> nextEventIdx(numProducers, 0);
+        uint32 numReceived = 0;
+        uint32 numOutOfOrder = 0;
+        uint64 totalLatency = 0;
+        uint64 maxLatency = 0;
+        IEventDataPtr pEvent;
+        uint64 pushTime = 0;
+        while (numReceived < numEvents)
+        {
+            if (!queue.TryPop(pEvent, pushTime))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            uint64 latency = SDL_GetPerformanceCounter() - pushTime;
+            totalLatency += latency;
+            maxLatency = max(maxLatency, latency);
+
+            shared_ptr<EventData_Move_Actor> pMoveEvent = static_pointer_cast<EventData_Move_Actor>(pEvent);
+            uint32 producerIdx = pMoveEvent->GetActorId();
+            if ((uint32)pMoveEvent->GetMove().x != nextEventIdx[producerIdx])
+            {
+                numOutOfOrder++;
+            }
+            nextEventIdx[producerIdx] = (uint32)pMoveEvent->GetMove().x + 1;
+            numReceived++;
+        }
+        pEvent.reset();
+
+        uint64 elapsedTime = SDL_GetPerformanceCounter() - startTime;
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+
+        bool isEmpty = !queue.TryPop(pEvent, pushTime);
+        pConsole->AddLine(ToStr((unsigned long)numReceived) + " events from " + ToStr((unsigned long)numProducers) + " threads in " +
+            ToStr((unsigned long)((elapsedTime * 1000) / frequency)) + " ms, " +
+            ToStr((unsigned long)((uint64)numReceived * frequency / max(elapsedTime, (uint64)1) / 1000)) + "k events/s", COLOR_GREEN);
+        pConsole->AddLine("Latency avg: " + ToStr((unsigned long)((totalLatency * 1000000) / (frequency * numReceived))) +
+            " us, max: " + ToStr((unsigned long)((maxLatency * 1000000) / frequency)) + " us, full queue retries: " +
+            ToStr((unsigned long)numFullQueueRetries.load()), COLOR_GREEN);
+        pConsole->AddLine("Out of order: " + ToStr((unsigned long)numOutOfOrder) + ", left in queue: " + (isEmpty ? "0" : "some"),
+            (numOutOfOrder == 0 && isEmpty) ? COLOR_GREEN : COLOR_RED);
+        wasCommandExecuted = true;
+    }
+
+    // e.g. "bench update 2000", spawns 2000 pickups and 2000 enemies in 4 steps and compares
+    // per-actor update of all components with scheduled update of only those which need it
+    if (commandStr.find("bench update ") == 0 && commandArgs.size() == 3)
+    {
+        BaseGameLogic* pGameLogic = g_pApp->GetGameLogic();
+        StrongActorPtr pClaw = pGameLogic->GetClawActor();
+        if (!pClaw)
+        {
+            pConsole->AddLine("Level has to be loaded to spawn actors", COLOR_RED);
+            return;
+        }
+
+        const int32 numSteps = 4;
+        const int32 numTicks = 50;
+        const uint32 tickMs = 10;
+        int32 numActorsPerStep = max(1, std::stoi(commandArgs[2]) / numSteps);
+
+        // Enemies need level's image set, there are only pickups if this level does not have officers
+        Point spawnOrigin = pClaw->GetPositionComponent()->GetPosition();
+        std::string enemyImageSet = "/LEVEL" + ToStr((int)pGameLogic->GetCurrentLevelData()->GetLevelNumber()) + "/IMAGES/OFFICER/*";
+        std::string enemyAnimationSet = enemyImageSet;
+        enemyAnimationSet.replace(enemyAnimationSet.find("/IMAGES/"), strlen("/IMAGES/"), "/ANIS/");
+        bool canSpawnEnemies = !g_pApp->GetResourceCache()->Match(enemyImageSet).empty();
+
+        std::vector<uint32> spawnedActorIds;
+        uint64 frequency = SDL_GetPerformanceFrequency();
+        for (int32 step = 0; step < numSteps; step++)
+        {
+            for (int32 actorIdx = 0; actorIdx < numActorsPerStep; actorIdx++)
+            {
+                int32 spawnIdx = step * numActorsPerStep + actorIdx;
+                Point spawnPosition(spawnOrigin.x + (spawnIdx % 100) * 64, spawnOrigin.y - 2000 - (spawnIdx / 100) * 128);
+
+                if (StrongActorPtr pPickup = ActorTemplates::CreateActorPickup(PickupType_Treasure_Coins, spawnPosition, true))
+                {
+                    spawnedActorIds.push_back(pPickup->GetGUID());
+                }
+
+                if (canSpawnEnemies)
+                {
+                    TiXmlElement* pEnemyXml = ActorTemplates::CreateXmlData_EnemyAIActor(enemyImageSet, enemyAnimationSet,
+                        spawnPosition + Point(0, 64), std::vector<PickupType>(), "Officer", 1000, spawnPosition.x - 100, spawnPosition.x + 100);
+                    if (StrongActorPtr pEnemy = pGameLogic->VCreateActor(pEnemyXml, NULL))
+                    {
+                        spawnedActorIds.push_back(pEnemy->GetGUID());
+                        IEventMgr::Get()->VQueueEvent(MakeEvent<EventData_New_Actor>(pEnemy->GetGUID()));
+                    }
+                }
+            }
+
+            uint64 perActorTime = 0;
+            uint64 scheduledTime = 0;
+            for (int32 tick = 0; tick < numTicks; tick++)
+            {
+                uint64 startTime = SDL_GetPerformanceCounter();
+                for (const auto& actorPair : pGameLogic->m_ActorMap)
+                {
+                    actorPair.second->Update(tickMs);
+                }
+                perActorTime += SDL_GetPerformanceCounter() - startTime;
+
+                startTime = SDL_GetPerformanceCounter();
+                pGameLogic->m_ComponentUpdateScheduler.Update(tickMs);
+                scheduledTime += SDL_GetPerformanceCounter() - startTime;
+            }
+
+            pConsole->AddLine("Actors: " + ToStr((unsigned long)pGameLogic->m_ActorMap.size()) + ", updated components: " +
+                ToStr((unsigned long)pGameLogic->m_ComponentUpdateScheduler.GetNumScheduledComponents()) +
+                ", per actor: " + ToStr((unsigned long)((perActorTime * 1000000) / (frequency * numTicks))) + " us/tick" +
+                ", scheduled: " + ToStr((unsigned long)((scheduledTime * 1000000) / (frequency * numTicks))) + " us/tick", COLOR_GREEN);
+        }
+
+        // Queued after their creation events so that views see them created first
+        for (uint32 actorId : spawnedActorIds)
+        {
+            IEventMgr::Get()->VQueueEvent(MakeEvent<EventData_Destroy_Actor>(actorId));
+        }
+        wasCommandExecuted = true;
+    }
+
     if (!wasCommandExecuted)
     {
         pConsole->AddLine("Unknown command: \"" + commandStr + "\"", COLOR_RED);
@@ -0,0 +1,843 @@
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+#include "LevelCache.h"
+#include "BaseGameApp.h"
+#include "BaseGameLogic.h"
+#include "GameSaves.h"
+#include "../Actor/ActorTemplates.h"
+#include "../Physics/TileGeometryCompiler.h"
+#include "../Resource/Loaders/WwdLoader.h"
+#include "../Util/Converters.h"
+#include "../Util/Util.h"
+
+//=====================================================================================================================
+// File layout
+//
+//    LevelCacheHeader, then one LevelCacheSection per LevelCacheSectionType, then data of the sections. Every section
+//    starts at 8 byte boundary and all structures consist only of 32 and 64 bit fields so that the arrays can be read
+//    straight from the mapped file.
+//
+//    Level XML is stored as its nodes in document order, each node followed by its children. Node names, attributes
+//    and texts are indices into one blob of null terminated strings, attributes of all elements are stored in one
+//    array in the same order as the elements.
+//=====================================================================================================================
+
+static const char LEVEL_CACHE_MAGIC[4] = { 'C', 'L', 'V', 'L' };
+
+enum LevelCacheSectionType
+{
+    LevelCacheSection_Properties,
+    LevelCacheSection_Strings,
+    LevelCacheSection_TileDescriptions,
+    LevelCacheSection_CollisionPrototypes,
+    LevelCacheSection_CollisionRectangles,
+    LevelCacheSection_Planes,
+    LevelCacheSection_Tiles,
+    LevelCacheSection_TileGeometry,
+    LevelCacheSection_XmlStrings,
+    LevelCacheSection_XmlNodes,
+    LevelCacheSection_XmlAttributes,
+    LevelCacheSection_Count
+};
+
+struct LevelCacheHeader
+{
+    char magic[4];
+    uint32 version;
+    uint64 wwdHash;
+    uint64 converterVersion;
+    uint32 fileSize;
+    uint32 numSections;
+};
+
+struct LevelCacheSection
+{
+    uint32 offset;
+    uint32 size;
+    uint32 count;
+    uint32 reserved;
+};
+
+struct CachedLevelProperties
+{
+    int32 spawnX;
+    int32 spawnY;
+    uint32 numTileCollisionRects;
+    uint32 hasTileGeometry;
+};
+
+struct CachedTileDescription
+{
+    int32 tileId;
+    int32 type;
+    int32 width;
+    int32 height;
+    int32 insideAttrib;
+    int32 outsideAttrib;
+    TileRect rect;
+};
+
+struct CachedCollisionPrototype
+{
+    int32 id;
+    uint32 width;
+    uint32 height;
+    uint32 firstRectIdx;
+    uint32 numRects;
+};
+
+struct CachedCollisionRectangle
+{
+    int32 collisionType;
+    SDL_Rect rect;
+};
+
+struct CachedPlane
+{
+    uint32 firstTileIdx;
+    uint32 numTiles;
+};
+
+enum CachedXmlNodeType
+{
+    CachedXmlNode_Element,
+    CachedXmlNode_Text,
+    CachedXmlNode_CData
+};
+
+struct CachedXmlNode
+{
+    int32 type;
+    // Name of element or the text
+    uint32 valueIdx;
+    uint32 numAttributes;
+    uint32 numChildren;
+};
+
+struct CachedXmlAttribute
+{
+    uint32 nameIdx;
+    uint32 valueIdx;
+};
+
+static const uint32 LEVEL_CACHE_DATA_OFFSET = sizeof(LevelCacheHeader) + LevelCacheSection_Count * sizeof(LevelCacheSection);
+
+//=====================================================================================================================
+// Writing
+//=====================================================================================================================
+
+template <class T>
+static void AppendSection(std::vector<char>& buffer, LevelCacheSectionType type, const T* pData, uint32 count)
+{
+    buffer.resize((buffer.size() + 7) & ~(size_t)7);
+
+    LevelCacheSection section = { (uint32)buffer.size(), (uint32)(count * sizeof(T)), count, 0 };
+    memcpy(&buffer[sizeof(LevelCacheHeader) + type * sizeof(LevelCacheSection)], &section, sizeof(section));
+
+    const char* pBytes = reinterpret_cast<const char*>(pData);
+    buffer.insert(buffer.end(), pBytes, pBytes + section.size);
+}
+
+static void AppendString(std::vector<char>& strings, const std::string& str)
+{
+    strings.insert(strings.end(), str.c_str(), str.c_str() + str.length() + 1);
+}
+
+struct CachedXmlTree
+{
+    std::vector<char> strings;
+    std::vector<CachedXmlNode> nodes;
+    std::vector<CachedXmlAttribute> attributes;
+
+    // Actor XML repeats the same names and values over and over, each string is stored only once
+    std::unordered_map<std::string, uint32> stringIdxMap;
+};
+
+static uint32 AddXmlString(CachedXmlTree& tree, const char* str)
+{
+    auto findIt = tree.stringIdxMap.find(str);
+    if (findIt != tree.stringIdxMap.end())
+    {
+        return findIt->second;
+    }
+
+    uint32 stringIdx = tree.strings.size();
+    AppendString(tree.strings, str);
+    tree.stringIdxMap.insert(std::make_pair(std::string(str), stringIdx));
+
+    return stringIdx;
+}
+
+// Comments and declarations are dropped, nothing reads them
+static bool IsCachedXmlNode(const TiXmlNode* pNode)
+{
+    return pNode->ToElement() != NULL || pNode->ToText() != NULL;
+}
+
+static void AppendXmlNode(CachedXmlTree& tree, const TiXmlNode* pNode)
+{
+    CachedXmlNode cachedNode = { CachedXmlNode_Element, AddXmlString(tree, pNode->Value()), 0, 0 };
+
+    if (const TiXmlText* pText = pNode->ToText())
+    {
+        cachedNode.type = pText->CDATA() ? CachedXmlNode_CData : CachedXmlNode_Text;
+        tree.nodes.push_back(cachedNode);
+        return;
+    }
+
+    for (const TiXmlAttribute* pAttr = pNode->ToElement()->FirstAttribute(); pAttr; pAttr = pAttr->Next())
+    {
+        CachedXmlAttribute cachedAttr = { AddXmlString(tree, pAttr->Name()), AddXmlString(tree, pAttr->Value()) };
+        tree.attributes.push_back(cachedAttr);
+        cachedNode.numAttributes++;
+    }
+
+    for (const TiXmlNode* pChild = pNode->FirstChild(); pChild; pChild = pChild->NextSibling())
+    {
+        if (IsCachedXmlNode(pChild))
+        {
+            cachedNode.numChildren++;
+        }
+    }
+
+    tree.nodes.push_back(cachedNode);
+
+    for (const TiXmlNode* pChild = pNode->FirstChild(); pChild; pChild = pChild->NextSibling())
+    {
+        if (IsCachedXmlNode(pChild))
+        {
+            AppendXmlNode(tree, pChild);
+        }
+    }
+}
+
+//=====================================================================================================================
+// Reading
+//=====================================================================================================================
+
+// Read-only view of a whole file, memory is only paged in as sections are touched
+class MappedFile
+{
+public:
+    MappedFile() : m_pData(NULL), m_Size(0) { }
+    ~MappedFile() { Close(); }
+
+    bool Open(const std::string& path, uint32 minSize)
+    {
+#ifdef _WIN32
+        HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (hFile == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        HANDLE hMapping = NULL;
+        if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart >= (LONGLONG)minSize && fileSize.QuadPart <= UINT32_MAX)
+        {
+            hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        }
+        // View keeps both the mapping and the file open
+        CloseHandle(hFile);
+        if (hMapping == NULL)
+        {
+            return false;
+        }
+
+        m_pData = static_cast<const char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(hMapping);
+        if (m_pData == NULL)
+        {
+            return false;
+        }
+        m_Size = (uint32)fileSize.QuadPart;
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStat;
+        void* pData = MAP_FAILED;
+        if (fstat(fd, &fileStat) == 0 && (uint64)fileStat.st_size >= minSize && (uint64)fileStat.st_size <= UINT32_MAX)
+        {
+            pData = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        // Mapping keeps the file open
+        close(fd);
+        if (pData == MAP_FAILED)
+        {
+            return false;
+        }
+
+        m_pData = static_cast<const char*>(pData);
+        m_Size = (uint32)fileStat.st_size;
+#endif
+        return true;
+    }
+
+    void Close()
+    {
+        if (m_pData == NULL)
+        {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(m_pData);
+#else
+        munmap(const_cast<char*>(m_pData), m_Size);
+#endif
+        m_pData = NULL;
+        m_Size = 0;
+    }
+
+    const char* GetData() const { return m_pData; }
+    uint32 GetSize() const { return m_Size; }
+
+private:
+    const char* m_pData;
+    uint32 m_Size;
+};
+
+template <class T>
+static const T* GetSection(const MappedFile& file, LevelCacheSectionType type, uint32& count)
+{
+    LevelCacheSection section;
+    memcpy(&section, file.GetData() + sizeof(LevelCacheHeader) + type * sizeof(LevelCacheSection), sizeof(section));
+
+    if (section.offset < LEVEL_CACHE_DATA_OFFSET || section.offset > file.GetSize() || section.offset % 8 != 0 ||
+        section.size > file.GetSize() - section.offset || (uint64)section.count * sizeof(T) != section.size)
+    {
+        return NULL;
+    }
+
+    count = section.count;
+    return reinterpret_cast<const T*>(file.GetData() + section.offset);
+}
+
+// Returns NULL if there is no terminated string left
+static const char* ReadString(const char*& pStrings, const char* pStringsEnd)
+{
+    const char* pStr = pStrings;
+    const char* pTerminator = static_cast<const char*>(memchr(pStr, '\0', pStringsEnd - pStr));
+    if (pTerminator == NULL)
+    {
+        return NULL;
+    }
+
+    pStrings = pTerminator + 1;
+    return pStr;
+}
+
+// Builds XML tree straight from cached nodes, returns NULL if they do not form exactly one element tree
+static TiXmlElement* ReadXmlTree(const char* pStrings, uint32 numStringBytes, const CachedXmlNode* pNodes,
+    uint32 numNodes, const CachedXmlAttribute* pAttributes, uint32 numAttributes)
+{
+    if (numStringBytes == 0 || pStrings[numStringBytes - 1] != '\0' ||
+        numNodes == 0 || pNodes[0].type != CachedXmlNode_Element)
+    {
+        return NULL;
+    }
+
+    TiXmlElement* pRoot = NULL;
+    // Elements whose children are being read with number of children still to be read
+    std::vector<std::pair<TiXmlElement*, uint32>> openElems;
+    uint32 attrIdx = 0;
+    bool isValid = true;
+    for (uint32 nodeIdx = 0; isValid && nodeIdx < numNodes; nodeIdx++)
+    {
+        const CachedXmlNode& cachedNode = pNodes[nodeIdx];
+        isValid = cachedNode.valueIdx < numStringBytes && (nodeIdx == 0 || !openElems.empty());
+        if (!isValid)
+        {
+            break;
+        }
+
+        TiXmlNode* pNode = NULL;
+        if (cachedNode.type == CachedXmlNode_Element && cachedNode.numAttributes <= numAttributes - attrIdx)
+        {
+            TiXmlElement* pElem = new TiXmlElement(pStrings + cachedNode.valueIdx);
+            for (uint32 elemAttrIdx = 0; isValid && elemAttrIdx < cachedNode.numAttributes; elemAttrIdx++)
+            {
+                const CachedXmlAttribute& cachedAttr = pAttributes[attrIdx++];
+                isValid = cachedAttr.nameIdx < numStringBytes && cachedAttr.valueIdx < numStringBytes;
+                if (isValid)
+                {
+                    pElem->SetAttribute(pStrings + cachedAttr.nameIdx, pStrings + cachedAttr.valueIdx);
+                }
+            }
+            pNode = pElem;
+        }
+        else if ((cachedNode.type == CachedXmlNode_Text || cachedNode.type == CachedXmlNode_CData) &&
+            cachedNode.numAttributes == 0 && cachedNode.numChildren == 0)
+        {
+            TiXmlText* pText = new TiXmlText(pStrings + cachedNode.valueIdx);
+            pText->SetCDATA(cachedNode.type == CachedXmlNode_CData);
+            pNode = pText;
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        if (!isValid)
+        {
+            SAFE_DELETE(pNode);
+            break;
+        }
+
+        if (openElems.empty())
+        {
+            pRoot = pNode->ToElement();
+        }
+        else
+        {
+            openElems.back().first->LinkEndChild(pNode);
+            openElems.back().second--;
+        }
+
+        if (cachedNode.numChildren > 0)
+        {
+            openElems.push_back(std::make_pair(pNode->ToElement(), cachedNode.numChildren));
+        }
+        while (!openElems.empty() && openElems.back().second == 0)
+        {
+            openElems.pop_back();
+        }
+    }
+
+    if (!isValid || !openElems.empty() || attrIdx != numAttributes)
+    {
+        SAFE_DELETE(pRoot);
+        return NULL;
+    }
+
+    return pRoot;
+}
+
+//=====================================================================================================================
+// LevelCache implementation
+//=====================================================================================================================
+
+uint64 LevelCache::HashWwdData(const char* pData, uint32 size)
+{
+    // 64-bit FNV-1a
+    uint64 hash = 14695981039346656037ULL;
+    for (uint32 byteIdx = 0; byteIdx < size; byteIdx++)
+    {
+        hash ^= (uint8)pData[byteIdx];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+bool LevelCache::ReadWwdResource(const std::string& wwdPath, RawWwd& rawWwd)
+{
+    IResourceFile* pResourceFile = g_pApp->GetResourceCache()->GetResourceFile();
+    Resource resource(wwdPath);
+
+    int32 rawSize = pResourceFile->VGetRawResourceSize(&resource);
+    if (rawSize <= 0)
+    {
+        return false;
+    }
+
+    // Mapped archive is used in place, it is only copied when resource file cannot hand out views
+    rawWwd.pData = pResourceFile->VGetRawResourceView(&resource);
+    if (rawWwd.pData == NULL)
+    {
+        rawWwd.buffer.resize(rawSize);
+        if (pResourceFile->VGetRawResource(&resource, rawWwd.buffer.data()) != rawSize)
+        {
+            return false;
+        }
+        rawWwd.pData = rawWwd.buffer.data();
+    }
+
+    rawWwd.size = rawSize;
+    rawWwd.hash = HashWwdData(rawWwd.pData, rawWwd.size);
+    return true;
+}
+
+static const char* GetLevelCacheBuildStamp()
+{
+    return __DATE__ " " __TIME__;
+}
+
+uint64 LevelCache::GetConverterVersion()
+{
+    static uint64 s_ConverterVersion = 0;
+    if (s_ConverterVersion == 0)
+    {
+        // Every translation unit whose code ends up in compiled level, a rebuild of any of them may change its output
+        std::string versionString = ToStr((uint32)FORMAT_VERSION);
+        const char* buildStamps[] =
+        {
+            GetLevelCacheBuildStamp(),
+            GetConvertersBuildStamp(),
+            Util::GetBuildStamp(),
+            ActorTemplates::GetBuildStamp(),
+            TileGeometryCompiler::GetBuildStamp(),
+            LevelData::GetBuildStamp()
+        };
+        for (const char* pBuildStamp : buildStamps)
+        {
+            versionString += std::string("|") + pBuildStamp;
+        }
+
+        s_ConverterVersion = HashWwdData(versionString.c_str(), versionString.length());
+    }
+
+    return s_ConverterVersion;
+}
+
+std::string LevelCache::GetCompiledLevelPath(const std::string& cacheDir, uint64 wwdHash)
+{
+    char fileName[48];
+    snprintf(fileName, sizeof(fileName), "%016llX-%016llX.LVC", (unsigned long long)wwdHash,
+        (unsigned long long)GetConverterVersion());
+
+    return cacheDir + "/" + fileName;
+}
+
+std::string LevelCache::GetDefaultCacheDir()
+{
+    char* pPrefPath = SDL_GetPrefPath("CaptainClaw", "LevelCache");
+    if (pPrefPath == NULL)
+    {
+        LOG_WARNING("No per-user directory for compiled levels: " + std::string(SDL_GetError()));
+        return "";
+    }
+
+    // Has trailing separator, GetCompiledLevelPath() adds its own
+    std::string cacheDir = pPrefPath;
+    SDL_free(pPrefPath);
+    cacheDir.pop_back();
+
+    return cacheDir;
+}
+
+bool LevelCache::Compile(WapWwd* pWwd, uint64 wwdHash, uint32 levelNumber, const std::string& cacheDir)
+{
+    PROFILE_CPU("LEVEL COMPILATION");
+
+    LevelData levelData;
+    levelData.m_LeveNumber = levelNumber;
+    levelData.LoadPropertiesFromWwd(pWwd);
+
+    // Main plane geometry is merged the same way as when level is loaded from WWD
+    StaticGeometryList tileGeometry;
+    uint32 numTileCollisionRects = 0;
+    bool hasTileGeometry = false;
+    for (uint32 planeIdx = 0; planeIdx < pWwd->planesCount && planeIdx < levelData.m_PlaneTiles.size(); planeIdx++)
+    {
+        const WwdPlaneProperties& planeProperties = pWwd->planes[planeIdx].properties;
+        if (!(planeProperties.flags & WAP_PLANE_FLAG_MAIN_PLANE) ||
+            planeProperties.tilePixelWidth == 0 || planeProperties.tilePixelHeight == 0)
+        {
+            continue;
+        }
+
+        int32 tilesOnAxisX = planeProperties.pixelWidth / planeProperties.tilePixelWidth;
+        int32 tilesOnAxisY = planeProperties.pixelHeight / planeProperties.tilePixelHeight;
+        const std::vector<int32>& planeTiles = levelData.m_PlaneTiles[planeIdx];
+        if (planeTiles.size() >= (size_t)(tilesOnAxisX * tilesOnAxisY))
+        {
+            numTileCollisionRects = levelData.CompileTileGeometry(planeTiles, tilesOnAxisX, tilesOnAxisY,
+                planeProperties.tilePixelWidth, planeProperties.tilePixelHeight, tileGeometry);
+            hasTileGeometry = true;
+        }
+        break;
+    }
+
+    std::vector<char> buffer(LEVEL_CACHE_DATA_OFFSET);
+
+    CachedLevelProperties properties = { pWwd->properties.startX, pWwd->properties.startY,
+        numTileCollisionRects, hasTileGeometry };
+    AppendSection(buffer, LevelCacheSection_Properties, &properties, 1);
+
+    std::vector<char> strings;
+    AppendString(strings, levelData.m_LevelName);
+    AppendString(strings, levelData.m_LevelAuthor);
+    AppendString(strings, levelData.m_LevelCreatedDate);
+    AppendString(strings, levelData.m_PalettePath);
+    AppendSection(buffer, LevelCacheSection_Strings, strings.data(), strings.size());
+
+    std::vector<CachedTileDescription> tileDescs;
+    tileDescs.reserve(levelData.m_TileDescriptionMap.size());
+    for (const auto& tileDescPair : levelData.m_TileDescriptionMap)
+    {
+        const TileDescription& tileDesc = tileDescPair.second;
+        CachedTileDescription cachedTileDesc = { tileDesc.tileId, tileDesc.type, tileDesc.width, tileDesc.height,
+            tileDesc.insideAttrib, tileDesc.outsideAttrib, tileDesc.rect };
+        tileDescs.push_back(cachedTileDesc);
+    }
+    AppendSection(buffer, LevelCacheSection_TileDescriptions, tileDescs.data(), tileDescs.size());
+
+    std::vector<CachedCollisionPrototype> tileProtos;
+    std::vector<CachedCollisionRectangle> collisionRects;
+    tileProtos.reserve(levelData.m_TileCollisionPrototypeMap.size());
+    for (const auto& tileProtoPair : levelData.m_TileCollisionPrototypeMap)
+    {
+        const TileCollisionPrototype& tileProto = tileProtoPair.second;
+        CachedCollisionPrototype cachedTileProto = { tileProto.id, tileProto.width, tileProto.height,
+            (uint32)collisionRects.size(), (uint32)tileProto.collisionRectangles.size() };
+        tileProtos.push_back(cachedTileProto);
+
+        for (const TileCollisionRectangle& collisionRect : tileProto.collisionRectangles)
+        {
+            CachedCollisionRectangle cachedCollisionRect = { collisionRect.collisionType, collisionRect.collisionRect };
+            collisionRects.push_back(cachedCollisionRect);
+        }
+    }
+    AppendSection(buffer, LevelCacheSection_CollisionPrototypes, tileProtos.data(), tileProtos.size());
+    AppendSection(buffer, LevelCacheSection_CollisionRectangles, collisionRects.data(), collisionRects.size());
+
+    std::vector<CachedPlane> planes;
+    std::vector<int32> tiles;
+    for (const std::vector<int32>& planeTiles : levelData.m_PlaneTiles)
+    {
+        CachedPlane cachedPlane = { (uint32)tiles.size(), (uint32)planeTiles.size() };
+        planes.push_back(cachedPlane);
+        tiles.insert(tiles.end(), planeTiles.begin(), planeTiles.end());
+    }
+    AppendSection(buffer, LevelCacheSection_Planes, planes.data(), planes.size());
+    AppendSection(buffer, LevelCacheSection_Tiles, tiles.data(), tiles.size());
+
+    std::vector<CachedCollisionRectangle> cachedGeometry;
+    cachedGeometry.reserve(tileGeometry.size());
+    for (const StaticGeometryRect& geometryRect : tileGeometry)
+    {
+        CachedCollisionRectangle cachedGeometryRect = { geometryRect.collisionType, geometryRect.rect };
+        cachedGeometry.push_back(cachedGeometryRect);
+    }
+    AppendSection(buffer, LevelCacheSection_TileGeometry, cachedGeometry.data(), cachedGeometry.size());
+
+    TiXmlElement* pXmlLevelRoot = WwdToXml(pWwd, false);
+    CachedXmlTree xmlTree;
+    AppendXmlNode(xmlTree, pXmlLevelRoot);
+    SAFE_DELETE(pXmlLevelRoot);
+    AppendSection(buffer, LevelCacheSection_XmlStrings, xmlTree.strings.data(), xmlTree.strings.size());
+    AppendSection(buffer, LevelCacheSection_XmlNodes, xmlTree.nodes.data(), xmlTree.nodes.size());
+    AppendSection(buffer, LevelCacheSection_XmlAttributes, xmlTree.attributes.data(), xmlTree.attributes.size());
+
+    LevelCacheHeader header;
+    memcpy(header.magic, LEVEL_CACHE_MAGIC, sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.wwdHash = wwdHash;
+    header.converterVersion = GetConverterVersion();
+    header.fileSize = buffer.size();
+    header.numSections = LevelCacheSection_Count;
+    memcpy(buffer.data(), &header, sizeof(header));
+
+    // Written under temporary name first so that other running instance never maps half written file
+    std::string compiledLevelPath = GetCompiledLevelPath(cacheDir, wwdHash);
+    std::string tempPath = compiledLevelPath + ".tmp";
+    SDL_RWops* pFile = SDL_RWFromFile(tempPath.c_str(), "wb");
+    if (pFile == NULL)
+    {
+        // Read-only cache directory is not an error, it is only mentioned once
+        static bool s_bReportedNotWritable = false;
+        if (!s_bReportedNotWritable)
+        {
+            LOG("Level cache directory " + cacheDir + " is not writable, levels are loaded from WWD");
+            s_bReportedNotWritable = true;
+        }
+        return false;
+    }
+
+    bool isWritten = SDL_RWwrite(pFile, buffer.data(), buffer.size(), 1) == 1;
+    SDL_RWclose(pFile);
+
+    std::remove(compiledLevelPath.c_str());
+    if (!isWritten || std::rename(tempPath.c_str(), compiledLevelPath.c_str()) != 0)
+    {
+        LOG_ERROR("Could not write compiled level: " + compiledLevelPath);
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+TiXmlElement* LevelCache::Load(uint64 wwdHash, const std::string& cacheDir, LevelData* pLevelData)
+{
+    PROFILE_CPU("COMPILED LEVEL LOADING");
+
+    std::string compiledLevelPath = GetCompiledLevelPath(cacheDir, wwdHash);
+    MappedFile file;
+    if (!file.Open(compiledLevelPath, LEVEL_CACHE_DATA_OFFSET))
+    {
+        return NULL;
+    }
+
+    LevelCacheHeader header;
+    memcpy(&header, file.GetData(), sizeof(header));
+    if (memcmp(header.magic, LEVEL_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != FORMAT_VERSION ||
+        header.wwdHash != wwdHash ||
+        header.converterVersion != GetConverterVersion() ||
+        header.fileSize != file.GetSize() ||
+        header.numSections != LevelCacheSection_Count)
+    {
+        LOG_WARNING("Compiled level " + compiledLevelPath + " is outdated or corrupted");
+        return NULL;
+    }
+
+    uint32 numProperties = 0, numStringBytes = 0, numTileDescs = 0, numTileProtos = 0, numCollisionRects = 0,
+        numPlanes = 0, numTiles = 0, numGeometryRects = 0, numXmlStringBytes = 0, numXmlNodes = 0, numXmlAttributes = 0;
+    const CachedLevelProperties* pProperties = GetSection<CachedLevelProperties>(file, LevelCacheSection_Properties, numProperties);
+    const char* pStrings = GetSection<char>(file, LevelCacheSection_Strings, numStringBytes);
+    const CachedTileDescription* pTileDescs = GetSection<CachedTileDescription>(file, LevelCacheSection_TileDescriptions, numTileDescs);
+    const CachedCollisionPrototype* pTileProtos = GetSection<CachedCollisionPrototype>(file, LevelCacheSection_CollisionPrototypes, numTileProtos);
+    const CachedCollisionRectangle* pCollisionRects = GetSection<CachedCollisionRectangle>(file, LevelCacheSection_CollisionRectangles, numCollisionRects);
+    const CachedPlane* pPlanes = GetSection<CachedPlane>(file, LevelCacheSection_Planes, numPlanes);
+    const int32* pTiles = GetSection<int32>(file, LevelCacheSection_Tiles, numTiles);
+    const CachedCollisionRectangle* pGeometryRects = GetSection<CachedCollisionRectangle>(file, LevelCacheSection_TileGeometry, numGeometryRects);
+    const char* pXmlStrings = GetSection<char>(file, LevelCacheSection_XmlStrings, numXmlStringBytes);
+    const CachedXmlNode* pXmlNodes = GetSection<CachedXmlNode>(file, LevelCacheSection_XmlNodes, numXmlNodes);
+    const CachedXmlAttribute* pXmlAttributes = GetSection<CachedXmlAttribute>(file, LevelCacheSection_XmlAttributes, numXmlAttributes);
+
+    const char* pStringsEnd = pStrings + numStringBytes;
+    const char* pLevelName = pStrings ? ReadString(pStrings, pStringsEnd) : NULL;
+    const char* pLevelAuthor = pLevelName ? ReadString(pStrings, pStringsEnd) : NULL;
+    const char* pLevelCreatedDate = pLevelAuthor ? ReadString(pStrings, pStringsEnd) : NULL;
+    const char* pPalettePath = pLevelCreatedDate ? ReadString(pStrings, pStringsEnd) : NULL;
+
+    bool isValid = pProperties && numProperties == 1 && pPalettePath && pTileDescs && pTileProtos &&
+        pCollisionRects && pPlanes && pTiles && pGeometryRects && pXmlStrings && pXmlNodes && pXmlAttributes;
+    for (uint32 protoIdx = 0; isValid && protoIdx < numTileProtos; protoIdx++)
+    {
+        isValid = pTileProtos[protoIdx].firstRectIdx <= numCollisionRects &&
+            pTileProtos[protoIdx].numRects <= numCollisionRects - pTileProtos[protoIdx].firstRectIdx;
+    }
+    for (uint32 planeIdx = 0; isValid && planeIdx < numPlanes; planeIdx++)
+    {
+        isValid = pPlanes[planeIdx].firstTileIdx <= numTiles &&
+            pPlanes[planeIdx].numTiles <= numTiles - pPlanes[planeIdx].firstTileIdx;
+    }
+    if (!isValid)
+    {
+        LOG_WARNING("Compiled level " + compiledLevelPath + " is corrupted");
+        return NULL;
+    }
+
+    // Built first so that level data is not touched if the XML is broken
+    TiXmlElement* pXmlLevelRoot = ReadXmlTree(pXmlStrings, numXmlStringBytes, pXmlNodes, numXmlNodes,
+        pXmlAttributes, numXmlAttributes);
+    if (pXmlLevelRoot == NULL)
+    {
+        LOG_WARNING("Compiled level " + compiledLevelPath + " has corrupted level XML");
+        return NULL;
+    }
+
+    // Claw takes jump height from current options, so it is not taken from the time level was compiled
+    for (TiXmlElement* pActorElem = pXmlLevelRoot->FirstChildElement("Actor"); pActorElem;
+        pActorElem = pActorElem->NextSiblingElement("Actor"))
+    {
+        if (std::string(pActorElem->Attribute("Type") ? pActorElem->Attribute("Type") : "") == "Claw")
+        {
+            TiXmlElement* pClawActor = CreateClawActor(pProperties->spawnX, pProperties->spawnY);
+            pXmlLevelRoot->ReplaceChild(pActorElem, *pClawActor);
+            SAFE_DELETE(pClawActor);
+            break;
+        }
+    }
+
+    pLevelData->m_LevelName = pLevelName;
+    pLevelData->m_LevelAuthor = pLevelAuthor;
+    pLevelData->m_LevelCreatedDate = pLevelCreatedDate;
+    pLevelData->m_PalettePath = pPalettePath;
+
+    // Written from ordered maps so every insert goes to the end
+    pLevelData->m_TileDescriptionMap.clear();
+    for (uint32 tileDescIdx = 0; tileDescIdx < numTileDescs; tileDescIdx++)
+    {
+        const CachedTileDescription& cachedTileDesc = pTileDescs[tileDescIdx];
+        TileDescription tileDesc = { cachedTileDesc.tileId, cachedTileDesc.type, cachedTileDesc.width,
+            cachedTileDesc.height, cachedTileDesc.insideAttrib, cachedTileDesc.outsideAttrib, cachedTileDesc.rect };
+        pLevelData->m_TileDescriptionMap.insert(pLevelData->m_TileDescriptionMap.end(), std::make_pair(tileDesc.tileId, tileDesc));
+    }
+
+    pLevelData->m_TileCollisionPrototypeMap.clear();
+    for (uint32 protoIdx = 0; protoIdx < numTileProtos; protoIdx++)
+    {
+        const CachedCollisionPrototype& cachedTileProto = pTileProtos[protoIdx];
+
+        TileCollisionPrototype tileProto;
+        tileProto.id = cachedTileProto.id;
+        tileProto.width = cachedTileProto.width;
+        tileProto.height = cachedTileProto.height;
+        tileProto.collisionRectangles.resize(cachedTileProto.numRects);
+        for (uint32 rectIdx = 0; rectIdx < cachedTileProto.numRects; rectIdx++)
+        {
+            const CachedCollisionRectangle& cachedRect = pCollisionRects[cachedTileProto.firstRectIdx + rectIdx];
+            tileProto.collisionRectangles[rectIdx].collisionType = CollisionType(cachedRect.collisionType);
+            tileProto.collisionRectangles[rectIdx].collisionRect = cachedRect.rect;
+        }
+
+        pLevelData->m_TileCollisionPrototypeMap.insert(pLevelData->m_TileCollisionPrototypeMap.end(), std::make_pair(tileProto.id, tileProto));
+    }
+
+    pLevelData->m_PlaneTiles.resize(numPlanes);
+    for (uint32 planeIdx = 0; planeIdx < numPlanes; planeIdx++)
+    {
+        const int32* pPlaneTiles = pTiles + pPlanes[planeIdx].firstTileIdx;
+        pLevelData->m_PlaneTiles[planeIdx].assign(pPlaneTiles, pPlaneTiles + pPlanes[planeIdx].numTiles);
+    }
+
+    pLevelData->m_TileGeometry.resize(numGeometryRects);
+    for (uint32 rectIdx = 0; rectIdx < numGeometryRects; rectIdx++)
+    {
+        pLevelData->m_TileGeometry[rectIdx].collisionType = CollisionType(pGeometryRects[rectIdx].collisionType);
+        pLevelData->m_TileGeometry[rectIdx].rect = pGeometryRects[rectIdx].rect;
+    }
+    pLevelData->m_NumTileCollisionRects = pProperties->numTileCollisionRects;
+    pLevelData->m_bHasTileGeometry = pProperties->hasTileGeometry != 0;
+
+    return pXmlLevelRoot;
+}
+
+bool LevelCache::CompileAllLevels(const std::string& cacheDir)
+{
+    if (cacheDir.empty())
+    {
+        LOG_ERROR("Level cache directory is not set");
+        return false;
+    }
+
+    bool areAllCompiled = true;
+    for (uint32 levelNumber = 1; levelNumber <= LEVELS_COUNT; levelNumber++)
+    {
+        std::string wwdPath = "/LEVEL" + ToStr(levelNumber) + "/WORLDS/WORLD.WWD";
+
+        RawWwd rawWwd;
+        WapWwd* pWwd = NULL;
+        if (!ReadWwdResource(wwdPath, rawWwd) ||
+            (pWwd = WwdResourceLoader::LoadAndReturnWwd(wwdPath.c_str(), rawWwd.pData, rawWwd.size)) == NULL ||
+            !Compile(pWwd, rawWwd.hash, levelNumber, cacheDir))
+        {
+            LOG_ERROR("Could not compile level " + ToStr(levelNumber));
+            areAllCompiled = false;
+            continue;
+        }
+
+        LOG("Compiled level " + ToStr(levelNumber) + " into " + GetCompiledLevelPath(cacheDir, rawWwd.hash));
+    }
+
+    return areAllCompiled;
+}
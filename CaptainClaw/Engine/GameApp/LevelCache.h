@@ -0,0 +1,61 @@
+#ifndef __LEVEL_CACHE_H__
+#define __LEVEL_CACHE_H__
+
+#include <libwap.h>
+#include <vector>
+#include "../SharedDefines.h"
+
+class LevelData;
+
+//---------------------------------------------------------------------------------------------------------------------
+// LevelCache
+//
+// Levels compiled into a binary file which is mapped into memory when the level is loaded. Each file is named after
+// hash of the WWD it was compiled from and version of the code which converted it, so an edited WWD or a rebuilt
+// game never picks up a stale file. Tile planes, tile descriptions, collision prototypes and merged collision
+// geometry of the main plane are stored as fixed layout arrays and only copied out. Level actors are stored as
+// already tokenized XML tree which is rebuilt without any text parsing, actor factory still creates actors from XML.
+//---------------------------------------------------------------------------------------------------------------------
+class LevelCache
+{
+public:
+    // Has to be bumped whenever file layout changes, changes of the converting code are picked up by
+    // GetConverterVersion()
+    static const uint32 FORMAT_VERSION = 2;
+
+    // WWD resource read but not parsed yet, points either into resource file or into the buffer
+    struct RawWwd
+    {
+        RawWwd() : pData(NULL), size(0), hash(0) { }
+
+        const char* pData;
+        uint32 size;
+        uint64 hash;
+        std::vector<char> buffer;
+    };
+
+    static uint64 HashWwdData(const char* pData, uint32 size);
+    // Reads and hashes WWD resource, returns false if there is no such resource. Data is kept so that the WWD
+    // can be parsed from it when there is no compiled level.
+    static bool ReadWwdResource(const std::string& wwdPath, RawWwd& rawWwd);
+    // Changes whenever FORMAT_VERSION changes or any code producing compiled level data is rebuilt
+    static uint64 GetConverterVersion();
+    static std::string GetCompiledLevelPath(const std::string& cacheDir, uint64 wwdHash);
+    // Per-user writable directory (SDL_GetPrefPath), working directory is often read-only or the install directory.
+    // Empty if platform has no such directory.
+    static std::string GetDefaultCacheDir();
+
+    // Returns false without reporting an error if cache directory is not writable, level is then simply loaded
+    // from WWD every time
+    static bool Compile(WapWwd* pWwd, uint64 wwdHash, uint32 levelNumber, const std::string& cacheDir);
+
+    // Fills level properties, tile descriptions, plane tiles and main plane geometry and returns level XML without
+    // tiles, the same as WwdToXml(pWwd, false) would. Returns NULL if there is no valid compiled level for given
+    // WWD hash.
+    static TiXmlElement* Load(uint64 wwdHash, const std::string& cacheDir, LevelData* pLevelData);
+
+    // Compiles all levels ahead of time, used by --compile-levels command line switch
+    static bool CompileAllLevels(const std::string& cacheDir);
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "BaseGameApp.h"
+#include "LevelCache.h"
 
 #include "MainLoop.h"
 
@@ -29,6 +30,17 @@ int RunGameEngine(int argc, char** argv)
         return -1;
     }
 
+    // "--compile-levels" compiles all levels into level cache directory and exits
+    for (int argIdx = 1; argIdx < argc; argIdx++)
+    {
+        if (std::string(argv[argIdx]) == "--compile-levels")
+        {
+            bool areAllCompiled = LevelCache::CompileAllLevels(g_pApp->GetGameConfig()->levelCacheDir);
+            g_pApp->Terminate();
+            return areAllCompiled ? 0 : -1;
+        }
+    }
+
     // Run the game
     return g_pApp->Run();
 }
@@ -3,6 +3,17 @@
 #include "Image.h"
 #include "../SharedDefines.h"
 
+// Decoded PID pixels are R, G, B, A bytes in memory which maps to different packed format
+// depending on endianness
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+static const uint32_t PID_PIXEL_FORMAT = SDL_PIXELFORMAT_RGBA8888;
+#else
+static const uint32_t PID_PIXEL_FORMAT = SDL_PIXELFORMAT_ABGR8888;
+#endif
+
+// Rows start on 16 byte boundary which suits both SIMD stores and texture uploads
+static const uint32_t PID_PITCH_ALIGNMENT = 16;
+
 Image::Image()
     :
     m_Width(0),
@@ -11,15 +22,42 @@ Image::Image()
     m_OffsetY(0),
     m_pTexture(NULL)
 {
-    
+    m_SourceRect = { 0, 0, 0, 0 };
 }
 
 Image::~Image()
 {
-    SDL_DestroyTexture(m_pTexture);
+    // Atlas page is owned by all of its images
+    if (!m_pAtlasTexture)
+    {
+        SDL_DestroyTexture(m_pTexture);
+    }
     m_pTexture = NULL;
 }
 
+uint32_t Image::GetTextureMemorySize()
+{
+    if (m_pTexture == NULL)
+    {
+        return 0;
+    }
+
+    // Only this image's share of the page
+    if (m_pAtlasTexture)
+    {
+        return m_SourceRect.w * m_SourceRect.h * sizeof(uint32_t);
+    }
+
+    uint32_t format;
+    int width, height;
+    if (SDL_QueryTexture(m_pTexture, &format, NULL, &width, &height) != 0)
+    {
+        return 0;
+    }
+
+    return SDL_BYTESPERPIXEL(format) * width * height;
+}
+
 SDL_Rect Image::GetPositonRect(int32_t x, int32_t y)
 {
     int positionX = x - m_Width / 2 + m_OffsetX;
@@ -107,6 +145,48 @@ SDL_Texture* Image::GetTextureFromPid(WapPid* pid, SDL_Renderer* renderer)
     return texture;
 }
 
+SDL_Texture* Image::GetTextureFromPidPixels(const PidPixelData& pixelData, SDL_Renderer* renderer)
+{
+    assert(renderer != NULL);
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, PID_PIXEL_FORMAT, SDL_TEXTUREACCESS_STATIC, pixelData.width, pixelData.height);
+    if (texture == NULL)
+    {
+        return NULL;
+    }
+
+    // Same as texture created from surface with alpha channel
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    if (SDL_UpdateTexture(texture, NULL, pixelData.pixels.data(), pixelData.pitch) != 0)
+    {
+        SDL_DestroyTexture(texture);
+        return NULL;
+    }
+
+    return texture;
+}
+
+bool Image::DecodePid(const char* rawBuffer, uint32_t size, WapPal* palette, PidPixelData& pixelData)
+{
+    WapPid header;
+    if (WAP_PidLoadHeaderFromData(rawBuffer, size, &header) < 0 || header.width == 0 || header.height == 0)
+    {
+        return false;
+    }
+
+    pixelData.width = header.width;
+    pixelData.height = header.height;
+    pixelData.offsetX = header.offsetX;
+    pixelData.offsetY = header.offsetY;
+    pixelData.pitch = (header.width * sizeof(uint32_t) + PID_PITCH_ALIGNMENT - 1) & ~(PID_PITCH_ALIGNMENT - 1);
+
+    // Every pixel is written by decoder, padding is never uploaded
+    pixelData.pixels.resize((pixelData.pitch / sizeof(uint32_t)) * pixelData.height);
+
+    return WAP_PidDecodeFromData(rawBuffer, size, palette, pixelData.pixels.data(), pixelData.pitch) == 0;
+}
+
 Image* Image::CreateImage(WapPid* pid, SDL_Renderer* renderer)
 {
     Image* image = new Image();
@@ -119,10 +199,36 @@ Image* Image::CreateImage(WapPid* pid, SDL_Renderer* renderer)
     return image;
 }
 
-Image* Image::CreatePcxImage(char* rawBuffer, uint32_t size, SDL_Renderer* renderer, bool useColorKey, SDL_Color colorKey)
+Image* Image::CreateImage(const PidPixelData& pixelData, SDL_Renderer* renderer)
+{
+    Image* image = new Image();
+    if (!image->Initialize(pixelData, renderer))
+    {
+        delete image;
+        return NULL;
+    }
+
+    return image;
+}
+
+Image* Image::CreatePidImage(const char* rawBuffer, uint32_t size, WapPal* palette, SDL_Renderer* renderer)
+{
+    // Reused between calls so that synchronous loads do not allocate pixel buffer per image.
+    // Renderer is bound to main thread anyway.
+    static PidPixelData s_PixelData;
+
+    if (!DecodePid(rawBuffer, size, palette, s_PixelData))
+    {
+        return NULL;
+    }
+
+    return CreateImage(s_PixelData, renderer);
+}
+
+Image* Image::CreatePcxImage(const char* rawBuffer, uint32_t size, SDL_Renderer* renderer, bool useColorKey, SDL_Color colorKey)
 {
     Image* pImage = new Image();
-    SDL_RWops* pRWops = SDL_RWFromMem((void*)rawBuffer, size);
+    SDL_RWops* pRWops = SDL_RWFromConstMem(rawBuffer, size);
     SDL_Surface* pSurface = IMG_LoadPCX_RW(pRWops);
     if (pSurface == NULL)
     {
@@ -153,10 +259,10 @@ Image* Image::CreatePcxImage(char* rawBuffer, uint32_t size, SDL_Renderer* rende
     return pImage;
 }
 
-Image* Image::CreatePngImage(char* rawBuffer, uint32_t size, SDL_Renderer* renderer)
+Image* Image::CreatePngImage(const char* rawBuffer, uint32_t size, SDL_Renderer* renderer)
 {
     Image* pImage = new Image();
-    SDL_RWops* pRWops = SDL_RWFromMem((void*)rawBuffer, size);
+    SDL_RWops* pRWops = SDL_RWFromConstMem(rawBuffer, size);
     SDL_Surface* pSurface = IMG_LoadPNG_RW(pRWops);
     if (pSurface == NULL)
     {
@@ -234,6 +340,43 @@ bool Image::Initialize(WapPid* pid, SDL_Renderer* renderer)
     return true;
 }
 
+Image* Image::CreateAtlasImage(std::shared_ptr<SDL_Texture> pAtlasTexture, const SDL_Rect& sourceRect, int offsetX, int offsetY)
+{
+    assert(pAtlasTexture != nullptr);
+
+    Image* pImage = new Image();
+    pImage->m_pAtlasTexture = pAtlasTexture;
+    pImage->m_pTexture = pAtlasTexture.get();
+    pImage->m_SourceRect = sourceRect;
+    pImage->m_Width = sourceRect.w;
+    pImage->m_Height = sourceRect.h;
+    pImage->m_OffsetX = offsetX;
+    pImage->m_OffsetY = offsetY;
+
+    return pImage;
+}
+
+bool Image::Initialize(const PidPixelData& pixelData, SDL_Renderer* renderer)
+{
+    if (renderer == NULL)
+    {
+        return false;
+    }
+
+    m_Width = pixelData.width;
+    m_Height = pixelData.height;
+    m_OffsetX = pixelData.offsetX;
+    m_OffsetY = pixelData.offsetY;
+
+    m_pTexture = GetTextureFromPidPixels(pixelData, renderer);
+    if (m_pTexture == NULL)
+    {
+        return false;
+    }
+
+    return true;
+}
+
 bool Image::Initialize(SDL_Texture* pTexture)
 {
     if (pTexture == NULL)
@@ -3,7 +3,24 @@
 
 #include <libwap.h>
 #include <SDL2/SDL.h>
+#include <memory>
 #include <stdint.h>
+#include <vector>
+
+// PID decoded straight into texture rows. Decoding does not need renderer so it can run on any
+// thread, only creating image from it has to be done on main thread.
+struct PidPixelData
+{
+    PidPixelData() : width(0), height(0), offsetX(0), offsetY(0), pitch(0) { }
+
+    uint32_t width;
+    uint32_t height;
+    int32_t offsetX;
+    int32_t offsetY;
+    // Length of one row in bytes
+    uint32_t pitch;
+    std::vector<uint32_t> pixels;
+};
 
 class Image
 {
@@ -12,16 +29,28 @@ public:
     ~Image();
 
     static SDL_Texture* GetTextureFromPid(WapPid* pid, SDL_Renderer* renderer);
+    static SDL_Texture* GetTextureFromPidPixels(const PidPixelData& pixelData, SDL_Renderer* renderer);
+    static bool DecodePid(const char* rawBuffer, uint32_t size, WapPal* palette, PidPixelData& pixelData);
     static Image* CreateImage(WapPid* pid, SDL_Renderer* renderer);
-    static Image* CreatePcxImage(char* rawBuffer, uint32_t size, SDL_Renderer* renderer, bool useColorKey = false, SDL_Color colorKey = { 0, 0, 0, 0 });
-    static Image* CreatePngImage(char* rawBuffer, uint32_t size, SDL_Renderer* renderer);
+    static Image* CreateImage(const PidPixelData& pixelData, SDL_Renderer* renderer);
+    // Decodes PID without intermediate WapPid, has to be called from main thread
+    static Image* CreatePidImage(const char* rawBuffer, uint32_t size, WapPal* palette, SDL_Renderer* renderer);
+    static Image* CreatePcxImage(const char* rawBuffer, uint32_t size, SDL_Renderer* renderer, bool useColorKey = false, SDL_Color colorKey = { 0, 0, 0, 0 });
+    static Image* CreatePngImage(const char* rawBuffer, uint32_t size, SDL_Renderer* renderer);
     static Image* CreateImageFromColor(SDL_Color color, int w, int h, SDL_Renderer* pRenderer);
+    // Image which is only a part of shared atlas page, see TextureAtlasBuilder
+    static Image* CreateAtlasImage(std::shared_ptr<SDL_Texture> pAtlasTexture, const SDL_Rect& sourceRect, int offsetX, int offsetY);
 
     inline SDL_Texture* GetTexture() { return m_pTexture; }
+    // Part of the texture occupied by this image, NULL stands for whole texture
+    inline const SDL_Rect* GetSourceRect() const { return m_pAtlasTexture ? &m_SourceRect : NULL; }
+    inline bool IsInAtlas() const { return m_pAtlasTexture != nullptr; }
     inline int GetWidth() { return m_Width; }
     inline int GetHeight() { return m_Height; }
     inline int GetOffsetX() { return m_OffsetX; }
     inline int GetOffsetY() { return m_OffsetY; }
+    // Video memory taken by the texture
+    uint32_t GetTextureMemorySize();
 
     void SetOffset(int x, int y) { m_OffsetX = x; m_OffsetY = y; }
 
@@ -29,9 +58,13 @@ public:
 
 private:
     bool Initialize(WapPid* pid, SDL_Renderer* renderer);
+    bool Initialize(const PidPixelData& pixelData, SDL_Renderer* renderer);
     bool Initialize(SDL_Texture* pTexture);
 
     SDL_Texture* m_pTexture;
+    // Keeps shared atlas page alive, m_pTexture then points to it
+    std::shared_ptr<SDL_Texture> m_pAtlasTexture;
+    SDL_Rect m_SourceRect;
     int m_Width;
     int m_Height;
     int m_OffsetX;
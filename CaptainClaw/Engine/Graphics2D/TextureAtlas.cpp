@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <assert.h>
+
+#include "TextureAtlas.h"
+#include "Image.h"
+
+// Transparent gap between images so that filtered sampling of one image does not bleed
+// into its neighbours
+static const int32_t ATLAS_IMAGE_PADDING = 1;
+
+TextureAtlasBuilder::TextureAtlasBuilder(SDL_Renderer* pRenderer, int32_t maxPageSize)
+    :
+    m_pRenderer(pRenderer),
+    m_PageSize(maxPageSize)
+{
+    assert(m_pRenderer != NULL);
+
+    SDL_RendererInfo rendererInfo;
+    if (SDL_GetRendererInfo(m_pRenderer, &rendererInfo) == 0)
+    {
+        // 0 means that renderer does not have any limit
+        if (rendererInfo.max_texture_width > 0)
+        {
+            m_PageSize = std::min(m_PageSize, rendererInfo.max_texture_width);
+        }
+        if (rendererInfo.max_texture_height > 0)
+        {
+            m_PageSize = std::min(m_PageSize, rendererInfo.max_texture_height);
+        }
+    }
+}
+
+int32_t TextureAtlasBuilder::AddImage(int32_t width, int32_t height)
+{
+    if (width <= 0 || height <= 0 || width > m_PageSize || height > m_PageSize)
+    {
+        return -1;
+    }
+
+    AtlasImage image;
+    image.rect = { 0, 0, width, height };
+    image.pageIdx = 0;
+    m_Images.push_back(image);
+
+    return m_Images.size() - 1;
+}
+
+void TextureAtlasBuilder::Pack()
+{
+    assert(m_Pages.empty() && "Atlas was already packed");
+
+    if (m_Images.empty())
+    {
+        return;
+    }
+
+    // Tallest first so that shelves waste as little space as possible
+    std::vector<int32_t> order(m_Images.size());
+    for (int32_t imageId = 0; imageId < (int32_t)order.size(); imageId++)
+    {
+        order[imageId] = imageId;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](int32_t lhs, int32_t rhs)
+    {
+        return m_Images[lhs].rect.h > m_Images[rhs].rect.h;
+    });
+
+    m_Pages.push_back(AtlasPage());
+    int32_t shelfX = 0;
+    int32_t shelfY = 0;
+    int32_t shelfHeight = 0;
+    for (int32_t imageId : order)
+    {
+        SDL_Rect& rect = m_Images[imageId].rect;
+
+        // Next shelf
+        if (shelfX + rect.w > m_PageSize)
+        {
+            shelfX = 0;
+            shelfY += shelfHeight + ATLAS_IMAGE_PADDING;
+            shelfHeight = 0;
+        }
+
+        // Next page
+        if (shelfY + rect.h > m_PageSize)
+        {
+            m_Pages.push_back(AtlasPage());
+            shelfX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+
+        AtlasPage& page = m_Pages.back();
+        rect.x = shelfX;
+        rect.y = shelfY;
+        m_Images[imageId].pageIdx = m_Pages.size() - 1;
+
+        shelfX += rect.w + ATLAS_IMAGE_PADDING;
+        shelfHeight = std::max(shelfHeight, rect.h);
+
+        // Pages are only as big as their content
+        page.width = std::max(page.width, rect.x + rect.w);
+        page.height = std::max(page.height, rect.y + rect.h);
+    }
+
+    for (AtlasPage& page : m_Pages)
+    {
+        // Fully transparent, padding is never written
+        page.pixels.assign(page.width * page.height, 0);
+    }
+}
+
+uint32_t* TextureAtlasBuilder::GetPixels(int32_t imageId, uint32_t& pitch)
+{
+    const AtlasImage& image = m_Images[imageId];
+    AtlasPage& page = m_Pages[image.pageIdx];
+    assert(!page.pixels.empty());
+
+    pitch = page.width * sizeof(uint32_t);
+    return &page.pixels[image.rect.y * page.width + image.rect.x];
+}
+
+bool TextureAtlasBuilder::CreatePageTextures()
+{
+    for (AtlasPage& page : m_Pages)
+    {
+        PidPixelData pagePixels;
+        pagePixels.width = page.width;
+        pagePixels.height = page.height;
+        pagePixels.pitch = page.width * sizeof(uint32_t);
+        pagePixels.pixels.swap(page.pixels);
+
+        SDL_Texture* pTexture = Image::GetTextureFromPidPixels(pagePixels, m_pRenderer);
+        if (pTexture == NULL)
+        {
+            return false;
+        }
+
+        page.pTexture.reset(pTexture, SDL_DestroyTexture);
+    }
+
+    return true;
+}
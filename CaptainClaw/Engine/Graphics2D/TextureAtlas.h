@@ -0,0 +1,64 @@
+#ifndef TEXTUREATLAS_H_
+#define TEXTUREATLAS_H_
+
+#include <SDL2/SDL.h>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+//=================================================================================================
+// class TextureAtlasBuilder
+//
+//     Packs many small images into few large page textures. Images are placed on shelves sorted
+//     by height, pixels are then written straight into page buffers (see GetPixels) and every
+//     page is uploaded at once. Images from the same page share one texture so renderer does
+//     not have to switch textures while drawing them.
+//
+
+class TextureAtlasBuilder
+{
+public:
+    // Page side in pixels, it is clamped to what renderer supports
+    TextureAtlasBuilder(SDL_Renderer* pRenderer, int32_t maxPageSize = 2048);
+
+    // Returns image id or -1 if image is too big to share a page with others
+    int32_t AddImage(int32_t width, int32_t height);
+
+    // Places all added images and allocates page buffers
+    void Pack();
+
+    // Valid between Pack() and CreatePageTextures(), pitch is in bytes
+    uint32_t* GetPixels(int32_t imageId, uint32_t& pitch);
+
+    // Uploads page buffers (R, G, B, A bytes per pixel) and frees them
+    bool CreatePageTextures();
+
+    uint32_t GetNumPages() const { return m_Pages.size(); }
+    const SDL_Rect& GetImageRect(int32_t imageId) const { return m_Images[imageId].rect; }
+    std::shared_ptr<SDL_Texture> GetImageTexture(int32_t imageId) const { return m_Pages[m_Images[imageId].pageIdx].pTexture; }
+
+private:
+    struct AtlasImage
+    {
+        SDL_Rect rect;
+        uint32_t pageIdx;
+    };
+
+    struct AtlasPage
+    {
+        AtlasPage() : width(0), height(0) { }
+
+        int32_t width;
+        int32_t height;
+        std::vector<uint32_t> pixels;
+        std::shared_ptr<SDL_Texture> pTexture;
+    };
+
+    SDL_Renderer* m_pRenderer;
+    int32_t m_PageSize;
+
+    std::vector<AtlasImage> m_Images;
+    std::vector<AtlasPage> m_Pages;
+};
+
+#endif
@@ -271,6 +271,7 @@ public:
 
     virtual void VActivate(uint32_t actorId) = 0;
     virtual void VDeactivate(uint32_t actorId) = 0;
+    virtual bool VIsActive(uint32_t actorId) = 0;
 
     virtual void VSetPosition(uint32_t actorId, const Point& position) = 0;
     virtual Point VGetPosition(uint32_t actorId) = 0;
@@ -35,7 +35,7 @@ shared_ptr<PhysicsComponent> GetPhysicsComponentFromB2Body(const b2Body* pBody)
     }
 
     shared_ptr<PhysicsComponent> pPhysicsComponent =
-        MakeStrongPtr(pActor->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+        MakeStrongPtr(pActor->GetComponent<PhysicsComponent>());
     assert(pPhysicsComponent);
 
     return pPhysicsComponent;
@@ -52,7 +52,7 @@ shared_ptr<KinematicComponent> GetKinematicComponentFromB2Body(const b2Body* pBo
     }
 
     shared_ptr<KinematicComponent> pKinematicComponent =
-        MakeStrongPtr(pActor->GetComponent<KinematicComponent>(KinematicComponent::g_Name));
+        MakeStrongPtr(pActor->GetComponent<KinematicComponent>());
     assert(pKinematicComponent);
 
     return pKinematicComponent;
@@ -69,7 +69,7 @@ shared_ptr<TriggerComponent> GetTriggerComponentFromB2Body(const b2Body* pBody)
         return nullptr;
     }
 
-    auto pWeakTrigComp = pActor->GetComponent<TriggerComponent>(TriggerComponent::g_Name);
+    auto pWeakTrigComp = pActor->GetComponent<TriggerComponent>();
     if (!pWeakTrigComp.expired())
     {
         shared_ptr<TriggerComponent> pTriggerComponent = MakeStrongPtr(pWeakTrigComp);
@@ -91,7 +91,7 @@ shared_ptr<ProjectileAIComponent> GetProjectileAIComponentFromB2Body(const b2Bod
 
     // May no longer be valid, calling methods have to check it
     shared_ptr<ProjectileAIComponent> pComponent =
-        MakeStrongPtr(pActor->GetComponent<ProjectileAIComponent>(ProjectileAIComponent::g_Name));
+        MakeStrongPtr(pActor->GetComponent<ProjectileAIComponent>());
 
     return pComponent;
 }
@@ -200,158 +200,161 @@ bool ClawPhysics::VInitialize()
 void ClawPhysics::VSyncVisibleScene()
 {
     // check all the existing actor's bodies for changes. 
-    //  If there is a change, send the appropriate event for the game system.
+    //  Moved actors are collected and sent in one event after all bodies are checked.
 
-    // Iterating vector or list has lower overhead
-    /*for (ActorIDToBox2DBodyMap::const_iterator it = m_ActorToBodyMap.begin();
-        it != m_ActorToBodyMap.end();
-        ++it)*/
-    for (const std::pair<uint32, b2Body*>& it : m_ActorIdAndBodyList)
+    // Only non-static bodies are in the list. Sleeping bodies did not move during last step
+    // so they are skipped, Box2D wakes them when anything touches or pushes them.
+    m_MovedActors.clear();
+    for (size_t bodyIdx = 0; bodyIdx < m_SyncedBodies.size(); bodyIdx++)
     {
-        b2Body* pActorBody = it.second;
+        // Copied, state callbacks below can add new bodies to the list
+        const SyncedActorBody syncedBody = m_SyncedBodies[bodyIdx];
+        b2Body* pActorBody = syncedBody.pBody;
         assert(pActorBody);
 
-        if (pActorBody->GetType() == b2_staticBody)
+        // User data is cleared when actor is being removed
+        if (!pActorBody->IsAwake() || !pActorBody->GetUserData())
         {
             continue;
         }
 
-        uint32 actorId = it.first;
+        uint32 actorId = syncedBody.actorId;
 
-        StrongActorPtr pGameActor = MakeStrongPtr(g_pApp->GetGameLogic()->VGetActor(actorId));
-        //assert(pGameActor);
+        PositionComponent* pPositionComponent = syncedBody.pPositionComponent;
+        assert(pPositionComponent);
 
-        if (pGameActor && pActorBody)
-        {
-            /*shared_ptr<PositionComponent> pPositionComponent = MakeStrongPtr(pGameActor->GetComponent<PositionComponent>(PositionComponent::g_Name));*/
-
-            shared_ptr<PositionComponent> pPositionComponent = pGameActor->GetPositionComponent();
-            assert(pPositionComponent);
-
-            Point bodyPixelPosition = b2Vec2ToPoint(MetersToPixels(pActorBody->GetPosition()));
-            Point actorPixelPosition = pPositionComponent->GetPosition();
+        Point bodyPixelPosition = b2Vec2ToPoint(MetersToPixels(pActorBody->GetPosition()));
+        Point actorPixelPosition = pPositionComponent->GetPosition();
 
-            // TODO: Now only Claw cares about falling / jumping states, maybe refactor in future
-            //if (pGameActor->GetName() == "Claw")
+        // TODO: Now only Claw cares about falling / jumping states, maybe refactor in future
+        //if (pGameActor->GetName() == "Claw")
 
-            // This causes slight CPU (1.5%) overhead
-            if (pActorBody->GetType() == b2_dynamicBody)
+        // This causes slight CPU (1.5%) overhead
+        if (pActorBody->GetType() == b2_dynamicBody)
+        {
+            PhysicsComponent* pPhysicsComponent = syncedBody.pPhysicsComponent;
+            assert(pPhysicsComponent);
+            bool wasFalling = pPhysicsComponent->IsFalling();
+            bool wasJumping = pPhysicsComponent->IsJumping();
+            // Set jumping / falling properties
+            //if ((uint32)bodyPixelPosition.y != (uint32)actorPixelPosition.y)
+            if (fabs(bodyPixelPosition.y - actorPixelPosition.y) > DBL_EPSILON)
             {
-                shared_ptr<PhysicsComponent> pPhysicsComponent = GetPhysicsComponentFromB2Body(pActorBody);
-                bool wasFalling = pPhysicsComponent->IsFalling();
-                bool wasJumping = pPhysicsComponent->IsJumping();
-                // Set jumping / falling properties
-                //if ((uint32)bodyPixelPosition.y != (uint32)actorPixelPosition.y)
-                if (fabs(bodyPixelPosition.y - actorPixelPosition.y) > DBL_EPSILON)
+                // He might be on platform
+                if (pPhysicsComponent->IsOnGround())
                 {
-                    // He might be on platform
-                    if (pPhysicsComponent->IsOnGround())
-                    {
-                        pPhysicsComponent->SetFalling(false);
-                        pPhysicsComponent->SetJumping(false);
-                        if (pActorBody->GetLinearVelocity().y < -5)
-                        {
-                            pPhysicsComponent->AddJumpHeight(fabs(bodyPixelPosition.y - actorPixelPosition.y));
-                        }
-                    }
-                    // Falling
-                    else if ((bodyPixelPosition.y - actorPixelPosition.y) > DBL_EPSILON)
-                    {
-                        // TODO: Some unknown stuff is making claw cancel jump
-                        /*if (pGameActor->GetName() == "Claw")
-                        {
-                        if ((bodyPixelPosition.y - actorPixelPosition.y) > 2 || true)
-                        {
-                        pPhysicsComponent->SetFalling(true);
-                        pPhysicsComponent->SetJumping(false);
-                        }
-                        }
-                        else
-                        {
-                        pPhysicsComponent->SetFalling(true);
-                        pPhysicsComponent->SetJumping(false);
-                        }*/
-
-                        pPhysicsComponent->SetFalling(true);
-                        pPhysicsComponent->SetJumping(false);
-                    }
-                    else // Jumping
+                    pPhysicsComponent->SetFalling(false);
+                    pPhysicsComponent->SetJumping(false);
+                    if (pActorBody->GetLinearVelocity().y < -5)
                     {
-                        if (pPhysicsComponent->CanJump())
-                        {
-                            pPhysicsComponent->SetFalling(false);
-                            pPhysicsComponent->SetJumping(true);
-                            pPhysicsComponent->AddJumpHeight(fabs(bodyPixelPosition.y - actorPixelPosition.y));
-
-                            float jumpPixelsLeft = pPhysicsComponent->GetMaxJumpHeight() - pPhysicsComponent->GetHeightInAir();
-                            // Jumped past limit
-                            if (!g_pApp->GetGameCheats()->clawInfiniteJump && jumpPixelsLeft < 0.0f)
-                            {
-                                // Set b2Body to its max height
-                                bodyPixelPosition = Point(bodyPixelPosition.x, bodyPixelPosition.y + fabs(jumpPixelsLeft));
-                                VSetPosition(actorId, bodyPixelPosition);
-                                pPhysicsComponent->SetForceFall();
-                            }
-                        }
+                        pPhysicsComponent->AddJumpHeight(fabs(bodyPixelPosition.y - actorPixelPosition.y));
                     }
                 }
-                else if (fabs(bodyPixelPosition.y - actorPixelPosition.y) < DBL_EPSILON)
+                // Falling
+                else if ((bodyPixelPosition.y - actorPixelPosition.y) > DBL_EPSILON)
                 {
-                    // TODO: Check this. This causes animation glitches on connected ground platforms
-                    // Should be fixed when all consecutive tiles are joined, but anyway, keep this in mind
-                    if (!pPhysicsComponent->IsOnGround() && (bodyPixelPosition.y - actorPixelPosition.y) > DBL_EPSILON)
+                    // TODO: Some unknown stuff is making claw cancel jump
+                    /*if (pGameActor->GetName() == "Claw")
+                    {
+                    if ((bodyPixelPosition.y - actorPixelPosition.y) > 2 || true)
                     {
-                        //LOG("!pPhysicsComponent->IsOnGround()");
-                        pPhysicsComponent->SetFalling(true);
+                    pPhysicsComponent->SetFalling(true);
+                    pPhysicsComponent->SetJumping(false);
+                    }
                     }
                     else
                     {
-                        pPhysicsComponent->SetFalling(false);
-                    }
+                    pPhysicsComponent->SetFalling(true);
                     pPhysicsComponent->SetJumping(false);
-                }
+                    }*/
 
-                // Notify change of states
-                if (!wasFalling && pPhysicsComponent->IsFalling())
+                    pPhysicsComponent->SetFalling(true);
+                    pPhysicsComponent->SetJumping(false);
+                }
+                else // Jumping
                 {
-                    /*if (pGameActor->GetName() == "Claw")
+                    if (pPhysicsComponent->CanJump())
                     {
-                    LOG("----" + ToStr(bodyPixelPosition.y - actorPixelPosition.y));
-
-                    int count;
-                    auto keys = SDL_GetKeyboardState(&count);
+                        pPhysicsComponent->SetFalling(false);
+                        pPhysicsComponent->SetJumping(true);
+                        pPhysicsComponent->AddJumpHeight(fabs(bodyPixelPosition.y - actorPixelPosition.y));
 
-                    LOG("space: " + ToStr(keys[SDL_SCANCODE_SPACE]));
-                    }*/
-                    pPhysicsComponent->OnStartFalling();
+                        float jumpPixelsLeft = pPhysicsComponent->GetMaxJumpHeight() - pPhysicsComponent->GetHeightInAir();
+                        // Jumped past limit
+                        if (!g_pApp->GetGameCheats()->clawInfiniteJump && jumpPixelsLeft < 0.0f)
+                        {
+                            // Set b2Body to its max height
+                            bodyPixelPosition = Point(bodyPixelPosition.x, bodyPixelPosition.y + fabs(jumpPixelsLeft));
+                            VSetPosition(actorId, bodyPixelPosition);
+                            pPhysicsComponent->SetForceFall();
+                        }
+                    }
                 }
-                if (!wasJumping && pPhysicsComponent->IsJumping())
+            }
+            else if (fabs(bodyPixelPosition.y - actorPixelPosition.y) < DBL_EPSILON)
+            {
+                // TODO: Check this. This causes animation glitches on connected ground platforms
+                // Should be fixed when all consecutive tiles are joined, but anyway, keep this in mind
+                if (!pPhysicsComponent->IsOnGround() && (bodyPixelPosition.y - actorPixelPosition.y) > DBL_EPSILON)
+                {
+                    //LOG("!pPhysicsComponent->IsOnGround()");
+                    pPhysicsComponent->SetFalling(true);
+                }
+                else
                 {
-                    //LOG(ToStr(bodyPixelPosition.y - actorPixelPosition.y));
-                    pPhysicsComponent->OnStartJumping();
+                    pPhysicsComponent->SetFalling(false);
                 }
+                pPhysicsComponent->SetJumping(false);
             }
 
-            // Body moved by some portion
-            if ((fabs(bodyPixelPosition.x - actorPixelPosition.x)) > DBL_EPSILON ||
-                (fabs(bodyPixelPosition.y - actorPixelPosition.y)) > DBL_EPSILON)
+            // Notify change of states
+            if (!wasFalling && pPhysicsComponent->IsFalling())
             {
-                // Box2D has moved the physics object. Update actor's position and notify subsystems which care
-                pPositionComponent->SetPosition(bodyPixelPosition);
+                /*if (pGameActor->GetName() == "Claw")
+                {
+                LOG("----" + ToStr(bodyPixelPosition.y - actorPixelPosition.y));
 
-                shared_ptr<EventData_Move_Actor> pEvent(new EventData_Move_Actor(actorId, bodyPixelPosition));
-                IEventMgr::Get()->VTriggerEvent(pEvent);
+                int count;
+                auto keys = SDL_GetKeyboardState(&count);
 
-                // If it is kinematic body (moving platform, elevator), notify it
-                if (pActorBody->GetType() == b2_kinematicBody)
-                {
-                    shared_ptr<KinematicComponent> pKinematicComponent = GetKinematicComponentFromB2Body(pActorBody);
-                    //pKinematicComponent->RemoveCarriedBody(pActorBody);
-                    pKinematicComponent->OnMoved(bodyPixelPosition);
-                }
+                LOG("space: " + ToStr(keys[SDL_SCANCODE_SPACE]));
+                }*/
+                pPhysicsComponent->OnStartFalling();
+            }
+            if (!wasJumping && pPhysicsComponent->IsJumping())
+            {
+                //LOG(ToStr(bodyPixelPosition.y - actorPixelPosition.y));
+                pPhysicsComponent->OnStartJumping();
+            }
+        }
+
+        // Body moved by some portion
+        if ((fabs(bodyPixelPosition.x - actorPixelPosition.x)) > DBL_EPSILON ||
+            (fabs(bodyPixelPosition.y - actorPixelPosition.y)) > DBL_EPSILON)
+        {
+            // Box2D has moved the physics object. Update actor's position and notify subsystems which care
+            pPositionComponent->SetPosition(bodyPixelPosition);
+            m_MovedActors.push_back(ActorMove(actorId, bodyPixelPosition));
+
+            // If it is kinematic body (moving platform, elevator), notify it
+            if (pActorBody->GetType() == b2_kinematicBody)
+            {
+                KinematicComponent* pKinematicComponent = syncedBody.pKinematicComponent;
+                assert(pKinematicComponent);
+                //pKinematicComponent->RemoveCarriedBody(pActorBody);
+                pKinematicComponent->OnMoved(bodyPixelPosition);
             }
         }
     }
+
+    if (!m_MovedActors.empty())
+    {
+        shared_ptr<EventData_Move_Actors_Batch> pEvent(MakeEvent<EventData_Move_Actors_Batch>(m_MovedActors));
+        IEventMgr::Get()->VTriggerEvent(pEvent);
+
+        // Take the storage back so that next sync does not have to allocate it
+        pEvent->SwapMoves(m_MovedActors);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -375,11 +378,11 @@ void ClawPhysics::VOnUpdate(const uint32 msDiff)
             m_pWorld->DestroyBody(pBody);
             m_ActorToBodyMap.erase(actorId);
             m_BodyToActorMap.erase(pBody);
-            for (auto iter = m_ActorIdAndBodyList.begin(); iter != m_ActorIdAndBodyList.end(); iter++)
+            for (auto iter = m_SyncedBodies.begin(); iter != m_SyncedBodies.end(); iter++)
             {
-                if (iter->first == actorId)
+                if (iter->pBody == pBody)
                 {
-                    m_ActorIdAndBodyList.erase(iter);
+                    m_SyncedBodies.erase(iter);
                     break;
                 }
             }
@@ -523,7 +526,7 @@ void ClawPhysics::VAddDynamicActor(WeakActorPtr pActor)
     }
 
     shared_ptr<PositionComponent> pPositionComponent =
-        MakeStrongPtr(pStrongActor->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(pStrongActor->GetComponent<PositionComponent>());
     if (!pPositionComponent)
     {
         return;
@@ -531,7 +534,7 @@ void ClawPhysics::VAddDynamicActor(WeakActorPtr pActor)
     Point position = pPositionComponent->GetPosition();
 
     shared_ptr<PhysicsComponent> pPhysicsComponent =
-        MakeStrongPtr(pStrongActor->GetComponent<PhysicsComponent>(PhysicsComponent::g_Name));
+        MakeStrongPtr(pStrongActor->GetComponent<PhysicsComponent>());
     if (!pPhysicsComponent)
     {
         return;
@@ -581,7 +584,7 @@ void ClawPhysics::VAddDynamicActor(WeakActorPtr pActor)
 
     m_ActorToBodyMap.insert(std::make_pair(pStrongActor->GetGUID(), pBody));
     m_BodyToActorMap.insert(std::make_pair(pBody, pStrongActor->GetGUID()));
-    m_ActorIdAndBodyList.push_back(std::make_pair(pStrongActor->GetGUID(), pBody));
+    AddSyncedBody(pStrongActor, pBody);
 }
 
 //-----------------------------------------------------------------------------
@@ -600,7 +603,7 @@ void ClawPhysics::VAddKinematicBody(WeakActorPtr pActor)
     }
 
     shared_ptr<PositionComponent> pPositionComponent =
-        MakeStrongPtr(pStrongActor->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(pStrongActor->GetComponent<PositionComponent>());
     if (!pPositionComponent)
     {
         LOG_ERROR("Attempting to create kinematic body without position component");
@@ -609,7 +612,7 @@ void ClawPhysics::VAddKinematicBody(WeakActorPtr pActor)
     Point position = pPositionComponent->GetPosition();
 
     shared_ptr<KinematicComponent> pKinematicComponent =
-        MakeStrongPtr(pStrongActor->GetComponent<KinematicComponent>(KinematicComponent::g_Name));
+        MakeStrongPtr(pStrongActor->GetComponent<KinematicComponent>());
     if (!pKinematicComponent)
     {
         LOG_ERROR("Attempting to create kinematic body without kinematic component");
@@ -640,7 +643,7 @@ void ClawPhysics::VAddKinematicBody(WeakActorPtr pActor)
 
     m_ActorToBodyMap.insert(std::make_pair(pStrongActor->GetGUID(), pBody));
     m_BodyToActorMap.insert(std::make_pair(pBody, pStrongActor->GetGUID()));
-    m_ActorIdAndBodyList.push_back(std::make_pair(pStrongActor->GetGUID(), pBody));
+    AddSyncedBody(pStrongActor, pBody);
 }
 
 void ClawPhysics::VAddStaticBody(WeakActorPtr pActor, Point bodySize, CollisionType collisionType)
@@ -654,7 +657,7 @@ void ClawPhysics::VAddStaticBody(WeakActorPtr pActor, Point bodySize, CollisionT
     }
 
     shared_ptr<PositionComponent> pPositionComponent =
-        MakeStrongPtr(pStrongActor->GetComponent<PositionComponent>(PositionComponent::g_Name));
+        MakeStrongPtr(pStrongActor->GetComponent<PositionComponent>());
     if (!pPositionComponent)
     {
         LOG_ERROR("Attempting to create static body without position component");
@@ -685,7 +688,7 @@ void ClawPhysics::VAddStaticBody(WeakActorPtr pActor, Point bodySize, CollisionT
 
     m_ActorToBodyMap.insert(std::make_pair(pStrongActor->GetGUID(), pBody));
     m_BodyToActorMap.insert(std::make_pair(pBody, pStrongActor->GetGUID()));
-    m_ActorIdAndBodyList.push_back(std::make_pair(pStrongActor->GetGUID(), pBody));
+    AddSyncedBody(pStrongActor, pBody);
 }
 
 void ClawPhysics::VAddActorBody(const ActorBodyDef* actorBodyDef)
@@ -807,7 +810,7 @@ void ClawPhysics::VAddActorBody(const ActorBodyDef* actorBodyDef)
 
     m_ActorToBodyMap.insert(std::make_pair(pStrongActor->GetGUID(), pBody));
     m_BodyToActorMap.insert(std::make_pair(pBody, pStrongActor->GetGUID()));
-    m_ActorIdAndBodyList.push_back(std::make_pair(pStrongActor->GetGUID(), pBody));
+    AddSyncedBody(pStrongActor, pBody);
 
     if (actorBodyDef->setInitialSpeed)
     {
@@ -819,6 +822,24 @@ void ClawPhysics::VAddActorBody(const ActorBodyDef* actorBodyDef)
     }
 }
 
+void ClawPhysics::AddSyncedBody(StrongActorPtr pActor, b2Body* pBody)
+{
+    // Static bodies never move on their own
+    if (pBody->GetType() == b2_staticBody)
+    {
+        return;
+    }
+
+    SyncedActorBody syncedBody;
+    syncedBody.actorId = pActor->GetGUID();
+    syncedBody.pBody = pBody;
+    syncedBody.pPositionComponent = pActor->GetPositionComponent().get();
+    syncedBody.pPhysicsComponent = MakeStrongPtr(pActor->GetComponent<PhysicsComponent>()).get();
+    syncedBody.pKinematicComponent = MakeStrongPtr(pActor->GetComponent<KinematicComponent>()).get();
+
+    m_SyncedBodies.push_back(syncedBody);
+}
+
 void ClawPhysics::AddActorFixtureToBody(b2Body* pBody, const ActorFixtureDef* pFixtureDef)
 {
     assert(pBody);
@@ -955,7 +976,7 @@ void ClawPhysics::VCreateTrigger(WeakActorPtr pActor, const Point& pos, Point& s
 
     m_ActorToBodyMap.insert(std::make_pair(pStrongActor->GetGUID(), pBody));
     m_BodyToActorMap.insert(std::make_pair(pBody, pStrongActor->GetGUID()));
-    m_ActorIdAndBodyList.push_back(std::make_pair(pStrongActor->GetGUID(), pBody));
+    AddSyncedBody(pStrongActor, pBody);
 }
 
 //-----------------------------------------------------------------------------
@@ -1115,6 +1136,8 @@ void ClawPhysics::VSetPosition(uint32_t actorId, const Point& position)
     if (b2Body* pBody = FindBox2DBody(actorId))
     {
         pBody->SetTransform(b2Position, 0);
+        // Sleeping bodies are not synced, see VSyncVisibleScene()
+        pBody->SetAwake(true);
     }
 }
 
@@ -1154,6 +1177,21 @@ void ClawPhysics::VDeactivate(uint32_t actorId)
     }
 }
 
+//-----------------------------------------------------------------------------
+// ClawPhysics::VIsActive
+//
+//    Returns false if body is deactivated or actor does not have any body.
+//
+bool ClawPhysics::VIsActive(uint32_t actorId)
+{
+    if (b2Body* pBody = FindBox2DBody(actorId))
+    {
+        return pBody->IsActive();
+    }
+
+    return false;
+}
+
 bool ClawPhysics::VIsAwake(uint32_t actorId)
 {
     if (b2Body* pBody = FindBox2DBody(actorId))
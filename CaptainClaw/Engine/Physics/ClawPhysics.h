@@ -3,12 +3,36 @@
 
 #include "../Interfaces.h"
 #include "../SharedDefines.h"
+#include "../Events/Events.h"
+#include "../Actor/ActorPool.h"
 
 #include <Box2D/Box2D.h>
 
-typedef std::map<uint32, b2Body*> ActorIDToBox2DBodyMap;
-typedef std::map<b2Body*, uint32> Box2DBodyToActorIDMap;
-typedef std::vector<std::pair<uint32, b2Body*>> ActorIdAndBodyList;
+// Nodes are pooled, bodies of spawned actors are added and removed constantly. Bodies themselves come from Box2D's
+// own block allocator which recycles them as well.
+typedef std::map<uint32, b2Body*, std::less<uint32>,
+    ActorPoolAllocator<std::pair<const uint32, b2Body*>>> ActorIDToBox2DBodyMap;
+typedef std::map<b2Body*, uint32, std::less<b2Body*>,
+    ActorPoolAllocator<std::pair<b2Body* const, uint32>>> Box2DBodyToActorIDMap;
+
+class PositionComponent;
+class KinematicComponent;
+class PhysicsComponent;
+class TriggerComponent;
+class ProjectileAIComponent;
+
+// Non-static body which has to be synced with its actor
+struct SyncedActorBody
+{
+    uint32 actorId;
+    b2Body* pBody;
+    // Cached when body is created, valid as long as body's user data is set
+    PositionComponent* pPositionComponent;
+    PhysicsComponent* pPhysicsComponent;
+    KinematicComponent* pKinematicComponent;
+};
+
+typedef std::vector<SyncedActorBody> SyncedActorBodyList;
 
 class PhysicsContactListener;
 class PhysicsDebugDrawer;
@@ -61,6 +85,7 @@ public:
 
     virtual void VActivate(uint32_t actorId) override;
     virtual void VDeactivate(uint32_t actorId) override;
+    virtual bool VIsActive(uint32_t actorId) override;
 
     virtual void VSetPosition(uint32_t actorId, const Point& position) override;
     virtual Point VGetPosition(uint32_t actorId) override;
@@ -76,6 +101,7 @@ private:
     uint32 FindActorId(b2Body* pBody);
     void ScheduleActorForRemoval(uint32 actorId) { m_ActorsToBeDestroyed.push_back(actorId); }
     void AddActorFixtureToBody(b2Body* pBody, const ActorFixtureDef* pFixtureDef);
+    void AddSyncedBody(StrongActorPtr pActor, b2Body* pBody);
     
     unique_ptr<b2World> m_pWorld;
     unique_ptr<PhysicsDebugDrawer> m_pDebugDrawer;
@@ -88,14 +114,11 @@ private:
     
     ActorIDToBox2DBodyMap m_ActorToBodyMap;
     Box2DBodyToActorIDMap m_BodyToActorMap;
-    ActorIdAndBodyList m_ActorIdAndBodyList;
+    SyncedActorBodyList m_SyncedBodies;
+    // Reused by VSyncVisibleScene() so that syncing does not allocate every frame
+    ActorMoveList m_MovedActors;
 };
 
-class KinematicComponent;
-class PhysicsComponent;
-class TriggerComponent;
-class ProjectileAIComponent;
-
 extern shared_ptr<PhysicsComponent> GetPhysicsComponentFromB2Body(const b2Body* pBody);
 extern shared_ptr<KinematicComponent> GetKinematicComponentFromB2Body(const b2Body* pBody);
 extern shared_ptr<TriggerComponent> GetTriggerComponentFromB2Body(const b2Body* pBody);
@@ -191,7 +191,7 @@ void PhysicsContactListener::BeginContact(b2Contact* pContact)
                     assert(pActor);
 
                     shared_ptr<CrumblingPegAIComponent> pCrumblingPegComponent =
-                        MakeStrongPtr(pActor->GetComponent<CrumblingPegAIComponent>(CrumblingPegAIComponent::g_Name));
+                        MakeStrongPtr(pActor->GetComponent<CrumblingPegAIComponent>());
                     if (pCrumblingPegComponent)
                     {
                         pCrumblingPegComponent->OnContact(pFixtureB->GetBody());
@@ -248,14 +248,14 @@ void PhysicsContactListener::BeginContact(b2Contact* pContact)
                 {
                     // HACK:
                     /*if (shared_ptr<ClawControllableComponent> pClaw =
-                        MakeStrongPtr(pActor->GetComponent<ClawControllableComponent>(ClawControllableComponent::g_Name)))
+                        MakeStrongPtr(pActor->GetComponent<ClawControllableComponent>()))
                     {
                         Actor* pProjectileActor = static_cast<Actor*>(pFixtureA->GetBody()->GetUserData());
                         shared_ptr<PositionComponent> pProjectilePositionComponent =
-                            MakeStrongPtr(pProjectileActor->GetComponent<PositionComponent>(PositionComponent::g_Name));
+                            MakeStrongPtr(pProjectileActor->GetComponent<PositionComponent>());
 
                         shared_ptr<PositionComponent> pClawPositionComponent =
-                            MakeStrongPtr(pActor->GetComponent<PositionComponent>(PositionComponent::g_Name));
+                            MakeStrongPtr(pActor->GetComponent<PositionComponent>());
 
                         assert(pProjectilePositionComponent);
                         assert(pClawPositionComponent);
@@ -299,7 +299,7 @@ void PhysicsContactListener::BeginContact(b2Contact* pContact)
                 assert(pActor);
 
                 shared_ptr<HealthComponent> pHealthComponent =
-                    MakeStrongPtr(pActor->GetComponent<HealthComponent>(HealthComponent::g_Name));
+                    MakeStrongPtr(pActor->GetComponent<HealthComponent>());
                 if (pHealthComponent)
                 {
                     pHealthComponent->AddHealth(-1 * (pHealthComponent->GetHealth() + 1), DamageType_DeathSpike, Point(0, 0));
@@ -324,7 +324,7 @@ void PhysicsContactListener::BeginContact(b2Contact* pContact)
                 if (pActorwhoEntered && pActorWithMeleeSensor)
                 {
                     shared_ptr<EnemyAIComponent> pEnemyAIComponent =
-                        MakeStrongPtr(pActorWithMeleeSensor->GetComponent<EnemyAIComponent>(EnemyAIComponent::g_Name));
+                        MakeStrongPtr(pActorWithMeleeSensor->GetComponent<EnemyAIComponent>());
                     if (pEnemyAIComponent)
                     {
                         pEnemyAIComponent->OnEnemyEnteredMeleeZone(pActorwhoEntered);
@@ -350,7 +350,7 @@ void PhysicsContactListener::BeginContact(b2Contact* pContact)
                 if (pActorwhoEntered && pActorWithRangedSensor)
                 {
                     shared_ptr<EnemyAIComponent> pEnemyAIComponent =
-                        MakeStrongPtr(pActorWithRangedSensor->GetComponent<EnemyAIComponent>(EnemyAIComponent::g_Name));
+                        MakeStrongPtr(pActorWithRangedSensor->GetComponent<EnemyAIComponent>());
                     if (pEnemyAIComponent)
                     {
                         pEnemyAIComponent->OnEnemyEnteredRangedZone(pActorwhoEntered);
@@ -376,7 +376,7 @@ void PhysicsContactListener::BeginContact(b2Contact* pContact)
                 if (pActorwhoEntered && pActorWithDamageAura)
                 {
                     shared_ptr<DamageAuraComponent> pDamageAuraComponent =
-                        MakeStrongPtr(pActorWithDamageAura->GetComponent<DamageAuraComponent>(DamageAuraComponent::g_Name));
+                        MakeStrongPtr(pActorWithDamageAura->GetComponent<DamageAuraComponent>());
                     if (pDamageAuraComponent)
                     {
                         pDamageAuraComponent->OnActorEntered(pActorwhoEntered);
@@ -523,7 +523,7 @@ void PhysicsContactListener::EndContact(b2Contact* pContact)
                 if (pActorWhoLeft && pActorWithMeleeSensor)
                 {
                     shared_ptr<EnemyAIComponent> pEnemyAIComponent =
-                        MakeStrongPtr(pActorWithMeleeSensor->GetComponent<EnemyAIComponent>(EnemyAIComponent::g_Name));
+                        MakeStrongPtr(pActorWithMeleeSensor->GetComponent<EnemyAIComponent>());
                     if (pEnemyAIComponent)
                     {
                         pEnemyAIComponent->OnEnemyLeftMeleeZone(pActorWhoLeft);
@@ -549,7 +549,7 @@ void PhysicsContactListener::EndContact(b2Contact* pContact)
                 if (pActorWhoLeft && pActorWithRangedSensor)
                 {
                     shared_ptr<EnemyAIComponent> pEnemyAIComponent =
-                        MakeStrongPtr(pActorWithRangedSensor->GetComponent<EnemyAIComponent>(EnemyAIComponent::g_Name));
+                        MakeStrongPtr(pActorWithRangedSensor->GetComponent<EnemyAIComponent>());
                     if (pEnemyAIComponent)
                     {
                         pEnemyAIComponent->OnEnemyLeftRangedZone(pActorWhoLeft);
@@ -575,7 +575,7 @@ void PhysicsContactListener::EndContact(b2Contact* pContact)
                 if (pActorwhoEntered && pActorWithDamageAura)
                 {
                     shared_ptr<DamageAuraComponent> pDamageAuraComponent =
-                        MakeStrongPtr(pActorWithDamageAura->GetComponent<DamageAuraComponent>(DamageAuraComponent::g_Name));
+                        MakeStrongPtr(pActorWithDamageAura->GetComponent<DamageAuraComponent>());
                     if (pDamageAuraComponent)
                     {
                         pDamageAuraComponent->OnActorLeft(pActorwhoEntered);
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <cstring>
+
+#include "TileGeometryCompiler.h"
+
+TileGeometryCompiler::TileGeometryCompiler(int32 tilesOnAxisX, int32 tilesOnAxisY, int32 tileWidth, int32 tileHeight)
+    :
+    m_TilesOnAxisX(tilesOnAxisX),
+    m_TilesOnAxisY(tilesOnAxisY),
+    m_TileWidth(tileWidth),
+    m_TileHeight(tileHeight),
+    m_NumAddedRects(0)
+{
+    for (int32 type = CollisionType_Solid; type <= CollisionType_Death; type++)
+    {
+        if (IsMergedType(CollisionType(type)))
+        {
+            m_FullTileGrids[GetGridIdx(CollisionType(type))].resize(tilesOnAxisX * tilesOnAxisY, 0);
+        }
+    }
+}
+
+const char* TileGeometryCompiler::GetBuildStamp()
+{
+    return __DATE__ " " __TIME__;
+}
+
+void TileGeometryCompiler::AddTileRect(int32 tileX, int32 tileY, CollisionType collisionType, const SDL_Rect& rect)
+{
+    assert(tileX >= 0 && tileX < m_TilesOnAxisX && tileY >= 0 && tileY < m_TilesOnAxisY);
+
+    if (IsMergedType(collisionType) &&
+        rect.x == 0 && rect.y == 0 && rect.w == m_TileWidth && rect.h == m_TileHeight)
+    {
+        m_FullTileGrids[GetGridIdx(collisionType)][tileY * m_TilesOnAxisX + tileX] = 1;
+        m_NumAddedRects++;
+        return;
+    }
+
+    SDL_Rect planeRect = { tileX * m_TileWidth + rect.x, tileY * m_TileHeight + rect.y, rect.w, rect.h };
+    AddRect(collisionType, planeRect);
+}
+
+void TileGeometryCompiler::AddRect(CollisionType collisionType, const SDL_Rect& rect)
+{
+    if (collisionType == CollisionType_None || rect.w <= 0 || rect.h <= 0)
+    {
+        return;
+    }
+
+    if (IsMergedType(collisionType))
+    {
+        m_PartialRects[GetGridIdx(collisionType)].push_back(rect);
+    }
+    else
+    {
+        StaticGeometryRect geometryRect = { collisionType, rect };
+        m_UnmergedRects.push_back(geometryRect);
+    }
+
+    m_NumAddedRects++;
+}
+
+void TileGeometryCompiler::Compile(StaticGeometryList& geometry)
+{
+    for (int32 type = CollisionType_Solid; type <= CollisionType_Death; type++)
+    {
+        CollisionType collisionType = CollisionType(type);
+        if (!IsMergedType(collisionType))
+        {
+            continue;
+        }
+
+        std::vector<SDL_Rect>& rects = m_PartialRects[GetGridIdx(collisionType)];
+        MergeFullTiles(collisionType, rects);
+        MergeRects(collisionType, rects, geometry);
+    }
+
+    geometry.insert(geometry.end(), m_UnmergedRects.begin(), m_UnmergedRects.end());
+    m_UnmergedRects.clear();
+}
+
+void TileGeometryCompiler::MergeFullTiles(CollisionType collisionType, std::vector<SDL_Rect>& rects)
+{
+    // Tiles are cleared as they are merged so every tile ends up in exactly one rectangle
+    std::vector<uint8>& grid = m_FullTileGrids[GetGridIdx(collisionType)];
+    const bool canMergeAlongColumn = CanMergeAlongColumn(collisionType);
+
+    for (int32 tileY = 0; tileY < m_TilesOnAxisY; tileY++)
+    {
+        uint8* pRow = &grid[tileY * m_TilesOnAxisX];
+        for (int32 tileX = 0; tileX < m_TilesOnAxisX; tileX++)
+        {
+            if (!pRow[tileX])
+            {
+                continue;
+            }
+
+            int32 width = 1;
+            while (tileX + width < m_TilesOnAxisX && pRow[tileX + width])
+            {
+                width++;
+            }
+
+            int32 height = 1;
+            while (canMergeAlongColumn && tileY + height < m_TilesOnAxisY)
+            {
+                const uint8* pSpan = &grid[(tileY + height) * m_TilesOnAxisX + tileX];
+                if (std::find(pSpan, pSpan + width, 0) != pSpan + width)
+                {
+                    break;
+                }
+                height++;
+            }
+
+            for (int32 spanY = tileY; spanY < tileY + height; spanY++)
+            {
+                memset(&grid[spanY * m_TilesOnAxisX + tileX], 0, width);
+            }
+
+            SDL_Rect rect = { tileX * m_TileWidth, tileY * m_TileHeight, width * m_TileWidth, height * m_TileHeight };
+            rects.push_back(rect);
+        }
+    }
+}
+
+void TileGeometryCompiler::MergeRects(CollisionType collisionType, std::vector<SDL_Rect>& rects, StaticGeometryList& geometry)
+{
+    // Rectangles with the same vertical extent which touch or overlap along the row
+    std::sort(rects.begin(), rects.end(), [](const SDL_Rect& left, const SDL_Rect& right)
+    {
+        if (left.y != right.y) return left.y < right.y;
+        if (left.h != right.h) return left.h < right.h;
+        return left.x < right.x;
+    });
+
+    size_t numMerged = 0;
+    for (const SDL_Rect& rect : rects)
+    {
+        SDL_Rect* pLast = numMerged > 0 ? &rects[numMerged - 1] : NULL;
+        if (pLast && pLast->y == rect.y && pLast->h == rect.h && rect.x <= pLast->x + pLast->w)
+        {
+            pLast->w = max(pLast->x + pLast->w, rect.x + rect.w) - pLast->x;
+        }
+        else
+        {
+            rects[numMerged++] = rect;
+        }
+    }
+    rects.resize(numMerged);
+
+    if (CanMergeAlongColumn(collisionType))
+    {
+        std::sort(rects.begin(), rects.end(), [](const SDL_Rect& left, const SDL_Rect& right)
+        {
+            if (left.x != right.x) return left.x < right.x;
+            if (left.w != right.w) return left.w < right.w;
+            return left.y < right.y;
+        });
+
+        numMerged = 0;
+        for (const SDL_Rect& rect : rects)
+        {
+            SDL_Rect* pLast = numMerged > 0 ? &rects[numMerged - 1] : NULL;
+            if (pLast && pLast->x == rect.x && pLast->w == rect.w && rect.y <= pLast->y + pLast->h)
+            {
+                pLast->h = max(pLast->y + pLast->h, rect.y + rect.h) - pLast->y;
+            }
+            else
+            {
+                rects[numMerged++] = rect;
+            }
+        }
+        rects.resize(numMerged);
+    }
+
+    for (const SDL_Rect& rect : rects)
+    {
+        StaticGeometryRect geometryRect = { collisionType, rect };
+        geometry.push_back(geometryRect);
+    }
+    rects.clear();
+}
@@ -0,0 +1,74 @@
+#ifndef __TILEGEOMETRYCOMPILER_H__
+#define __TILEGEOMETRYCOMPILER_H__
+
+#include <vector>
+#include <SDL2/SDL.h>
+
+#include "../Interfaces.h"
+#include "../SharedDefines.h"
+
+struct StaticGeometryRect
+{
+    CollisionType collisionType;
+    SDL_Rect rect;
+};
+
+typedef std::vector<StaticGeometryRect> StaticGeometryList;
+
+//---------------------------------------------------------------------------------------------------------------------
+// TileGeometryCompiler
+//
+// Merges collision rectangles of plane tiles into as few rectangles as possible. Tiles whose whole area has one
+// collision type are rasterised into a grid per collision type which is merged greedily, first along the row and
+// then down as long as the whole span below is covered too. The resulting rectangles are then merged together with
+// rectangles covering only part of a tile, with neighbours of exactly the same height (along rows) or width (along
+// columns), so e.g. a half tile wall continues the full tile wall next to it.
+//
+// Ground is only merged along rows, it is one-way and a taller fixture would change where it can be passed from
+// below. Ladders are not merged at all, climbing snaps actor to the ladder fixture and its extents decide where the
+// ladder top and bottom are, so they stay exactly as they were per tile.
+//---------------------------------------------------------------------------------------------------------------------
+class TileGeometryCompiler
+{
+public:
+    TileGeometryCompiler(int32 tilesOnAxisX, int32 tilesOnAxisY, int32 tileWidth, int32 tileHeight);
+
+    // Rectangle is relative to the tile, it does not have to cover the whole tile
+    void AddTileRect(int32 tileX, int32 tileY, CollisionType collisionType, const SDL_Rect& rect);
+    // Rectangle in plane pixels, e.g. additional ground which is not part of any tile
+    void AddRect(CollisionType collisionType, const SDL_Rect& rect);
+
+    // Can only be called once
+    void Compile(StaticGeometryList& geometry);
+
+    uint32 GetNumAddedRects() const { return m_NumAddedRects; }
+
+    // Time TileGeometryCompiler was compiled, part of LevelCache::GetConverterVersion()
+    static const char* GetBuildStamp();
+
+private:
+    // Solid, ground and death are merged, ladders are passed as they are
+    static bool IsMergedType(CollisionType collisionType) { return collisionType != CollisionType_None && collisionType != CollisionType_Climb; }
+    // Index into m_FullTileGrids, types are CollisionType_Solid..CollisionType_Death
+    static int32 GetGridIdx(CollisionType collisionType) { return collisionType - CollisionType_Solid; }
+    static bool CanMergeAlongColumn(CollisionType collisionType) { return collisionType != CollisionType_Ground; }
+
+    // Appends merged full tiles to rects in plane pixels
+    void MergeFullTiles(CollisionType collisionType, std::vector<SDL_Rect>& rects);
+    void MergeRects(CollisionType collisionType, std::vector<SDL_Rect>& rects, StaticGeometryList& geometry);
+
+    int32 m_TilesOnAxisX;
+    int32 m_TilesOnAxisY;
+    int32 m_TileWidth;
+    int32 m_TileHeight;
+
+    // One byte per tile for each merged collision type, non-zero if tile is fully covered
+    std::vector<uint8> m_FullTileGrids[CollisionType_Death];
+    std::vector<SDL_Rect> m_PartialRects[CollisionType_Death];
+    // Collision types which are not merged are passed as they are
+    StaticGeometryList m_UnmergedRects;
+
+    uint32 m_NumAddedRects;
+};
+
+#endif
@@ -17,7 +17,17 @@ AniResourceExtraData::~AniResourceExtraData()
     }
 }
 
-void AniResourceExtraData::LoadAni(char* rawBuffer, uint32 size)
+uint32 AniResourceExtraData::VGetMemorySize()
+{
+    if (_ani == NULL)
+    {
+        return 0;
+    }
+
+    return sizeof(WapAni) + _ani->imageSetPathLength + _ani->animationFramesCount * sizeof(AniAnimationFrame);
+}
+
+void AniResourceExtraData::LoadAni(const char* rawBuffer, uint32 size)
 {
     _ani = WAP_AniLoadFromData(rawBuffer, size);
 }
@@ -28,7 +38,7 @@ void AniResourceExtraData::LoadAni(char* rawBuffer, uint32 size)
 //     This class implements the IResourceLoader interface with ANI animation desc format
 //
 
-bool AniResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
+bool AniResourceLoader::VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
 {
     if (rawSize <= 0 || rawBuffer == NULL)
     {
@@ -44,6 +54,18 @@ bool AniResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::shar
     return true;
 }
 
+shared_ptr<IResourceExtraData> AniResourceLoader::VDecodeResource(const char* rawBuffer, uint32 rawSize)
+{
+    shared_ptr<AniResourceExtraData> extraData = shared_ptr<AniResourceExtraData>(new AniResourceExtraData());
+    extraData->LoadAni(rawBuffer, rawSize);
+    if (extraData->GetAni() == NULL)
+    {
+        return nullptr;
+    }
+
+    return extraData;
+}
+
 WapAni* AniResourceLoader::LoadAndReturnAni(const char* resourceString)
 {
     Resource resource(resourceString);
@@ -8,10 +8,12 @@ class Animation;
 class AniResourceExtraData : public IResourceExtraData
 {
 public:
+    AniResourceExtraData() { _ani = NULL; }
     virtual ~AniResourceExtraData();
 
     virtual std::string VToString() { return "AniResourceExtraData"; }
-    void LoadAni(char* rawBuffer, uint32 size);
+    virtual uint32 VGetMemorySize();
+    void LoadAni(const char* rawBuffer, uint32 size);
     WapAni* GetAni() { return _ani; }
 
 private:
@@ -24,8 +26,10 @@ public:
     virtual std::string VGetPattern() { return "*.ani"; }
     virtual bool VUseRawFile() { return false; }
     virtual bool VDiscardRawBufferAfterLoad() { return true; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize) { return rawSize; }
-    virtual bool VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize) { return rawSize; }
+    virtual bool VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
+    virtual bool VCanDecodeAsync() { return true; }
+    virtual std::shared_ptr<IResourceExtraData> VDecodeResource(const char* rawBuffer, uint32 rawSize);
 
     static WapAni* LoadAndReturnAni(const char* resourceString);
     static std::shared_ptr<AniResourceLoader> Create();
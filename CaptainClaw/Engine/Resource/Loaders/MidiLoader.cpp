@@ -19,7 +19,7 @@ MidiResourceExtraData::~MidiResourceExtraData()
     // Sound takes care of its own destruction
 }
 
-void MidiResourceExtraData::LoadMidiFile(char* rawBuffer, uint32 size)
+void MidiResourceExtraData::LoadMidiFile(const char* rawBuffer, uint32 size)
 {
     MidiFile* pMidiFile = WAP_XmiToMidiFromData(rawBuffer, size);
     // TODO: After testing comment this assert
@@ -38,7 +38,7 @@ void MidiResourceExtraData::LoadMidiFile(char* rawBuffer, uint32 size)
 //     This class implements the IResourceLoader interface with Midi "file handle"
 //
 
-bool MidiResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
+bool MidiResourceLoader::VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
 {
     if (rawSize <= 0 || rawBuffer == NULL)
     {
@@ -59,7 +59,7 @@ bool MidiResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::sha
     return true;
 }
 
-uint32 MidiResourceLoader::VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize)
+uint32 MidiResourceLoader::VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize)
 {
     // It is how it is - thats how Mix_Chunk consumes it.
     return rawSize;
@@ -10,7 +10,8 @@ public:
     virtual ~MidiResourceExtraData();
 
     virtual std::string VToString() { return "MidiResourceExtraData"; }
-    void LoadMidiFile(char* rawBuffer, uint32 size);
+    virtual uint32 VGetMemorySize() { return m_pMidiFile ? m_pMidiFile->size : 0; }
+    void LoadMidiFile(const char* rawBuffer, uint32 size);
     shared_ptr<MidiFile> GetMidiFile() { return m_pMidiFile; }
 
 private:
@@ -23,8 +24,8 @@ public:
     virtual std::string VGetPattern() { return "*.xmi"; }
     virtual bool VUseRawFile() { return false; }
     virtual bool VDiscardRawBufferAfterLoad() { return true; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize);
-    virtual bool VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize);
+    virtual bool VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
 
     static shared_ptr<MidiFile> LoadAndReturnMidiFile(const char* resourceString);
     static std::shared_ptr<MidiResourceLoader> Create();
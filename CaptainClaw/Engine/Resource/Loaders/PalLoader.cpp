@@ -16,7 +16,7 @@ PalResourceExtraData::~PalResourceExtraData()
     }
 }
 
-void PalResourceExtraData::LoadPal(char* rawBuffer, uint32 size)
+void PalResourceExtraData::LoadPal(const char* rawBuffer, uint32 size)
 {
     _palette = WAP_PalLoadFromData(rawBuffer, size);
 }
@@ -27,7 +27,7 @@ void PalResourceExtraData::LoadPal(char* rawBuffer, uint32 size)
 //     This class implements the IResourceLoader interface with PAL (256bit palette) file loading
 //
 
-bool PalResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
+bool PalResourceLoader::VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
 {
     if (rawSize <= 0 || rawBuffer == NULL)
     {
@@ -11,7 +11,8 @@ public:
     virtual ~PalResourceExtraData();
 
     virtual std::string VToString() { return "PalResourceExtraData"; }
-    void LoadPal(char* rawBuffer, uint32 size);
+    virtual uint32 VGetMemorySize() { return (_palette != NULL) ? sizeof(WapPal) : 0; }
+    void LoadPal(const char* rawBuffer, uint32 size);
     WapPal* GetPalette() { return _palette; }
 
 private:
@@ -24,8 +25,8 @@ public:
     virtual std::string VGetPattern() { return "*.pal"; }
     virtual bool VUseRawFile() { return false; }
     virtual bool VDiscardRawBufferAfterLoad() { return true; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize) { return rawSize; }
-    virtual bool VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize) { return rawSize; }
+    virtual bool VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
 
     static WapPal* LoadAndReturnPal(const char* resourceString);
     static std::shared_ptr<PalResourceLoader> Create();
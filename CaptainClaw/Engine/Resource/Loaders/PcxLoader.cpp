@@ -10,7 +10,12 @@
 //     This class implements the IResourceExtraData
 //
 
-void PcxResourceExtraData::LoadImage(char* rawBuffer, uint32 size, bool useColorKey, SDL_Color colorKey)
+uint32 PcxResourceExtraData::VGetTextureMemorySize()
+{
+    return m_pImage ? m_pImage->GetTextureMemorySize() : 0;
+}
+
+void PcxResourceExtraData::LoadImage(const char* rawBuffer, uint32 size, bool useColorKey, SDL_Color colorKey)
 {
     if (m_pImage == nullptr)
     {
@@ -45,6 +50,8 @@ shared_ptr<Image> PcxResourceLoader::LoadAndReturnImage(const char* resourceStri
         }
 
         handle->SetExtraData(extraData);
+        // Raw image is not needed once it lives in texture
+        handle->ReleaseDataBuffer();
     }
 
     return extraData->GetImage();
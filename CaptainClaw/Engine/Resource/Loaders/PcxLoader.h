@@ -12,7 +12,8 @@ public:
     PcxResourceExtraData() { m_pImage = nullptr; }
 
     virtual std::string VToString() { return "PcxResourceExtraData"; }
-    void LoadImage(char* rawBuffer, uint32 size, bool useColorKey = false, SDL_Color colorKey = { 0, 0, 0, 0 });
+    virtual uint32 VGetTextureMemorySize();
+    void LoadImage(const char* rawBuffer, uint32 size, bool useColorKey = false, SDL_Color colorKey = { 0, 0, 0, 0 });
     shared_ptr<Image> GetImage() { return m_pImage; }
 
 private:
@@ -25,8 +26,8 @@ public:
     virtual std::string VGetPattern() { return "*.pcx"; }
     virtual bool VUseRawFile() { return true; }
     virtual bool VDiscardRawBufferAfterLoad() { return true; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize) { return rawSize; }
-    virtual bool VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle) { return true; }
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize) { return rawSize; }
+    virtual bool VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle) { return true; }
 
     static shared_ptr<Image> LoadAndReturnImage(const char* resourceString, bool useColorKey = false, SDL_Color colorKey = { 0, 0, 0, 0 });
     static std::shared_ptr<PcxResourceLoader> Create();
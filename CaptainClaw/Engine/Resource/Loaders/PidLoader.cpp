@@ -1,6 +1,7 @@
 #include "PidLoader.h"
 
 #include "../../Graphics2D/Image.h"
+#include "../../Graphics2D/TextureAtlas.h"
 #include "../../GameApp/BaseGameApp.h"
 
 //=================================================================================================
@@ -17,7 +18,18 @@ PidResourceExtraData::~PidResourceExtraData()
     }
 }
 
-void PidResourceExtraData::LoadPid(char* rawBuffer, uint32 size, WapPal* palette)
+uint32 PidResourceExtraData::VGetMemorySize()
+{
+    uint32 pidSize = (_pid != NULL) ? (_pid->colorsCount * sizeof(WAP_ColorRGBA)) : 0;
+    return pidSize + _pixelData.pixels.size() * sizeof(uint32_t);
+}
+
+uint32 PidResourceExtraData::VGetTextureMemorySize()
+{
+    return _image ? _image->GetTextureMemorySize() : 0;
+}
+
+void PidResourceExtraData::LoadPid(const char* rawBuffer, uint32 size, WapPal* palette)
 {
     if (_pid == NULL)
     {
@@ -25,19 +37,46 @@ void PidResourceExtraData::LoadPid(char* rawBuffer, uint32 size, WapPal* palette
     }
 }
 
-void PidResourceExtraData::LoadImage(char* rawBuffer, uint32 size, WapPal* palette)
+void PidResourceExtraData::LoadImage(const char* rawBuffer, uint32 size, WapPal* palette)
 {
-    if (_pid == NULL)
+    // PID loaded through LoadAndReturnPid is reused, otherwise decode straight into texture
+    if (_pid == NULL && !_hasPixelData)
+    {
+        if (_image == NULL)
+        {
+            _image = shared_ptr<Image>(Image::CreatePidImage(rawBuffer, size, palette, g_pApp->GetRenderer()));
+        }
+        return;
+    }
+    CreateImageFromPid();
+}
+
+void PidResourceExtraData::DecodePixels(const char* rawBuffer, uint32 size, WapPal* palette)
+{
+    if (!_hasPixelData)
     {
-        LoadPid(rawBuffer, size, palette);
+        _hasPixelData = Image::DecodePid(rawBuffer, size, palette, _pixelData);
     }
+}
+
+void PidResourceExtraData::CreateImageFromPid()
+{
     if (_image == NULL)
     {
         SDL_Renderer* renderer = g_pApp->GetRenderer();
-        _image = shared_ptr<Image>(Image::CreateImage(_pid, renderer));
-        WAP_PidDestroy(_pid); _pid = NULL;
-        SAFE_DELETE_ARRAY(rawBuffer);
+        if (_hasPixelData)
+        {
+            _image = shared_ptr<Image>(Image::CreateImage(_pixelData, renderer));
+        }
+        else
+        {
+            _image = shared_ptr<Image>(Image::CreateImage(_pid, renderer));
+        }
     }
+
+    WAP_PidDestroy(_pid); _pid = NULL;
+    std::vector<uint32_t>().swap(_pixelData.pixels);
+    _hasPixelData = false;
 }
 
 //=================================================================================================
@@ -89,6 +128,8 @@ shared_ptr<Image> PidResourceLoader::LoadAndReturnImage(const char* resourceStri
         }
 
         handle->SetExtraData(extraData);
+        // Raw PID is not needed once it lives in texture
+        handle->ReleaseDataBuffer();
     }
     // Extra data could be created within LoadAndReturnPid but not the image
     else if (!extraData->GetImage())
@@ -100,11 +141,198 @@ shared_ptr<Image> PidResourceLoader::LoadAndReturnImage(const char* resourceStri
             LOG_ERROR(extraData->VToString() + ": GetImage() returned nullptr. Check if PidResourceLoader is registered.");
             return NULL;
         }
+
+        // Decoded PID was swapped for texture
+        handle->UpdateExtraDataMemorySize();
+        handle->ReleaseDataBuffer();
     }
 
     return extraData->GetImage();
 }
 
+std::vector<shared_ptr<Image>> PidResourceLoader::LoadAndReturnImageSet(const std::vector<std::string>& resourcePaths, WapPal* palette)
+{
+    struct AtlasedPid
+    {
+        uint32 pathIdx;
+        int32 atlasImageId;
+        WapPid header;
+        const char* pRawData;
+        uint32 rawSize;
+        // Set when level pipeline already decoded the PID, its pixels are then only copied
+        shared_ptr<PidResourceExtraData> pDecoded;
+    };
+
+    ResourceCache* pResourceCache = g_pApp->GetResourceCache();
+    IResourceFile* pResourceFile = pResourceCache->GetResourceFile();
+    TextureAtlasBuilder atlasBuilder(g_pApp->GetRenderer());
+
+    std::vector<shared_ptr<Image>> images(resourcePaths.size());
+    std::vector<AtlasedPid> atlasedPids;
+    std::vector<std::vector<char>> rawBuffers;
+    atlasedPids.reserve(resourcePaths.size());
+    rawBuffers.reserve(resourcePaths.size());
+
+    for (uint32 pathIdx = 0; pathIdx < resourcePaths.size(); pathIdx++)
+    {
+        Resource resource(resourcePaths[pathIdx]);
+
+        AtlasedPid pid;
+        pid.pathIdx = pathIdx;
+        pid.header = WapPid();
+
+        if (pResourceCache->IsLoaded(&resource))
+        {
+            shared_ptr<ResourceHandle> handle = pResourceCache->GetHandle(&resource);
+            shared_ptr<PidResourceExtraData> extraData = std::static_pointer_cast<PidResourceExtraData>(handle->GetExtraData());
+
+            // Image set could be shared with another actor which already packed it
+            if (extraData && extraData->GetImage() && extraData->GetImage()->IsInAtlas())
+            {
+                images[pathIdx] = extraData->GetImage();
+                continue;
+            }
+
+            if (extraData && extraData->HasPixelData())
+            {
+                pid.pDecoded = extraData;
+            }
+        }
+
+        pid.atlasImageId = -1;
+        pid.pRawData = NULL;
+        pid.rawSize = 0;
+        if (pid.pDecoded)
+        {
+            const PidPixelData& pixelData = pid.pDecoded->GetPixelData();
+            pid.header.width = pixelData.width;
+            pid.header.height = pixelData.height;
+            pid.header.offsetX = pixelData.offsetX;
+            pid.header.offsetY = pixelData.offsetY;
+            pid.atlasImageId = atlasBuilder.AddImage(pixelData.width, pixelData.height);
+        }
+        else
+        {
+            // Pixels are decoded straight into atlas page, mapped archives do not even need a copy
+            pid.pRawData = pResourceFile->VGetRawResourceView(&resource);
+            int32 rawSize = pResourceFile->VGetRawResourceSize(&resource);
+            if (pid.pRawData == NULL && rawSize > 0)
+            {
+                rawBuffers.push_back(std::vector<char>(rawSize));
+                if (pResourceFile->VGetRawResource(&resource, rawBuffers.back().data()) >= 0)
+                {
+                    pid.pRawData = rawBuffers.back().data();
+                }
+            }
+            pid.rawSize = (rawSize > 0) ? rawSize : 0;
+
+            if (pid.pRawData != NULL && WAP_PidLoadHeaderFromData(pid.pRawData, pid.rawSize, &pid.header) == 0)
+            {
+                pid.atlasImageId = atlasBuilder.AddImage(pid.header.width, pid.header.height);
+            }
+        }
+
+        if (pid.atlasImageId < 0)
+        {
+            images[pathIdx] = LoadAndReturnImage(resourcePaths[pathIdx].c_str(), palette);
+            continue;
+        }
+
+        atlasedPids.push_back(pid);
+    }
+
+    atlasBuilder.Pack();
+
+    for (AtlasedPid& pid : atlasedPids)
+    {
+        uint32 pitch;
+        uint32_t* pPixels = atlasBuilder.GetPixels(pid.atlasImageId, pitch);
+        if (pid.pDecoded)
+        {
+            const PidPixelData& pixelData = pid.pDecoded->GetPixelData();
+            for (uint32 y = 0; y < pixelData.height; y++)
+            {
+                memcpy((char*)pPixels + y * pitch, (const char*)pixelData.pixels.data() + y * pixelData.pitch,
+                    pixelData.width * sizeof(uint32_t));
+            }
+            continue;
+        }
+
+        if (WAP_PidDecodeFromData(pid.pRawData, pid.rawSize, palette, pPixels, pitch) < 0)
+        {
+            // Its place in atlas is left transparent
+            images[pid.pathIdx] = LoadAndReturnImage(resourcePaths[pid.pathIdx].c_str(), palette);
+            pid.atlasImageId = -1;
+        }
+    }
+
+    if (!atlasBuilder.CreatePageTextures())
+    {
+        LOG_ERROR("Could not create atlas textures: " + std::string(SDL_GetError()));
+        for (AtlasedPid& pid : atlasedPids)
+        {
+            if (pid.atlasImageId >= 0)
+            {
+                images[pid.pathIdx] = LoadAndReturnImage(resourcePaths[pid.pathIdx].c_str(), palette);
+            }
+        }
+
+        return images;
+    }
+
+    for (AtlasedPid& pid : atlasedPids)
+    {
+        if (pid.atlasImageId < 0)
+        {
+            continue;
+        }
+
+        shared_ptr<Image> image(Image::CreateAtlasImage(atlasBuilder.GetImageTexture(pid.atlasImageId),
+            atlasBuilder.GetImageRect(pid.atlasImageId), pid.header.offsetX, pid.header.offsetY));
+        images[pid.pathIdx] = image;
+
+        shared_ptr<PidResourceExtraData> extraData(new PidResourceExtraData());
+        extraData->SetImage(image);
+
+        // Pixels decoded by level pipeline or standalone image loaded before are released once nobody uses them
+        Resource resource(resourcePaths[pid.pathIdx]);
+        if (pResourceCache->IsLoaded(&resource))
+        {
+            shared_ptr<ResourceHandle> handle = pResourceCache->GetHandle(&resource);
+            handle->SetExtraData(extraData);
+            handle->ReleaseDataBuffer();
+        }
+        else
+        {
+            pResourceCache->InsertDecoded(&resource, extraData);
+        }
+    }
+
+    return images;
+}
+
+shared_ptr<IResourceExtraData> PidResourceLoader::VDecodeResource(const char* rawBuffer, uint32 rawSize)
+{
+    // Pixels are decoded with level palette which has to be set before level resources are streamed
+    shared_ptr<PidResourceExtraData> extraData(new PidResourceExtraData());
+    extraData->DecodePixels(rawBuffer, rawSize, g_pApp->GetCurrentPalette());
+    if (!extraData->HasPixelData())
+    {
+        return nullptr;
+    }
+
+    return extraData;
+}
+
+bool PidResourceLoader::VUploadResource(shared_ptr<IResourceExtraData> extraData)
+{
+    // Decoded pixels are kept without texture. Almost every level PID belongs to an image set which
+    // LoadAndReturnImageSet copies into atlas page, own texture would be uploaded only to be replaced.
+    // PIDs requested alone get their texture in LoadAndReturnImage.
+    shared_ptr<PidResourceExtraData> pidExtraData = std::static_pointer_cast<PidResourceExtraData>(extraData);
+    return pidExtraData->HasPixelData();
+}
+
 shared_ptr<PidResourceLoader> PidResourceLoader::Create()
 {
     return shared_ptr<PidResourceLoader>(new PidResourceLoader());
@@ -4,22 +4,33 @@
 #include <libwap.h>
 #include <tinyxml.h>
 #include "../ResourceCache.h"
+#include "../../Graphics2D/Image.h"
 
-class Image;
 class PidResourceExtraData : public IResourceExtraData
 {
 public:
-    PidResourceExtraData() { _pid = NULL; _image = nullptr; }
+    PidResourceExtraData() { _pid = NULL; _image = nullptr; _hasPixelData = false; }
     virtual ~PidResourceExtraData();
 
     virtual std::string VToString() { return "PidResourceExtraData"; }
-    void LoadPid(char* rawBuffer, uint32 size, WapPal* palette);
-    void LoadImage(char* rawBuffer, uint32 size, WapPal* palette);
+    virtual uint32 VGetMemorySize();
+    virtual uint32 VGetTextureMemorySize();
+    void LoadPid(const char* rawBuffer, uint32 size, WapPal* palette);
+    void LoadImage(const char* rawBuffer, uint32 size, WapPal* palette);
+    // Decodes PID into texture ready pixels, safe to call from worker threads
+    void DecodePixels(const char* rawBuffer, uint32 size, WapPal* palette);
+    // Uploads already decoded pixels or loaded PID into texture and frees them
+    void CreateImageFromPid();
     WapPid* GetPid() { return _pid; }
+    bool HasPixelData() const { return _hasPixelData; }
+    const PidPixelData& GetPixelData() const { return _pixelData; }
     shared_ptr<Image> GetImage() { return _image; }
+    void SetImage(shared_ptr<Image> image) { _image = image; }
 
 private:
     WapPid* _pid;
+    PidPixelData _pixelData;
+    bool _hasPixelData;
     // Use shared_ptr here so that objects that are using it can dictate its lifetime
     shared_ptr<Image> _image;
 };
@@ -30,11 +41,17 @@ public:
     virtual std::string VGetPattern() { return "*.pid"; }
     virtual bool VUseRawFile() { return true; }
     virtual bool VDiscardRawBufferAfterLoad() { return false; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize) { return rawSize; }
-    virtual bool VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle) { return true; }
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize) { return rawSize; }
+    virtual bool VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle) { return true; }
+    virtual bool VCanDecodeAsync() { return true; }
+    virtual std::shared_ptr<IResourceExtraData> VDecodeResource(const char* rawBuffer, uint32 rawSize);
+    virtual bool VUploadResource(std::shared_ptr<IResourceExtraData> extraData);
 
     static WapPid* LoadAndReturnPid(const char* resourceString, WapPal* palette);
     static shared_ptr<Image> LoadAndReturnImage(const char* resourceString, WapPal* palette);
+    // Packs whole image set into shared atlas pages, images which do not fit are loaded separately.
+    // Returned images are in the same order as given paths, failed ones are nullptr.
+    static std::vector<shared_ptr<Image>> LoadAndReturnImageSet(const std::vector<std::string>& resourcePaths, WapPal* palette);
     static std::shared_ptr<PidResourceLoader> Create();
 };
 
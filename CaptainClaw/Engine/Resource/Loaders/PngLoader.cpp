@@ -10,7 +10,12 @@
 //     This class implements the IResourceExtraData
 //
 
-void PngResourceExtraData::LoadImage(char* rawBuffer, uint32 size)
+uint32 PngResourceExtraData::VGetTextureMemorySize()
+{
+    return m_pImage ? m_pImage->GetTextureMemorySize() : 0;
+}
+
+void PngResourceExtraData::LoadImage(const char* rawBuffer, uint32 size)
 {
     if (m_pImage == nullptr)
     {
@@ -44,6 +49,8 @@ shared_ptr<Image> PngResourceLoader::LoadAndReturnImage(const char* resourceStri
         }
 
         handle->SetExtraData(extraData);
+        // Raw image is not needed once it lives in texture
+        handle->ReleaseDataBuffer();
     }
 
     return extraData->GetImage();
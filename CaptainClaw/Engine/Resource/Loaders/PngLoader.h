@@ -11,7 +11,8 @@ public:
     PngResourceExtraData() { m_pImage = nullptr; }
 
     virtual std::string VToString() { return "PngResourceExtraData"; }
-    void LoadImage(char* rawBuffer, uint32 size);
+    virtual uint32 VGetTextureMemorySize();
+    void LoadImage(const char* rawBuffer, uint32 size);
     shared_ptr<Image> GetImage() { return m_pImage; }
 
 private:
@@ -24,8 +25,8 @@ public:
     virtual std::string VGetPattern() { return "*.png"; }
     virtual bool VUseRawFile() { return true; }
     virtual bool VDiscardRawBufferAfterLoad() { return true; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize) { return rawSize; }
-    virtual bool VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle) { return true; }
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize) { return rawSize; }
+    virtual bool VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle) { return true; }
 
     static shared_ptr<Image> LoadAndReturnImage(const char* resourceString);
     static std::shared_ptr<PngResourceLoader> Create();
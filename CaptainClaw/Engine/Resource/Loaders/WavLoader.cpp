@@ -16,12 +16,13 @@ void DeleteMixChunk(Mix_Chunk* sound)
 
 WavResourceExtraData::~WavResourceExtraData()
 {
-    // Sound takes care of its own destruction
+    // Sound takes care of its own destruction, converted samples are freed only if sound was never created
+    SDL_free(_pConvertedSamples);
 }
 
-void WavResourceExtraData::LoadWavSound(char* rawBuffer, uint32 size)
+void WavResourceExtraData::LoadWavSound(const char* rawBuffer, uint32 size)
 {
-    SDL_RWops* soundRwOps = SDL_RWFromMem((void*)rawBuffer, size);
+    SDL_RWops* soundRwOps = SDL_RWFromConstMem(rawBuffer, size);
     _sound = shared_ptr<Mix_Chunk>(Mix_LoadWAV_RW(soundRwOps, 1), DeleteMixChunk);
     if (_sound == NULL)
     {
@@ -30,14 +31,87 @@ void WavResourceExtraData::LoadWavSound(char* rawBuffer, uint32 size)
     //LOG("RawBufferSize = " + ToStr(size) + ", Sound size = " + ToStr(_sound->alen));
 }
 
+bool WavResourceExtraData::ConvertWavSound(const char* rawBuffer, uint32 size, int frequency, Uint16 format, int channels)
+{
+    // Same steps as Mix_LoadWAV_RW takes for WAV files
+    SDL_AudioSpec wavSpec;
+    Uint8* pSamples = NULL;
+    Uint32 length = 0;
+    if (SDL_LoadWAV_RW(SDL_RWFromConstMem(rawBuffer, size), 1, &wavSpec, &pSamples, &length) == NULL)
+    {
+        return false;
+    }
+
+    SDL_AudioCVT cvt;
+    int needsConversion = SDL_BuildAudioCVT(&cvt, wavSpec.format, wavSpec.channels, wavSpec.freq, format, channels, frequency);
+    if (needsConversion < 0)
+    {
+        SDL_FreeWAV(pSamples);
+        return false;
+    }
+
+    if (needsConversion > 0)
+    {
+        Uint8* pConverted = (Uint8*)SDL_realloc(pSamples, length * cvt.len_mult);
+        if (pConverted == NULL)
+        {
+            SDL_FreeWAV(pSamples);
+            return false;
+        }
+
+        cvt.buf = pSamples = pConverted;
+        cvt.len = length;
+        if (SDL_ConvertAudio(&cvt) < 0)
+        {
+            SDL_free(pSamples);
+            return false;
+        }
+        length = cvt.len_cvt;
+    }
+
+    _pConvertedSamples = pSamples;
+    _convertedLength = length;
+
+    return true;
+}
+
+void WavResourceExtraData::CreateSoundFromConvertedSamples()
+{
+    if (_sound || _pConvertedSamples == NULL)
+    {
+        return;
+    }
+
+    Mix_Chunk* pChunk = Mix_QuickLoad_RAW(_pConvertedSamples, _convertedLength);
+    if (pChunk == NULL)
+    {
+        LOG_ERROR("Failed to create WAV sound: " + std::string(Mix_GetError()));
+        return;
+    }
+
+    // Chunk frees the samples just like the ones loaded by Mix_LoadWAV_RW
+    pChunk->allocated = 1;
+    _sound = shared_ptr<Mix_Chunk>(pChunk, DeleteMixChunk);
+    _pConvertedSamples = NULL;
+    _convertedLength = 0;
+}
+
 //=================================================================================================
 // class WavResourceLoader
 //
 //     This class implements the IResourceLoader interface with WAV sound format
 //
 
-bool WavResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
+bool WavResourceLoader::VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
+{
+    uint32 loadedSize;
+    return VLoadResourceAndGetSize(rawBuffer, rawSize, handle, loadedSize);
+}
+
+bool WavResourceLoader::VLoadResourceAndGetSize(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle, uint32& loadedSize)
 {
+    loadedSize = 0;
+
     if (rawSize <= 0 || rawBuffer == NULL)
     {
         LOG_ERROR("Received invalid rawBuffer or its size");
@@ -53,17 +127,47 @@ bool WavResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::shar
     }
 
     handle->SetExtraData(extraData);
+    loadedSize = extraData->VGetMemorySize();
 
     return true;
 }
 
-uint32 WavResourceLoader::VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize)
+uint32 WavResourceLoader::VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize)
+{
+    // Real size is known only after sound is converted into mixer's format which is what
+    // VLoadResourceAndGetSize reports, raw PCM size is good enough estimate without decoding it
+    return rawSize;
+}
+
+bool WavResourceLoader::VCanDecodeAsync()
 {
-    // TODO: This is inefficent, this resource gets basically loaded twice, once just
-    // to find out how much room it takes and second time to actually create it
-    SDL_RWops* soundRwOps = SDL_RWFromMem((void*)rawBuffer, rawSize);
-    auto pSound = shared_ptr<Mix_Chunk>(Mix_LoadWAV_RW(soundRwOps, 1), DeleteMixChunk);
-    return pSound->alen;
+    // Called from ResourceLoadPipeline::Start() on main thread before any worker starts
+    if (Mix_QuerySpec(&m_MixerFrequency, &m_MixerFormat, &m_MixerChannels) == 0)
+    {
+        // Audio is not opened, sounds are loaded synchronously which reports it
+        return false;
+    }
+
+    return true;
+}
+
+shared_ptr<IResourceExtraData> WavResourceLoader::VDecodeResource(const char* rawBuffer, uint32 rawSize)
+{
+    shared_ptr<WavResourceExtraData> extraData(new WavResourceExtraData());
+    if (!extraData->ConvertWavSound(rawBuffer, rawSize, m_MixerFrequency, m_MixerFormat, m_MixerChannels))
+    {
+        return nullptr;
+    }
+
+    return extraData;
+}
+
+bool WavResourceLoader::VUploadResource(shared_ptr<IResourceExtraData> extraData)
+{
+    shared_ptr<WavResourceExtraData> wavExtraData = std::static_pointer_cast<WavResourceExtraData>(extraData);
+    wavExtraData->CreateSoundFromConvertedSamples();
+
+    return wavExtraData->GetSound() != nullptr;
 }
 
 shared_ptr<Mix_Chunk> WavResourceLoader::LoadAndReturnSound(const char* resourceString)
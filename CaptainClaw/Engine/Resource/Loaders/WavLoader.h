@@ -9,27 +9,52 @@
 class WavResourceExtraData : public IResourceExtraData
 {
 public:
+    WavResourceExtraData() : _pConvertedSamples(NULL), _convertedLength(0) { }
     virtual ~WavResourceExtraData();
 
     virtual std::string VToString() { return "WavResourceExtraData"; }
-    void LoadWavSound(char* rawBuffer, uint32 size);
+    virtual uint32 VGetMemorySize() { return _sound ? _sound->alen : _convertedLength; }
+    void LoadWavSound(const char* rawBuffer, uint32 size);
+    // Parses WAV and converts its samples into given mixer format. Uses only SDL's audio
+    // conversion which has no global state, so it is safe to call from worker threads.
+    bool ConvertWavSound(const char* rawBuffer, uint32 size, int frequency, Uint16 format, int channels);
+    // Wraps converted samples into mixer chunk, main thread only
+    void CreateSoundFromConvertedSamples();
     shared_ptr<Mix_Chunk> GetSound() { return _sound; }
 
 private:
     shared_ptr<Mix_Chunk> _sound;
+    // Owned until CreateSoundFromConvertedSamples() hands them over to _sound
+    Uint8* _pConvertedSamples;
+    uint32 _convertedLength;
 };
 
 class WavResourceLoader : public IResourceLoader
 {
 public:
+    WavResourceLoader() : m_MixerFrequency(0), m_MixerFormat(0), m_MixerChannels(0) { }
+
     virtual std::string VGetPattern() { return "*.wav"; }
     virtual bool VUseRawFile() { return false; }
     virtual bool VDiscardRawBufferAfterLoad() { return true; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize);
-    virtual bool VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize);
+    virtual bool VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
+    virtual bool VLoadResourceAndGetSize(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle, uint32& loadedSize);
+    // Mix_LoadWAV_RW reads SDL_mixer's global state, so ResourceLoadPipeline's workers do only the parts
+    // which do not need it - parsing WAV and converting it with SDL_ConvertAudio into mixer format queried
+    // on main thread in VCanDecodeAsync(). Mix_QuickLoad_RAW then creates the chunk on main thread.
+    virtual bool VCanDecodeAsync();
+    virtual std::shared_ptr<IResourceExtraData> VDecodeResource(const char* rawBuffer, uint32 rawSize);
+    virtual bool VUploadResource(std::shared_ptr<IResourceExtraData> extraData);
 
     static shared_ptr<Mix_Chunk> LoadAndReturnSound(const char* resourceString);
     static std::shared_ptr<WavResourceLoader> Create();
+
+private:
+    // Format of opened audio device, only read by workers after VCanDecodeAsync() set it
+    int m_MixerFrequency;
+    Uint16 m_MixerFormat;
+    int m_MixerChannels;
 };
 
 #endif
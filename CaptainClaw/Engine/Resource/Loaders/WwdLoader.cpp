@@ -19,7 +19,24 @@ WwdResourceExtraData::~WwdResourceExtraData()
     }
 }
 
-void WwdResourceExtraData::LoadWwd(char* rawBuffer, uint32 size)
+uint32 WwdResourceExtraData::VGetMemorySize()
+{
+    if (_wapWorldLevel == NULL)
+    {
+        return 0;
+    }
+
+    uint32 memorySize = sizeof(WapWwd) + _wapWorldLevel->tileDescriptionsCount * sizeof(WwdTileDescription);
+    for (uint32 planeIdx = 0; planeIdx < _wapWorldLevel->planesCount; planeIdx++)
+    {
+        const WwdPlane& plane = _wapWorldLevel->planes[planeIdx];
+        memorySize += sizeof(WwdPlane) + plane.tilesCount * sizeof(int32_t) + plane.objectsCount * sizeof(WwdObject);
+    }
+
+    return memorySize;
+}
+
+void WwdResourceExtraData::LoadWwd(const char* rawBuffer, uint32 size)
 {
     _wapWorldLevel = WAP_WwdLoadFromData(rawBuffer, size);
 }
@@ -31,7 +48,7 @@ void WwdResourceExtraData::LoadWwd(char* rawBuffer, uint32 size)
 //
 //=================================================================================================
 
-bool WwdResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
+bool WwdResourceLoader::VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
 {
     if (rawSize <= 0 || rawBuffer == NULL)
     {
@@ -63,6 +80,29 @@ WapWwd* WwdResourceLoader::LoadAndReturnWwd(const char* resourceString)
     return extraData->GetWwd();
 }
 
+WapWwd* WwdResourceLoader::LoadAndReturnWwd(const char* resourceString, const char* rawBuffer, uint32 rawSize)
+{
+    Resource resource(resourceString);
+
+    ResourceCache* pResourceCache = g_pApp->GetResourceCache();
+    if (pResourceCache->IsLoaded(&resource))
+    {
+        return LoadAndReturnWwd(resourceString);
+    }
+
+    shared_ptr<WwdResourceExtraData> extraData = shared_ptr<WwdResourceExtraData>(new WwdResourceExtraData());
+    extraData->LoadWwd(rawBuffer, rawSize);
+    if (extraData->GetWwd() == NULL)
+    {
+        LOG_ERROR("Could not parse WWD: " + std::string(resourceString));
+        return NULL;
+    }
+
+    pResourceCache->InsertDecoded(&resource, extraData);
+
+    return extraData->GetWwd();
+}
+
 std::shared_ptr<WwdResourceLoader> WwdResourceLoader::Create()
 {
     return shared_ptr<WwdResourceLoader>(new WwdResourceLoader());
@@ -11,7 +11,8 @@ public:
     virtual ~WwdResourceExtraData();
 
     virtual std::string VToString() { return "WwdResourceExtraData"; }
-    void LoadWwd(char* rawBuffer, uint32 size);
+    virtual uint32 VGetMemorySize();
+    void LoadWwd(const char* rawBuffer, uint32 size);
     WapWwd* GetWwd() { return _wapWorldLevel; }
 
 private:
@@ -24,10 +25,12 @@ public:
     virtual std::string VGetPattern() { return "*.wwd"; }
     virtual bool VUseRawFile() { return false; }
     virtual bool VDiscardRawBufferAfterLoad() { return true; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize) { return rawSize; }
-    virtual bool VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize) { return rawSize; }
+    virtual bool VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
 
     static WapWwd* LoadAndReturnWwd(const char* resourceString);
+    // Parses WWD which caller already read instead of reading it again, e.g. after hashing it
+    static WapWwd* LoadAndReturnWwd(const char* resourceString, const char* rawBuffer, uint32 rawSize);
     static std::shared_ptr<WwdResourceLoader> Create();
 };
 
@@ -8,9 +8,10 @@
 //     This class implements the IResourceExtraData
 //
 
-void XmlResourceExtraData::ParseXml(char* rawBuffer)
+void XmlResourceExtraData::ParseXml(const char* rawBuffer, uint32 size)
 {
     _xmlDocument.Parse(rawBuffer);
+    m_XmlSize = size;
 }
 
 TiXmlElement* XmlResourceExtraData::GetRoot()
@@ -24,7 +25,7 @@ TiXmlElement* XmlResourceExtraData::GetRoot()
 //     This class implements the IResourceLoader interface with XML document loading
 //
 
-bool XmlResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
+bool XmlResourceLoader::VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle)
 {
     if (rawSize <= 0 || rawBuffer == NULL)
     {
@@ -33,7 +34,7 @@ bool XmlResourceLoader::VLoadResource(char* rawBuffer, uint32 rawSize, std::shar
     }
 
     shared_ptr<XmlResourceExtraData> extraData = shared_ptr<XmlResourceExtraData>(new XmlResourceExtraData());
-    extraData->ParseXml(rawBuffer);
+    extraData->ParseXml(rawBuffer, rawSize);
 
     handle->SetExtraData(extraData);
 
@@ -7,12 +7,17 @@
 class XmlResourceExtraData : public IResourceExtraData
 {
 public:
+    XmlResourceExtraData() { m_XmlSize = 0; }
+
     virtual std::string VToString() { return "XmlResourceExtraData"; }
-    void ParseXml(char* rawBuffer);
+    // Parsed document is not tracked node by node, its source text is good enough estimate
+    virtual uint32 VGetMemorySize() { return m_XmlSize; }
+    void ParseXml(const char* rawBuffer, uint32 size);
     TiXmlElement* GetRoot();
 
 private:
     TiXmlDocument _xmlDocument;
+    uint32 m_XmlSize;
 };
 
 class XmlResourceLoader : public IResourceLoader
@@ -21,8 +26,8 @@ public:
     virtual std::string VGetPattern() { return "*.xml"; }
     virtual bool VUseRawFile() { return false; }
     virtual bool VDiscardRawBufferAfterLoad() { return true; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize) { return rawSize; }
-    virtual bool VLoadResource(char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize) { return rawSize; }
+    virtual bool VLoadResource(const char* rawBuffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle);
 
     static TiXmlElement* LoadAndReturnRootXmlElement(const char* resourceString, bool fromLocalFile = false);
     static std::shared_ptr<XmlResourceLoader> Create();
@@ -12,8 +12,15 @@
 Resource::Resource(const std::string& name)
 {
     _name = name;
-    // Transform resource name into lower case characters
-    std::transform(_name.begin(), _name.end(), _name.begin(), (int(*)(int)) std::tolower);
+
+    // Transform resource name into lower case characters and hash it (FNV-1a) in one go
+    uint64 hash = 14695981039346656037ULL;
+    for (char& c : _name)
+    {
+        c = (char)std::tolower((unsigned char)c);
+        hash = (hash ^ (uint8)c) * 1099511628211ULL;
+    }
+    m_NameHash = (size_t)hash;
 }
 
 //=================================================================================================
@@ -73,22 +80,27 @@ int32 ResourceRezArchive::VGetRawResource(Resource* r, char* outBuffer)
         return -1;
     }
 
-    // This this buffer is owner by libwap => we need to create our own
-    char* data = WAP_GetRezFileData(rezFile);
-    //LOG_WARNING("rezFile->fullName = " + std::string(rezFile->fullPathAndName));
-    if (data == NULL)
+    // Read straight into caller's buffer, this is safe to do from any thread
+    int32 bytesRead = WAP_ReadRezFileInto(rezFile, outBuffer);
+    if (bytesRead < 0)
     {
         LOG_ERROR("Could not load buffer for rez file: " + r->GetName() + " in rezArchive: " + _rezArchiveFileName);
         return -1;
     }
 
-    // 
-    memcpy(outBuffer, data, rezFile->size);
+    return bytesRead;
+}
 
-    // We dont need libwaps data anymore
-    WAP_FreeFileData(rezFile);
+const char* ResourceRezArchive::VGetRawResourceView(Resource* r)
+{
+    RezFile* rezFile = WAP_GetRezFileFromRezArchive(_rezArchive, r->GetName().c_str());
+    if (rezFile == NULL)
+    {
+        return NULL;
+    }
 
-    return rezFile->size;
+    // NULL when archive is not memory mapped, caller falls back to VGetRawResource
+    return WAP_GetRezFileDataView(rezFile);
 }
 
 int32 ResourceRezArchive::VGetNumResources() const
@@ -216,31 +228,68 @@ std::vector<std::string> ResourceZipArchive::GetAllFilesInDirectory(const char*
 // class ResourceHandle
 //
 
-ResourceHandle::ResourceHandle(Resource& resource, char* buffer, uint32 size, ResourceCache* resCache)
+ResourceHandle::ResourceHandle(Resource& resource, const char* buffer, uint32 size, ResourceCache* resCache, bool isBufferView)
     : _resource(resource)
 {
     _buffer = buffer;
     _size = size;
+    m_bIsBufferView = isBufferView;
     _extraData = NULL;
+    m_ExtraDataMemorySize = 0;
+    m_TextureMemorySize = 0;
     _resourceCache = resCache;
 }
 
 ResourceHandle::~ResourceHandle()
 {
-    SAFE_DELETE_ARRAY(_buffer);
+    ReleaseDataBuffer();
+    _resourceCache->MemoryHasBeenFreed(m_ExtraDataMemorySize, m_TextureMemorySize);
+}
 
-    _resourceCache->MemoryHasBeenFreed(_size);
+void ResourceHandle::SetExtraData(std::shared_ptr<IResourceExtraData> extraData)
+{
+    _extraData = extraData;
+    UpdateExtraDataMemorySize();
+}
+
+void ResourceHandle::UpdateExtraDataMemorySize()
+{
+    _resourceCache->MemoryHasBeenFreed(m_ExtraDataMemorySize, m_TextureMemorySize);
+
+    m_ExtraDataMemorySize = _extraData ? _extraData->VGetMemorySize() : 0;
+    m_TextureMemorySize = _extraData ? _extraData->VGetTextureMemorySize() : 0;
+
+    _resourceCache->MemoryHasBeenAllocated(m_ExtraDataMemorySize, m_TextureMemorySize);
+}
+
+void ResourceHandle::ReleaseDataBuffer()
+{
+    if (_buffer == NULL)
+    {
+        return;
+    }
+
+    if (!m_bIsBufferView)
+    {
+        SAFE_DELETE_ARRAY(_buffer);
+        _resourceCache->MemoryHasBeenFreed(_size);
+    }
+
+    _buffer = NULL;
+    _size = 0;
 }
 
 //=================================================================================================
 // class ResourceCache
 //
 
-ResourceCache::ResourceCache(const uint32 sizeInMB, IResourceFile* resourceFile, std::string name)
+ResourceCache::ResourceCache(const uint32 sizeInMB, const uint32 textureSizeInMB, IResourceFile* resourceFile, std::string name)
 {
     m_Name = name;
-    _cacheSize = sizeInMB * 1024 * 1024;
+    _cacheSize = (uint64)sizeInMB * 1024 * 1024;
     _allocated = 0;
+    m_TextureCacheSize = (uint64)textureSizeInMB * 1024 * 1024;
+    m_TextureAllocated = 0;
     _resourceFile = resourceFile;
 }
 
@@ -258,12 +307,27 @@ bool ResourceCache::Init()
 {
     if (_resourceFile->VOpen())
     {
+        BuildPathIndex();
         return true;
     }
 
     return false;
 }
 
+void ResourceCache::BuildPathIndex()
+{
+    int32 numFiles = _resourceFile->VGetNumResources();
+
+    std::vector<std::string> resourceNames;
+    resourceNames.reserve(numFiles);
+    for (int32 fileIdx = 0; fileIdx < numFiles; ++fileIdx)
+    {
+        resourceNames.push_back(_resourceFile->VGetResourceName(fileIdx));
+    }
+
+    m_PathIndex.Build(resourceNames);
+}
+
 void ResourceCache::RegisterLoader(std::shared_ptr<IResourceLoader> loader)
 {
     _resourceLoaderList.push_front(loader);
@@ -284,22 +348,40 @@ std::shared_ptr<ResourceHandle> ResourceCache::GetHandle(Resource* r)
     return handle;
 }
 
-std::shared_ptr<ResourceHandle> ResourceCache::Load(Resource* r)
+std::shared_ptr<IResourceLoader> ResourceCache::FindLoader(Resource* r)
 {
-    std::shared_ptr<IResourceLoader> loader;
-    std::shared_ptr<ResourceHandle> handle;
-
     for (auto resourceLoader : _resourceLoaderList)
     {
-        std::shared_ptr<IResourceLoader> testLoader = resourceLoader;
-
-        if (WildcardMatch(testLoader->VGetPattern().c_str(), r->GetName().c_str()))
+        if (WildcardMatch(resourceLoader->VGetPattern().c_str(), r->GetName().c_str()))
         {
-            loader = testLoader;
-            break;
+            return resourceLoader;
         }
     }
 
+    return nullptr;
+}
+
+bool ResourceCache::IsLoaded(Resource* r)
+{
+    return _resourceMap.find(*r) != _resourceMap.end();
+}
+
+std::shared_ptr<ResourceHandle> ResourceCache::InsertDecoded(Resource* r, std::shared_ptr<IResourceExtraData> extraData)
+{
+    // Nothing but the decoded extra data is kept, it accounts for itself
+    std::shared_ptr<ResourceHandle> handle(new ResourceHandle(*r, NULL, 0, this));
+    handle->SetExtraData(extraData);
+
+    Insert(handle);
+
+    return handle;
+}
+
+std::shared_ptr<ResourceHandle> ResourceCache::Load(Resource* r)
+{
+    std::shared_ptr<ResourceHandle> handle;
+
+    std::shared_ptr<IResourceLoader> loader = FindLoader(r);
     if (!loader)
     {
         LOG_ERROR("Default resource loader for resource: " + r->GetName() + " not found");
@@ -313,47 +395,52 @@ std::shared_ptr<ResourceHandle> ResourceCache::Load(Resource* r)
         return nullptr;
     }
 
-    int32 allocSize = rawSize + ((loader->VAddNullZero()) ? (1) : (0));
-    char* rawBuffer = loader->VUseRawFile() ? Allocate(allocSize) : new char[allocSize];
-    if (rawBuffer == NULL)
+    // Views point into read-only mapped archive which is shared by every load of the resource,
+    // loaders only ever get const data
+    const char* rawBuffer = NULL;
+    bool isRawBufferView = false;
+    if (!loader->VAddNullZero())
     {
-        LOG_ERROR("Could not allocate enough memory for resource: " + r->GetName() + 
-            " in resource file: " + _resourceFile->VGetName());
-        return nullptr;
+        rawBuffer = _resourceFile->VGetRawResourceView(r);
+        isRawBufferView = rawBuffer != NULL;
     }
-    memset(rawBuffer, 0, allocSize);
 
-    if (_resourceFile->VGetRawResource(r, rawBuffer) < 0)
+    if (!isRawBufferView)
     {
-        LOG_ERROR("Could not retrieve data buffer from resource: " + r->GetName() + 
-            " in resource file: " + _resourceFile->VGetName());
-        return nullptr;
-    }
+        int32 allocSize = rawSize + ((loader->VAddNullZero()) ? (1) : (0));
+        char* ownedBuffer = loader->VUseRawFile() ? Allocate(allocSize) : new char[allocSize];
+        if (ownedBuffer == NULL)
+        {
+            LOG_ERROR("Could not allocate enough memory for resource: " + r->GetName() +
+                " in resource file: " + _resourceFile->VGetName());
+            return nullptr;
+        }
+        memset(ownedBuffer, 0, allocSize);
 
-    char* buffer = NULL;
-    uint32 size = 0;
+        if (_resourceFile->VGetRawResource(r, ownedBuffer) < 0)
+        {
+            LOG_ERROR("Could not retrieve data buffer from resource: " + r->GetName() +
+                " in resource file: " + _resourceFile->VGetName());
+            return nullptr;
+        }
+
+        rawBuffer = ownedBuffer;
+    }
 
     // Just store binary data + size in handle
     if (loader->VUseRawFile())
     {
-        buffer = rawBuffer;
-        handle = std::shared_ptr<ResourceHandle>(new ResourceHandle(*r, buffer, rawSize, this));
+        handle = std::shared_ptr<ResourceHandle>(new ResourceHandle(*r, rawBuffer, rawSize, this, isRawBufferView));
     }
     else // Or store meaningful arbitrary file format
     {
-        size = loader->VGetLoadedResourceSize(rawBuffer, rawSize);
-        buffer = Allocate(size);
-        if (buffer == NULL)
-        {
-            LOG_ERROR("Could not allocate enough memory for resource: " + r->GetName() +
-                " in resource file: " + _resourceFile->VGetName());
-            return shared_ptr<ResourceHandle>();
-        }
-         
-        handle = std::shared_ptr<ResourceHandle>(new ResourceHandle(*r, buffer, size, this));
-        bool success = loader->VLoadResource(rawBuffer, rawSize, handle);
+        // Loaded resource lives only in its extra data which accounts for its real size once it is set,
+        // older resources are evicted after it is inserted
+        handle = std::shared_ptr<ResourceHandle>(new ResourceHandle(*r, NULL, 0, this));
+        uint32 loadedSize = 0;
+        bool success = loader->VLoadResourceAndGetSize(rawBuffer, rawSize, handle, loadedSize);
 
-        if (loader->VDiscardRawBufferAfterLoad())
+        if (loader->VDiscardRawBufferAfterLoad() && !isRawBufferView)
         {
             SAFE_DELETE_ARRAY(rawBuffer);
         }
@@ -363,6 +450,13 @@ std::shared_ptr<ResourceHandle> ResourceCache::Load(Resource* r)
             LOG_ERROR("Could not load resource from raw data");
             return nullptr;
         }
+
+        if (loadedSize > _cacheSize)
+        {
+            LOG_ERROR("Could not allocate enough memory for resource: " + r->GetName() +
+                " in resource file: " + _resourceFile->VGetName());
+            return nullptr;
+        }
     }
 
     if (!handle)
@@ -372,21 +466,33 @@ std::shared_ptr<ResourceHandle> ResourceCache::Load(Resource* r)
         return nullptr;
     }
 
-    _lruList.push_front(handle);
-    _resourceMap[r->GetName()] = handle;
+    Insert(handle);
+    EnforceBudgets();
 
     return handle;
 }
 
+void ResourceCache::Insert(std::shared_ptr<ResourceHandle> handle)
+{
+    _lruList.push_front(handle);
+    handle->m_LruPosition = _lruList.begin();
+    _resourceMap[handle->GetResource()] = handle;
+}
+
 std::shared_ptr<ResourceHandle> ResourceCache::Find(Resource* r)
 {
-    return _resourceMap[r->GetName()];
+    auto findIt = _resourceMap.find(*r);
+    if (findIt == _resourceMap.end())
+    {
+        return nullptr;
+    }
+
+    return findIt->second;
 }
 
 void ResourceCache::Update(std::shared_ptr<ResourceHandle> handle)
 {
-    _lruList.remove(handle);
-    _lruList.push_front(handle);
+    _lruList.splice(_lruList.begin(), _lruList, handle->m_LruPosition);
 }
 
 char* ResourceCache::Allocate(uint32 size)
@@ -409,22 +515,14 @@ char* ResourceCache::Allocate(uint32 size)
 void ResourceCache::FreeOneResource()
 {
     //LOG("FreeOneResource");
-    ResourceHandleList::iterator gonner = _lruList.end();
-    gonner--;
-
-    shared_ptr<ResourceHandle> handle = *gonner;
-
-    _lruList.pop_back();
-    _resourceMap.erase(handle->GetName());
+    Free(_lruList.back());
 }
 
 void ResourceCache::Flush()
 {
     while (!_lruList.empty())
     {
-        std::shared_ptr<ResourceHandle> handle = *(_lruList.begin());
-        Free(handle);
-        _lruList.pop_front();
+        Free(_lruList.front());
     }
 }
 
@@ -435,11 +533,8 @@ bool ResourceCache::MakeRoom(uint32 size)
         return false;
     }
 
-    int64 x = _cacheSize - _allocated;
-    //LOG("Room left: " + ToStr(x));
-
     // Return NULL if there is no possibility to allocate memory
-    while (size > (_cacheSize - _allocated))
+    while (_allocated + size > _cacheSize)
     {
         if (_lruList.empty())
         {
@@ -454,16 +549,64 @@ bool ResourceCache::MakeRoom(uint32 size)
 
 void ResourceCache::Free(std::shared_ptr<ResourceHandle> gonner)
 {
-    _lruList.remove(gonner);
-    _resourceMap.erase(gonner->GetName());
+    _lruList.erase(gonner->m_LruPosition);
+    _resourceMap.erase(gonner->GetResource());
 }
 
-void ResourceCache::MemoryHasBeenFreed(uint32 size)
+void ResourceCache::EnforceBudgets()
+{
+    // Most recently used resource is never evicted, it is the one which is being loaded or used
+    while ((_allocated > _cacheSize || m_TextureAllocated > m_TextureCacheSize) && _lruList.size() > 1)
+    {
+        FreeOneResource();
+    }
+}
+
+void ResourceCache::MemoryHasBeenAllocated(uint32 size, uint32 textureSize)
+{
+    _allocated += size;
+    m_TextureAllocated += textureSize;
+
+    EnforceBudgets();
+}
+
+void ResourceCache::MemoryHasBeenFreed(uint32 size, uint32 textureSize)
 {
     _allocated -= size;
+    m_TextureAllocated -= textureSize;
+}
+
+ResourceResidencyMap ResourceCache::GetResidencyByType()
+{
+    ResourceResidencyMap residencyMap;
+
+    for (std::shared_ptr<ResourceHandle> handle : _lruList)
+    {
+        std::string name = handle->GetName();
+        size_t dotPos = name.rfind('.');
+        std::string extension = (dotPos == std::string::npos) ? "" : name.substr(dotPos + 1);
+
+        ResourceResidency& residency = residencyMap[extension];
+        residency.numResources++;
+        // Mapped views are owned by resource file
+        residency.memorySize += (handle->IsBufferView() ? 0 : handle->GetSize()) + handle->GetExtraDataMemorySize();
+        residency.textureMemorySize += handle->GetTextureMemorySize();
+    }
+
+    return residencyMap;
 }
 
 std::vector<std::string> ResourceCache::Match(const std::string pattern)
+{
+    if (_resourceFile == NULL)
+    {
+        return std::vector<std::string>();
+    }
+
+    return m_PathIndex.Match(pattern);
+}
+
+std::vector<std::string> ResourceCache::MatchLinear(const std::string pattern)
 {
     std::vector<std::string> matchingNames;
 
@@ -483,8 +626,6 @@ std::vector<std::string> ResourceCache::Match(const std::string pattern)
         // Everything is converted into lower case so maintain consistency
         std::transform(fileNamePath.begin(), fileNamePath.end(), fileNamePath.begin(), (int(*)(int)) std::tolower);
 
-        //std::cout << "Filename: " << fileNamePath << ", Pattern: " << pattern << std::endl;
-
         if (WildcardMatch(patternCopy.c_str(), fileNamePath.c_str()))
         {
             matchingNames.push_back(fileNamePath);
@@ -493,37 +634,34 @@ std::vector<std::string> ResourceCache::Match(const std::string pattern)
 
     return matchingNames;
 }
-using namespace std;
+
 int32 ResourceCache::Preload(const std::string pattern, void(*progressCallback)(int32, bool &))
 {
     if (_resourceFile == NULL)
     {
         return 0;
     }
-        
-    int32 numFiles = _resourceFile->VGetNumResources();
+
+    std::vector<std::string> matchingNames = m_PathIndex.Match(pattern);
+    int32 numMatched = matchingNames.size();
     int32 loaded = 0;
     bool cancel = false;
 
-    // Everything is converted into lower case so maintain consistency
-    std::string patternCopy = pattern;
-    std::transform(patternCopy.begin(), patternCopy.end(), patternCopy.begin(), (int(*)(int)) std::tolower);
-
-    for (int32 fileIdx = 0; fileIdx < numFiles; ++fileIdx)
+    for (const std::string& resourceName : matchingNames)
     {
-        Resource resource(_resourceFile->VGetResourceName(fileIdx));
-        //cout << "Checking pattern for resource: " << resource.GetName() << endl;
+        Resource resource(resourceName);
 
-        if (WildcardMatch(patternCopy.c_str(), resource.GetName().c_str()))
-        {
-            // This loads unloaded resource and skips loaded ones
-            GetHandle(&resource);
-            ++loaded;
-        }
+        // This loads unloaded resource and skips loaded ones
+        GetHandle(&resource);
+        ++loaded;
 
         if (progressCallback != NULL)
         {
-            progressCallback((fileIdx / numFiles) * 100, cancel);
+            progressCallback((loaded * 100) / numMatched, cancel);
+            if (cancel)
+            {
+                break;
+            }
         }
     }
 
@@ -533,4 +671,4 @@ int32 ResourceCache::Preload(const std::string pattern, void(*progressCallback)(
 std::vector<std::string> ResourceCache::GetAllFilesInDirectory(const char* directoryPath)
 {
     return _resourceFile->GetAllFilesInDirectory(directoryPath);
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -3,22 +3,40 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include <stdlib.h>
 #include <libwap.h>
 #include "../SharedDefines.h"
 #include "ZipFile.h"
+#include "ResourcePathIndex.h"
 
 class Resource
 {
 public:
     Resource(const std::string &name);
 
-    inline std::string GetName() { return _name; }
+    inline const std::string& GetName() const { return _name; }
+    // Computed once from lower case name so that cache lookups do not have to rehash it
+    inline size_t GetNameHash() const { return m_NameHash; }
 
 protected:
     std::string _name;
+    size_t m_NameHash;
+};
+
+struct ResourceNameHash
+{
+    size_t operator()(const Resource& resource) const { return resource.GetNameHash(); }
+};
+
+struct ResourceNameEqual
+{
+    bool operator()(const Resource& left, const Resource& right) const
+    {
+        return left.GetNameHash() == right.GetNameHash() && left.GetName() == right.GetName();
+    }
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -29,6 +47,11 @@ class IResourceExtraData
 {
 public:
     virtual std::string VToString() = 0;
+
+    // Real memory taken by decoded resource in system memory and in textures, resource cache
+    // evicts against these and not against size of raw file the resource was loaded from
+    virtual uint32 VGetMemorySize() { return 0; }
+    virtual uint32 VGetTextureMemorySize() { return 0; }
 };
 
 // This would work well in a perfect universe witihout any code repetition but not all
@@ -66,6 +89,11 @@ public:
     virtual std::string VGetName() const = 0;
     virtual int32 VGetRawResourceSize(Resource* r) = 0;
     virtual int32 VGetRawResource(Resource* r, char* outBuffer) = 0;
+    // Returns resource data which lives within resource file itself (e.g. memory mapped archive)
+    // or NULL if resource file cannot provide it without copying
+    virtual const char* VGetRawResourceView(Resource* r) { return NULL; }
+    // Whether VGetRawResource and VGetRawResourceView can be called from multiple threads at once
+    virtual bool VSupportsConcurrentReads() const { return false; }
     virtual int32 VGetNumResources() const = 0;
     virtual std::string VGetResourceName(int32 num) const = 0;
     virtual bool VIsUsingDevelopmentDIrectories() const = 0;
@@ -81,8 +109,23 @@ public:
     virtual bool VUseRawFile() = 0;
     virtual bool VDiscardRawBufferAfterLoad() = 0;
     virtual bool VAddNullZero() { return false; }
-    virtual uint32 VGetLoadedResourceSize(char* rawBuffer, uint32 rawSize) = 0;
-    virtual bool VLoadResource(char* buffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle) = 0;
+    virtual uint32 VGetLoadedResourceSize(const char* rawBuffer, uint32 rawSize) = 0;
+    virtual bool VLoadResource(const char* buffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle) = 0;
+    // Loads resource and reports how much memory it takes, this is what ResourceCache::Load uses.
+    // Loaders which have to decode the resource to know its size (e.g. WAV) override this
+    // so that the resource is decoded only once.
+    virtual bool VLoadResourceAndGetSize(const char* buffer, uint32 rawSize, std::shared_ptr<ResourceHandle> handle, uint32& loadedSize)
+    {
+        loadedSize = VGetLoadedResourceSize(buffer, rawSize);
+        return VLoadResource(buffer, rawSize, handle);
+    }
+
+    // Optional split of VLoadResource used by ResourceLoadPipeline. VDecodeResource runs on worker
+    // thread so it must not touch SDL renderer nor resource cache, VUploadResource then finishes
+    // the resource on main thread.
+    virtual bool VCanDecodeAsync() { return false; }
+    virtual std::shared_ptr<IResourceExtraData> VDecodeResource(const char* rawBuffer, uint32 rawSize) { return nullptr; }
+    virtual bool VUploadResource(std::shared_ptr<IResourceExtraData> extraData) { return true; }
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -98,6 +141,8 @@ public:
     virtual std::string VGetName() const { return _rezArchiveFileName; }
     virtual int32 VGetRawResourceSize(Resource* r);
     virtual int32 VGetRawResource(Resource* r, char* outBuffer);
+    virtual const char* VGetRawResourceView(Resource* r);
+    virtual bool VSupportsConcurrentReads() const { return true; }
     virtual int32 VGetNumResources() const;
     virtual std::string VGetResourceName(int32 num) const;
     virtual bool VIsUsingDevelopmentDIrectories() const { return false; }
@@ -131,38 +176,73 @@ private:
 //------------------------------------------------------------------------------------------------
 
 class ResourceCache;
+class ResourceHandle;
+
+typedef std::list<std::shared_ptr<ResourceHandle>> ResourceHandleList;
+
 class ResourceHandle
 {
+    // Cache keeps handle's position within its LRU list
+    friend class ResourceCache;
+
 public:
-    ResourceHandle(Resource& resource, char* buffer, uint32 size, ResourceCache* resCache);
+    // Buffer views are owned by resource file, they are neither freed nor accounted in resource cache
+    ResourceHandle(Resource& resource, const char* buffer, uint32 size, ResourceCache* resCache, bool isBufferView = false);
     virtual ~ResourceHandle();
 
-    const std::string GetName() { return _resource.GetName(); }
+    const std::string& GetName() const { return _resource.GetName(); }
+    const Resource& GetResource() const { return _resource; }
     uint32 GetSize() const { return _size; }
-    char* GetDataBuffer() const { return _buffer; }
-    char* GetWritableBuffer() { return _buffer; }
+    // Raw data may be a view into read-only mapped archive, it must never be written to
+    const char* GetDataBuffer() const { return _buffer; }
+    bool IsBufferView() const { return m_bIsBufferView; }
+
+    // Frees raw data once extra data created from it does not need it anymore
+    void ReleaseDataBuffer();
 
     std::shared_ptr<IResourceExtraData> GetExtraData() { return _extraData; }
-    void SetExtraData(std::shared_ptr<IResourceExtraData> extraData) { _extraData = extraData; }
+    void SetExtraData(std::shared_ptr<IResourceExtraData> extraData);
+
+    // Has to be called when extra data changed its size after it was set, e.g. texture was created
+    void UpdateExtraDataMemorySize();
+    uint32 GetExtraDataMemorySize() const { return m_ExtraDataMemorySize; }
+    uint32 GetTextureMemorySize() const { return m_TextureMemorySize; }
 
 protected:
     Resource _resource;
-    char* _buffer;
+    const char* _buffer;
     uint32 _size;
+    bool m_bIsBufferView;
     std::shared_ptr<IResourceExtraData> _extraData;
+    // What is currently accounted in resource cache for extra data
+    uint32 m_ExtraDataMemorySize;
+    uint32 m_TextureMemorySize;
     ResourceCache* _resourceCache;
 
 private:
+    // Valid only while handle is in cache, lets cache touch or evict it in constant time
+    ResourceHandleList::iterator m_LruPosition;
 };
 
-typedef std::list<std::shared_ptr<ResourceHandle>> ResourceHandleList;
 typedef std::list<std::shared_ptr<IResourceLoader>> ResourceLoaderList;
-typedef std::map<std::string, std::shared_ptr<ResourceHandle>> ResourceHandleMap;
+typedef std::unordered_map<Resource, std::shared_ptr<ResourceHandle>, ResourceNameHash, ResourceNameEqual> ResourceHandleMap;
+
+struct ResourceResidency
+{
+    ResourceResidency() : numResources(0), memorySize(0), textureMemorySize(0) { }
+
+    uint32 numResources;
+    uint64 memorySize;
+    uint64 textureMemorySize;
+};
+
+// Key is file extension of the resource
+typedef std::map<std::string, ResourceResidency> ResourceResidencyMap;
 
 class ResourceCache
 {
 public:
-    ResourceCache(const uint32 sizeInMb, IResourceFile* resourceFile, std::string name = "");
+    ResourceCache(const uint32 sizeInMb, const uint32 textureSizeInMb, IResourceFile* resourceFile, std::string name = "");
     virtual ~ResourceCache();
 
     bool Init();
@@ -175,18 +255,39 @@ public:
 
     int32 Preload(const std::string pattern, void(*progressCallback)(int32, bool &));
     std::vector<std::string> Match(const std::string pattern);
+    // Reference implementation of Match() which tests every resource name, used for benchmarking
+    std::vector<std::string> MatchLinear(const std::string pattern);
     std::vector<std::string> GetAllFilesInDirectory(const char* directoryPath);
 
     void Flush();
 
     bool IsUsingDevelopmentDirectories() { assert(_resourceFile != NULL); return _resourceFile->VIsUsingDevelopmentDIrectories(); }
 
-    void MemoryHasBeenFreed(uint32 size);
+    void MemoryHasBeenAllocated(uint32 size, uint32 textureSize);
+    void MemoryHasBeenFreed(uint32 size, uint32 textureSize = 0);
+
+    uint64 GetAllocated() const { return _allocated; }
+    uint64 GetCacheSize() const { return _cacheSize; }
+    uint64 GetTextureAllocated() const { return m_TextureAllocated; }
+    uint64 GetTextureCacheSize() const { return m_TextureCacheSize; }
+    ResourceResidencyMap GetResidencyByType();
+
+    // Used by ResourceLoadPipeline, main thread only
+    IResourceFile* GetResourceFile() { return _resourceFile; }
+    std::shared_ptr<IResourceLoader> FindLoader(Resource* r);
+    bool IsLoaded(Resource* r);
+    bool Exists(Resource* r) const { return m_PathIndex.Contains(r->GetName()); }
+    std::shared_ptr<ResourceHandle> InsertDecoded(Resource* r, std::shared_ptr<IResourceExtraData> extraData);
+
+    uint32 GetNumResidentResources() const { return _lruList.size(); }
 
 protected:
     bool MakeRoom(uint32 size);
+    // Evicts least recently used resources until both budgets are met
+    void EnforceBudgets();
     char* Allocate(uint32 size);
     void Free(std::shared_ptr<ResourceHandle> gonner);
+    void Insert(std::shared_ptr<ResourceHandle> handle);
 
     std::shared_ptr<ResourceHandle> Load(Resource* r);
     std::shared_ptr<ResourceHandle> Find(Resource* r);
@@ -194,16 +295,22 @@ protected:
 
     void FreeOneResource();
 
+    void BuildPathIndex();
+
 private:
     std::string m_Name;
     IResourceFile* _resourceFile;
 
     uint64 _cacheSize;
     uint64 _allocated;
+    uint64 m_TextureCacheSize;
+    uint64 m_TextureAllocated;
 
     ResourceHandleList _lruList;
     ResourceLoaderList _resourceLoaderList;
     ResourceHandleMap _resourceMap;
+
+    ResourcePathIndex m_PathIndex;
 };
 
 #endif
\ No newline at end of file
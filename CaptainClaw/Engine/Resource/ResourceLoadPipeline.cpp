@@ -0,0 +1,336 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <SDL2/SDL.h>
+
+#include "ResourceLoadPipeline.h"
+#include "ResourceCache.h"
+
+static uint64 TicksToMicroseconds(uint64 ticks)
+{
+    return (ticks * 1000000) / SDL_GetPerformanceFrequency();
+}
+
+//=================================================================================================
+// struct ResourceLoadStats
+//
+
+ResourceLoadStats::ResourceLoadStats()
+    :
+    numResources(0),
+    numDecodedAsync(0),
+    numLoadedSync(0),
+    bytesRead(0),
+    ioTime(0),
+    decodeTime(0),
+    uploadTime(0),
+    syncLoadTime(0),
+    wallTime(0)
+{
+
+}
+
+std::string ResourceLoadStats::ToString() const
+{
+    return "Resources: " + ToStr((unsigned long)numResources) +
+        " (async: " + ToStr((unsigned long)numDecodedAsync) + ", sync: " + ToStr((unsigned long)numLoadedSync) + ")" +
+        ", read: " + ToStr((unsigned long)(bytesRead / 1024)) + " kB" +
+        ", I/O: " + ToStr((unsigned long)(ioTime / 1000)) + " ms" +
+        ", decode: " + ToStr((unsigned long)(decodeTime / 1000)) + " ms" +
+        ", upload: " + ToStr((unsigned long)(uploadTime / 1000)) + " ms" +
+        ", sync load: " + ToStr((unsigned long)(syncLoadTime / 1000)) + " ms" +
+        ", wall: " + ToStr((unsigned long)(wallTime / 1000)) + " ms";
+}
+
+//=================================================================================================
+// class ResourceLoadPipeline
+//
+
+struct ResourceLoadPipeline::WorkerState
+{
+    WorkerState()
+        :
+        nextAsyncRequestIdx(0),
+        bCancelled(false),
+        numRunningWorkers(0),
+        ioTicks(0),
+        decodeTicks(0),
+        bytesRead(0)
+    { }
+
+    std::vector<std::thread> workers;
+    std::atomic<uint32> nextAsyncRequestIdx;
+    std::atomic<bool> bCancelled;
+    std::atomic<uint32> numRunningWorkers;
+
+    std::mutex decodedMutex;
+    std::condition_variable decodedCondition;
+    std::deque<DecodedResource> decodedQueue;
+
+    std::atomic<uint64> ioTicks;
+    std::atomic<uint64> decodeTicks;
+    std::atomic<uint64> bytesRead;
+};
+
+ResourceLoadPipeline::ResourceLoadPipeline(ResourceCache* pCache, uint32 numWorkers)
+    :
+    m_pCache(pCache),
+    m_NumWorkers(numWorkers),
+    m_NextSyncRequestIdx(0),
+    m_NumCommitted(0),
+    m_bStatsCollected(false),
+    m_pWorkerState(new WorkerState()),
+    m_StartTicks(0)
+{
+    assert(m_pCache != NULL);
+
+    if (m_NumWorkers == 0)
+    {
+        // Leave one core for main thread which uploads textures and renders loading screen
+        uint32 numCores = std::thread::hardware_concurrency();
+        m_NumWorkers = (numCores > 1) ? (numCores - 1) : 1;
+    }
+}
+
+ResourceLoadPipeline::~ResourceLoadPipeline()
+{
+    Cancel();
+}
+
+void ResourceLoadPipeline::Start(const std::string& pattern)
+{
+    Start(m_pCache->Match(pattern));
+}
+
+void ResourceLoadPipeline::Start(const std::vector<std::string>& resourceNames)
+{
+    assert(m_pWorkerState->workers.empty() && "Pipeline was already started");
+
+    m_StartTicks = SDL_GetPerformanceCounter();
+
+    // Resource file has to be able to serve reads from multiple threads, otherwise
+    // everything is loaded on main thread
+    bool canReadConcurrently = m_pCache->GetResourceFile()->VSupportsConcurrentReads();
+
+    for (const std::string& resourceName : resourceNames)
+    {
+        Resource resource(resourceName);
+        if (m_pCache->IsLoaded(&resource) || !m_pCache->Exists(&resource))
+        {
+            continue;
+        }
+
+        std::shared_ptr<IResourceLoader> pLoader = m_pCache->FindLoader(&resource);
+        if (canReadConcurrently && pLoader && pLoader->VCanDecodeAsync())
+        {
+            LoadRequest request;
+            request.resourceName = resourceName;
+            request.pLoader = pLoader;
+            m_AsyncRequests.push_back(request);
+        }
+        else
+        {
+            m_SyncRequests.push_back(resourceName);
+        }
+    }
+
+    m_Stats.numResources = GetNumResources();
+
+    if (m_AsyncRequests.empty())
+    {
+        return;
+    }
+
+    uint32 numWorkers = std::min(m_NumWorkers, (uint32)m_AsyncRequests.size());
+    m_pWorkerState->numRunningWorkers = numWorkers;
+    for (uint32 workerIdx = 0; workerIdx < numWorkers; workerIdx++)
+    {
+        m_pWorkerState->workers.push_back(std::thread(&ResourceLoadPipeline::WorkerThread, this));
+    }
+}
+
+void ResourceLoadPipeline::Cancel()
+{
+    m_pWorkerState->bCancelled = true;
+
+    for (std::thread& worker : m_pWorkerState->workers)
+    {
+        worker.join();
+    }
+    m_pWorkerState->workers.clear();
+}
+
+float ResourceLoadPipeline::GetProgress() const
+{
+    if (GetNumResources() == 0)
+    {
+        return 100.0f;
+    }
+
+    return (m_NumCommitted * 100.0f) / GetNumResources();
+}
+
+void ResourceLoadPipeline::WorkerThread()
+{
+    WorkerState* pState = m_pWorkerState.get();
+    IResourceFile* pResourceFile = m_pCache->GetResourceFile();
+    std::vector<char> rawBuffer;
+
+    while (!pState->bCancelled)
+    {
+        uint32 requestIdx = pState->nextAsyncRequestIdx++;
+        if (requestIdx >= m_AsyncRequests.size())
+        {
+            break;
+        }
+
+        const LoadRequest& request = m_AsyncRequests[requestIdx];
+        Resource resource(request.resourceName);
+
+        DecodedResource decodedResource;
+        decodedResource.requestIdx = requestIdx;
+
+        // I/O - mapped archives do not need to be read at all
+        uint64 ioStartTicks = SDL_GetPerformanceCounter();
+        const char* pRawData = pResourceFile->VGetRawResourceView(&resource);
+        int32 rawSize = pResourceFile->VGetRawResourceSize(&resource);
+        if (pRawData == NULL && rawSize >= 0)
+        {
+            rawBuffer.resize(rawSize);
+            if (pResourceFile->VGetRawResource(&resource, rawBuffer.data()) >= 0)
+            {
+                pRawData = rawBuffer.data();
+            }
+        }
+        uint64 decodeStartTicks = SDL_GetPerformanceCounter();
+        pState->ioTicks += decodeStartTicks - ioStartTicks;
+
+        // Decode - failed resources are left with NULL extra data and are loaded
+        // synchronously by main thread which also reports the error
+        if (pRawData != NULL)
+        {
+            pState->bytesRead += rawSize;
+            decodedResource.pExtraData = request.pLoader->VDecodeResource(pRawData, rawSize);
+        }
+        pState->decodeTicks += SDL_GetPerformanceCounter() - decodeStartTicks;
+
+        {
+            std::lock_guard<std::mutex> lock(pState->decodedMutex);
+            pState->decodedQueue.push_back(decodedResource);
+        }
+        pState->decodedCondition.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pState->decodedMutex);
+        pState->numRunningWorkers--;
+    }
+    pState->decodedCondition.notify_one();
+}
+
+void ResourceLoadPipeline::CommitDecodedResource(DecodedResource& decodedResource)
+{
+    const LoadRequest& request = m_AsyncRequests[decodedResource.requestIdx];
+    Resource resource(request.resourceName);
+
+    m_NumCommitted++;
+
+    // Someone could have requested it synchronously in the meantime
+    if (m_pCache->IsLoaded(&resource))
+    {
+        return;
+    }
+
+    if (decodedResource.pExtraData)
+    {
+        uint64 uploadStartTicks = SDL_GetPerformanceCounter();
+        bool uploaded = request.pLoader->VUploadResource(decodedResource.pExtraData) &&
+            m_pCache->InsertDecoded(&resource, decodedResource.pExtraData);
+        m_Stats.uploadTime += TicksToMicroseconds(SDL_GetPerformanceCounter() - uploadStartTicks);
+
+        if (uploaded)
+        {
+            m_Stats.numDecodedAsync++;
+            return;
+        }
+    }
+
+    LOG_WARNING("Could not decode resource: " + request.resourceName + " on worker thread, loading it synchronously");
+
+    uint64 syncStartTicks = SDL_GetPerformanceCounter();
+    m_pCache->GetHandle(&resource);
+    m_Stats.syncLoadTime += TicksToMicroseconds(SDL_GetPerformanceCounter() - syncStartTicks);
+    m_Stats.numLoadedSync++;
+}
+
+void ResourceLoadPipeline::LoadNextSyncResource()
+{
+    Resource resource(m_SyncRequests[m_NextSyncRequestIdx]);
+    m_NextSyncRequestIdx++;
+    m_NumCommitted++;
+
+    uint64 syncStartTicks = SDL_GetPerformanceCounter();
+    m_pCache->GetHandle(&resource);
+    m_Stats.syncLoadTime += TicksToMicroseconds(SDL_GetPerformanceCounter() - syncStartTicks);
+    m_Stats.numLoadedSync++;
+}
+
+bool ResourceLoadPipeline::Pump(uint32 budgetMs)
+{
+    WorkerState* pState = m_pWorkerState.get();
+    uint64 endTicks = SDL_GetPerformanceCounter() + (SDL_GetPerformanceFrequency() * budgetMs) / 1000;
+
+    while (!IsDone() && SDL_GetPerformanceCounter() < endTicks)
+    {
+        std::unique_lock<std::mutex> lock(pState->decodedMutex);
+        if (!pState->decodedQueue.empty())
+        {
+            DecodedResource decodedResource = pState->decodedQueue.front();
+            pState->decodedQueue.pop_front();
+            lock.unlock();
+
+            CommitDecodedResource(decodedResource);
+            continue;
+        }
+        lock.unlock();
+
+        // Nothing decoded yet, make use of the time with resources that cannot be loaded in background
+        if (m_NextSyncRequestIdx < m_SyncRequests.size())
+        {
+            LoadNextSyncResource();
+            continue;
+        }
+
+        // Only waiting for workers now
+        lock.lock();
+        if (pState->decodedQueue.empty() && pState->numRunningWorkers > 0)
+        {
+            uint64 remainingTicks = endTicks - std::min(endTicks, (uint64)SDL_GetPerformanceCounter());
+            pState->decodedCondition.wait_for(lock, std::chrono::microseconds(TicksToMicroseconds(remainingTicks)));
+        }
+    }
+
+    if (!IsDone())
+    {
+        return false;
+    }
+
+    if (m_bStatsCollected)
+    {
+        return true;
+    }
+
+    // Everything is in cache, collect stats
+    Cancel();
+    m_bStatsCollected = true;
+
+    m_Stats.ioTime = TicksToMicroseconds(pState->ioTicks);
+    m_Stats.decodeTime = TicksToMicroseconds(pState->decodeTicks);
+    m_Stats.bytesRead = pState->bytesRead;
+    m_Stats.wallTime = TicksToMicroseconds(SDL_GetPerformanceCounter() - m_StartTicks);
+
+    return true;
+}
@@ -0,0 +1,105 @@
+#ifndef __RESOURCE_LOAD_PIPELINE_H__
+#define __RESOURCE_LOAD_PIPELINE_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../SharedDefines.h"
+
+class ResourceCache;
+class IResourceLoader;
+class IResourceExtraData;
+
+// Times are in microseconds, worker stages are summed over all worker threads
+struct ResourceLoadStats
+{
+    ResourceLoadStats();
+
+    std::string ToString() const;
+
+    uint32 numResources;
+    uint32 numDecodedAsync;
+    uint32 numLoadedSync;
+    uint64 bytesRead;
+
+    uint64 ioTime;
+    uint64 decodeTime;
+    uint64 uploadTime;
+    uint64 syncLoadTime;
+    uint64 wallTime;
+};
+
+//=================================================================================================
+// class ResourceLoadPipeline
+//
+//     Loads all resources matching given pattern into resource cache. Resources whose loader
+//     supports it (IResourceLoader::VCanDecodeAsync) are read and decoded on worker threads,
+//     main thread only uploads finished resources (e.g. creates textures) and inserts them
+//     into the cache. Everything else is loaded synchronously on main thread in between.
+//
+//     Start() and Pump() must be called from main thread. Worker threads never touch resource
+//     cache itself, only its resource file and loaders.
+//
+//     Threading primitives are kept out of this header since <thread> and friends do not
+//     survive max() macro from SharedDefines.h.
+//
+
+class ResourceLoadPipeline
+{
+public:
+    // numWorkers == 0 picks number of workers based on available cores
+    ResourceLoadPipeline(ResourceCache* pCache, uint32 numWorkers = 0);
+    ~ResourceLoadPipeline();
+
+    void Start(const std::string& pattern);
+    // Names which are not present in resource file are skipped
+    void Start(const std::vector<std::string>& resourceNames);
+
+    // Commits finished resources for at most budgetMs, returns true when everything is loaded
+    bool Pump(uint32 budgetMs);
+
+    void Cancel();
+
+    bool IsDone() const { return m_NumCommitted == GetNumResources(); }
+    uint32 GetNumResources() const { return m_AsyncRequests.size() + m_SyncRequests.size(); }
+    // 0 - 100
+    float GetProgress() const;
+    const ResourceLoadStats& GetStats() const { return m_Stats; }
+
+private:
+    struct LoadRequest
+    {
+        std::string resourceName;
+        std::shared_ptr<IResourceLoader> pLoader;
+    };
+
+    struct DecodedResource
+    {
+        uint32 requestIdx;
+        std::shared_ptr<IResourceExtraData> pExtraData;
+    };
+
+    // Workers, worker -> main thread queue and worker stats
+    struct WorkerState;
+
+    void WorkerThread();
+    void CommitDecodedResource(DecodedResource& decodedResource);
+    void LoadNextSyncResource();
+
+    ResourceCache* m_pCache;
+    uint32 m_NumWorkers;
+
+    std::vector<LoadRequest> m_AsyncRequests;
+    std::vector<std::string> m_SyncRequests;
+    uint32 m_NextSyncRequestIdx;
+    uint32 m_NumCommitted;
+    bool m_bStatsCollected;
+
+    std::unique_ptr<WorkerState> m_pWorkerState;
+
+    uint64 m_StartTicks;
+    ResourceLoadStats m_Stats;
+};
+
+#endif
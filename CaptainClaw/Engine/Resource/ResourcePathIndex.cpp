@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cctype>
+
+#include "ResourcePathIndex.h"
+#include "../Util/StringUtil.h"
+
+static const char DIRECTORY_SEPARATOR = '/';
+
+static bool StartsWith(const std::string& str, const std::string& prefix)
+{
+    return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
+ResourcePathIndex::ResourcePathIndex()
+    :
+    m_bIsBuilt(false)
+{
+
+}
+
+void ResourcePathIndex::Clear()
+{
+    m_SortedNames.clear();
+    m_DirectoryNodes.clear();
+    m_bIsBuilt = false;
+}
+
+void ResourcePathIndex::Build(std::vector<std::string>& names)
+{
+    Clear();
+
+    m_SortedNames.swap(names);
+    for (std::string& name : m_SortedNames)
+    {
+        // Everything is converted into lower case so maintain consistency
+        std::transform(name.begin(), name.end(), name.begin(), (int(*)(int)) std::tolower);
+    }
+    std::sort(m_SortedNames.begin(), m_SortedNames.end());
+
+    // Root node stands for empty prefix and thus covers all names
+    m_DirectoryNodes.push_back(DirectoryNode());
+    m_DirectoryNodes[0].lastNameIdx = m_SortedNames.size();
+
+    // Names sharing a directory prefix are contiguous in sorted table so each node only
+    // has to remember where its range begins and ends
+    for (uint32 nameIdx = 0; nameIdx < m_SortedNames.size(); ++nameIdx)
+    {
+        const std::string& name = m_SortedNames[nameIdx];
+
+        uint32 currNodeIdx = 0;
+        size_t componentStart = 0;
+        size_t separatorPos = name.find(DIRECTORY_SEPARATOR);
+        while (separatorPos != std::string::npos)
+        {
+            std::string component = name.substr(componentStart, separatorPos - componentStart + 1);
+
+            auto findIt = m_DirectoryNodes[currNodeIdx].children.find(component);
+            if (findIt == m_DirectoryNodes[currNodeIdx].children.end())
+            {
+                uint32 newNodeIdx = m_DirectoryNodes.size();
+                m_DirectoryNodes[currNodeIdx].children.insert(std::make_pair(component, newNodeIdx));
+
+                m_DirectoryNodes.push_back(DirectoryNode());
+                m_DirectoryNodes[newNodeIdx].firstNameIdx = nameIdx;
+
+                currNodeIdx = newNodeIdx;
+            }
+            else
+            {
+                currNodeIdx = findIt->second;
+            }
+
+            m_DirectoryNodes[currNodeIdx].lastNameIdx = nameIdx + 1;
+
+            componentStart = separatorPos + 1;
+            separatorPos = name.find(DIRECTORY_SEPARATOR, componentStart);
+        }
+    }
+
+    m_bIsBuilt = true;
+}
+
+const ResourcePathIndex::DirectoryNode* ResourcePathIndex::FindDirectoryNode(const std::string& directoryPrefix) const
+{
+    if (m_DirectoryNodes.empty())
+    {
+        return NULL;
+    }
+
+    const DirectoryNode* pNode = &m_DirectoryNodes[0];
+
+    size_t componentStart = 0;
+    size_t separatorPos = directoryPrefix.find(DIRECTORY_SEPARATOR);
+    while (separatorPos != std::string::npos)
+    {
+        std::string component = directoryPrefix.substr(componentStart, separatorPos - componentStart + 1);
+
+        auto findIt = pNode->children.find(component);
+        if (findIt == pNode->children.end())
+        {
+            return NULL;
+        }
+
+        pNode = &m_DirectoryNodes[findIt->second];
+
+        componentStart = separatorPos + 1;
+        separatorPos = directoryPrefix.find(DIRECTORY_SEPARATOR, componentStart);
+    }
+
+    return pNode;
+}
+
+bool ResourcePathIndex::GetCandidateRange(const std::string& literalPrefix, uint32& firstNameIdx, uint32& lastNameIdx) const
+{
+    // Narrow search to the deepest directory fully specified by the literal prefix
+    size_t lastSeparatorPos = literalPrefix.rfind(DIRECTORY_SEPARATOR);
+    std::string directoryPrefix = (lastSeparatorPos == std::string::npos) ? "" : literalPrefix.substr(0, lastSeparatorPos + 1);
+
+    const DirectoryNode* pNode = FindDirectoryNode(directoryPrefix);
+    if (pNode == NULL)
+    {
+        return false;
+    }
+
+    // And then by the rest of the literal prefix within that directory
+    auto rangeBegin = m_SortedNames.begin() + pNode->firstNameIdx;
+    auto rangeEnd = m_SortedNames.begin() + pNode->lastNameIdx;
+
+    auto firstIt = std::lower_bound(rangeBegin, rangeEnd, literalPrefix);
+    auto lastIt = firstIt;
+    while (lastIt != rangeEnd && StartsWith(*lastIt, literalPrefix))
+    {
+        ++lastIt;
+    }
+
+    firstNameIdx = firstIt - m_SortedNames.begin();
+    lastNameIdx = lastIt - m_SortedNames.begin();
+
+    return firstNameIdx != lastNameIdx;
+}
+
+bool ResourcePathIndex::Contains(const std::string& name) const
+{
+    return std::binary_search(m_SortedNames.begin(), m_SortedNames.end(), name);
+}
+
+std::vector<std::string> ResourcePathIndex::Match(const std::string& pattern) const
+{
+    std::vector<std::string> matchingNames;
+
+    // Everything is converted into lower case so maintain consistency
+    std::string patternCopy = pattern;
+    std::transform(patternCopy.begin(), patternCopy.end(), patternCopy.begin(), (int(*)(int)) std::tolower);
+
+    size_t wildcardPos = patternCopy.find_first_of("*?");
+    std::string literalPrefix = patternCopy.substr(0, wildcardPos);
+
+    // No wildcard at all - at most one name can match
+    if (wildcardPos == std::string::npos)
+    {
+        if (std::binary_search(m_SortedNames.begin(), m_SortedNames.end(), patternCopy))
+        {
+            matchingNames.push_back(patternCopy);
+        }
+
+        return matchingNames;
+    }
+
+    uint32 firstNameIdx, lastNameIdx;
+    if (!GetCandidateRange(literalPrefix, firstNameIdx, lastNameIdx))
+    {
+        return matchingNames;
+    }
+
+    // "/LEVEL1/*" like patterns match every candidate, no need to test them
+    bool isTrailingStarOnly = patternCopy.find_first_not_of('*', wildcardPos) == std::string::npos;
+    if (isTrailingStarOnly)
+    {
+        matchingNames.assign(m_SortedNames.begin() + firstNameIdx, m_SortedNames.begin() + lastNameIdx);
+        return matchingNames;
+    }
+
+    for (uint32 nameIdx = firstNameIdx; nameIdx < lastNameIdx; ++nameIdx)
+    {
+        if (WildcardMatch(patternCopy.c_str(), m_SortedNames[nameIdx].c_str()))
+        {
+            matchingNames.push_back(m_SortedNames[nameIdx]);
+        }
+    }
+
+    return matchingNames;
+}
@@ -0,0 +1,56 @@
+#ifndef __RESOURCE_PATH_INDEX_H__
+#define __RESOURCE_PATH_INDEX_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../SharedDefines.h"
+
+//=================================================================================================
+// class ResourcePathIndex
+//
+//     Case-folded index over all resource names of one IResourceFile. Names are kept in a sorted
+//     table and every directory prefix is stored in a trie node which knows the contiguous range
+//     of names inside that directory. Glob queries only test names which share the pattern's
+//     literal prefix instead of walking the whole archive.
+//
+
+class ResourcePathIndex
+{
+public:
+    ResourcePathIndex();
+
+    // Takes ownership of names, they do not have to be lower case nor sorted
+    void Build(std::vector<std::string>& names);
+    void Clear();
+
+    bool IsBuilt() const { return m_bIsBuilt; }
+    uint32 GetNumNames() const { return m_SortedNames.size(); }
+
+    // Same semantics as WildcardMatch() over all lower case names, results are sorted
+    std::vector<std::string> Match(const std::string& pattern) const;
+    // Name has to be lower case already
+    bool Contains(const std::string& name) const;
+
+private:
+    struct DirectoryNode
+    {
+        DirectoryNode() : firstNameIdx(0), lastNameIdx(0) { }
+
+        // Key is directory name including its trailing separator, e.g. "images/"
+        std::map<std::string, uint32> children;
+        // Names with this node's prefix are in range [firstNameIdx, lastNameIdx)
+        uint32 firstNameIdx;
+        uint32 lastNameIdx;
+    };
+
+    const DirectoryNode* FindDirectoryNode(const std::string& directoryPrefix) const;
+    bool GetCandidateRange(const std::string& literalPrefix, uint32& firstNameIdx, uint32& lastNameIdx) const;
+
+    bool m_bIsBuilt;
+    std::vector<std::string> m_SortedNames;
+    std::vector<DirectoryNode> m_DirectoryNodes;
+};
+
+#endif
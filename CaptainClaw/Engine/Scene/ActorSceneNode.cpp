@@ -18,6 +18,14 @@ SDL2ActorSceneNode::~SDL2ActorSceneNode()
 
 }
 
+SDL_Texture* SDL2ActorSceneNode::GetBatchTexture() const
+{
+    ActorRenderComponent* arc = static_cast<ActorRenderComponent*>(m_pRenderComponent);
+
+    shared_ptr<Image> actorImage = MakeStrongPtr(arc->GetCurrentImage());
+    return actorImage ? actorImage->GetTexture() : NULL;
+}
+
 void SDL2ActorSceneNode::VRender(Scene* pScene)
 {
     // In Claw every actor is a rectangle which simplifies stuff A LOT. Keep this is mind
@@ -53,15 +61,17 @@ void SDL2ActorSceneNode::VRender(Scene* pScene)
     const SDL_Rect cameraRect = pCamera->GetCameraRect();
     int32 offsetX = arc->IsMirrored() ? -actorImage->GetOffsetX() : actorImage->GetOffsetX();
     int32 offsetY = arc->IsInverted() ? -actorImage->GetOffsetY() : actorImage->GetOffsetY();
+    // Simulation runs at fixed rate, frames in between are drawn where actor would be at that time
+    const Point position = GetInterpolatedPosition();
     SDL_Rect renderRect =
     {
-        (int)m_Properties.GetPosition().x - actorImage->GetWidth() / 2  + offsetX - cameraRect.x,
-        (int)m_Properties.GetPosition().y - actorImage->GetHeight() / 2 + offsetY - cameraRect.y,
+        (int)position.x - actorImage->GetWidth() / 2  + offsetX - cameraRect.x,
+        (int)position.y - actorImage->GetHeight() / 2 + offsetY - cameraRect.y,
         actorImage->GetWidth(),
         actorImage->GetHeight()
     };
 
     SDL_Renderer* renderer = pScene->GetRenderer();
-    SDL_RenderCopyEx(renderer, actorImage->GetTexture(), NULL, &renderRect, 0, NULL, 
+    SDL_RenderCopyEx(renderer, actorImage->GetTexture(), actorImage->GetSourceRect(), &renderRect, 0, NULL, 
         arc->IsMirrored() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
 }
@@ -17,6 +17,8 @@ public:
 
     // Interface overrides
     virtual void VRender(Scene* pScene);
+    // Texture of current image, actors sharing atlas page end up next to each other
+    virtual SDL_Texture* GetBatchTexture() const;
 
 protected:
 };
@@ -15,6 +15,7 @@ Scene::Scene(SDL_Renderer* renderer)
     IEventMgr* pEventMgr = IEventMgr::Get();
     pEventMgr->VAddListener(MakeDelegate(this, &Scene::NewRenderComponentDelegate), EventData_New_Render_Component::sk_EventType);
     pEventMgr->VAddListener(MakeDelegate(this, &Scene::MoveActorDelegate), EventData_Move_Actor::sk_EventType);
+    pEventMgr->VAddListener(MakeDelegate(this, &Scene::MoveActorsBatchDelegate), EventData_Move_Actors_Batch::sk_EventType);
     pEventMgr->VAddListener(MakeDelegate(this, &Scene::DestroyActorDelegate), EventData_Destroy_Actor::sk_EventType);
 }
 
@@ -24,6 +25,7 @@ Scene::~Scene()
     pEventMgr->VRemoveListener(MakeDelegate(this, &Scene::NewRenderComponentDelegate), EventData_New_Render_Component::sk_EventType);
     pEventMgr->VRemoveListener(MakeDelegate(this, &Scene::DestroyActorDelegate), EventData_Destroy_Actor::sk_EventType);
     pEventMgr->VRemoveListener(MakeDelegate(this, &Scene::MoveActorDelegate), EventData_Move_Actor::sk_EventType);
+    pEventMgr->VRemoveListener(MakeDelegate(this, &Scene::MoveActorsBatchDelegate), EventData_Move_Actors_Batch::sk_EventType);
 }
 
 void Scene::OnUpdate(uint32 msDiff)
@@ -95,6 +97,11 @@ void Scene::SortSceneNodesByZCoord()
     m_pRoot->SortChildrenByZCoord();
 }
 
+const RenderPassNode* Scene::GetRenderPassNode(RenderPass pass) const
+{
+    return static_cast<RootNode*>(m_pRoot.get())->GetRenderPassNode(pass);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 // Event delegates
 //---------------------------------------------------------------------------------------------------------------------
@@ -131,4 +138,19 @@ void Scene::MoveActorDelegate(IEventDataPtr pEventData)
         Point moveDestination = pCastEventData->GetMove();
         pNode->VSetPosition(moveDestination);
     }
+}
+
+void Scene::MoveActorsBatchDelegate(IEventDataPtr pEventData)
+{
+    shared_ptr<EventData_Move_Actors_Batch> pCastEventData = static_pointer_cast<EventData_Move_Actors_Batch>(pEventData);
+
+    for (const ActorMove& actorMove : pCastEventData->GetMoves())
+    {
+        SceneActorMap::iterator iter = m_ActorMap.find(actorMove.actorId);
+        if (iter != m_ActorMap.end())
+        {
+            Point moveDestination = actorMove.move;
+            iter->second->VSetPosition(moveDestination);
+        }
+    }
 }
\ No newline at end of file
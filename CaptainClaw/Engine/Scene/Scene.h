@@ -11,7 +11,7 @@ public:
     virtual ~Scene();
 
     void OnRender();
-    bool OnLostDevice() { return true; }
+    bool OnLostDevice() { return m_pRoot->VOnLostDevice(this); }
     void OnUpdate(uint32 msDiff);
 
     shared_ptr<ISceneNode> FindActor(uint32 actorId);
@@ -25,11 +25,14 @@ public:
 
     void SortSceneNodesByZCoord();
 
+    const RenderPassNode* GetRenderPassNode(RenderPass pass) const;
+
     // Event delegates
     void NewRenderComponentDelegate(IEventDataPtr pEventData);
     void ModifiedRenderComponentDelegate(IEventDataPtr pEventData);
     void DestroyActorDelegate(IEventDataPtr pEventData);
     void MoveActorDelegate(IEventDataPtr pEventData);
+    void MoveActorsBatchDelegate(IEventDataPtr pEventData);
 
 protected:
     shared_ptr<SceneNode>   m_pRoot;
@@ -1,9 +1,29 @@
+#include <functional>
+
 #include "SceneNodes.h"
 #include "Scene.h"
 #include "../Actor/ActorComponent.h"
 #include "../Actor/Components/RenderComponent.h"
 #include "../GameApp/BaseGameApp.h"
 
+// Longer moves within one simulation step are teleports and are not interpolated
+const double MAX_INTERPOLATED_DISTANCE = 256.0;
+
+// Side of one grid cell of RenderPassNode in pixels
+const int32 SCENE_GRID_CELL_SIZE = 256;
+// Nodes reaching farther than this from their position are not put into the grid
+const int32 MAX_GRID_NODE_EXTENT = 2048;
+
+static int32 GetGridCellCoord(double position)
+{
+    return (int32)floor(position / SCENE_GRID_CELL_SIZE);
+}
+
+static uint64 GetGridCellKey(const Point& position)
+{
+    return ((uint64)(uint32)GetGridCellCoord(position.x) << 32) | (uint32)GetGridCellCoord(position.y);
+}
+
 //=================================================================================================
 // SceneNodeProperties Implementation
 //
@@ -29,6 +49,12 @@ SceneNode::SceneNode(uint32 actorId, BaseRenderComponent* renderComponent, Rende
     m_Properties.m_RenderPass = renderPass;
     m_Properties.m_ZCoord = zCoord;
     m_pRenderComponent = renderComponent;
+    m_PreviousPosition = position;
+    m_LastMoveStep = 0;
+    m_RenderOrder = 0;
+    m_GridCellKey = 0;
+    m_bIsInGrid = false;
+    m_LastVisibleFrame = 0;
 
     /*if (m_Properties.m_Width == 0 || m_Properties.m_Height == 0)
     {
@@ -41,9 +67,58 @@ SceneNode::~SceneNode()
     //LOG("Destroyed SceneNode: " + ToStr(m_Properties.GetActorId()));
 }
 
-// Idk now, SDL2 should handle everything on its own
+void SceneNode::VSetPosition(Point& position)
+{
+    // Only the first move within a simulation step knows where node was when the step started
+    uint32 simulationStep = g_pApp->GetSimulationStep();
+    if (m_LastMoveStep != simulationStep)
+    {
+        m_PreviousPosition = m_Properties.m_Position;
+        m_LastMoveStep = simulationStep;
+    }
+
+    m_Properties.m_Position = position;
+
+    if (m_pParent)
+    {
+        m_pParent->VOnChildMoved(this);
+    }
+}
+
+void SceneNode::OnResized()
+{
+    if (m_pParent)
+    {
+        m_pParent->VOnChildResized(this);
+    }
+}
+
+Point SceneNode::GetInterpolatedPosition() const
+{
+    // Node did not move during the last step
+    if (m_LastMoveStep != g_pApp->GetSimulationStep())
+    {
+        return m_Properties.m_Position;
+    }
+
+    Point move = m_Properties.m_Position - m_PreviousPosition;
+    if (fabs(move.x) > MAX_INTERPOLATED_DISTANCE || fabs(move.y) > MAX_INTERPOLATED_DISTANCE)
+    {
+        return m_Properties.m_Position;
+    }
+
+    double alpha = g_pApp->GetInterpolationAlpha();
+    return Point(m_PreviousPosition.x + move.x * alpha, m_PreviousPosition.y + move.y * alpha);
+}
+
+// SDL2 restores textures on its own, only content rendered into textures is lost
 bool SceneNode::VOnLostDevice(Scene* pScene)
 {
+    for (auto child : m_ChildrenList)
+    {
+        child->VOnLostDevice(pScene);
+    }
+
     return true;
 }
 
@@ -72,8 +147,6 @@ void SceneNode::VRenderChildren(Scene* pScene)
 {
     for (auto childNode : m_ChildrenList)
     {
-        // TODO: Huge overhead from testing visibility of every single actor each frame
-        // Possible solution: Use Box2D Broadphase to retrieve all actors within AABB
         if (childNode->VIsVisible(pScene))
         {
             childNode->VPreRender(pScene);
@@ -115,7 +188,11 @@ bool SceneNode::VIsVisible(Scene* pScene) const
 
 bool SceneNode::VAddChild(shared_ptr<ISceneNode> ikid)
 {
-    m_ChildrenList.push_back(ikid);
+    // Children stay ordered by Z coordinate, new child goes after children with the same one
+    int32 zCoord = ikid->GetZCoord();
+    SceneNodeList::iterator insertIter = std::upper_bound(m_ChildrenList.begin(), m_ChildrenList.end(), zCoord,
+        [](int32 zCoord, const shared_ptr<ISceneNode>& pNode) { return zCoord < pNode->GetZCoord(); });
+    m_ChildrenList.insert(insertIter, ikid);
 
     shared_ptr<SceneNode> kid = static_pointer_cast<SceneNode>(ikid);
     kid->m_pParent = this;
@@ -148,10 +225,268 @@ void SceneNode::SortChildrenByZCoord()
     std::sort(m_ChildrenList.begin(), m_ChildrenList.end(), 
         [](const shared_ptr<ISceneNode>& lhs, const shared_ptr<ISceneNode>& rhs)
     {
-        return lhs->GetZCoord() < rhs->GetZCoord();
+        if (lhs->GetZCoord() != rhs->GetZCoord())
+        {
+            return lhs->GetZCoord() < rhs->GetZCoord();
+        }
+
+        return std::less<SDL_Texture*>()(lhs->GetBatchTexture(), rhs->GetBatchTexture());
     });
 }
 
+//=================================================================================================
+// RenderPassNode Implementation
+//
+
+RenderPassNode::RenderPassNode(RenderPass renderPass)
+    : SceneNode(INVALID_ACTOR_ID, NULL, renderPass, { 0, 0 }),
+    m_MaxNodeExtent(0),
+    m_NextRenderOrder(0),
+    m_RenderFrame(1),
+    m_bIsVisibleOrderDirty(false),
+    m_NumLastVisibilityTests(0)
+{
+
+}
+
+RenderPassNode::~RenderPassNode()
+{
+    // Nodes can outlive the scene when someone else still holds them
+    for (auto pChildNode : m_ChildrenList)
+    {
+        static_cast<SceneNode*>(pChildNode.get())->m_pParent = NULL;
+    }
+}
+
+bool RenderPassNode::VAddChild(shared_ptr<ISceneNode> kid)
+{
+    // Drawing order comes from Z coordinate and render order, not from position in the children list
+    m_ChildrenList.push_back(kid);
+
+    SceneNode* pNode = static_cast<SceneNode*>(kid.get());
+    pNode->m_pParent = this;
+    pNode->m_RenderOrder = m_NextRenderOrder++;
+    pNode->m_LastVisibleFrame = 0;
+    AddToGrid(pNode);
+
+    return true;
+}
+
+bool RenderPassNode::VRemoveChild(uint32 actorId)
+{
+    for (SceneNodeList::iterator iter = m_ChildrenList.begin(); iter != m_ChildrenList.end(); ++iter)
+    {
+        SceneNode* pNode = static_cast<SceneNode*>(iter->get());
+        if (pNode->m_Properties.GetActorId() != INVALID_ACTOR_ID && actorId == pNode->m_Properties.GetActorId())
+        {
+            RemoveFromGrid(pNode);
+            pNode->m_pParent = NULL;
+            m_ChildrenList.erase(iter);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void RenderPassNode::VRenderChildren(Scene* pScene)
+{
+    shared_ptr<CameraNode> pCamera = pScene->GetCamera();
+    if (!pCamera)
+    {
+        LOG_ERROR("Rendering render pass without available scene camera");
+        return;
+    }
+
+    // Visible set is the same as in last frame if every visible node was visible then too and their count matches
+    m_RenderFrame++;
+    m_FrameVisibleNodes.clear();
+    uint32 numStillVisible = 0;
+    auto addVisibleNode = [this, &numStillVisible](SceneNode* pNode)
+    {
+        if (pNode->m_LastVisibleFrame + 1 == m_RenderFrame)
+        {
+            numStillVisible++;
+        }
+        pNode->m_LastVisibleFrame = m_RenderFrame;
+        m_FrameVisibleNodes.push_back(pNode);
+    };
+
+    m_NumLastVisibilityTests = m_AlwaysTestedNodes.size();
+    for (SceneNode* pNode : m_AlwaysTestedNodes)
+    {
+        if (pNode->VIsVisible(pScene))
+        {
+            addVisibleNode(pNode);
+        }
+    }
+
+    // Any node which can reach into camera rect has its position within this area
+    const SDL_Rect cameraRect = pCamera->GetCameraRect();
+    int32 minCellX = GetGridCellCoord(cameraRect.x - m_MaxNodeExtent);
+    int32 maxCellX = GetGridCellCoord(cameraRect.x + cameraRect.w + m_MaxNodeExtent);
+    int32 minCellY = GetGridCellCoord(cameraRect.y - m_MaxNodeExtent);
+    int32 maxCellY = GetGridCellCoord(cameraRect.y + cameraRect.h + m_MaxNodeExtent);
+    for (int32 cellY = minCellY; cellY <= maxCellY; cellY++)
+    {
+        for (int32 cellX = minCellX; cellX <= maxCellX; cellX++)
+        {
+            auto cellIter = m_GridCells.find(((uint64)(uint32)cellX << 32) | (uint32)cellY);
+            if (cellIter == m_GridCells.end())
+            {
+                continue;
+            }
+
+            m_NumLastVisibilityTests += cellIter->second.size();
+            for (SceneNode* pNode : cellIter->second)
+            {
+                if (pNode->VIsVisible(pScene))
+                {
+                    addVisibleNode(pNode);
+                }
+            }
+        }
+    }
+
+    // Z coordinate of a node never changes, so drawing order only has to be found again when the set changed.
+    // Visible nodes are few, sorting them then is cheaper than keeping exact order of the whole pass.
+    if (m_bIsVisibleOrderDirty || numStillVisible != m_VisibleNodes.size() ||
+        m_FrameVisibleNodes.size() != m_VisibleNodes.size())
+    {
+        m_VisibleNodes.swap(m_FrameVisibleNodes);
+        std::sort(m_VisibleNodes.begin(), m_VisibleNodes.end(), [](const SceneNode* pLeft, const SceneNode* pRight)
+        {
+            if (pLeft->m_Properties.GetZCoord() != pRight->m_Properties.GetZCoord())
+            {
+                return pLeft->m_Properties.GetZCoord() < pRight->m_Properties.GetZCoord();
+            }
+
+            return pLeft->m_RenderOrder < pRight->m_RenderOrder;
+        });
+        m_bIsVisibleOrderDirty = false;
+    }
+
+    for (SceneNode* pNode : m_VisibleNodes)
+    {
+        pNode->VPreRender(pScene);
+        pNode->VRender(pScene);
+        pNode->VRenderChildren(pScene);
+        pNode->VPostRender(pScene);
+    }
+}
+
+void RenderPassNode::SortChildrenByZCoord()
+{
+    SceneNode::SortChildrenByZCoord();
+
+    for (size_t childIdx = 0; childIdx < m_ChildrenList.size(); childIdx++)
+    {
+        static_cast<SceneNode*>(m_ChildrenList[childIdx].get())->m_RenderOrder = childIdx;
+    }
+    m_NextRenderOrder = m_ChildrenList.size();
+    m_bIsVisibleOrderDirty = true;
+}
+
+void RenderPassNode::VOnChildMoved(SceneNode* pChild)
+{
+    if (!pChild->m_bIsInGrid)
+    {
+        return;
+    }
+
+    UpdateMaxExtent(GetNodeExtent(pChild));
+
+    uint64 cellKey = GetGridCellKey(pChild->m_Properties.GetPosition());
+    if (cellKey != pChild->m_GridCellKey)
+    {
+        RemoveFromGrid(pChild);
+
+        m_GridCells[cellKey].push_back(pChild);
+        pChild->m_GridCellKey = cellKey;
+        pChild->m_bIsInGrid = true;
+    }
+}
+
+void RenderPassNode::VOnChildResized(SceneNode* pChild)
+{
+    if (pChild->m_bIsInGrid)
+    {
+        UpdateMaxExtent(GetNodeExtent(pChild));
+    }
+}
+
+void RenderPassNode::AddToGrid(SceneNode* pNode)
+{
+    int32 extent = GetNodeExtent(pNode);
+    if (extent > MAX_GRID_NODE_EXTENT)
+    {
+        m_AlwaysTestedNodes.push_back(pNode);
+        return;
+    }
+
+    UpdateMaxExtent(extent);
+
+    pNode->m_GridCellKey = GetGridCellKey(pNode->m_Properties.GetPosition());
+    pNode->m_bIsInGrid = true;
+    m_GridCells[pNode->m_GridCellKey].push_back(pNode);
+}
+
+void RenderPassNode::RemoveFromGrid(SceneNode* pNode)
+{
+    if (!pNode->m_bIsInGrid)
+    {
+        auto findIter = std::find(m_AlwaysTestedNodes.begin(), m_AlwaysTestedNodes.end(), pNode);
+        if (findIter != m_AlwaysTestedNodes.end())
+        {
+            m_AlwaysTestedNodes.erase(findIter);
+        }
+        return;
+    }
+
+    auto cellIter = m_GridCells.find(pNode->m_GridCellKey);
+    assert(cellIter != m_GridCells.end());
+
+    std::vector<SceneNode*>& cellNodes = cellIter->second;
+    auto findIter = std::find(cellNodes.begin(), cellNodes.end(), pNode);
+    assert(findIter != cellNodes.end());
+    *findIter = cellNodes.back();
+    cellNodes.pop_back();
+
+    if (cellNodes.empty())
+    {
+        m_GridCells.erase(cellIter);
+    }
+
+    pNode->m_bIsInGrid = false;
+}
+
+int32 RenderPassNode::GetNodeExtent(SceneNode* pNode) const
+{
+    if (!pNode->m_pRenderComponent)
+    {
+        return -1;
+    }
+
+    // Invisible actors have empty rect
+    SDL_Rect rect = pNode->m_pRenderComponent->VGetPositionRect();
+    if (rect.w <= 0 || rect.h <= 0)
+    {
+        return -1;
+    }
+
+    const Point& position = pNode->m_Properties.GetPosition();
+    double extentX = max(position.x - rect.x, rect.x + rect.w - position.x);
+    double extentY = max(position.y - rect.y, rect.y + rect.h - position.y);
+
+    return (int32)ceil(max(extentX, extentY));
+}
+
+void RenderPassNode::UpdateMaxExtent(int32 extent)
+{
+    // Node which grew too big after it was put into the grid would make every query huge
+    m_MaxNodeExtent = max(m_MaxNodeExtent, std::min(extent, MAX_GRID_NODE_EXTENT));
+}
+
 //=================================================================================================
 // RootNode Implementation
 //
@@ -160,22 +495,22 @@ RootNode::RootNode() : SceneNode(INVALID_ACTOR_ID, NULL, RenderPass_0, { 0, 0 })
 {
     m_ChildrenList.reserve(RenderPass_Last);
 
-    shared_ptr<SceneNode> backgroundGroup(new SceneNode(INVALID_ACTOR_ID, NULL, RenderPass_Background, { 0, 0 }));
+    shared_ptr<SceneNode> backgroundGroup(new RenderPassNode(RenderPass_Background));
     m_ChildrenList.push_back(backgroundGroup);
 
-    shared_ptr<SceneNode> actionGroup(new SceneNode(INVALID_ACTOR_ID, NULL, RenderPass_Action, { 0, 0 }));
+    shared_ptr<SceneNode> actionGroup(new RenderPassNode(RenderPass_Action));
     m_ChildrenList.push_back(actionGroup);
 
-    shared_ptr<SceneNode> actorGroup(new SceneNode(INVALID_ACTOR_ID, NULL, RenderPass_Actor, { 0, 0 }));
+    shared_ptr<SceneNode> actorGroup(new RenderPassNode(RenderPass_Actor));
     m_ChildrenList.push_back(actorGroup);
 
-    shared_ptr<SceneNode> foregroundGroup(new SceneNode(INVALID_ACTOR_ID, NULL, RenderPass_Foreground, { 0, 0 }));
+    shared_ptr<SceneNode> foregroundGroup(new RenderPassNode(RenderPass_Foreground));
     m_ChildrenList.push_back(foregroundGroup);
 
-    shared_ptr<SceneNode> HUDGroup(new SceneNode(INVALID_ACTOR_ID, NULL, RenderPass_HUD, { 0, 0 }));
+    shared_ptr<SceneNode> HUDGroup(new RenderPassNode(RenderPass_HUD));
     m_ChildrenList.push_back(HUDGroup); 
 
-    shared_ptr<SceneNode> invisibleGroup(new SceneNode(INVALID_ACTOR_ID, NULL, RenderPass_NotRendered, { 0, 0 }));
+    shared_ptr<SceneNode> invisibleGroup(new RenderPassNode(RenderPass_NotRendered));
     m_ChildrenList.push_back(invisibleGroup);
 }
 
@@ -263,7 +598,7 @@ void CameraNode::SetViewPosition(Scene* pScene)
     // If there is a target, make sure target is in the center of the camera
     if (m_pTarget)
     {
-        Point targetPos = m_pTarget->VGetProperties()->GetPosition();
+        Point targetPos = m_pTarget->GetInterpolatedPosition();
         // Center camera
         Point scale = g_pApp->GetScale();
         Point cameraPos = targetPos - Point((m_Width / 2) / scale.x, (m_Height / 2) / scale.y);
@@ -2,6 +2,7 @@
 #define __SCENENODE_H__
 
 #include "../SharedDefines.h"
+#include "../Actor/ActorPool.h"
 
 enum RenderPass
 {
@@ -44,6 +45,8 @@ public:
 
     virtual void SortChildrenByZCoord() = 0;
     virtual int32 GetZCoord() const = 0;
+    // Nodes with the same Z coordinate are grouped by texture so that they can be drawn without switching it
+    virtual SDL_Texture* GetBatchTexture() const = 0;
 };
 
 class SceneNodeProperties
@@ -73,6 +76,8 @@ typedef std::vector <shared_ptr<ISceneNode>> SceneNodeList;
 
 class SceneNode : public ISceneNode
 {
+    friend class RenderPassNode;
+
 public:
     SceneNode(uint32 actorId, BaseRenderComponent* renderComponent, RenderPass renderPass, Point position, int32 zCoord = 0);
     virtual ~SceneNode();
@@ -92,23 +97,103 @@ public:
     virtual bool VRemoveChild(uint32 actorId);
     virtual bool VOnLostDevice(Scene* pScene);
 
-    virtual void VSetPosition(Point& position) { m_Properties.m_Position = position; }
+    virtual void VSetPosition(Point& position);
     Point GetPosition() { return m_Properties.m_Position; }
+    // Position between the last two simulation steps matching the time of rendered frame
+    Point GetInterpolatedPosition() const;
 
     int32 GetOrientation() const { return m_Properties.m_Orientation; }
 
     virtual int32 GetZCoord() const { return m_Properties.m_ZCoord; }
+    virtual SDL_Texture* GetBatchTexture() const { return NULL; }
 
+    // Children are kept ordered by Z coordinate as they are added, full sort additionally groups
+    // children with the same Z coordinate by texture and is meant to be done once after level load
     virtual void SortChildrenByZCoord();
 
+    // Called by child after its position changed
+    virtual void VOnChildMoved(SceneNode* pChild) { }
+    // Called by child after its rect changed without moving, e.g. animation frame of different size
+    virtual void VOnChildResized(SceneNode* pChild) { }
+
+    // Tells parent that rect of this node changed, render component calls it
+    void OnResized();
+
 protected:
     SceneNodeList           m_ChildrenList;
     SceneNode*              m_pParent;
     SceneNodeProperties     m_Properties;
     BaseRenderComponent*    m_pRenderComponent;
+
+    // Where node was before it moved during simulation step m_LastMoveStep
+    Point                   m_PreviousPosition;
+    uint32                  m_LastMoveStep;
+
+    // Bookkeeping of parent RenderPassNode
+    uint32                  m_RenderOrder;
+    uint64                  m_GridCellKey;
+    bool                    m_bIsInGrid;
+    uint32                  m_LastVisibleFrame;
 };
 
-typedef std::map<uint32, shared_ptr<ISceneNode>> SceneActorMap;
+// Nodes are pooled, see ActorPool
+typedef std::map<uint32, shared_ptr<ISceneNode>, std::less<uint32>,
+    ActorPoolAllocator<std::pair<const uint32, shared_ptr<ISceneNode>>>> SceneActorMap;
+
+//=================================================================================================
+// class RenderPassNode
+//
+//     Holds all nodes of one render pass. Nodes are kept in a uniform grid by their position,
+//     rendering looks only into grid cells under the camera and tests visibility of nodes found
+//     there, so its cost depends on what is on screen rather than on how many nodes the level has.
+//     Query area is widened by the largest distance between any node's position and the edge of
+//     its rect seen so far, it is updated whenever a node is added, moves or changes its size. Nodes bigger than a few screens (tile planes, HUD) are tested always.
+//     Visible nodes are drawn by Z coordinate, nodes with the same one in the order they had after
+//     the last full sort, followed by nodes added since then. Children are only appended, so adding
+//     all nodes of a level costs nothing until the one full sort after load. Visible nodes are only
+//     sorted again in frames in which some node became visible or stopped being visible.
+//
+
+class RenderPassNode : public SceneNode
+{
+public:
+    RenderPassNode(RenderPass renderPass);
+    virtual ~RenderPassNode();
+
+    virtual bool VAddChild(shared_ptr<ISceneNode> kid);
+    virtual bool VRemoveChild(uint32 actorId);
+    virtual void VRenderChildren(Scene* pScene);
+    virtual void SortChildrenByZCoord();
+
+    // Moves child to the grid cell of its new position
+    virtual void VOnChildMoved(SceneNode* pChild);
+    // Widens grid queries if child now reaches farther from its position
+    virtual void VOnChildResized(SceneNode* pChild);
+
+    uint32 GetNumChildren() const { return m_ChildrenList.size(); }
+    uint32 GetNumLastVisibilityTests() const { return m_NumLastVisibilityTests; }
+
+private:
+    void AddToGrid(SceneNode* pNode);
+    void RemoveFromGrid(SceneNode* pNode);
+    // Distance from node's position to the farthest edge of its rect, negative if rect is empty
+    int32 GetNodeExtent(SceneNode* pNode) const;
+    void UpdateMaxExtent(int32 extent);
+
+    std::unordered_map<uint64, std::vector<SceneNode*>> m_GridCells;
+    std::vector<SceneNode*> m_AlwaysTestedNodes;
+    int32 m_MaxNodeExtent;
+    uint32 m_NextRenderOrder;
+
+    // Visible nodes of last rendered frame in drawing order, kept until the visible set changes
+    std::vector<SceneNode*> m_VisibleNodes;
+    // Kept to avoid reallocation every frame
+    std::vector<SceneNode*> m_FrameVisibleNodes;
+    uint32 m_RenderFrame;
+    // Render order changed by full sort
+    bool m_bIsVisibleOrderDirty;
+    uint32 m_NumLastVisibilityTests;
+};
 
 class RootNode : public SceneNode
 {
@@ -118,6 +203,8 @@ public:
     virtual void VRenderChildren(Scene* pScene);
     virtual bool VRemoveChild(uint32 actorId);
     virtual bool VIsVisible(Scene* pScene) { return true; }
+
+    RenderPassNode* GetRenderPassNode(RenderPass pass) const { return static_cast<RenderPassNode*>(m_ChildrenList[pass].get()); }
 };
 
 class CameraNode : public SceneNode
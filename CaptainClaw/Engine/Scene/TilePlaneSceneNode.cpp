@@ -1,100 +1,429 @@
+#include <algorithm>
+#include <functional>
 #include <SDL2/SDL.h>
 #include "Scene.h"
 #include "TilePlaneSceneNode.h"
 #include "../Actor/Components/RenderComponent.h"
 #include "../Graphics2D/Image.h"
 #include "../GameApp/BaseGameApp.h"
+#include "../Resource/ResourceCache.h"
+
+// Side of one chunk texture in pixels
+const int32 TILE_CHUNK_SIZE = 512;
+// Chunk textures kept per plane, visible chunks which do not fit are drawn tile by tile
+const uint32 MAX_TILE_CHUNK_TEXTURES = 24;
+// Chunk textures are ARGB8888
+const uint32 TILE_CHUNK_TEXTURE_BYTES = TILE_CHUNK_SIZE * TILE_CHUNK_SIZE * 4;
+// Chunks this close to the view are built ahead, one per frame, while there is room for them
+const int32 TILE_CHUNK_PREFETCH_MARGIN = 256;
+
+// Chunk textures of all planes
+static uint32 s_NumAllChunkTextures = 0;
+
+static void ChunkTextureCreated()
+{
+    s_NumAllChunkTextures++;
+    if (g_pApp && g_pApp->GetResourceCache())
+    {
+        g_pApp->GetResourceCache()->MemoryHasBeenAllocated(0, TILE_CHUNK_TEXTURE_BYTES);
+    }
+}
+
+static void DestroyChunkTexture(SDL_Texture* pTexture)
+{
+    SDL_DestroyTexture(pTexture);
+
+    assert(s_NumAllChunkTextures > 0);
+    s_NumAllChunkTextures--;
+    if (g_pApp && g_pApp->GetResourceCache())
+    {
+        g_pApp->GetResourceCache()->MemoryHasBeenFreed(0, TILE_CHUNK_TEXTURE_BYTES);
+    }
+}
+
+static int32 FloorDiv(int32 value, int32 divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+static int32 PositiveModulo(int32 value, int32 divisor)
+{
+    int32 remainder = value % divisor;
+    return remainder < 0 ? remainder + divisor : remainder;
+}
+
+static int32 GreatestCommonDivisor(int32 a, int32 b)
+{
+    while (b != 0)
+    {
+        int32 remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+
+    return a;
+}
 
 SDL2TilePlaneSceneNode::SDL2TilePlaneSceneNode(const uint32 actorId,
     BaseRenderComponent* pRenderComponent,
     RenderPass renderPass,
     Point position)
-    : SceneNode(actorId, pRenderComponent, renderPass, position)
+    : SceneNode(actorId, pRenderComponent, renderPass, position),
+    m_NumChunkTextures(0),
+    m_FrameIdx(0),
+    m_bChunksUnsupported(false)
 {
 
 }
 
 SDL2TilePlaneSceneNode::~SDL2TilePlaneSceneNode()
 {
+    ReleaseChunks();
+}
 
+bool SDL2TilePlaneSceneNode::VOnLostDevice(Scene* pScene)
+{
+    ReleaseChunks();
+    return SceneNode::VOnLostDevice(pScene);
+}
+
+uint32 SDL2TilePlaneSceneNode::GetNumAllChunkTextures()
+{
+    return s_NumAllChunkTextures;
+}
+
+uint32 SDL2TilePlaneSceneNode::GetAllChunkTexturesSize()
+{
+    return s_NumAllChunkTextures * TILE_CHUNK_TEXTURE_BYTES;
+}
+
+void SDL2TilePlaneSceneNode::ReleaseChunks()
+{
+    for (auto& chunkPair : m_Chunks)
+    {
+        if (chunkPair.second.pTexture)
+        {
+            DestroyChunkTexture(chunkPair.second.pTexture);
+        }
+    }
+
+    m_Chunks.clear();
+    m_NumChunkTextures = 0;
 }
 
 void SDL2TilePlaneSceneNode::VRender(Scene* pScene)
 {
     TilePlaneRenderComponent* pRenderComponent = static_cast<TilePlaneRenderComponent*>(m_pRenderComponent);
-
     const TilePlaneProperties* pProperties = pRenderComponent->GetTilePlaneProperties();
-    const TileImageList* pImageList = pRenderComponent->GetTileImageList();
 
     shared_ptr<CameraNode> camera = pScene->GetCamera();
     SDL_Renderer* renderer = pScene->GetRenderer();
 
-    // Multiple times user variables
-    int32 tilePixelWidth = pProperties->tilePixelWidth;
-    int32 tilePixelHeight = pProperties->tilePixelHeight;
-
-    int32_t renderPadding = 100;
-
-    Point scale = g_pApp->GetScale();
-
     float movementRatioX = pProperties->movementPercentX / 100.0f;
     float movementRatioY = pProperties->movementPercentY / 100.0f;
 
     int32_t parallaxCameraPosX = (int32_t)(camera->GetPosition().x * movementRatioX);
     int32_t parallaxCameraPosY = (int32_t)(camera->GetPosition().y * movementRatioY);
 
-    int32_t startCol = parallaxCameraPosX / tilePixelWidth;
-    int32_t startRow = parallaxCameraPosY / tilePixelHeight;
+    // Part of the plane seen by camera, in plane pixels
+    const SDL_Rect cameraRect = camera->GetCameraRect();
+    const SDL_Rect planeViewRect = { parallaxCameraPosX, parallaxCameraPosY, cameraRect.w, cameraRect.h };
+
+    m_FrameIdx++;
+
+    if (m_bChunksUnsupported)
+    {
+        CollectTiles(planeViewRect, planeViewRect.x, planeViewRect.y);
+        DrawTiles(renderer, false);
+    }
+    else
+    {
+        RenderChunks(renderer, planeViewRect);
+    }
+}
+
+void SDL2TilePlaneSceneNode::RenderChunks(SDL_Renderer* pRenderer, const SDL_Rect& planeViewRect)
+{
+    int32 minChunkX = FloorDiv(planeViewRect.x, TILE_CHUNK_SIZE);
+    int32 maxChunkX = FloorDiv(planeViewRect.x + planeViewRect.w - 1, TILE_CHUNK_SIZE);
+    int32 minChunkY = FloorDiv(planeViewRect.y, TILE_CHUNK_SIZE);
+    int32 maxChunkY = FloorDiv(planeViewRect.y + planeViewRect.h - 1, TILE_CHUNK_SIZE);
+    for (int32 chunkY = minChunkY; chunkY <= maxChunkY; chunkY++)
+    {
+        for (int32 chunkX = minChunkX; chunkX <= maxChunkX; chunkX++)
+        {
+            SDL_Rect chunkRect = { chunkX * TILE_CHUNK_SIZE, chunkY * TILE_CHUNK_SIZE, TILE_CHUNK_SIZE, TILE_CHUNK_SIZE };
+
+            TileChunk* pChunk = GetChunk(pRenderer, chunkX, chunkY);
+            if (!pChunk)
+            {
+                // Nothing is found outside of the plane, chunk which could not be built is drawn tile by tile
+                CollectTiles(chunkRect, planeViewRect.x, planeViewRect.y);
+                DrawTiles(pRenderer, false);
+                continue;
+            }
+
+            pChunk->lastDrawnFrame = m_FrameIdx;
+            if (pChunk->pTexture)
+            {
+                SDL_Rect renderRect = { chunkRect.x - planeViewRect.x, chunkRect.y - planeViewRect.y, TILE_CHUNK_SIZE, TILE_CHUNK_SIZE };
+                SDL_RenderCopy(pRenderer, pChunk->pTexture, NULL, &renderRect);
+            }
+        }
+    }
 
-    int32_t colTilesToRender = (uint32_t)((camera->GetWidth() / tilePixelWidth) / scale.x) +
-        (uint32_t)((renderPadding * 2) / pProperties->tilePixelWidth);
+    if (m_bChunksUnsupported || m_NumChunkTextures >= MAX_TILE_CHUNK_TEXTURES)
+    {
+        return;
+    }
 
-    int32_t rowTilesToRender = (uint32_t)((camera->GetHeight() / tilePixelHeight) / scale.y) +
-        (uint32_t)((renderPadding * 2) / tilePixelHeight);
+    // Build one chunk which camera is approaching
+    for (int32 chunkY = FloorDiv(planeViewRect.y - TILE_CHUNK_PREFETCH_MARGIN, TILE_CHUNK_SIZE);
+        chunkY <= FloorDiv(planeViewRect.y + planeViewRect.h + TILE_CHUNK_PREFETCH_MARGIN, TILE_CHUNK_SIZE); chunkY++)
+    {
+        for (int32 chunkX = FloorDiv(planeViewRect.x - TILE_CHUNK_PREFETCH_MARGIN, TILE_CHUNK_SIZE);
+            chunkX <= FloorDiv(planeViewRect.x + planeViewRect.w + TILE_CHUNK_PREFETCH_MARGIN, TILE_CHUNK_SIZE); chunkX++)
+        {
+            int32 wrappedChunkX = chunkX;
+            int32 wrappedChunkY = chunkY;
+            uint64 chunkKey;
+            if (GetChunkKey(wrappedChunkX, wrappedChunkY, chunkKey) && m_Chunks.find(chunkKey) == m_Chunks.end())
+            {
+                GetChunk(pRenderer, chunkX, chunkY);
+                return;
+            }
+        }
+    }
+}
+
+SDL2TilePlaneSceneNode::TileChunk* SDL2TilePlaneSceneNode::GetChunk(SDL_Renderer* pRenderer, int32 chunkX, int32 chunkY)
+{
+    uint64 chunkKey;
+    if (!GetChunkKey(chunkX, chunkY, chunkKey))
+    {
+        return NULL;
+    }
 
-    // Some planes (Back, Front) repeat themselves, which means they can be rendered
-    // even when out of bounds
-    int32_t maxTileIdxX = pProperties->tilesOnAxisX;
-    int32_t maxTileIdxY = pProperties->tilesOnAxisY;
-    int32_t minTileIdxX = 0;
-    int32_t minTileIdxY = 0;
-    // TODO: Wrap even when when out of bounds on the negative side
+    auto findIter = m_Chunks.find(chunkKey);
+    if (findIter != m_Chunks.end())
+    {
+        return &findIter->second;
+    }
+
+    if (m_bChunksUnsupported)
+    {
+        return NULL;
+    }
+
+    TileChunk chunk = { NULL, m_FrameIdx };
+    if (!BuildChunk(pRenderer, chunkX, chunkY, chunk))
+    {
+        return NULL;
+    }
+
+    return &(m_Chunks[chunkKey] = chunk);
+}
+
+bool SDL2TilePlaneSceneNode::GetChunkKey(int32& chunkX, int32& chunkY, uint64& chunkKey) const
+{
+    const TilePlaneProperties* pProperties = static_cast<TilePlaneRenderComponent*>(m_pRenderComponent)->GetTilePlaneProperties();
+
+    // Wrapped plane looks the same again after a number of chunks which fit whole number of planes
+    int32 planePixelWidth = pProperties->tilesOnAxisX * pProperties->tilePixelWidth;
     if (pProperties->isWrappedX)
     {
-        maxTileIdxX = INT32_MAX;
-        minTileIdxX = 0;
+        chunkX = PositiveModulo(chunkX, planePixelWidth / GreatestCommonDivisor(planePixelWidth, TILE_CHUNK_SIZE));
+    }
+    else if (chunkX < 0 || chunkX * TILE_CHUNK_SIZE >= planePixelWidth)
+    {
+        return false;
     }
+
+    int32 planePixelHeight = pProperties->tilesOnAxisY * pProperties->tilePixelHeight;
     if (pProperties->isWrappedY)
     {
-        maxTileIdxY = INT32_MAX;
-        minTileIdxY = 0;
+        chunkY = PositiveModulo(chunkY, planePixelHeight / GreatestCommonDivisor(planePixelHeight, TILE_CHUNK_SIZE));
+    }
+    else if (chunkY < 0 || chunkY * TILE_CHUNK_SIZE >= planePixelHeight)
+    {
+        return false;
+    }
+
+    chunkKey = ((uint64)(uint32)chunkX << 32) | (uint32)chunkY;
+    return true;
+}
+
+bool SDL2TilePlaneSceneNode::BuildChunk(SDL_Renderer* pRenderer, int32 chunkX, int32 chunkY, TileChunk& chunk)
+{
+    SDL_Rect chunkRect = { chunkX * TILE_CHUNK_SIZE, chunkY * TILE_CHUNK_SIZE, TILE_CHUNK_SIZE, TILE_CHUNK_SIZE };
+    CollectTiles(chunkRect, chunkRect.x, chunkRect.y);
+    if (m_TileDraws.empty())
+    {
+        chunk.pTexture = NULL;
+        return true;
+    }
+
+    SDL_Texture* pTexture = AcquireChunkTexture(pRenderer);
+    if (!pTexture)
+    {
+        return false;
     }
 
-    int32_t row, col;
-    for (row = startRow; row < (startRow + rowTilesToRender); row++)
+    SDL_Texture* pPreviousTarget = SDL_GetRenderTarget(pRenderer);
+    if (SDL_SetRenderTarget(pRenderer, pTexture) != 0)
     {
-        for (col = startCol; col < (startCol + colTilesToRender); col++)
+        LOG_WARNING("Could not render to tile chunk texture: " + std::string(SDL_GetError()) + ", tiles will be drawn one by one");
+        DestroyChunkTexture(pTexture);
+        m_bChunksUnsupported = true;
+        return false;
+    }
+
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(pRenderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(pRenderer, 0, 0, 0, 0);
+    SDL_RenderClear(pRenderer);
+    SDL_SetRenderDrawColor(pRenderer, r, g, b, a);
+
+    // Tiles do not overlap so copying their alpha into the chunk and blending the chunk later
+    // gives the same result as blending tiles directly
+    DrawTiles(pRenderer, true);
+
+    SDL_SetRenderTarget(pRenderer, pPreviousTarget);
+
+    chunk.pTexture = pTexture;
+    m_NumChunkTextures++;
+
+    return true;
+}
+
+SDL_Texture* SDL2TilePlaneSceneNode::AcquireChunkTexture(SDL_Renderer* pRenderer)
+{
+    if (m_NumChunkTextures >= MAX_TILE_CHUNK_TEXTURES)
+    {
+        auto leastRecentIter = m_Chunks.end();
+        for (auto chunkIter = m_Chunks.begin(); chunkIter != m_Chunks.end(); ++chunkIter)
         {
-            // Dont render anything out of bounds
-            if ((col < minTileIdxX) || (col > maxTileIdxX) ||
-                (row < minTileIdxY) || (row > maxTileIdxY))
+            const TileChunk& chunk = chunkIter->second;
+            if (chunk.pTexture && chunk.lastDrawnFrame != m_FrameIdx &&
+                (leastRecentIter == m_Chunks.end() || chunk.lastDrawnFrame < leastRecentIter->second.lastDrawnFrame))
             {
-                continue;
+                leastRecentIter = chunkIter;
             }
+        }
+
+        if (leastRecentIter != m_Chunks.end())
+        {
+            SDL_Texture* pTexture = leastRecentIter->second.pTexture;
+            m_Chunks.erase(leastRecentIter);
+            m_NumChunkTextures--;
+            return pTexture;
+        }
+
+        // All chunks are visible, remaining ones are drawn tile by tile
+        return NULL;
+    }
+
+    SDL_Texture* pTexture = SDL_CreateTexture(pRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, TILE_CHUNK_SIZE, TILE_CHUNK_SIZE);
+    if (!pTexture)
+    {
+        LOG_WARNING("Could not create tile chunk texture: " + std::string(SDL_GetError()) + ", tiles will be drawn one by one");
+        m_bChunksUnsupported = true;
+        return NULL;
+    }
+
+    SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+    ChunkTextureCreated();
+    return pTexture;
+}
+
+void SDL2TilePlaneSceneNode::CollectTiles(const SDL_Rect& planeRect, int32 originX, int32 originY)
+{
+    TilePlaneRenderComponent* pRenderComponent = static_cast<TilePlaneRenderComponent*>(m_pRenderComponent);
 
-            int32_t x = (col - startCol) * tilePixelWidth;
-            int32_t y = (row - startRow) * tilePixelHeight;
-            Image* image = (*pImageList)[(row % pProperties->tilesOnAxisY) * pProperties->tilesOnAxisX + (col % pProperties->tilesOnAxisX)];
+    const TilePlaneProperties* pProperties = pRenderComponent->GetTilePlaneProperties();
+    const TileImageList* pImageList = pRenderComponent->GetTileImageList();
+
+    int32 tilePixelWidth = pProperties->tilePixelWidth;
+    int32 tilePixelHeight = pProperties->tilePixelHeight;
+
+    int32 startCol = FloorDiv(planeRect.x, tilePixelWidth);
+    int32 endCol = FloorDiv(planeRect.x + planeRect.w - 1, tilePixelWidth);
+    int32 startRow = FloorDiv(planeRect.y, tilePixelHeight);
+    int32 endRow = FloorDiv(planeRect.y + planeRect.h - 1, tilePixelHeight);
+
+    m_TileDraws.clear();
+
+    for (int32 row = startRow; row <= endRow; row++)
+    {
+        // Some planes (Back, Front) repeat themselves, which means they can be rendered
+        // even when out of bounds
+        int32 tileRow = row;
+        if (pProperties->isWrappedY)
+        {
+            tileRow = PositiveModulo(row, pProperties->tilesOnAxisY);
+        }
+        else if (row < 0 || row >= pProperties->tilesOnAxisY)
+        {
+            continue;
+        }
+
+        for (int32 col = startCol; col <= endCol; col++)
+        {
+            int32 tileCol = col;
+            if (pProperties->isWrappedX)
+            {
+                tileCol = PositiveModulo(col, pProperties->tilesOnAxisX);
+            }
+            else if (col < 0 || col >= pProperties->tilesOnAxisX)
+            {
+                continue;
+            }
 
+            Image* image = (*pImageList)[tileRow * pProperties->tilesOnAxisX + tileCol];
             if (image && image->GetTexture() != NULL)
             {
-                SDL_Rect tileRect = { x - (parallaxCameraPosX % tilePixelWidth),
-                    y - (parallaxCameraPosY % tilePixelHeight),
+                SDL_Rect tileRect = { col * tilePixelWidth - originX,
+                    row * tilePixelHeight - originY,
                     tilePixelWidth,
                     tilePixelHeight };
 
-                SDL_RenderCopy(renderer, image->GetTexture(), NULL, &tileRect);
+                m_TileDraws.push_back({ image, tileRect });
             }
         }
     }
 }
+
+void SDL2TilePlaneSceneNode::DrawTiles(SDL_Renderer* pRenderer, bool copyAlpha)
+{
+    // Tiles never overlap so they can be drawn in any order - draw them texture by texture
+    // which with atlased tiles means only few texture switches per plane
+    std::stable_sort(m_TileDraws.begin(), m_TileDraws.end(), [](const TileDraw& lhs, const TileDraw& rhs)
+    {
+        return std::less<SDL_Texture*>()(lhs.pImage->GetTexture(), rhs.pImage->GetTexture());
+    });
+
+    SDL_Texture* pCurrentTexture = NULL;
+    SDL_BlendMode currentBlendMode = SDL_BLENDMODE_BLEND;
+    for (const TileDraw& tileDraw : m_TileDraws)
+    {
+        SDL_Texture* pTexture = tileDraw.pImage->GetTexture();
+        if (copyAlpha && pTexture != pCurrentTexture)
+        {
+            if (pCurrentTexture)
+            {
+                SDL_SetTextureBlendMode(pCurrentTexture, currentBlendMode);
+            }
+
+            SDL_GetTextureBlendMode(pTexture, &currentBlendMode);
+            SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_NONE);
+            pCurrentTexture = pTexture;
+        }
+
+        SDL_RenderCopy(pRenderer, pTexture, tileDraw.pImage->GetSourceRect(), &tileDraw.renderRect);
+    }
+
+    if (pCurrentTexture)
+    {
+        SDL_SetTextureBlendMode(pCurrentTexture, currentBlendMode);
+    }
+}
@@ -4,6 +4,20 @@
 #include "../SharedDefines.h"
 #include "../Scene/SceneNodes.h"
 
+//=================================================================================================
+// class SDL2TilePlaneSceneNode
+//
+//     Tile planes do not change, so their tiles are composed into 512x512 chunk textures which
+//     are then drawn instead of individual tiles. Chunks are built when the camera gets close to
+//     them and the least recently drawn ones are reused for new chunks once there are too many.
+//     Each plane keeps at most 24 chunk textures (1 MB each), visible chunks which do not fit are
+//     drawn tile by tile, so a plane never holds more than 24 MB of them. Chunk textures are also
+//     counted against texture budget of the resource cache, so cached images make room for them.
+//     Chunks of wrapped planes repeat with the plane, so wrapping around does not build new ones.
+//     Renderers without render target support draw tiles one by one.
+//
+
+class Image;
 class SDL2TilePlaneSceneNode : public SceneNode
 {
 public:
@@ -16,8 +30,50 @@ public:
 
     // Interface overrides
     virtual void VRender(Scene* pScene);
+    // Contents of chunk textures are lost, they are built again when needed
+    virtual bool VOnLostDevice(Scene* pScene);
+
+    // Chunk textures of all tile planes
+    static uint32 GetNumAllChunkTextures();
+    static uint32 GetAllChunkTexturesSize();
 
 protected:
+    struct TileDraw
+    {
+        Image* pImage;
+        SDL_Rect renderRect;
+    };
+
+    struct TileChunk
+    {
+        // NULL when chunk has no tiles
+        SDL_Texture* pTexture;
+        uint32 lastDrawnFrame;
+    };
+
+    void RenderChunks(SDL_Renderer* pRenderer, const SDL_Rect& planeViewRect);
+
+    // Returns NULL for chunks outside of the plane or when chunk could not be built
+    TileChunk* GetChunk(SDL_Renderer* pRenderer, int32 chunkX, int32 chunkY);
+    // Wraps chunk coordinates of wrapped planes, returns false for chunk outside of the plane
+    bool GetChunkKey(int32& chunkX, int32& chunkY, uint64& chunkKey) const;
+    bool BuildChunk(SDL_Renderer* pRenderer, int32 chunkX, int32 chunkY, TileChunk& chunk);
+    void ReleaseChunks();
+    // Gets texture for a new chunk, reusing the least recently drawn one when there are too many
+    SDL_Texture* AcquireChunkTexture(SDL_Renderer* pRenderer);
+
+    // Collects tiles overlapping rect given in plane pixels, positioned relative to origin
+    void CollectTiles(const SDL_Rect& planeRect, int32 originX, int32 originY);
+    // Draws collected tiles, copyAlpha replaces target pixels instead of blending with them
+    void DrawTiles(SDL_Renderer* pRenderer, bool copyAlpha);
+
+    // Visible tiles of current frame, kept to avoid reallocation every frame
+    std::vector<TileDraw> m_TileDraws;
+
+    std::unordered_map<uint64, TileChunk> m_Chunks;
+    uint32 m_NumChunkTextures;
+    uint32 m_FrameIdx;
+    bool m_bChunksUnsupported;
 };
 
 #endif
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <tinyxml.h>
 #include <Box2D/Box2D.h>
 #include <algorithm>
@@ -90,7 +90,7 @@ void ScreenElementHUD::VOnRender(uint32 msDiff)
         for (int i = 0; i < SCORE_NUMBERS_COUNT; i++)
         {
             SDL_Rect renderRect = { 40 + i * 13, 5, m_ScoreNumbers[i]->GetWidth(), m_ScoreNumbers[i]->GetHeight() };
-            SDL_RenderCopy(m_pRenderer, m_ScoreNumbers[i]->GetTexture(), NULL, &renderRect);
+            SDL_RenderCopy(m_pRenderer, m_ScoreNumbers[i]->GetTexture(), m_ScoreNumbers[i]->GetSourceRect(), &renderRect);
         }
     }
 
@@ -104,7 +104,7 @@ void ScreenElementHUD::VOnRender(uint32 msDiff)
                 2 + m_HealthNumbers[i]->GetOffsetY(),
                 m_HealthNumbers[i]->GetWidth(), 
                 m_HealthNumbers[i]->GetHeight() };
-            SDL_RenderCopy(m_pRenderer, m_HealthNumbers[i]->GetTexture(), NULL, &renderRect);
+            SDL_RenderCopy(m_pRenderer, m_HealthNumbers[i]->GetTexture(), m_HealthNumbers[i]->GetSourceRect(), &renderRect);
         }
     }
 
@@ -118,7 +118,7 @@ void ScreenElementHUD::VOnRender(uint32 msDiff)
                 43 + m_AmmoNumbers[i]->GetOffsetY(), 
                 m_AmmoNumbers[i]->GetWidth(), 
                 m_AmmoNumbers[i]->GetHeight() };
-            SDL_RenderCopy(m_pRenderer, m_AmmoNumbers[i]->GetTexture(), NULL, &renderRect);
+            SDL_RenderCopy(m_pRenderer, m_AmmoNumbers[i]->GetTexture(), m_AmmoNumbers[i]->GetSourceRect(), &renderRect);
         }
     }
 
@@ -132,7 +132,7 @@ void ScreenElementHUD::VOnRender(uint32 msDiff)
                 71 + m_LivesNumbers[i]->GetOffsetY(),
                 m_LivesNumbers[i]->GetWidth(), 
                 m_LivesNumbers[i]->GetHeight() };
-            SDL_RenderCopy(m_pRenderer, m_LivesNumbers[i]->GetTexture(), NULL, &renderRect);
+            SDL_RenderCopy(m_pRenderer, m_LivesNumbers[i]->GetTexture(), m_LivesNumbers[i]->GetSourceRect(), &renderRect);
         }
     }
 
@@ -142,7 +142,7 @@ void ScreenElementHUD::VOnRender(uint32 msDiff)
         for (int i = 0; i < STOPWATCH_NUMBERS_COUNT; i++)
         {
             SDL_Rect renderRect = { 40 + i * 13, 45, m_StopwatchNumbers[i]->GetWidth(), m_StopwatchNumbers[i]->GetHeight() };
-            SDL_RenderCopy(m_pRenderer, m_StopwatchNumbers[i]->GetTexture(), NULL, &renderRect);
+            SDL_RenderCopy(m_pRenderer, m_StopwatchNumbers[i]->GetTexture(), m_StopwatchNumbers[i]->GetSourceRect(), &renderRect);
         }
     }
 
@@ -6,6 +6,7 @@
 #include "../Audio/Audio.h"
 #include "../Resource/Loaders/MidiLoader.h"
 #include "../Resource/Loaders/WavLoader.h"
+#include "../Resource/ResourceCache.h"
 #include "../Util/PrimeSearch.h"
 
 const uint32 g_InvalidGameViewId = 0xFFFFFFFF;
@@ -13,7 +14,9 @@ const uint32 g_InvalidGameViewId = 0xFFFFFFFF;
 HumanView::HumanView(SDL_Renderer* renderer)
     :
     m_bRendering(true),
-    m_bPostponeRenderPresent(false)
+    m_bPostponeRenderPresent(false),
+    m_NumSoundCacheMisses(0),
+    m_SoundCacheMissTime(0)
 {
     m_pProcessMgr = new ProcessMgr();
 
@@ -79,9 +82,6 @@ void HumanView::VOnRender(uint32 msDiff)
         //PROFILE_CPU(".");
         SDL_RenderClear(renderer);
 
-        // Sort screen elements
-        m_ScreenElements.sort(SortBy_SharedPtr_Content<IScreenElement>());
-
         for (shared_ptr<IScreenElement> screenElement : m_ScreenElements)
         {
             
@@ -224,7 +224,10 @@ bool HumanView::VOnEvent(SDL_Event& evt)
 
 void HumanView::VOnLostDevice()
 {
-
+    if (m_pScene)
+    {
+        m_pScene->OnLostDevice();
+    }
 }
 
 bool HumanView::EnterMenu(TiXmlElement* pMenuData)
@@ -249,12 +252,23 @@ bool HumanView::LoadGame(TiXmlElement* pLevelData)
 {
     m_pScene->SortSceneNodesByZCoord();
 
+    m_NumSoundCacheMisses = 0;
+    m_SoundCacheMissTime = 0;
+
     return VLoadGameDelegate(pLevelData);
 }
 
 void HumanView::VPushElement(shared_ptr<IScreenElement> element)
 {
-    m_ScreenElements.push_front(element);
+    // New element goes in front of elements with the same z order
+    SortBy_SharedPtr_Content<IScreenElement> isLess;
+    ScreenElementList::iterator insertIter = m_ScreenElements.begin();
+    while (insertIter != m_ScreenElements.end() && isLess(*insertIter, element))
+    {
+        ++insertIter;
+    }
+
+    m_ScreenElements.insert(insertIter, element);
 }
 
 void HumanView::VRemoveElement(shared_ptr<IScreenElement> element)
@@ -351,12 +365,11 @@ void HumanView::ScoreUpdatedDelegate(IEventDataPtr pEventData)
         {
             if ((pCastEventData->GetOldScore() / 1000000) != (pCastEventData->GetNewScore() / 1000000))
             {
-                shared_ptr<EventData_New_Life> pEvent(new EventData_New_Life(pCastEventData->GetActorId(), 1));
+                shared_ptr<EventData_New_Life> pEvent(MakeEvent<EventData_New_Life>(pCastEventData->GetActorId(), 1));
                 IEventMgr::Get()->VQueueEvent(pEvent);
 
                 // Play new life sound
-                IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-                    new EventData_Request_Play_Sound(SOUND_GAME_EXTRA_LIFE, 100, false)));
+                IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_GAME_EXTRA_LIFE, 100, false));
             }
         }
     }
@@ -492,9 +505,19 @@ void HumanView::RequestPlaySoundDelegate(IEventDataPtr pEventData)
         }
         else // Effect / Speech etc. - WAV
         {
+            Resource soundResource(pCastEventData->GetSoundPath());
+            bool isSoundCached = g_pApp->GetResourceCache()->IsLoaded(&soundResource);
+            uint64 loadStartTicks = SDL_GetPerformanceCounter();
+
             shared_ptr<Mix_Chunk> pSound = WavResourceLoader::LoadAndReturnSound(pCastEventData->GetSoundPath().c_str());
             assert(pSound != nullptr);
 
+            if (!isSoundCached)
+            {
+                m_NumSoundCacheMisses++;
+                m_SoundCacheMissTime += ((SDL_GetPerformanceCounter() - loadStartTicks) * 1000000) / SDL_GetPerformanceFrequency();
+            }
+
             if (!g_pApp->GetAudio()->PlaySound(pSound.get(), pCastEventData->GetVolume(), pCastEventData->GetNumLoops()))
             {
                 IEventMgr::Get()->VQueueEvent(pCastEventData);
@@ -715,8 +738,7 @@ void DeathFadeInOutProcess::VOnUpdate(uint32 msDiff)
         {
             if (m_CurrentTime >= m_StartDelay)
             {
-                IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-                    new EventData_Request_Play_Sound(SOUND_GAME_DEATH_FADE_IN_SOUND, 100, false)));
+                IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_GAME_DEATH_FADE_IN_SOUND, 100, false));
 
                 m_CurrentTime = 0;
                 m_DeathFadeState = DeathFadeState_FadingIn;
@@ -728,8 +750,7 @@ void DeathFadeInOutProcess::VOnUpdate(uint32 msDiff)
         {
             if (m_CurrentTime >= m_FadeInDuration)
             {
-                IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-                    new EventData_Request_Play_Sound(SOUND_GAME_DEATH_FADE_OUT_SOUND, 100, false)));
+                IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_GAME_DEATH_FADE_OUT_SOUND, 100, false));
 
                 g_pApp->GetHumanView()->SetRendering(true);
                 m_CurrentTime = 0;
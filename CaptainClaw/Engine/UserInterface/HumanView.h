@@ -53,6 +53,11 @@ public:
     bool IsRendering() { return m_bRendering; }
     void SetPostponeRenderPresent(bool postpone) { m_bPostponeRenderPresent = postpone; }
 
+    // Sounds which were not prefetched during level load and stalled the frame which played them
+    uint32 GetNumSoundCacheMisses() const { return m_NumSoundCacheMisses; }
+    // In microseconds
+    uint64 GetSoundCacheMissTime() const { return m_SoundCacheMissTime; }
+
 protected:
     virtual bool VLoadGameDelegate(TiXmlElement* levelData) { VPushElement(m_pScene); return true; }
 
@@ -91,11 +96,15 @@ protected:
     shared_ptr<IKeyboardHandler> m_pKeyboardHandler;
     shared_ptr<IPointerHandler> m_pPointerHandler;
 
+    // Sorted by z order when elements are pushed, element changing its z order has to be pushed again
     ScreenElementList m_ScreenElements;
 
     bool m_bRendering;
     bool m_bPostponeRenderPresent;
 
+    uint32 m_NumSoundCacheMisses;
+    uint64 m_SoundCacheMissTime;
+
 private:
     void RegisterAllDelegates();
     void RemoveAllDelegates();
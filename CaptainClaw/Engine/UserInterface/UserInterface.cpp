@@ -257,7 +257,7 @@ static IEventDataPtr XmlElemToGeneratedEvent(TiXmlElement* pElem)
         std::string pageName;
         ParseValueFromXmlElem(&pageName, pElem->FirstChildElement("PageName"));
 
-        pEventData.reset(new EventData_Menu_SwitchPage(pageName));
+        pEventData = MakeEvent<EventData_Menu_SwitchPage>(pageName);
     }
     else if (eventType == "LoadGame")
     {
@@ -267,11 +267,11 @@ static IEventDataPtr XmlElemToGeneratedEvent(TiXmlElement* pElem)
         ParseValueFromXmlElem(&levelNumber, pElem->FirstChildElement("LevelNumber"));
         ParseValueFromXmlElem(&checkpointNumber, pElem->FirstChildElement("CheckpointNumber"));
 
-        pEventData.reset(new EventData_Menu_LoadGame(levelNumber, isNewGame, checkpointNumber));
+        pEventData = MakeEvent<EventData_Menu_LoadGame>(levelNumber, isNewGame, checkpointNumber);
     }
     else if (eventType == "QuitGame")
     {
-        pEventData.reset(new EventData_Quit_Game());
+        pEventData = MakeEvent<EventData_Quit_Game>();
     }
     else if (eventType == "ChangeSoundEnabled")
     {
@@ -280,7 +280,7 @@ static IEventDataPtr XmlElemToGeneratedEvent(TiXmlElement* pElem)
         ParseValueFromXmlElem(&isEnabled, pElem->FirstChildElement("IsEnabled"));
         ParseValueFromXmlElem(&isMusic, pElem->FirstChildElement("IsMusic"));
 
-        pEventData.reset(new EventData_Sound_Enabled_Changed(isEnabled, isMusic));
+        pEventData = MakeEvent<EventData_Sound_Enabled_Changed>(isEnabled, isMusic);
     }
     else if (eventType == "ModifyMenuItemVisibility")
     {
@@ -289,7 +289,7 @@ static IEventDataPtr XmlElemToGeneratedEvent(TiXmlElement* pElem)
         ParseValueFromXmlElem(&menuItemName, pElem->FirstChildElement("MenuItemName"));
         ParseValueFromXmlElem(&isVisible, pElem->FirstChildElement("IsVisible"));
 
-        pEventData.reset(new EventData_Menu_Modifiy_Item_Visibility(menuItemName, isVisible));
+        pEventData = MakeEvent<EventData_Menu_Modifiy_Item_Visibility>(menuItemName, isVisible);
     }
     else if (eventType == "PlaySound")
     {
@@ -302,7 +302,7 @@ static IEventDataPtr XmlElemToGeneratedEvent(TiXmlElement* pElem)
         ParseValueFromXmlElem(&isMusic, pElem->FirstChildElement("IsMusic"));
         ParseValueFromXmlElem(&loops, pElem->FirstChildElement("Loops"));
 
-        pEventData.reset(new EventData_Request_Play_Sound(soundName, volume, isMusic, loops));
+        pEventData = MakeEvent<EventData_Request_Play_Sound>(soundName, volume, isMusic, loops);
     }
     else if (eventType == "ModifyMenuItemState")
     {
@@ -311,7 +311,7 @@ static IEventDataPtr XmlElemToGeneratedEvent(TiXmlElement* pElem)
         ParseValueFromXmlElem(&menuItemName, pElem->FirstChildElement("MenuItemName"));
         ParseValueFromXmlElem(&menuItemState, pElem->FirstChildElement("State"));
 
-        pEventData.reset(new EventData_Menu_Modify_Item_State(menuItemName, menuItemState));
+        pEventData = MakeEvent<EventData_Menu_Modify_Item_State>(menuItemName, menuItemState);
     }
     else if (eventType == "ModifyVolume")
     {
@@ -328,7 +328,7 @@ static IEventDataPtr XmlElemToGeneratedEvent(TiXmlElement* pElem)
             return nullptr;
         }
 
-        pEventData.reset(new EventData_Set_Volume(deltaVolume, true, isMusic));
+        pEventData = MakeEvent<EventData_Set_Volume>(deltaVolume, true, isMusic);
     }
     else
     {
@@ -442,8 +442,7 @@ bool ScreenElementMenu::Initialize(TiXmlElement* pElem)
     g_MenuScale.Set(windowSize.x / m_pBackground->GetWidth(), windowSize.y / m_pBackground->GetHeight());
 
     // Play some music
-    IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-        new EventData_Request_Play_Sound(SOUND_MENU_MENUMUSIC, 100, false, -1)));
+    IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_MENU_MENUMUSIC, 100, false, -1));
 
     return true;
 }
@@ -595,8 +594,7 @@ bool ScreenElementMenuPage::VOnEvent(SDL_Event& evt)
             // HACK:
             if (keyCode == SDL_SCANCODE_ESCAPE)
             {
-                IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-                    new EventData_Request_Play_Sound(SOUND_MENU_SELECT_MENU_ITEM, 100)));
+                IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_MENU_SELECT_MENU_ITEM, 100));
             }
             IEventMgr::Get()->VQueueEvent(m_KeyToEventMap[keyCode]);
         }
@@ -763,8 +761,7 @@ bool ScreenElementMenuPage::MoveToMenuItemIdx(int oldIdx, int idxIncrement, bool
     if (playSound)
     {
         // Play sound
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-            new EventData_Request_Play_Sound(SOUND_MENU_CHANGE_MENU_ITEM, 100)));
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_MENU_CHANGE_MENU_ITEM, 100));
     }
 
     return true;
@@ -1124,8 +1121,7 @@ bool ScreenElementMenuItem::Press()
             IEventMgr::Get()->VQueueEvent(pEvent);
         }
         
-        IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-            new EventData_Request_Play_Sound(SOUND_MENU_SELECT_MENU_ITEM, 100)));
+        IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(SOUND_MENU_SELECT_MENU_ITEM, 100));
 
         return true;
     }
@@ -1,6 +1,11 @@
 #include "Converters.h"
 
-TiXmlElement* WwdToXml(WapWwd* wapWwd)
+const char* GetConvertersBuildStamp()
+{
+    return __DATE__ " " __TIME__;
+}
+
+TiXmlElement* WwdToXml(WapWwd* wapWwd, bool embedTileData)
 {
     PROFILE_CPU("WWD->XML");
     TiXmlDocument xmlDoc;
@@ -40,7 +45,7 @@ TiXmlElement* WwdToXml(WapWwd* wapWwd)
 
     TiXmlElement* tileDescRootElem = new TiXmlElement("TileDescriptions");
     levelProperties->LinkEndChild(tileDescRootElem);
-    int numTileDescriptions = wapWwd->tileDescriptionsCount;
+    int numTileDescriptions = embedTileData ? wapWwd->tileDescriptionsCount : 0;
     for (int tileDescIdx = 0; tileDescIdx < numTileDescriptions; tileDescIdx++)
     {
         WwdTileDescription wwdTileDesc = wapWwd->tileDescriptions[tileDescIdx];
@@ -149,11 +154,18 @@ TiXmlElement* WwdToXml(WapWwd* wapWwd)
         TiXmlElement* tiles = new TiXmlElement("Tiles");
         planeRenderComponentElem->LinkEndChild(tiles);
 
-        uint32 tilesCount = wwdPlane.tilesCount;
-        int32* pTiles = wwdPlane.tiles;
-        for (uint32 tileIdx = 0; tileIdx < tilesCount; ++tileIdx)
+        if (embedTileData)
         {
-            XML_ADD_TEXT_ELEMENT("Tile", ToStr(pTiles[tileIdx]).c_str(), tiles);
+            uint32 tilesCount = wwdPlane.tilesCount;
+            int32* pTiles = wwdPlane.tiles;
+            for (uint32 tileIdx = 0; tileIdx < tilesCount; ++tileIdx)
+            {
+                XML_ADD_TEXT_ELEMENT("Tile", ToStr(pTiles[tileIdx]).c_str(), tiles);
+            }
+        }
+        else
+        {
+            tiles->SetAttribute("LevelPlaneIdx", planeIdx);
         }
 
         if (wwdPlane.properties.flags & WAP_PLANE_FLAG_MAIN_PLANE)
@@ -220,7 +232,12 @@ TiXmlElement* WwdToXml(WapWwd* wapWwd)
         }
         else
         {
-            root->LinkEndChild(WwdObjectToXml(&actorProperties, imagesRootPath));
+            TiXmlElement* pActorElem = WwdObjectToXml(&actorProperties, imagesRootPath);
+            if (pActorElem && (actorProperties.dynamicFlags & WAP_OBJECT_DYNAMIC_FLAG_ALWAYS_ACTIVE))
+            {
+                pActorElem->SetAttribute("AlwaysActive", "true");
+            }
+            root->LinkEndChild(pActorElem);
         }
 
         continue;
@@ -927,11 +927,12 @@ inline TiXmlElement* WwdObjectToXml(WwdObject* wwdObject, std::string& imagesRoo
 // Claw to Xml
 //=====================================================================================================================
 
-inline TiXmlElement* CreateClawActor(WapWwd* pWapWwd)
+inline TiXmlElement* CreateClawActor(int32 spawnX, int32 spawnY)
 {
     TiXmlElement* pClawActor = new TiXmlElement("Actor");
     pClawActor->SetAttribute("Type", "Claw");
     pClawActor->SetAttribute("resource", "created");
+    pClawActor->SetAttribute("AlwaysActive", "true");
 
     /*ActorBodyDef clawBodyDef;
     clawBodyDef.addFootSensor = true;
@@ -945,7 +946,7 @@ inline TiXmlElement* CreateClawActor(WapWwd* pWapWwd)
     clawBodyDef.fixtureType = FixtureType_Controller;
     pClawActor->LinkEndChild(ActorTemplates::CreatePhysicsComponent(&clawBodyDef));*/
 
-    pClawActor->LinkEndChild(CreatePositionComponent(pWapWwd->properties.startX, pWapWwd->properties.startY));
+    pClawActor->LinkEndChild(CreatePositionComponent(spawnX, spawnY));
     //pClawActor->LinkEndChild(CreatePositionComponent(6250, 4350));
     pClawActor->LinkEndChild(CreateCollisionComponent(40, 110));
     pClawActor->LinkEndChild(CreatePhysicsComponent(true, false, true, g_pApp->GetGlobalOptions()->maxJumpHeight, 40, 110, 4.0, 0.0, 0.5));
@@ -980,6 +981,11 @@ inline TiXmlElement* CreateClawActor(WapWwd* pWapWwd)
     return pClawActor;
 }
 
+inline TiXmlElement* CreateClawActor(WapWwd* pWapWwd)
+{
+    return CreateClawActor(pWapWwd->properties.startX, pWapWwd->properties.startY);
+}
+
 //=====================================================================================================================
 // HUD to Xml
 //=====================================================================================================================
@@ -989,6 +995,8 @@ inline TiXmlElement* CreateHUDElement(std::string pathToImages, int animFrameDur
     TiXmlElement* pHUDElement = new TiXmlElement("Actor");
     pHUDElement->SetAttribute("Type", pathToImages.c_str());
     pHUDElement->SetAttribute("resource", "created");
+    // Positioned on screen, not in the level
+    pHUDElement->SetAttribute("AlwaysActive", "true");
 
     pHUDElement->LinkEndChild(CreatePositionComponent(position.x, position.y));
 
@@ -1030,7 +1038,11 @@ inline TiXmlElement* CreateHUDElement(std::string pathToImages, int animFrameDur
     return pHUDElement;
 }
 
-TiXmlElement* WwdToXml(WapWwd* wapWwd);
+// Without embedded tile data tile descriptions are left out and each plane references its tiles
+// by LevelPlaneIdx, level loader then takes them straight from WWD
+TiXmlElement* WwdToXml(WapWwd* wapWwd, bool embedTileData = true);
+// Time Converters.cpp was compiled, part of LevelCache::GetConverterVersion()
+const char* GetConvertersBuildStamp();
 
 
 #endif
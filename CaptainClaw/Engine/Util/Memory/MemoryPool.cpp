@@ -22,9 +22,12 @@
 
 #include "MemoryPool.h"
 #include "../StringUtil.h"
+#include <stdio.h>
 #include <stdlib.h>
 
-const static size_t CHUNK_HEADER_SIZE = (sizeof(unsigned char*));
+// Header holds next pointer, it is padded so data section which follows it stays aligned
+const static size_t CHUNK_HEADER_SIZE = MEMORY_POOL_ALIGNMENT;
+static_assert(CHUNK_HEADER_SIZE >= sizeof(unsigned char*), "Chunk header has to fit next pointer");
 
 MemoryPool::MemoryPool(void)
 {
@@ -45,6 +48,7 @@ bool MemoryPool::Init(unsigned int chunkSize, unsigned int numChunks)
     // fill out our size & number members
     m_chunkSize = chunkSize;
     m_numChunks = numChunks;
+    m_blockSize = (chunkSize + MEMORY_POOL_ALIGNMENT - 1) / MEMORY_POOL_ALIGNMENT * MEMORY_POOL_ALIGNMENT + CHUNK_HEADER_SIZE;
 
     // attempt to grow the memory array
     if (GrowMemoryArray())
@@ -62,7 +66,11 @@ void MemoryPool::Destroy(void)
     unsigned long totalNumChunks = m_numChunks * m_memArraySize;
     unsigned long wastedMem = (totalNumChunks - m_allocPeak) * m_chunkSize;
     str += "Destroying memory pool: [" + GetDebugName() + ":" + ToStr((unsigned long)m_chunkSize) + "] = " + ToStr(m_allocPeak) + "/" + ToStr((unsigned long)totalNumChunks) + " (" + ToStr(wastedMem) + " bytes wasted)\n";
+#ifdef _WIN32
     ::OutputDebugStringA(str.c_str());  // the logger is not initialized during many of the initial memory pool growths, so let's just use the OS version
+#else
+    fputs(str.c_str(), stderr);
+#endif
 #endif
 
     // free all memory
@@ -76,6 +84,11 @@ void MemoryPool::Destroy(void)
     Reset();
 }
 
+size_t MemoryPool::GetReservedBytes(void) const
+{
+    return (size_t)m_memArraySize * m_numChunks * m_blockSize;
+}
+
 void* MemoryPool::Alloc(void)
 {
     // If we're out of memory chunks, grow the pool.  This is very expensive.
@@ -90,12 +103,10 @@ void* MemoryPool::Alloc(void)
             return NULL;  // couldn't allocate anymore memory
     }
 
-#ifdef _DEBUG
     // update allocation reports
     ++m_numAllocs;
     if (m_numAllocs > m_allocPeak)
         m_allocPeak = m_numAllocs;
-#endif
 
     // grab the first chunk from the list and move to the next chunks
     unsigned char* pRet = m_pHead;
@@ -114,11 +125,9 @@ void MemoryPool::Free(void* pMem)
         SetNext(pBlock, m_pHead);
         m_pHead = pBlock;
 
-#ifdef _DEBUG
         // update allocation reports
+        assert(m_numAllocs > 0);
         --m_numAllocs;
-        assert(m_numAllocs >= 0);
-#endif
     }
 }
 
@@ -128,12 +137,11 @@ void MemoryPool::Reset(void)
     m_pHead = NULL;
     m_chunkSize = 0;
     m_numChunks = 0;
+    m_blockSize = 0;
     m_memArraySize = 0;
     m_toAllowResize = true;
-#ifdef _DEBUG
     m_allocPeak = 0;
     m_numAllocs = 0;
-#endif
 }
 
 bool MemoryPool::GrowMemoryArray(void)
@@ -191,10 +199,10 @@ bool MemoryPool::GrowMemoryArray(void)
 unsigned char* MemoryPool::AllocateNewMemoryBlock(void)
 {
     // calculate the size of each block and the size of the actual memory allocation
-    size_t blockSize = m_chunkSize + CHUNK_HEADER_SIZE;  // chunk + linked list overhead
+    size_t blockSize = m_blockSize;  // aligned chunk + linked list overhead
     size_t trueSize = blockSize * m_numChunks;
 
-    // allocate the memory
+    // allocate the memory, malloc() aligns it to MEMORY_POOL_ALIGNMENT
     unsigned char* pNewMem = (unsigned char*)malloc(trueSize);
     if (!pNewMem)
         return NULL;
@@ -23,16 +23,19 @@
 
 //--------------------------------------------------------------------------------------------------
 // This class represents a single memory pool.  A memory pool is pool of memory that's split into 
-// chunks of equal size, each with a 4-byte header.  The header is treated as a pointer that points
+// chunks of equal size, each with a header of MEMORY_POOL_ALIGNMENT bytes.  The header is treated as a pointer that points
 // to the next chunk, making the pool a singly-linked list of memory chunks.
 // 
 // When the pool is first initialized (via the Init() function), you must pass in a chunk size and
 // the number of chunks you want created.  These two values are immutable unless you destroy and
 // reinitialize the entire pool.  The chunk size is the size of each chunk, minus the header, in 
 // bytes.  The memory pool will allocate the appropriate amount of memory and set up the data
-// structure in the Init() call.  Thus, total memory usage will be N * (S + 4) + O, where N is the
-// number of chunks, S is the size of each chunk, and O is the overhead for the class (currently 
-// 18 + (number of reallocations * 4).
+// structure in the Init() call.  Thus, total memory usage will be N * (S + A) + O, where N is the
+// number of chunks, S is the size of each chunk rounded up to A, A is MEMORY_POOL_ALIGNMENT and O
+// is the overhead for the class (currently 18 + (number of reallocations * 4).
+//
+// Header and chunk stride are multiples of MEMORY_POOL_ALIGNMENT, so every chunk is aligned for
+// any fundamental type, doubles included, on 32 bit targets where pointers are 4 bytes too.
 // 
 // Call the Alloc() function to retrieve a chunk from the memory pool.  The Alloc() function removes
 // the head of the linked list, sets the new head to the next chunk, and returns a pointer to the 
@@ -45,20 +48,27 @@
 // will cause the chunk to the inserted to the front of the list, ready for the next bit.
 //--------------------------------------------------------------------------------------------------
 
+#include <cstddef>
 #include "../../SharedDefines.h"
 
+// Alignment of every chunk returned by Alloc(), same as malloc() guarantees
+const size_t MEMORY_POOL_ALIGNMENT = alignof(std::max_align_t);
+
 class MemoryPool
 {
     unsigned char** m_ppRawMemoryArray;  // an array of memory blocks, each split up into chunks and connected
     unsigned char* m_pHead;  // the front of the memory chunk linked list
     unsigned int m_chunkSize, m_numChunks;  // the size of each chunk and number of chunks per array, respectively
+    size_t m_blockSize;  // chunk size rounded up to MEMORY_POOL_ALIGNMENT plus header, distance between chunks
     unsigned int m_memArraySize;  // the number elements in the memory array
     bool m_toAllowResize;  // true if we resize the memory pool when it fills up
 
+    // allocation counters, kept in release builds too so pooled allocations can be verified in game
+    unsigned long m_allocPeak, m_numAllocs;
+
     // tracking variables we only care about for debug
 #ifdef _DEBUG
     std::string m_debugName;
-    unsigned long m_allocPeak, m_numAllocs;
 #endif
 
 public:
@@ -73,6 +83,12 @@ public:
     void Free(void* pMem);
     unsigned int GetChunkSize(void) const { return m_chunkSize; }
 
+    // statistics
+    unsigned long GetNumAllocs(void) const { return m_numAllocs; }
+    unsigned long GetAllocPeak(void) const { return m_allocPeak; }
+    unsigned int GetNumMemoryArrays(void) const { return m_memArraySize; }  // each one is a heap allocation of numChunks chunks
+    size_t GetReservedBytes(void) const;
+
     // settings
     void SetAllowResize(bool toAllowResize) { m_toAllowResize = toAllowResize; }
 
@@ -16,6 +16,11 @@
 
 namespace Util
 {
+    const char* GetBuildStamp()
+    {
+        return __DATE__ " " __TIME__;
+    }
+
     void SplitStringIntoVector(std::string str, std::vector<std::string>& vec)
     {
         std::stringstream ss(str);
@@ -376,8 +381,7 @@ namespace Util
         if (!sounds.empty())
         {
             int soundIdx = Util::GetRandomNumber(0, sounds.size() - 1);
-            IEventMgr::Get()->VTriggerEvent(IEventDataPtr(
-                new EventData_Request_Play_Sound(sounds[soundIdx].c_str(), volume, false)));
+            IEventMgr::Get()->VTriggerEvent(MakeEvent<EventData_Request_Play_Sound>(sounds[soundIdx].c_str(), volume, false));
         }
     }
 
@@ -19,6 +19,8 @@ namespace Util
     SDL_Rect WwdRectToSDLRect(WwdRect& rect);
 
     void ParseCollisionRectanglesFromTile(TileCollisionPrototype* tilePrototype, TileDescription* tileDesc);
+    // Time Util.cpp was compiled, part of LevelCache::GetConverterVersion()
+    const char* GetBuildStamp();
 
     void SplitStringIntoVector(std::string str, std::vector<std::string>& vec);
 
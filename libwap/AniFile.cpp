@@ -1,4 +1,5 @@
 #include <fstream>
+#include <vector>
 #include <stdint.h>
 #include <string.h>
 #include <string.h>
@@ -8,7 +9,7 @@
 #include "IO.h"
 #include "Util.h"
 
-WapAni* WAP_AniLoadFromDataImpl(char* data, size_t size)
+WapAni* WAP_AniLoadFromDataImpl(const char* data, size_t size)
 {
     uint32_t i;
     WapAni* wapAni = NULL;
@@ -80,7 +81,7 @@ WapAni* WAP_AniLoadFromDataImpl(char* data, size_t size)
     return wapAni;
 }
 
-WapAni* WAP_AniLoadFromData(char* data, size_t size)
+WapAni* WAP_AniLoadFromData(const char* data, size_t size)
 {
     try
     {
@@ -118,13 +119,14 @@ WapAni* WAP_AniLoadFromRezFile(RezFile* rezFile)
         return NULL;
     }
 
-    char* data = WAP_GetRezFileData(rezFile);
-    if (data == NULL)
+    // Read into our own buffer so that loading does not touch libwap's shared file data
+    std::vector<char> aniFileContents(rezFile->size);
+    if (WAP_ReadRezFileInto(rezFile, aniFileContents.data()) < 0)
     {
         return NULL;
     }
 
-    return WAP_AniLoadFromData(data, rezFile->size);
+    return WAP_AniLoadFromData(aniFileContents.data(), rezFile->size);
 }
 
 WapAni* WAP_AniLoadFromRezArchive(RezArchive* rezArchive, const char* aniFilePath)
@@ -1,10 +1,11 @@
 #include <fstream>
+#include <vector>
 #include <stdint.h>
 
 #include "libwap.h"
 #include "IO.h"
 
-WapPal* WAP_PalLoadFromData(char* data, size_t size)
+WapPal* WAP_PalLoadFromData(const char* data, size_t size)
 {
     uint32_t i;
     WapPal* wapPal = NULL;
@@ -65,13 +66,14 @@ WapPal* WAP_PalLoadFromRezFile(RezFile* rezFile)
         return NULL;
     }
 
-    char* data = WAP_GetRezFileData(rezFile);
-    if (data == NULL)
+    // Read into our own buffer so that loading does not touch libwap's shared file data
+    std::vector<char> palFileContents(rezFile->size);
+    if (WAP_ReadRezFileInto(rezFile, palFileContents.data()) < 0)
     {
         return NULL;
     }
 
-    return WAP_PalLoadFromData(data, rezFile->size);
+    return WAP_PalLoadFromData(palFileContents.data(), rezFile->size);
 }
 
 WapPal* WAP_PalLoadFromRezArchive(RezArchive* rezArchive, const char* palRezPath)
@@ -1,13 +1,23 @@
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <vector>
 #include <stdint.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define WAP_PID_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define WAP_PID_USE_NEON
+#endif
+
 #include "libwap.h"
 #include "IO.h"
 
 #include <iostream>
 using namespace std;
-WapPid* WAP_PidLoadFromData(char* data, size_t size, WapPal* palette)
+WapPid* WAP_PidLoadFromData(const char* data, size_t size, WapPal* palette)
 {
     uint32_t x, y;
     uint8_t byte;
@@ -44,8 +54,8 @@ WapPid* WAP_PidLoadFromData(char* data, size_t size, WapPal* palette)
     if (wapPid->flags & WAP_PID_FLAG_EMBEDDED_PALETTE)
     {
         uint32_t paletteOffset = size - WAP_PALETTE_SIZE_BYTES;
-        char* paletteData = &(data[paletteOffset]);
-        imagePalette = WAP_PalLoadFromData(paletteData, paletteOffset);
+        const char* paletteData = &(data[paletteOffset]);
+        imagePalette = WAP_PalLoadFromData(paletteData, WAP_PALETTE_SIZE_BYTES);
     }
     else
     {
@@ -55,6 +65,7 @@ WapPid* WAP_PidLoadFromData(char* data, size_t size, WapPal* palette)
     // Make sure we have loaded a palette
     if (imagePalette == NULL)
     {
+        delete wapPid;
         return NULL;
     }
 
@@ -172,6 +183,266 @@ WapPid* WAP_PidLoadFromData(char* data, size_t size, WapPal* palette)
     return wapPid;
 }
 
+//=================================================================================================
+// Direct PID decoding
+//
+//     Decodes RLE runs straight into caller's pitch-aligned buffer. Palette is turned into 256
+//     packed colors once per image so that every pixel is a single table load and store, input
+//     is bounds checked once per run instead of once per byte and long runs of the same color
+//     are filled 4 pixels at a time.
+//
+
+// Shorter runs are not worth setting up a vector register
+static const uint32_t PID_MIN_SIMD_RUN_LENGTH = 8;
+
+static inline uint32_t PackColor(const WAP_ColorRGBA& color)
+{
+    uint32_t packedColor;
+    memcpy(&packedColor, &color, sizeof(packedColor));
+    return packedColor;
+}
+
+static inline void FillPixels(uint32_t* pixels, uint32_t color, uint32_t count)
+{
+#if defined(WAP_PID_USE_SSE2)
+    if (count >= PID_MIN_SIMD_RUN_LENGTH)
+    {
+        __m128i colors = _mm_set1_epi32((int)color);
+        for (; count >= 4; count -= 4, pixels += 4)
+        {
+            _mm_storeu_si128((__m128i*)pixels, colors);
+        }
+    }
+#elif defined(WAP_PID_USE_NEON)
+    if (count >= PID_MIN_SIMD_RUN_LENGTH)
+    {
+        uint32x4_t colors = vdupq_n_u32(color);
+        for (; count >= 4; count -= 4, pixels += 4)
+        {
+            vst1q_u32(pixels, colors);
+        }
+    }
+#endif
+
+    for (; count > 0; count--)
+    {
+        *pixels++ = color;
+    }
+}
+
+// Keeps track of current position within output image, runs can span multiple rows
+struct PidPixelWriter
+{
+    PidPixelWriter(uint32_t* pixels, uint32_t pitch, uint32_t width, uint32_t height)
+        :
+        row(pixels),
+        rowPitch(pitch / sizeof(uint32_t)),
+        x(0),
+        width(width),
+        numRemainingRows(height)
+    { }
+
+    bool IsDone() const { return numRemainingRows == 0; }
+
+    uint32_t GetNumRemainingPixels() const
+    {
+        return (numRemainingRows == 0) ? 0 : ((numRemainingRows * width) - x);
+    }
+
+    void Fill(uint32_t color, uint32_t count)
+    {
+        while ((count > 0) && !IsDone())
+        {
+            uint32_t rowCount = std::min(count, width - x);
+            FillPixels(row + x, color, rowCount);
+            Advance(rowCount);
+            count -= rowCount;
+        }
+    }
+
+    void Copy(const uint8_t* indices, const uint32_t* colorTable, uint32_t count)
+    {
+        while ((count > 0) && !IsDone())
+        {
+            uint32_t rowCount = std::min(count, width - x);
+            uint32_t* rowPixels = row + x;
+            for (uint32_t i = 0; i < rowCount; i++)
+            {
+                rowPixels[i] = colorTable[indices[i]];
+            }
+            Advance(rowCount);
+            indices += rowCount;
+            count -= rowCount;
+        }
+    }
+
+private:
+    void Advance(uint32_t count)
+    {
+        x += count;
+        if (x == width)
+        {
+            x = 0;
+            row += rowPitch;
+            numRemainingRows--;
+        }
+    }
+
+    uint32_t* row;
+    uint32_t rowPitch;
+    uint32_t x;
+    uint32_t width;
+    uint32_t numRemainingRows;
+};
+
+static bool DecodeCompressedPid(const uint8_t* data, const uint8_t* dataEnd, const uint32_t* colorTable, PidPixelWriter& writer)
+{
+    static const WAP_ColorRGBA transparentColor = { 0, 0, 0, 1 };
+    const uint32_t transparentPackedColor = PackColor(transparentColor);
+
+    while (!writer.IsDone())
+    {
+        if (data >= dataEnd)
+        {
+            return false;
+        }
+
+        uint8_t byte = *data++;
+        if (byte > 128)
+        {
+            writer.Fill(transparentPackedColor, byte - 128);
+        }
+        else
+        {
+            // Indices past the end of image are never read
+            uint32_t count = std::min((uint32_t)byte, writer.GetNumRemainingPixels());
+            if ((uint32_t)(dataEnd - data) < count)
+            {
+                return false;
+            }
+
+            writer.Copy(data, colorTable, count);
+            data += count;
+        }
+    }
+
+    return true;
+}
+
+static bool DecodeUncompressedPid(const uint8_t* data, const uint8_t* dataEnd, const uint32_t* colorTable, PidPixelWriter& writer)
+{
+    while (!writer.IsDone())
+    {
+        if (data >= dataEnd)
+        {
+            return false;
+        }
+
+        uint32_t count = 1;
+        uint8_t byte = *data++;
+
+        // e.g. if byte = 220, then 220-192=28 same pixels are next to each other
+        if (byte > 192)
+        {
+            if (data >= dataEnd)
+            {
+                return false;
+            }
+
+            count = byte - 192;
+            byte = *data++;
+        }
+
+        writer.Fill(colorTable[byte], count);
+    }
+
+    return true;
+}
+
+int32_t WAP_PidLoadHeaderFromData(const char* data, size_t size, WapPid* wapPid)
+{
+    if ((data == NULL) || (size == 0) || (wapPid == NULL))
+    {
+        return -1;
+    }
+
+    (*wapPid) = { 0 };
+
+    try
+    {
+        InputStream pidFileStream(data, size);
+        pidFileStream.read(wapPid->fileDesc,
+            wapPid->flags,
+            wapPid->width,
+            wapPid->height,
+            wapPid->offsetX,
+            wapPid->offsetY,
+            wapPid->unk0,
+            wapPid->unk1);
+    }
+    catch (...)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t WAP_PidDecodeFromData(const char* data, size_t size, WapPal* palette, uint32_t* pixels, uint32_t pitch)
+{
+    WapPid header;
+    if (WAP_PidLoadHeaderFromData(data, size, &header) < 0)
+    {
+        return -1;
+    }
+
+    if ((pixels == NULL) || (pitch % sizeof(uint32_t) != 0) || (pitch < header.width * sizeof(uint32_t)))
+    {
+        return -1;
+    }
+
+    const uint8_t* pixelData = (const uint8_t*)data + 8 * sizeof(uint32_t);
+    const uint8_t* pixelDataEnd = (const uint8_t*)data + size;
+
+    uint32_t colorTable[256];
+    if (header.flags & WAP_PID_FLAG_EMBEDDED_PALETTE)
+    {
+        if (size < 8 * sizeof(uint32_t) + WAP_PALETTE_SIZE_BYTES)
+        {
+            return -1;
+        }
+
+        WapPal* embeddedPalette = WAP_PalLoadFromData(data + size - WAP_PALETTE_SIZE_BYTES, WAP_PALETTE_SIZE_BYTES);
+        if (embeddedPalette == NULL)
+        {
+            return -1;
+        }
+
+        memcpy(colorTable, embeddedPalette->colors, sizeof(colorTable));
+        WAP_PalDestroy(embeddedPalette);
+    }
+    else if (palette != NULL)
+    {
+        memcpy(colorTable, palette->colors, sizeof(colorTable));
+    }
+    else
+    {
+        return -1;
+    }
+
+    if ((header.width == 0) || (header.height == 0))
+    {
+        return 0;
+    }
+
+    PidPixelWriter writer(pixels, pitch, header.width, header.height);
+    bool decoded = (header.flags & WAP_PID_FLAG_COMPRESSION) ?
+        DecodeCompressedPid(pixelData, pixelDataEnd, colorTable, writer) :
+        DecodeUncompressedPid(pixelData, pixelDataEnd, colorTable, writer);
+
+    return decoded ? 0 : -1;
+}
+
 WapPid* WAP_PidLoadFromFile(const char* pidFilePath, WapPal* palette)
 {
     std::ifstream pidFileStream(pidFilePath, std::ios::binary);
@@ -198,13 +469,14 @@ WapPid* WAP_PidLoadFromRezFile(RezFile* rezFile, WapPal* palette)
         return NULL;
     }
 
-    char* data = WAP_GetRezFileData(rezFile);
-    if (data == NULL)
+    // Read into our own buffer so that loading does not touch libwap's shared file data
+    std::vector<char> pidFileContents(rezFile->size);
+    if (WAP_ReadRezFileInto(rezFile, pidFileContents.data()) < 0)
     {
         return NULL;
     }
 
-    return WAP_PidLoadFromData(data, rezFile->size, palette);
+    return WAP_PidLoadFromData(pidFileContents.data(), rezFile->size, palette);
 }
 
 WapPid* WAP_PidLoadFromRezArchive(RezArchive* rezArchive, const char* pidRezPath, WapPal* palette)
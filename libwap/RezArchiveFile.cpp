@@ -8,32 +8,57 @@
 #include <string>
 #include <string.h>
 #include <cctype>
+#include <errno.h>
 
 #include "libwap.h"
 #include <iostream>
 
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using namespace std;
 
 /*************************************************************************/
 /**************************** PRIVATE STRUCTURES *************************/
 /*************************************************************************/
 
+typedef std::vector<RezFile*> RezFileVec;
+
+// Everything needed to read from REZ archive, owned by RezArchive itself so that
+// reading does not have to touch any global state
 struct RezArchiveFileEntry
 {
-    RezArchive* rezArchive;
-    std::ifstream* fileStream;
-    std::mutex mutex;
+    // Native file used for positional reads which do not share any file cursor between threads
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+    // Whole REZ archive mapped into memory, NULL if mapping failed
+    const char* mappedData;
+    size_t mappedSize;
+
+    // All REZ files within archive, used for index based access
+    RezFileVec rezFiles;
 };
 
 /*************************************************************************/
 /******************** PRIVATE DATA GLOBAL VARIABLES **********************/
 /*************************************************************************/
 
-typedef std::vector<RezFile*> RezFileVec;
-
-static std::map<RezArchive*, RezArchiveFileEntry*> g_rezArchiveFileEntryMap;
+// Buffers handed out by WAP_GetRezFileData
 static std::map<RezFile*, char*> g_rezFileDataMap;
-static std::map<RezArchive*, RezFileVec*> g_rezArchiveFilesMap;
+static std::mutex g_rezFileDataMutex;
 
 uint8_t directorySeparator = '/';
 
@@ -109,42 +134,100 @@ void ToLower(char* string)
 /************************** API IMPLEMENTATIONS **************************/
 /*************************************************************************/
 
-char* WAP_GetRezFileData(RezFile* rezFile)
+int32_t WAP_ReadRezFileInto(RezFile* rezFile, char* buffer)
 {
     // Check if we got valid input
-    if ((rezFile == NULL) || (rezFile->owner == NULL))
+    if ((rezFile == NULL) || (rezFile->owner == NULL) || (rezFile->owner->fileEntry == NULL) ||
+        ((buffer == NULL) && (rezFile->size > 0)))
     {
-        return NULL;
+        return -1;
     }
 
-    // Check if we already accessed this file
-    if (g_rezFileDataMap.count(rezFile) != 0)
+    RezArchiveFileEntry* rezArchiveFileEntry = rezFile->owner->fileEntry;
+
+    // Mapped archive is just a copy
+    if (rezArchiveFileEntry->mappedData != NULL)
     {
-        return g_rezFileDataMap[rezFile];
+        if ((size_t)rezFile->offset + rezFile->size > rezArchiveFileEntry->mappedSize)
+        {
+            return -1;
+        }
+
+        memcpy(buffer, rezArchiveFileEntry->mappedData + rezFile->offset, rezFile->size);
+        return (int32_t)rezFile->size;
     }
-    else
+
+    // Otherwise read at file's offset, positional reads can run from any number of threads at once
+    uint32_t totalBytesRead = 0;
+    while (totalBytesRead < rezFile->size)
     {
-        // First time accessing it, we have to allocate it and load it
+        uint64_t offset = (uint64_t)rezFile->offset + totalBytesRead;
+        uint32_t bytesToRead = rezFile->size - totalBytesRead;
+#ifdef _WIN32
+        OVERLAPPED overlapped = { 0 };
+        overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
 
-        // Check if there is REZ archive entry
-        if (g_rezArchiveFileEntryMap.count(rezFile->owner) == 0)
+        DWORD bytesRead = 0;
+        if (!ReadFile(rezArchiveFileEntry->fileHandle, buffer + totalBytesRead, bytesToRead, &bytesRead, &overlapped) ||
+            (bytesRead == 0))
         {
-            return NULL;
+            return -1;
+        }
+#else
+        ssize_t bytesRead = pread(rezArchiveFileEntry->fileDescriptor, buffer + totalBytesRead, bytesToRead, (off_t)offset);
+        if (bytesRead < 0 && errno == EINTR)
+        {
+            continue;
         }
+        if (bytesRead <= 0)
+        {
+            return -1;
+        }
+#endif
+        totalBytesRead += (uint32_t)bytesRead;
+    }
+
+    return (int32_t)totalBytesRead;
+}
+
+char* WAP_GetRezFileData(RezFile* rezFile)
+{
+    // Check if we got valid input
+    if ((rezFile == NULL) || (rezFile->owner == NULL))
+    {
+        return NULL;
+    }
 
-        // Create new entry for rez file and allocate its data buffer
-        g_rezFileDataMap.insert(std::pair<RezFile*, char*>(rezFile, new char[rezFile->size]));
+    // Check if we already accessed this file
+    {
+        std::lock_guard<std::mutex> lock(g_rezFileDataMutex);
+        auto findIt = g_rezFileDataMap.find(rezFile);
+        if (findIt != g_rezFileDataMap.end())
+        {
+            return findIt->second;
+        }
+    }
 
-        RezArchiveFileEntry* rezArchiveFileEntry = g_rezArchiveFileEntryMap[rezFile->owner];
+    // First time accessing it, we have to allocate it and load it. This is done
+    // outside of the lock so that different files can be loaded in parallel
+    char* data = new char[rezFile->size];
+    if (WAP_ReadRezFileInto(rezFile, data) < 0)
+    {
+        delete[] data;
+        return NULL;
+    }
 
-        std::lock_guard<std::mutex> lock(rezArchiveFileEntry->mutex);
+    std::lock_guard<std::mutex> lock(g_rezFileDataMutex);
 
-        // Seek to file's offset within REZ file and load it
-        rezArchiveFileEntry->fileStream->seekg(rezFile->offset, std::ios::beg);
-        rezArchiveFileEntry->fileStream->read(g_rezFileDataMap[rezFile], rezFile->size);
+    // Some other thread could have loaded the same file in the meantime
+    auto insertResult = g_rezFileDataMap.insert(std::make_pair(rezFile, data));
+    if (!insertResult.second)
+    {
+        delete[] data;
     }
 
-    return g_rezFileDataMap[rezFile];
+    return insertResult.first->second;
 }
 
 void WAP_FreeFileData(RezFile* rezFile)
@@ -155,16 +238,36 @@ void WAP_FreeFileData(RezFile* rezFile)
         return;
     }
 
+    std::lock_guard<std::mutex> lock(g_rezFileDataMutex);
+
     // Check if file data for this REZ file are loaded
-    if (g_rezFileDataMap.count(rezFile) == 0)
+    auto findIt = g_rezFileDataMap.find(rezFile);
+    if (findIt == g_rezFileDataMap.end())
     {
         // Nothing to do
         return;
     }
 
-    delete[] g_rezFileDataMap[rezFile];
-    g_rezFileDataMap[rezFile] = NULL;
-    g_rezFileDataMap.erase(rezFile);
+    delete[] findIt->second;
+    g_rezFileDataMap.erase(findIt);
+}
+
+const char* WAP_GetRezFileDataView(RezFile* rezFile)
+{
+    // Check if we got valid input
+    if ((rezFile == NULL) || (rezFile->owner == NULL) || (rezFile->owner->fileEntry == NULL))
+    {
+        return NULL;
+    }
+
+    RezArchiveFileEntry* rezArchiveFileEntry = rezFile->owner->fileEntry;
+    if ((rezArchiveFileEntry->mappedData == NULL) ||
+        ((size_t)rezFile->offset + rezFile->size > rezArchiveFileEntry->mappedSize))
+    {
+        return NULL;
+    }
+
+    return rezArchiveFileEntry->mappedData + rezFile->offset;
 }
 
 static RezFile* GetChildFile(RezDirectory* rezFileDirectory, std::string fileName)
@@ -335,28 +438,96 @@ RezFile* WAP_GetRezFileFromRezDirectory(RezDirectory* rezDirectory, const char*
     return GetChildFile(searchedFileDirectory, fullFileName);
 }
 
-static void RegisterRezArchiveFile(RezArchive* rezArchive, std::ifstream* rezArchiveFileStream)
+static RezArchiveFileEntry* OpenRezArchiveFile(const char* rezFilePath)
 {
-    // Create loaded REZ file entry
     RezArchiveFileEntry* rezArchiveFileEntry = new RezArchiveFileEntry;
-    rezArchiveFileEntry->rezArchive = rezArchive;
-    rezArchiveFileEntry->fileStream = rezArchiveFileStream;
+    rezArchiveFileEntry->mappedData = NULL;
+    rezArchiveFileEntry->mappedSize = 0;
 
-    g_rezArchiveFileEntryMap.insert(std::pair<RezArchive*, RezArchiveFileEntry*>(rezArchive, rezArchiveFileEntry));
+    // Mapping is read-only, views into it are shared by every load of a resource so nothing may
+    // write to them. File itself stays open so that reads can fall back to positional reads when
+    // mapping is not possible.
+#ifdef _WIN32
+    rezArchiveFileEntry->mappingHandle = NULL;
+    rezArchiveFileEntry->fileHandle = CreateFileA(rezFilePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (rezArchiveFileEntry->fileHandle == INVALID_HANDLE_VALUE)
+    {
+        delete rezArchiveFileEntry;
+        return NULL;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(rezArchiveFileEntry->fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        return rezArchiveFileEntry;
+    }
+
+    HANDLE mappingHandle = CreateFileMappingA(rezArchiveFileEntry->fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mappingHandle == NULL)
+    {
+        return rezArchiveFileEntry;
+    }
+
+    void* mappedData = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (mappedData == NULL)
+    {
+        CloseHandle(mappingHandle);
+        return rezArchiveFileEntry;
+    }
+
+    rezArchiveFileEntry->mappingHandle = mappingHandle;
+    rezArchiveFileEntry->mappedData = (const char*)mappedData;
+    rezArchiveFileEntry->mappedSize = (size_t)fileSize.QuadPart;
+#else
+    rezArchiveFileEntry->fileDescriptor = open(rezFilePath, O_RDONLY);
+    if (rezArchiveFileEntry->fileDescriptor < 0)
+    {
+        delete rezArchiveFileEntry;
+        return NULL;
+    }
+
+    struct stat fileStat;
+    if (fstat(rezArchiveFileEntry->fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        return rezArchiveFileEntry;
+    }
+
+    void* mappedData = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, rezArchiveFileEntry->fileDescriptor, 0);
+    if (mappedData == MAP_FAILED)
+    {
+        return rezArchiveFileEntry;
+    }
+
+    rezArchiveFileEntry->mappedData = (const char*)mappedData;
+    rezArchiveFileEntry->mappedSize = (size_t)fileStat.st_size;
+#endif
+
+    return rezArchiveFileEntry;
 }
 
-static void UnregisterRezArchiveFile(RezArchive* rezArchive)
+static void CloseRezArchiveFile(RezArchiveFileEntry* rezArchiveFileEntry)
 {
-    // First check if there is given rez archive registered
-    if (g_rezArchiveFileEntryMap.count(rezArchive) != 0)
+    if (rezArchiveFileEntry == NULL)
     {
-        // Unregister loaded REZ file entry
-        RezArchiveFileEntry* rezArchiveFileEntry = g_rezArchiveFileEntryMap[rezArchive];
-        delete rezArchiveFileEntry->fileStream;
-        delete rezArchiveFileEntry;
-        rezArchiveFileEntry = NULL;
-        g_rezArchiveFileEntryMap.erase(rezArchive);
+        return;
+    }
+
+#ifdef _WIN32
+    if (rezArchiveFileEntry->mappedData != NULL)
+    {
+        UnmapViewOfFile(rezArchiveFileEntry->mappedData);
+        CloseHandle(rezArchiveFileEntry->mappingHandle);
     }
+    CloseHandle(rezArchiveFileEntry->fileHandle);
+#else
+    if (rezArchiveFileEntry->mappedData != NULL)
+    {
+        munmap((void*)rezArchiveFileEntry->mappedData, rezArchiveFileEntry->mappedSize);
+    }
+    close(rezArchiveFileEntry->fileDescriptor);
+#endif
+
+    delete rezArchiveFileEntry;
 }
 
 static std::string GetRezFileFullPath(RezFile* rezFile)
@@ -380,7 +551,7 @@ static std::string GetRezFileFullPath(RezFile* rezFile)
     return fullPath;
 }
 
-void FillRezFileMapWithDirectoryFiles(RezFileVec*& rezFileVec, RezDirectory* rezDirectory)
+static void FillRezFileMapWithDirectoryFiles(RezFileVec& rezFileVec, RezDirectory* rezDirectory)
 {
     if (rezDirectory->directoryContents == NULL)
     {
@@ -391,7 +562,7 @@ void FillRezFileMapWithDirectoryFiles(RezFileVec*& rezFileVec, RezDirectory* rez
     {
         RezFile* rezFile = rezDirectory->directoryContents->rezFiles[fileIdx];
 
-        rezFileVec->push_back(rezFile);
+        rezFileVec.push_back(rezFile);
     }
 
     for (uint32_t dirIdx = 0; dirIdx < rezDirectory->directoryContents->rezDirectoriesCount; dirIdx++)
@@ -400,54 +571,24 @@ void FillRezFileMapWithDirectoryFiles(RezFileVec*& rezFileVec, RezDirectory* rez
     }
 }
 
-static void CreateRezArchiveFileMap(RezArchive* rezArchive)
-{
-    if (g_rezArchiveFilesMap.count(rezArchive) != 0)
-    {
-        return;
-    }
-
-    RezFileVec* rezFileVec = new RezFileVec;
-    g_rezArchiveFilesMap.insert(std::make_pair(rezArchive, rezFileVec));
-
-    RezDirectory* rootDirectory = rezArchive->rootDirectory;
-    
-    FillRezFileMapWithDirectoryFiles(rezFileVec, rootDirectory);
-}
-
-void DestroyRezArchiveFileMap(RezArchive* rezArchive)
-{
-    if (g_rezArchiveFilesMap.count(rezArchive) == 0)
-    {
-        return;
-    }
-
-    RezFileVec* rezFileVec = g_rezArchiveFilesMap[rezArchive];
-
-    rezFileVec->clear();
-    delete rezFileVec;
-    g_rezArchiveFilesMap.erase(rezArchive);
-    rezFileVec = NULL;
-}
-
 RezFile* WAP_GetRezFileFromFileIdx(RezArchive* rezArchive, uint32_t rezFileIdx)
 {
-    if (g_rezArchiveFilesMap.count(rezArchive) == 0)
+    if ((rezArchive == NULL) || (rezArchive->fileEntry == NULL))
     {
         return NULL;
     }
 
-    return g_rezArchiveFilesMap[rezArchive]->at(rezFileIdx);
+    return rezArchive->fileEntry->rezFiles.at(rezFileIdx);
 }
 
 uint32_t WAP_GetRezFilesCount(RezArchive* rezArchive)
 {
-    if (g_rezArchiveFilesMap.count(rezArchive) == 0)
+    if ((rezArchive == NULL) || (rezArchive->fileEntry == NULL))
     {
         return 0;
     }
 
-    return g_rezArchiveFilesMap[rezArchive]->size();
+    return rezArchive->fileEntry->rezFiles.size();
 }
 
 static void ReadRezDirectory(RezArchive*& rezArchive, RezDirectory* rezDirectory, std::ifstream* fileStream)
@@ -608,6 +749,7 @@ RezArchive* WAP_LoadRezArchive(const char* rezFilePath)
     }
 
     RezArchive* rezArchive = new RezArchive;
+    rezArchive->fileEntry = NULL;
     rezArchive->rootDirectory = new RezDirectory;
     // Initialize to default values
     (*rezArchive->rootDirectory) = { 0 };
@@ -630,6 +772,7 @@ RezArchive* WAP_LoadRezArchive(const char* rezFilePath)
     // If this check fails, we did not load valid REZ file
     if (expectedRezArchiveSize != actualLoadedFileSize)
     {
+        delete fileStream;
         WAP_DestroyRezArchive(rezArchive);
         return NULL;
     }
@@ -637,13 +780,19 @@ RezArchive* WAP_LoadRezArchive(const char* rezFilePath)
     // Recursively read all directories
     ReadRezDirectory(rezArchive, rezArchive->rootDirectory, fileStream);
 
-    // Register loaded REZ archive file
-    RegisterRezArchiveFile(rezArchive, fileStream);
+    // Stream is only needed for parsing the directory tree, file data is read through file entry
+    delete fileStream;
+
+    rezArchive->fileEntry = OpenRezArchiveFile(rezFilePath);
+    if (rezArchive->fileEntry == NULL)
+    {
+        WAP_DestroyRezArchive(rezArchive);
+        return NULL;
+    }
+
+    // Create list of REZ files for index based access
+    FillRezFileMapWithDirectoryFiles(rezArchive->fileEntry->rezFiles, rezArchive->rootDirectory);
 
-    // Create map of REZ files with key being their full file path
-    //START_QUERY_PERFORMANCE_TIMER;
-    CreateRezArchiveFileMap(rezArchive);
-    //END_QUERY_PERFORMANCE_TIMER;
     return rezArchive;
 }
 
@@ -682,13 +831,11 @@ static void DestroyRezDirectory(RezDirectory* rezDirectory)
 // Valgrind - "All heap blocks were freed -- no leaks are possible"
 void WAP_DestroyRezArchive(RezArchive* rezArchive)
 {
-    // Unregister loaded REZ file entry
-    UnregisterRezArchiveFile(rezArchive);
-
     DestroyRezDirectory(rezArchive->rootDirectory);
 
-    // Clear file map associated with this archive
-    DestroyRezArchiveFileMap(rezArchive);
+    // Close native file and its mapping, this also releases list of REZ files
+    CloseRezArchiveFile(rezArchive->fileEntry);
+    rezArchive->fileEntry = NULL;
 
     delete rezArchive->rootDirectory;
     delete rezArchive;
@@ -239,7 +239,7 @@ void ReadTileDescriptions(WapWwd* wapWwd, InputStream& inputStream)
     }
 }
 
-WapWwd* WAP_TryWwdLoadFromImpl(char* data, uint32_t length)
+WapWwd* WAP_TryWwdLoadFromImpl(const char* data, uint32_t length)
 {
     WapWwd* wapWwd = NULL;
 
@@ -335,7 +335,7 @@ WapWwd* WAP_TryWwdLoadFromImpl(char* data, uint32_t length)
     return wapWwd;
 }
 
-WapWwd* WAP_WwdLoadFromData(char* data, uint32_t length)
+WapWwd* WAP_WwdLoadFromData(const char* data, uint32_t length)
 {
     try
     {
@@ -373,13 +373,14 @@ WapWwd* WAP_WwdLoadFromRezFile(RezFile* rezFile)
         return NULL;
     }
 
-    char* data = WAP_GetRezFileData(rezFile);
-    if (data == NULL)
+    // Read into our own buffer so that loading does not touch libwap's shared file data
+    std::vector<char> wwdFileContents(rezFile->size);
+    if (WAP_ReadRezFileInto(rezFile, wwdFileContents.data()) < 0)
     {
         return NULL;
     }
 
-    return WAP_WwdLoadFromData(data, rezFile->size);
+    return WAP_WwdLoadFromData(wwdFileContents.data(), rezFile->size);
 }
 
 WapWwd* WAP_WwdLoadFromRezArchive(RezArchive* rezArchive, const char* wwdFilePath)
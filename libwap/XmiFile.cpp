@@ -42,7 +42,8 @@ public:
     {
     }
 
-    MemoryBuffer(char* pData, size_t iLength)
+    // Wraps input data which is only ever read, buffer is copied before anything is written to it
+    MemoryBuffer(const char* pData, size_t iLength)
     {
         m_pData = m_pPointer = (char*)pData;
         m_pEnd = m_pData + iLength;
@@ -256,7 +257,7 @@ struct midi_token_list_t : std::vector<midi_token_t>
     }
 };
 
-MidiFile* WAP_XmiToMidiFromData(char* xmiData, size_t xmiLength)
+MidiFile* WAP_XmiToMidiFromData(const char* xmiData, size_t xmiLength)
 {
     MidiFile* midiFile = NULL;
     size_t midiLength;
@@ -451,13 +452,14 @@ MidiFile* WAP_XmiToMidiFromRezFile(RezFile* rezFile)
         return NULL;
     }
 
-    char* data = WAP_GetRezFileData(rezFile);
-    if (data == NULL)
+    // Read into our own buffer so that loading does not touch libwap's shared file data
+    std::vector<char> xmiFileContents(rezFile->size);
+    if (WAP_ReadRezFileInto(rezFile, xmiFileContents.data()) < 0)
     {
         return NULL;
     }
 
-    return WAP_XmiToMidiFromData(data, rezFile->size);
+    return WAP_XmiToMidiFromData(xmiFileContents.data(), rezFile->size);
 }
 
 MidiFile* WAP_XmiToMidiFromRezArchive(RezArchive* rezArchive, char* xmiFilePath)
@@ -26,6 +26,7 @@ extern "C" {
 
 typedef struct RezArchive RezArchive;
 typedef struct RezDirectory RezDirectory;
+typedef struct RezArchiveFileEntry RezArchiveFileEntry;
 
 typedef struct
 {
@@ -68,6 +69,9 @@ typedef struct RezArchive
     RezDirectory* rootDirectory;
     char header[127];
     uint32_t version;
+
+    // Private, native file handle and mapping of the archive
+    RezArchiveFileEntry* fileEntry;
 } RezArchive;
 
 /**
@@ -104,9 +108,21 @@ LIBWAP_API void WAP_SetDirectorySeparator(uint8_t separator);
  */
 LIBWAP_API uint8_t WAP_GetDirectorySeparator();
 
+/**
+ * @brief Reads file content of given RezFile into caller supplied buffer
+ * @note Function does not touch any global state and can be called from multiple threads at once,
+ *       even for the same RezArchive
+ *
+ * @param rezFile Given pointer to RezFile structure
+ * @param buffer Buffer which is at least rezFile->size bytes long
+ * @return Number of bytes read or -1 upon failure
+ */
+LIBWAP_API int32_t WAP_ReadRezFileInto(RezFile* rezFile, char* buffer);
+
 /**
  * @brief Gets file content (data buffer) from given RezFile
  * @note All REZ file datas allocated by this function are automatically freed upon destroying RezArchive
+ * @note Returned buffer is shared between all callers, prefer WAP_ReadRezFileInto when reading from multiple threads
  *
  * @param rezFile Given pointer to RezFile structure
  * @return Pointer to RezFile structure or NULL upon failure
@@ -121,6 +137,16 @@ LIBWAP_API char* WAP_GetRezFileData(RezFile* rezFile);
  */
 LIBWAP_API void WAP_FreeFileData(RezFile* rezFile);
 
+/**
+ * @brief Gets read-only view of file content (data buffer) from given RezFile without copying it
+ * @note Returned buffer points directly into memory mapped REZ archive and stays valid until RezArchive is destroyed
+ * @note Returned buffer must not be freed nor passed to WAP_FreeFileData
+ *
+ * @param rezFile Given pointer to RezFile structure
+ * @return Pointer to file content or NULL if REZ archive could not be memory mapped
+ */
+LIBWAP_API const char* WAP_GetRezFileDataView(RezFile* rezFile);
+
 /**
  * @brief Gets RezFile from given RezArchive and path to the RezFile
  * @note if rezFilePath is NULL or empty string (""), root directory is returned
@@ -436,7 +462,7 @@ typedef struct
  * @param length Data buffer length/size
  * @return Pointer to structure describing loaded level or NULL upon failure
  */
-LIBWAP_API WapWwd* WAP_WwdLoadFromData(char* data, uint32_t length);
+LIBWAP_API WapWwd* WAP_WwdLoadFromData(const char* data, uint32_t length);
 
 /**
  * @brief Loads WWD file (= file describing level) from given path to WWD file
@@ -515,7 +541,7 @@ typedef struct
  * @param length Data buffer length/size
  * @return Pointer to structure describing loaded 2D Animation or NULL upon failure
  */
-LIBWAP_API WapAni* WAP_AniLoadFromData(char* data, size_t size);
+LIBWAP_API WapAni* WAP_AniLoadFromData(const char* data, size_t size);
 
 /**
  * @brief Loads ANI file (= 2D animation description file) from given path to WWD file
@@ -568,7 +594,7 @@ typedef struct
  * @param xmiLength XMI music data length
  * @return Pointer to converted MIDI file structure or NULL upon failure
  */
-LIBWAP_API MidiFile* WAP_XmiToMidiFromData(char* xmiData, size_t xmiLength);
+LIBWAP_API MidiFile* WAP_XmiToMidiFromData(const char* xmiData, size_t xmiLength);
 
 /**
  * @brief Converts XMI music file format data to MIDI music file format data from given filesystem path to XMI file
@@ -632,7 +658,7 @@ typedef struct
  * @param size PAL data length
  * @return Pointer to RGBA Color palette
  */
-LIBWAP_API WapPal* WAP_PalLoadFromData(char* data, size_t size);
+LIBWAP_API WapPal* WAP_PalLoadFromData(const char* data, size_t size);
 
 /**
  * @brief Loads PAL color palette from filesystem's file path
@@ -706,7 +732,32 @@ typedef struct
  * @param palette Color palette to be used when decoding PID image. Pass NULL if you want to use embedded palette.
  * @return Pointer to PID file structure or NULL upon failure
  */
-LIBWAP_API WapPid* WAP_PidLoadFromData(char* data, size_t size, WapPal* palette);
+LIBWAP_API WapPid* WAP_PidLoadFromData(const char* data, size_t size, WapPal* palette);
+
+/**
+ * @brief Reads only PID header (dimensions, offsets, flags) from given data buffer
+ * @note Pixels are not decoded, colors are left NULL and colorsCount is 0
+ *
+ * @param data PID data buffer
+ * @param size PID data length
+ * @param wapPid PID structure to be filled
+ * @return 0 on success, negative number upon failure
+ */
+LIBWAP_API int32_t WAP_PidLoadHeaderFromData(const char* data, size_t size, WapPid* wapPid);
+
+/**
+ * @brief Decodes PID pixels from given data buffer straight into caller's pixel buffer
+ * @note If PID has embedded palette, embedded palette always takes preference
+ * @note Every pixel is written as 4 bytes in R, G, B, A order - same as WAP_ColorRGBA
+ *
+ * @param data PID data buffer
+ * @param size PID data length
+ * @param palette Color palette to be used when decoding PID image. Pass NULL if you want to use embedded palette.
+ * @param pixels Buffer with at least height rows of pitch bytes each, see WAP_PidLoadHeaderFromData
+ * @param pitch Length of one row within pixels in bytes, has to be multiple of 4 and at least width * 4
+ * @return 0 on success, negative number upon failure
+ */
+LIBWAP_API int32_t WAP_PidDecodeFromData(const char* data, size_t size, WapPal* palette, uint32_t* pixels, uint32_t pitch);
 
 /**
  * @brief Loads PID file (= 2D image format) from filesystem's file path
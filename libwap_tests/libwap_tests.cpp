@@ -4,6 +4,9 @@
 #include <libwap.h>
 #include "TestUtil.h"
 
+#include <thread>
+#include <atomic>
+
 TEST_CASE("----- REZ ARCHIVE FILE -----")
 {
     SECTION("Loading file with wrong path to REZ archive returns NULL")
@@ -253,6 +256,141 @@ TEST_CASE("----- REZ ARCHIVE FILE -----")
         WAP_FreeFileData(rezFile);
     }
 
+    SECTION("Getting file data view from valid REZ file returns same data as copied file data")
+    {
+        // Official CLAW.REZ file
+        RezArchive* rezArchive = WAP_LoadRezArchive("CLAW.REZ");
+
+        REQUIRE(rezArchive != NULL);
+
+        RezFile* rezFile = WAP_GetRezFileFromRezArchive(rezArchive, "CLAW/ANIS/DUCKPISTOL.ANI");
+        REQUIRE(rezFile != NULL);
+
+        const char* dataView = WAP_GetRezFileDataView(rezFile);
+        REQUIRE(dataView != NULL);
+
+        char* data = WAP_GetRezFileData(rezFile);
+        REQUIRE(data != NULL);
+        REQUIRE(memcmp(dataView, data, rezFile->size) == 0);
+
+        // View is not a copy, it is stable across calls
+        REQUIRE(WAP_GetRezFileDataView(rezFile) == dataView);
+
+        REQUIRE(WAP_GetRezFileDataView(NULL) == NULL);
+
+        WAP_FreeFileData(rezFile);
+        WAP_DestroyRezArchive(rezArchive);
+    }
+
+    SECTION("[WAP_ReadRezFileInto]: Reading and decoding files from multiple threads returns same data as single threaded reads")
+    {
+        // Official CLAW.REZ file
+        RezArchive* rezArchive = WAP_LoadRezArchive("CLAW.REZ");
+        REQUIRE(rezArchive != NULL);
+
+        REQUIRE(WAP_ReadRezFileInto(NULL, NULL) == -1);
+
+        WapPal* wapPal = WAP_PalLoadFromRezArchive(rezArchive, "LEVEL1/PALETTES/MAIN.PAL");
+        REQUIRE(wapPal != NULL);
+
+        // Single threaded reference - checksum of raw data and of decoded image
+        uint32_t rezFilesCount = WAP_GetRezFilesCount(rezArchive);
+        REQUIRE(rezFilesCount > 0);
+
+        std::vector<uint32_t> expectedChecksums(rezFilesCount);
+        for (uint32_t fileIdx = 0; fileIdx < rezFilesCount; fileIdx++)
+        {
+            RezFile* rezFile = WAP_GetRezFileFromFileIdx(rezArchive, fileIdx);
+            std::vector<char> data(rezFile->size);
+            REQUIRE(WAP_ReadRezFileInto(rezFile, data.data()) == (int32_t)rezFile->size);
+
+            uint32_t checksum = 0;
+            for (char c : data)
+            {
+                checksum = checksum * 31 + (uint8_t)c;
+            }
+            expectedChecksums[fileIdx] = checksum;
+        }
+
+        const uint32_t numThreads = 8;
+        std::atomic<uint32_t> numMismatches(0);
+        std::atomic<uint32_t> numDecodedImages(0);
+        std::vector<std::thread> threads;
+        for (uint32_t threadIdx = 0; threadIdx < numThreads; threadIdx++)
+        {
+            threads.push_back(std::thread([&, threadIdx]()
+            {
+                // Every thread walks whole archive from different starting point so that
+                // the same files are read concurrently as well
+                for (uint32_t i = 0; i < rezFilesCount; i++)
+                {
+                    uint32_t fileIdx = (i + threadIdx * (rezFilesCount / numThreads)) % rezFilesCount;
+                    RezFile* rezFile = WAP_GetRezFileFromFileIdx(rezArchive, fileIdx);
+
+                    std::vector<char> data(rezFile->size);
+                    if (WAP_ReadRezFileInto(rezFile, data.data()) != (int32_t)rezFile->size)
+                    {
+                        numMismatches++;
+                        continue;
+                    }
+
+                    uint32_t checksum = 0;
+                    for (char c : data)
+                    {
+                        checksum = checksum * 31 + (uint8_t)c;
+                    }
+                    if (checksum != expectedChecksums[fileIdx])
+                    {
+                        numMismatches++;
+                    }
+
+                    if (strcmp(rezFile->extension, "PID") == 0)
+                    {
+                        WapPid* wapPid = WAP_PidLoadFromRezFile(rezFile, wapPal);
+                        if (wapPid == NULL)
+                        {
+                            numMismatches++;
+                            continue;
+                        }
+                        numDecodedImages++;
+                        WAP_PidDestroy(wapPid);
+                    }
+                    else if (strcmp(rezFile->extension, "ANI") == 0)
+                    {
+                        WapAni* wapAni = WAP_AniLoadFromRezFile(rezFile);
+                        if (wapAni == NULL)
+                        {
+                            numMismatches++;
+                            continue;
+                        }
+                        WAP_AniDestroy(wapAni);
+                    }
+
+                    // Shared buffers handed out by libwap have to survive concurrent access as well
+                    if ((fileIdx % 64) == 0)
+                    {
+                        char* sharedData = WAP_GetRezFileData(rezFile);
+                        if (sharedData == NULL)
+                        {
+                            numMismatches++;
+                        }
+                    }
+                }
+            }));
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(numMismatches == 0);
+        REQUIRE(numDecodedImages > 0);
+
+        WAP_PalDestroy(wapPal);
+        WAP_DestroyRezArchive(rezArchive);
+    }
+
     SECTION("Getting valid directory from valid REZ directory with non-compliant directory separator set returns NULL")
     {
         // Official CLAW.REZ file